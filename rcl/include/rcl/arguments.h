@@ -317,13 +317,16 @@ rcl_arguments_get_param_files(
 /**
  * Parameter overrides are parsed directly from command line arguments and
  * parameter files provided in the command line.
+ * The output shares its contents with the arguments structure, see
+ * `rcl_yaml_node_struct_share()`, so it must only be modified through the
+ * rcl_yaml_param_parser API.
  *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | Yes
  * Thread-Safe        | No
- * Uses Atomics       | No
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] arguments An arguments structure that has been parsed.
@@ -0,0 +1,252 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file
+
+#ifndef RCL__COMPRESSION_H_
+#define RCL__COMPRESSION_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcl/allocator.h"
+#include "rcl/macros.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// Size of the header which precedes the compressed payload, holding the original size.
+#define RCL_COMPRESSION_HEADER_SIZE 8u
+
+/// Largest original size accepted when decompressing with a `max_decompressed_size` of 0.
+/**
+ * The original size is announced by the publisher, so without a cap a small
+ * crafted message could make each subscription reserve up to the decompress
+ * bound of the codec, e.g. 1 GiB for a 4 MiB LZ4 payload.
+ * Topics carrying larger messages must set `max_decompressed_size` explicitly.
+ */
+#define RCL_COMPRESSION_DEFAULT_MAX_DECOMPRESSED_SIZE ((size_t)64u * 1024u * 1024u)
+
+/// Signature of the functions which compress or decompress a buffer.
+/**
+ * `output_capacity` is at least the compress bound of the codec when
+ * compressing, and exactly the original size when decompressing.
+ * `scratch` is kept by the caller between calls, the codec may resize it with
+ * its own allocator and use it as working memory, so that once it is large
+ * enough compressing does not allocate.
+ * On failure the error message is set and `RCL_RET_ERROR` returned.
+ */
+typedef rcl_ret_t (* rcl_compression_function_t)(
+  const uint8_t * input,
+  size_t input_size,
+  uint8_t * output,
+  size_t output_capacity,
+  size_t * output_size,
+  rcl_serialized_message_t * scratch,
+  void * state);
+
+/// Compression codec applied to the serialized messages of a topic.
+/**
+ * A codec with a `NULL` name, as returned by
+ * rcl_get_zero_initialized_compression_codec(), disables compression.
+ *
+ * The name is appended to the topic name given to the middleware, as in
+ * `/map/lz4_compressed`, so publishers and subscriptions only match peers
+ * using the same codec, and peers which do not compress never see
+ * compressed payloads.
+ * The topic stays visible to tools which hide the topics with a token
+ * starting with an underscore.
+ * The name must only contain alphanumerics and underscores, and start with a
+ * letter.
+ *
+ * rcl_get_lz4_compression_codec() returns the built-in codec, and
+ * rcl_get_zstd_compression_codec() one using libzstd, if rcl was built with
+ * it.
+ * Others can be provided by filling the function pointers.
+ */
+typedef struct rcl_compression_codec_t
+{
+  /// Name of the codec, or `NULL` to disable compression.
+  const char * name;
+  /// Return the largest possible compressed size for an input of `size` bytes.
+  size_t (* compress_bound)(size_t size);
+  /// Return the largest original size a compressed payload of `size` bytes can hold.
+  /**
+   * The original size is read from a header written by the publisher, which
+   * is checked against this bound before any memory is reserved for it.
+   */
+  size_t (* decompress_bound)(size_t size);
+  /// Largest original size accepted when decompressing.
+  /**
+   * 0 stands for #RCL_COMPRESSION_DEFAULT_MAX_DECOMPRESSED_SIZE, and `SIZE_MAX`
+   * only bounds it by the decompress bound of the codec.
+   */
+  size_t max_decompressed_size;
+  /// Compress a buffer.
+  rcl_compression_function_t compress;
+  /// Decompress a buffer.
+  rcl_compression_function_t decompress;
+  /// Opaque state passed to the functions, e.g. a compression context.
+  void * state;
+} rcl_compression_codec_t;
+
+/// Return a codec with members set to `NULL`, which disables compression.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_compression_codec_t
+rcl_get_zero_initialized_compression_codec(void);
+
+/// Return the built-in codec, which produces blocks in the LZ4 block format.
+/**
+ * The compressor is a fast greedy matcher which favors speed over ratio,
+ * suited to the maps, point clouds and images sent over constrained links.
+ * It uses 16 KiB of scratch memory, and payloads expand at most 255 times.
+ * Its blocks are decoded by the reference LZ4 library, and it decodes the
+ * blocks of the reference LZ4 library, so it interoperates with peers using
+ * liblz4 behind the same topic name and header.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_compression_codec_t
+rcl_get_lz4_compression_codec(void);
+
+/// Get a codec compressing with zstd, which favors ratio over speed.
+/**
+ * It is only available if rcl was built with the `RCL_COMPRESSION_ZSTD_ENABLED`
+ * CMake option, which links rcl against libzstd.
+ * Unlike the LZ4 codec, libzstd allocates its working memory on each call
+ * with the default allocator, as it does not use the scratch message.
+ *
+ * \param[out] codec the zstd codec
+ * \return #RCL_RET_OK if successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_UNSUPPORTED if rcl was built without zstd.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_zstd_compression_codec(rcl_compression_codec_t * codec);
+
+/// Check that a codec is usable, setting the error message if not.
+/**
+ * \param[in] codec codec to check, with a non `NULL` name
+ * \return `true` if the name and functions of the codec are valid, otherwise `false`
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+bool
+rcl_compression_codec_is_valid(const rcl_compression_codec_t * codec);
+
+/// Return the topic name used on the wire by peers compressing with a codec.
+/**
+ * The returned string is allocated with the given allocator and owned by the caller.
+ *
+ * \param[in] topic_name fully qualified topic name
+ * \param[in] codec valid codec
+ * \param[in] allocator allocator for the returned string
+ * \param[out] output_topic_name the topic name with the codec suffix
+ * \return #RCL_RET_OK if successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_compression_get_topic_name(
+  const char * topic_name,
+  const rcl_compression_codec_t * codec,
+  rcl_allocator_t allocator,
+  char ** output_topic_name);
+
+/// Compress a serialized message.
+/**
+ * The output holds the original size in a #RCL_COMPRESSION_HEADER_SIZE bytes
+ * header followed by the compressed payload.
+ * The output and scratch messages are resized as needed with their own
+ * allocators, and reusing them between calls avoids allocating once they are
+ * large enough.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | Yes [2]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] if the output or scratch messages have to grow</i>
+ * <i>[2] for distinct outputs and scratch messages, if the codec is thread-safe</i>
+ *
+ * \param[in] codec valid codec
+ * \param[in] input serialized message to compress
+ * \param[inout] output initialized serialized message receiving the result
+ * \param[inout] scratch initialized serialized message used as working memory by the codec
+ * \return #RCL_RET_OK if successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if the codec failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_compress_serialized_message(
+  const rcl_compression_codec_t * codec,
+  const rcl_serialized_message_t * input,
+  rcl_serialized_message_t * output,
+  rcl_serialized_message_t * scratch);
+
+/// Decompress a serialized message produced by rcl_compress_serialized_message().
+/**
+ * The original size announced by the header comes from the publisher, so it
+ * is rejected, before the output is resized, when it exceeds the decompress
+ * bound of the codec or its `max_decompressed_size`, which defaults to
+ * #RCL_COMPRESSION_DEFAULT_MAX_DECOMPRESSED_SIZE.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | Yes [2]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] if the output or scratch messages have to grow</i>
+ * <i>[2] for distinct outputs and scratch messages, if the codec is thread-safe</i>
+ *
+ * \param[in] codec valid codec, the one the message was compressed with
+ * \param[in] input compressed message
+ * \param[inout] output initialized serialized message receiving the result
+ * \param[inout] scratch initialized serialized message used as working memory by the codec
+ * \return #RCL_RET_OK if successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if the input is corrupted, too large, or the codec failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_decompress_serialized_message(
+  const rcl_compression_codec_t * codec,
+  const rcl_serialized_message_t * input,
+  rcl_serialized_message_t * output,
+  rcl_serialized_message_t * scratch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__COMPRESSION_H_
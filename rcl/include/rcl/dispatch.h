@@ -0,0 +1,134 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__DISPATCH_H_
+#define RCL__DISPATCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcl/macros.h"
+#include "rcl/time.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// Scheduling attributes of a subscription, timer or service.
+/**
+ * They decide in which order ready entities are dispatched, see
+ * rcl_dispatch_order().
+ */
+typedef struct rcl_dispatch_attributes_t
+{
+  /// Fixed priority, entities with a higher priority are dispatched first.
+  int32_t priority;
+  /// Duration, in nanoseconds, from the release of the data to its deadline, or 0 for none.
+  rcl_duration_value_t relative_deadline;
+} rcl_dispatch_attributes_t;
+
+/// Order in which ready entities are dispatched.
+typedef enum rcl_dispatch_policy_e
+{
+  /// In the order the entities were added, which is the order of the wait set arrays.
+  RCL_DISPATCH_POLICY_ADDED_ORDER,
+  /// By decreasing priority.
+  RCL_DISPATCH_POLICY_FIXED_PRIORITY,
+  /// By increasing absolute deadline, entities without a deadline last.
+  RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST
+} rcl_dispatch_policy_t;
+
+/// Kind of the entity of a dispatch entry.
+typedef enum rcl_dispatch_entity_type_e
+{
+  RCL_DISPATCH_ENTITY_SUBSCRIPTION,
+  RCL_DISPATCH_ENTITY_TIMER,
+  RCL_DISPATCH_ENTITY_SERVICE,
+  /// Any other entity, which has the default attributes.
+  RCL_DISPATCH_ENTITY_OTHER
+} rcl_dispatch_entity_type_t;
+
+/// A ready entity to be ordered by rcl_dispatch_order().
+typedef struct rcl_dispatch_entry_t
+{
+  /// Kind of the entity.
+  rcl_dispatch_entity_type_t type;
+  /// Index of the entity, e.g. in the array of its kind of a wait set.
+  size_t index;
+  /// Scheduling attributes of the entity.
+  rcl_dispatch_attributes_t attributes;
+  /// System time, in nanoseconds, at which the data of the entity was released.
+  /**
+   * For messages and requests this is their source timestamp, and for timers the
+   * time at which they were scheduled to be called.
+   *
+   * The source timestamp is only known once the data is taken, so
+   * rcl_wait_set_get_dispatch_order() releases ready subscriptions and services
+   * at the time it is called instead.
+   * Among those, earliest deadline first then orders by relative deadline, and
+   * entries with equal deadlines keep the order of the wait set.
+   * rcl_executor_spin_some() takes ready data first and uses its source timestamp.
+   */
+  rcl_time_point_value_t release_time;
+} rcl_dispatch_entry_t;
+
+/// Return the default dispatch attributes, priority 0 and no deadline.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_dispatch_attributes_t
+rcl_dispatch_get_default_attributes(void);
+
+/// Return the absolute deadline of an entry, or `INT64_MAX` if it has none.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_time_point_value_t
+rcl_dispatch_entry_get_deadline(const rcl_dispatch_entry_t * entry);
+
+/// Sort dispatch entries in the order they should be dispatched in.
+/**
+ * The sort is stable, entries which compare equal keep their relative order,
+ * so that with #RCL_DISPATCH_POLICY_ADDED_ORDER the entries are left untouched.
+ * Under #RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST entries with equal deadlines
+ * are ordered by priority.
+ *
+ * The sort is done in place by insertion, which is quick for the handful of
+ * entities that are usually ready at once but quadratic in the worst case.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] entries the entries to sort
+ * \param[in] count the number of entries
+ * \param[in] policy the dispatch policy to sort by
+ * \return #RCL_RET_OK if the entries were sorted, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_dispatch_order(rcl_dispatch_entry_t * entries, size_t count, rcl_dispatch_policy_t policy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__DISPATCH_H_
@@ -0,0 +1,165 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file
+
+#ifndef RCL__ENVIRONMENT_H_
+#define RCL__ENVIRONMENT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcl/allocator.h"
+#include "rcl/macros.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+#include "rmw/localhost.h"
+#include "rmw/security_options.h"
+
+/// Snapshot of the environment variables read by rcl_init().
+/**
+ * The snapshot is captured the first time it is needed and then kept for the
+ * lifetime of the process, so that initializing many contexts, one after the
+ * other or concurrently, does not repeatedly read the environment.
+ * Changes made to the environment afterwards are thus only taken into
+ * account once rcl_reload_environment() is called.
+ */
+typedef struct rcl_environment_t
+{
+  /// Value of `ROS_DOMAIN_ID`, or #RCL_DEFAULT_DOMAIN_ID if unset or empty.
+  size_t domain_id;
+  /// Value of `ROS_LOCALHOST_ONLY`.
+  rmw_localhost_only_t localhost_only;
+  /// Whether `ROS_SECURITY_ENABLE` is "true".
+  bool security_enabled;
+  /// Value of `ROS_SECURITY_STRATEGY`.
+  rmw_security_enforcement_policy_t security_enforcement;
+  /// Value of `ROS_SECURITY_KEYSTORE`, or `NULL` if unset or empty.
+  const char * security_keystore;
+  /// Value of `ROS_SECURITY_ENCLAVE_OVERRIDE`, or `NULL` if unset or empty.
+  const char * security_enclave_override;
+} rcl_environment_t;
+
+/// Get the environment snapshot of the process, capturing it if needed.
+/**
+ * The returned snapshot holds a reference, which must be released with
+ * rcl_release_environment() once the snapshot is no longer used.
+ * It stays valid until then, even if rcl_reload_environment() is called in
+ * the meantime.
+ *
+ * The environment is read without holding any lock, so that threads getting
+ * the snapshot concurrently do not wait on each other.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ * <i>[1] only when the snapshot is captured</i>
+ *
+ * \param[out] environment the environment snapshot
+ * \return #RCL_RET_OK if the snapshot was retrieved, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an environment variable could not be read or is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_environment(const rcl_environment_t ** environment);
+
+/// Release a snapshot returned by rcl_get_environment().
+/**
+ * The snapshot is freed if it was discarded by rcl_reload_environment() and
+ * this was its last reference.
+ * If `environment` is `NULL`, nothing is done.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[in] environment the environment snapshot to release
+ */
+RCL_PUBLIC
+void
+rcl_release_environment(const rcl_environment_t * environment);
+
+/// Discard the environment snapshot of the process, along with its enclave cache.
+/**
+ * The next call to rcl_get_environment() captures a new snapshot.
+ * Snapshots previously returned by rcl_get_environment() remain valid until
+ * they are released.
+ * The contexts already initialized are not affected, as they copied the
+ * settings they need from the snapshot.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ */
+RCL_PUBLIC
+void
+rcl_reload_environment(void);
+
+/// Initialize security options from the environment snapshot and the given enclave name.
+/**
+ * This is the equivalent of rcl_get_security_options_from_environment(),
+ * but based on the environment snapshot of the process.
+ * The secure root of each enclave name, and whether it exists, is resolved
+ * once and cached along with the snapshot, without holding any lock.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | No
+ *
+ * \param[in] name name used to find the security root path.
+ * \param[in] allocator used to allocate the security root path.
+ * \param[out] security_options security options that will be configured according to
+ *  the environment.
+ * \return #RCL_RET_OK If the security options are returned properly, or
+ * \return #RCL_RET_INVALID_ARGUMENT if an argument is not valid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unexpected error happened
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_security_options_from_environment_snapshot(
+  const char * name,
+  const rcl_allocator_t * allocator,
+  rmw_security_options_t * security_options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ENVIRONMENT_H_
@@ -199,6 +199,193 @@ RCL_PUBLIC
 bool
 rcl_event_is_valid(const rcl_event_t * event);
 
+/// Internal rcl implementation struct.
+struct rcl_event_group_impl_t;
+
+/// Structure which aggregates the QoS events of many publishers and subscriptions.
+typedef struct rcl_event_group_t
+{
+  /// Pointer to the event group implementation
+  struct rcl_event_group_impl_t * impl;
+} rcl_event_group_t;
+
+/// Status change of a QoS event taken from an event group.
+typedef struct rcl_event_group_status_t
+{
+  /// Publisher whose status changed, or `NULL` for a subscription event.
+  const rcl_publisher_t * publisher;
+  /// Subscription whose status changed, or `NULL` for a publisher event.
+  const rcl_subscription_t * subscription;
+  /// Type of the event, which selects the member of status.
+  rmw_event_type_t event_type;
+  /// Status of the event.
+  union
+  {
+    rmw_liveliness_changed_status_t liveliness_changed;
+    rmw_requested_deadline_missed_status_t requested_deadline_missed;
+    rmw_requested_qos_incompatible_event_status_t requested_incompatible_qos;
+    rmw_message_lost_status_t message_lost;
+    rmw_liveliness_lost_status_t liveliness_lost;
+    rmw_offered_deadline_missed_status_t offered_deadline_missed;
+    rmw_offered_qos_incompatible_event_status_t offered_incompatible_qos;
+  } status;
+} rcl_event_group_status_t;
+
+/// Return a rcl_event_group_t struct with members set to `NULL`.
+/**
+ * Should be called to get a null rcl_event_group_t before passing to
+ * rcl_event_group_init().
+ *
+ * \return Zero initialized rcl_event_group_t.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_event_group_t
+rcl_get_zero_initialized_event_group(void);
+
+/// Initialize an event group for the endpoints of a node.
+/**
+ * An event group collects the QoS events of any number of publishers and
+ * subscriptions of a node, which are then taken in batches with
+ * rcl_event_group_take().
+ * The events of a group are not added to wait sets: as the middleware cannot
+ * notify of status changes other than through a wait set entry per event,
+ * the group is meant to be polled instead, e.g. from a timer, so that
+ * monitoring many endpoints does not grow the wait sets.
+ *
+ * The allocator of the node is used for the group.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] group preallocated, zero-initialized event group
+ * \param[in] node valid node whose endpoints are monitored
+ * \return #RCL_RET_OK if the group was initialized, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ALREADY_INIT if the group is already initialized, or
+ * \return #RCL_RET_NODE_INVALID if the node is invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_group_init(
+  rcl_event_group_t * group,
+  const rcl_node_t * node);
+
+/// Add a publisher event to an event group.
+/**
+ * The publisher must outlive its membership of the group, see
+ * rcl_event_group_remove().
+ *
+ * \param[inout] group the event group
+ * \param[in] publisher the publisher to get events from, created with the node of the group
+ * \param[in] event_type the event to listen for
+ * \return #RCL_RET_OK if the event was added, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ *   if the publisher does not belong to the node of the group, or
+ * \return #RCL_RET_PUBLISHER_INVALID if the publisher is invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_UNSUPPORTED if event_type is not supported, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_group_add_publisher_event(
+  rcl_event_group_t * group,
+  const rcl_publisher_t * publisher,
+  const rcl_publisher_event_type_t event_type);
+
+/// Add a subscription event to an event group.
+/**
+ * The subscription must outlive its membership of the group, see
+ * rcl_event_group_remove().
+ *
+ * \param[inout] group the event group
+ * \param[in] subscription the subscription to get events from, created with the node of the group
+ * \param[in] event_type the event to listen for
+ * \return #RCL_RET_OK if the event was added, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ *   if the subscription does not belong to the node of the group, or
+ * \return #RCL_RET_SUBSCRIPTION_INVALID if the subscription is invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_UNSUPPORTED if event_type is not supported, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_group_add_subscription_event(
+  rcl_event_group_t * group,
+  const rcl_subscription_t * subscription,
+  const rcl_subscription_event_type_t event_type);
+
+/// Remove every event of a publisher or subscription from an event group.
+/**
+ * \param[inout] group the event group
+ * \param[in] entity the publisher or subscription whose events are removed
+ * \return #RCL_RET_OK if the events were removed, even if there were none, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_group_remove(
+  rcl_event_group_t * group,
+  const void * entity);
+
+/// Take a batch of status changes from an event group.
+/**
+ * Only events whose status changed since they were last taken are returned.
+ * Events are polled in a round robin order across calls, so that a batch
+ * smaller than the group does not starve its last events.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] group the event group to take from, its round robin position advances
+ * \param[out] statuses array of at least `count` statuses to fill
+ * \param[in] count maximum number of statuses to take
+ * \param[out] taken number of statuses taken, set even if an error occurs
+ * \return #RCL_RET_OK if one or more statuses were taken, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if memory allocation failed, or
+ * \return #RCL_RET_EVENT_TAKE_FAILED if no status changed, or
+ * \return #RCL_RET_ERROR if an unexpected error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_group_take(
+  rcl_event_group_t * group,
+  rcl_event_group_status_t * statuses,
+  size_t count,
+  size_t * taken);
+
+/// Finalize an event group, along with its events.
+/**
+ * \param[inout] group the event group to finalize
+ * \return #RCL_RET_OK if successful, or
+ * \return #RCL_RET_INVALID_ARGUMENT if group is null, or
+ * \return #RCL_RET_ERROR if an unexpected error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_group_fini(rcl_event_group_t * group);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,496 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file
+
+#ifndef RCL__EXECUTOR_H_
+#define RCL__EXECUTOR_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcl/allocator.h"
+#include "rcl/client.h"
+#include "rcl/context.h"
+#include "rcl/dispatch.h"
+#include "rcl/guard_condition.h"
+#include "rcl/macros.h"
+#include "rcl/service.h"
+#include "rcl/subscription.h"
+#include "rcl/timer.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+#include "rcl/wait.h"
+
+/// Callback for a message taken from a subscription.
+typedef void (* rcl_executor_subscription_callback_t)(const void * message, void * context);
+
+/// Callback for a request taken by a service, which fills in the response to send.
+typedef void (* rcl_executor_service_callback_t)(
+  const void * request, void * response, void * context);
+
+/// Callback for a response taken by a client.
+typedef void (* rcl_executor_client_callback_t)(
+  const void * response, const rmw_request_id_t * request_header, void * context);
+
+/// Callback for a triggered guard condition.
+typedef void (* rcl_executor_guard_condition_callback_t)(void * context);
+
+/// Entity made of several wait set entities, such as an action server or client.
+/**
+ * The executor only calls these functions, `data` is owned by the caller and
+ * must outlive the executor.
+ * None of the functions may allocate after the first call to
+ * rcl_executor_prepare() for the executor to remain allocation free.
+ */
+typedef struct rcl_executor_waitable_t
+{
+  /// Caller storage passed to all functions.
+  void * data;
+  /// Get the number of wait set entities, see rcl_wait_set_init().
+  rcl_ret_t (* get_number_of_entities)(
+    void * data,
+    size_t * number_of_subscriptions,
+    size_t * number_of_guard_conditions,
+    size_t * number_of_timers,
+    size_t * number_of_clients,
+    size_t * number_of_services);
+  /// Add the entities to the cleared wait set.
+  rcl_ret_t (* add_to_wait_set)(void * data, rcl_wait_set_t * wait_set);
+  /// Store whether any entity is ready in the waited on wait set.
+  rcl_ret_t (* is_ready)(void * data, const rcl_wait_set_t * wait_set, bool * is_ready);
+  /// Take and process the ready entities.
+  rcl_ret_t (* execute)(void * data);
+} rcl_executor_waitable_t;
+
+/// Condition on the ready handles for the executor to dispatch any of them.
+typedef enum rcl_executor_trigger_e
+{
+  /// Dispatch as soon as any handle is ready.
+  RCL_EXECUTOR_TRIGGER_ANY = 0,
+  /// Dispatch only once all handles are ready.
+  RCL_EXECUTOR_TRIGGER_ALL,
+  /// Dispatch when the trigger predicate of the options returns true.
+  RCL_EXECUTOR_TRIGGER_PREDICATE
+} rcl_executor_trigger_t;
+
+/// Predicate on the ready handles, in the order they were added to the executor.
+typedef bool (* rcl_executor_trigger_predicate_t)(
+  const bool * is_ready, size_t number_of_handles, void * context);
+
+/// How the data of the ready handles is taken relative to their callbacks.
+typedef enum rcl_executor_semantics_e
+{
+  /// Take and execute each ready handle in turn.
+  RCL_EXECUTOR_SEMANTICS_TAKE_AND_EXECUTE = 0,
+  /// Take the data of all ready handles first, then execute them.
+  /**
+   * Every callback of a dispatch then sees the inputs as they were when the
+   * wait returned, as with logical execution time.
+   * Timers and waitables take and execute in one step, so they are called in
+   * the execute phase.
+   */
+  RCL_EXECUTOR_SEMANTICS_TAKE_ALL_THEN_EXECUTE
+} rcl_executor_semantics_t;
+
+/// Options for the executor.
+typedef struct rcl_executor_options_t
+{
+  /// Condition for dispatching the ready handles.
+  rcl_executor_trigger_t trigger;
+  /// Predicate used with #RCL_EXECUTOR_TRIGGER_PREDICATE.
+  rcl_executor_trigger_predicate_t trigger_predicate;
+  /// Context passed to the trigger predicate.
+  void * trigger_context;
+  /// How data is taken relative to the callbacks.
+  rcl_executor_semantics_t semantics;
+  /// Order in which the ready handles are dispatched.
+  /**
+   * Subscriptions and services use the dispatch attributes of their options,
+   * timers those set with rcl_timer_set_dispatch_attributes(), and all other
+   * handles the default attributes.
+   * With #RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST the deadlines depend on
+   * the source timestamps of the taken data, so the data of all ready handles is
+   * taken first whatever the semantics.
+   */
+  rcl_dispatch_policy_t dispatch_policy;
+  /// Custom allocator for the executor, used for setup only.
+  rcl_allocator_t allocator;
+} rcl_executor_options_t;
+
+struct rcl_executor_impl_t;
+
+/// Single-threaded executor dispatching a fixed table of handles over a reused wait set.
+/**
+ * Ready handles are dispatched in the order they were added, unless the
+ * dispatch policy of the options orders them by priority or deadline.
+ */
+typedef struct rcl_executor_t
+{
+  /// Pointer to the executor implementation.
+  struct rcl_executor_impl_t * impl;
+} rcl_executor_t;
+
+/// Return a rcl_executor_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_executor_t
+rcl_get_zero_initialized_executor(void);
+
+/// Return the default executor options.
+/**
+ * The defaults are:
+ *
+ * - trigger = #RCL_EXECUTOR_TRIGGER_ANY
+ * - trigger_predicate = `NULL`
+ * - trigger_context = `NULL`
+ * - semantics = #RCL_EXECUTOR_SEMANTICS_TAKE_AND_EXECUTE
+ * - dispatch_policy = #RCL_DISPATCH_POLICY_ADDED_ORDER
+ * - allocator = rcl_get_default_allocator()
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_executor_options_t
+rcl_executor_get_default_options(void);
+
+/// Initialize an executor with a handle table of a fixed capacity.
+/**
+ * The handle table is allocated here, and the wait set by the first call to
+ * rcl_executor_prepare() or rcl_executor_spin_some().
+ * After that, spinning does not allocate memory as long as no handle is added.
+ *
+ * Expected usage:
+ *
+ * ```c
+ * #include <rcl/executor.h>
+ *
+ * rcl_executor_t executor = rcl_get_zero_initialized_executor();
+ * rcl_executor_options_t options = rcl_executor_get_default_options();
+ * rcl_ret_t ret = rcl_executor_init(&executor, &context, 2, &options);
+ * // ... error handling
+ * ret = rcl_executor_add_subscription(&executor, &subscription, &msg, on_msg, NULL);
+ * ret = rcl_executor_add_timer(&executor, &timer);
+ * // ... error handling, then spin:
+ * ret = rcl_executor_spin_some(&executor, RCL_MS_TO_NS(100));
+ * // ... error handling, and eventually call the matching fini:
+ * ret = rcl_executor_fini(&executor);
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the zero initialized executor to initialize
+ * \param[in] context the context the entities of the executor belong to
+ * \param[in] number_of_handles non-zero capacity of the handle table
+ * \param[in] options the executor options, copied
+ * \return #RCL_RET_OK if the executor was initialized successfully, or
+ * \return #RCL_RET_ALREADY_INIT if the executor is not zero initialized, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_init(
+  rcl_executor_t * executor,
+  rcl_context_t * context,
+  size_t number_of_handles,
+  const rcl_executor_options_t * options);
+
+/// Finalize an executor.
+/**
+ * The entities of the handles are not finalized.
+ * Calling this function on a zero initialized executor does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to finalize
+ * \return #RCL_RET_OK if the executor was finalized successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_fini(rcl_executor_t * executor);
+
+/// Add a subscription, taken into the given message storage.
+/**
+ * The message is taken into `message`, which must outlive the executor, and
+ * passed to the callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to add the handle to
+ * \param[in] subscription the subscription to take from
+ * \param[in] message storage for the taken message
+ * \param[in] callback the callback to call with the taken message
+ * \param[in] context passed to the callback
+ * \return #RCL_RET_OK if the handle was added successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if the handle table is full.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_add_subscription(
+  rcl_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * message,
+  rcl_executor_subscription_callback_t callback,
+  void * context);
+
+/// Add a timer, called with rcl_timer_call() when ready.
+/**
+ * The timer callback is the one given to rcl_timer_init().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to add the handle to
+ * \param[in] timer the timer to call
+ * \return #RCL_RET_OK if the handle was added successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if the handle table is full.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_add_timer(
+  rcl_executor_t * executor,
+  rcl_timer_t * timer);
+
+/// Add a service, sending the response filled in by the callback.
+/**
+ * The request is taken into `request`, passed to the callback along with
+ * `response`, and `response` is sent once the callback returns.
+ * Both must outlive the executor.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to add the handle to
+ * \param[in] service the service to take requests from
+ * \param[in] request storage for the taken request
+ * \param[in] response storage for the response to send
+ * \param[in] callback the callback filling in the response
+ * \param[in] context passed to the callback
+ * \return #RCL_RET_OK if the handle was added successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if the handle table is full.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_add_service(
+  rcl_executor_t * executor,
+  rcl_service_t * service,
+  void * request,
+  void * response,
+  rcl_executor_service_callback_t callback,
+  void * context);
+
+/// Add a client, taking responses into the given storage.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to add the handle to
+ * \param[in] client the client to take responses from
+ * \param[in] response storage for the taken response
+ * \param[in] callback the callback to call with the taken response
+ * \param[in] context passed to the callback
+ * \return #RCL_RET_OK if the handle was added successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if the handle table is full.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_add_client(
+  rcl_executor_t * executor,
+  rcl_client_t * client,
+  void * response,
+  rcl_executor_client_callback_t callback,
+  void * context);
+
+/// Add a guard condition.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to add the handle to
+ * \param[in] guard_condition the guard condition to wait on
+ * \param[in] callback the callback to call when triggered
+ * \param[in] context passed to the callback
+ * \return #RCL_RET_OK if the handle was added successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if the handle table is full.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_add_guard_condition(
+  rcl_executor_t * executor,
+  rcl_guard_condition_t * guard_condition,
+  rcl_executor_guard_condition_callback_t callback,
+  void * context);
+
+/// Add a waitable, such as an action server or client.
+/**
+ * The waitable is copied, its data must outlive the executor.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to add the handle to
+ * \param[in] waitable the waitable functions and data
+ * \return #RCL_RET_OK if the handle was added successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if the handle table is full.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_add_waitable(
+  rcl_executor_t * executor,
+  const rcl_executor_waitable_t * waitable);
+
+/// Size the wait set for the handles added so far.
+/**
+ * This is done by rcl_executor_spin_some() when needed, calling it beforehand
+ * moves the allocation out of the first spin.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to prepare
+ * \return #RCL_RET_OK if the wait set was prepared successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_prepare(rcl_executor_t * executor);
+
+/// Wait once for the handles, and dispatch the ready ones if the trigger holds.
+/**
+ * Handles are dispatched in the order they were added.
+ * A handle with nothing to take after all, as can happen with spurious
+ * wake ups, is skipped.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] unless a handle was added since the wait set was prepared</i>
+ *
+ * \param[inout] executor the executor to spin
+ * \param[in] timeout the wait timeout in nanoseconds, see rcl_wait()
+ * \return #RCL_RET_OK if the executor waited successfully, whether or not it
+ *   dispatched any handle, or
+ * \return #RCL_RET_TIMEOUT if no handle became ready before the timeout, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_spin_some(rcl_executor_t * executor, int64_t timeout);
+
+/// Spin until the context of the executor is shut down.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] see rcl_executor_spin_some()</i>
+ *
+ * \param[inout] executor the executor to spin
+ * \param[in] timeout the timeout of each wait in nanoseconds
+ * \return #RCL_RET_OK once the context is shut down, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_executor_spin(rcl_executor_t * executor, int64_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__EXECUTOR_H_
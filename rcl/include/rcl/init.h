@@ -114,6 +114,122 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_shutdown(rcl_context_t * context);
 
+struct rcl_context_template_impl_t;
+
+/// Init options and global arguments resolved once, to initialize contexts from.
+/**
+ * A context template does everything rcl_init() does before the middleware
+ * is initialized: copying the init options, parsing the global arguments,
+ * resolving the domain id and localhost only settings from the environment,
+ * validating the enclave name and looking up its security options.
+ * Contexts initialized from it with rcl_init_from_template() only copy the
+ * result and initialize the middleware, which makes creating and destroying
+ * many contexts, e.g. for each tenant or each test, cheaper.
+ */
+typedef struct rcl_context_template_t
+{
+  /// Implementation specific pointer.
+  struct rcl_context_template_impl_t * impl;
+} rcl_context_template_t;
+
+/// Return a zero initialized context template.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_context_template_t
+rcl_get_zero_initialized_context_template(void);
+
+/// Initialize a context template.
+/**
+ * The arguments are validated and parsed as they are by rcl_init(), and the
+ * environment snapshot is used as it is at the time of this call (see
+ * rcl_get_environment()).
+ * The given options are copied, so they need to be cleaned up with
+ * rcl_init_options_fini() after this function returns.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] argc number of strings in argv
+ * \param[in] argv command line arguments
+ * \param[in] options options used to initialize contexts from the template
+ * \param[inout] context_template zero initialized template to initialize
+ * \return #RCL_RET_OK if the template was initialized successfully, or
+ * \return #RCL_RET_ALREADY_INIT if the template is already initialized, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_INVALID_ROS_ARGS if an invalid ROS argument is found, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_template_init(
+  int argc,
+  char const * const * argv,
+  const rcl_init_options_t * options,
+  rcl_context_template_t * context_template);
+
+/// Initialization of rcl from a context template.
+/**
+ * This is equivalent to calling rcl_init() with the arguments and options
+ * the template was initialized with, but the arguments are not parsed again
+ * and the environment is not consulted again.
+ * The resulting context is shutdown and finalized as any other, with
+ * rcl_shutdown() and rcl_context_fini(), and does not refer to the template,
+ * which may be finalized before the context.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_uint_least64_t`</i>
+ *
+ * \param[in] context_template initialized template
+ * \param[out] context resulting context object that represents this init
+ * \return #RCL_RET_OK if initialization is successful, or
+ * \return #RCL_RET_ALREADY_INIT if the context is already initialized, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_init_from_template(
+  const rcl_context_template_t * context_template,
+  rcl_context_t * context);
+
+/// Finalize a context template.
+/**
+ * Contexts initialized from the template are not affected.
+ * Calling this function on a zero initialized template does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] context_template template to finalize
+ * \return #RCL_RET_OK if the template was finalized successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_template_fini(rcl_context_template_t * context_template);
+
 #ifdef __cplusplus
 }
 #endif
@@ -129,6 +129,198 @@ rcl_subscription_get_network_flow_endpoints(
   rcutils_allocator_t * allocator,
   rcl_network_flow_endpoint_array_t * network_flow_endpoint_array);
 
+/// Caller owned storage for network flow endpoints, reused across queries.
+/**
+ * Unlike rcl_network_flow_endpoint_array_t, which is allocated by every
+ * query and must be finalized afterwards, a buffer keeps its storage between
+ * queries and only grows it when a query returns more network flow endpoints
+ * than it can hold.
+ * Periodically polling the network flow endpoints of the same entities does
+ * not allocate memory once the buffer has grown large enough.
+ */
+typedef struct rcl_network_flow_endpoint_buffer_t
+{
+  /// Network flow endpoints returned by the last query.
+  rcl_network_flow_endpoint_t * network_flow_endpoint;
+  /// Number of network flow endpoints returned by the last query.
+  size_t size;
+  /// Number of network flow endpoints the buffer can hold without growing.
+  size_t capacity;
+  /// Allocator used to grow and finalize the buffer.
+  rcl_allocator_t allocator;
+} rcl_network_flow_endpoint_buffer_t;
+
+/// Return a zero initialized network flow endpoint buffer.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_network_flow_endpoint_buffer_t
+rcl_get_zero_initialized_network_flow_endpoint_buffer(void);
+
+/// Initialize a network flow endpoint buffer
+/**
+ * The `buffer` argument must be zero-initialized.
+ *
+ * The `capacity` argument is the number of network flow endpoints to reserve
+ * storage for, and may be `0`, in which case storage is allocated by the first query.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] buffer the buffer to initialize
+ * \param[in] capacity number of network flow endpoints to reserve storage for
+ * \param[in] allocator allocator used to grow and finalize the buffer
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any argument is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if memory allocation fails.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_network_flow_endpoint_buffer_init(
+  rcl_network_flow_endpoint_buffer_t * buffer,
+  size_t capacity,
+  rcl_allocator_t allocator);
+
+/// Finalize a network flow endpoint buffer
+/**
+ * The buffer is zero initialized afterwards.
+ * Finalizing a zero initialized buffer does nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] buffer the buffer to finalize
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any argument is null.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_network_flow_endpoint_buffer_fini(rcl_network_flow_endpoint_buffer_t * buffer);
+
+/// Get network flow endpoints of a publisher into a reusable buffer
+/**
+ * Same as rcl_publisher_get_network_flow_endpoints(), but the network flow
+ * endpoints replace the content of the given initialized `buffer`.
+ * Memory is only allocated when the buffer needs to grow, using its allocator.
+ * If the query fails, the buffer is left empty.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [2]
+ * <i>[1] only if the buffer needs to grow</i>
+ * <i>[2] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] publisher the publisher instance to inspect
+ * \param[inout] buffer the buffer to fill
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any argument is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if memory allocation fails, or
+ * \return `RCL_RET_UNSUPPORTED` if not supported, or
+ * \return `RCL_RET_ERROR` if an unexpected error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_fill_network_flow_endpoint_buffer(
+  const rcl_publisher_t * publisher,
+  rcl_network_flow_endpoint_buffer_t * buffer);
+
+/// Get network flow endpoints of a subscription into a reusable buffer
+/**
+ * Same as rcl_subscription_get_network_flow_endpoints(), but the network flow
+ * endpoints replace the content of the given initialized `buffer`.
+ * Memory is only allocated when the buffer needs to grow, using its allocator.
+ * If the query fails, the buffer is left empty.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [2]
+ * <i>[1] only if the buffer needs to grow</i>
+ * <i>[2] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] subscription the subscription instance to inspect
+ * \param[inout] buffer the buffer to fill
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any argument is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if memory allocation fails, or
+ * \return `RCL_RET_UNSUPPORTED` if not supported, or
+ * \return `RCL_RET_ERROR` if an unexpected error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_fill_network_flow_endpoint_buffer(
+  const rcl_subscription_t * subscription,
+  rcl_network_flow_endpoint_buffer_t * buffer);
+
+/// Get network flow endpoints of many publishers and subscriptions into a reusable buffer
+/**
+ * Query the network flow endpoints of all the given publishers and then of
+ * all the given subscriptions, typically all those of a node, in one call.
+ * The network flow endpoints replace the content of the given initialized
+ * `buffer`, one entity after the other.
+ *
+ * If `offsets` is not `NULL`, it must have room for
+ * `num_publishers + num_subscriptions + 1` elements: the network flow
+ * endpoints of the `i`-th entity, publishers first, are then those from
+ * `offsets[i]` up to, but excluding, `offsets[i + 1]`.
+ *
+ * All entities must be valid.
+ * If the query of any entity fails, the buffer is left empty.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [2]
+ * <i>[1] only if the buffer needs to grow</i>
+ * <i>[2] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] publishers the publishers to inspect, may be `NULL` if `num_publishers` is `0`
+ * \param[in] num_publishers number of publishers
+ * \param[in] subscriptions the subscriptions to inspect, may be `NULL` if
+ *   `num_subscriptions` is `0`
+ * \param[in] num_subscriptions number of subscriptions
+ * \param[inout] buffer the buffer to fill
+ * \param[out] offsets offsets of the network flow endpoints of each entity, may be `NULL`
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any argument is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if memory allocation fails, or
+ * \return `RCL_RET_UNSUPPORTED` if not supported, or
+ * \return `RCL_RET_ERROR` if an unexpected error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_fill_network_flow_endpoint_buffer(
+  const rcl_publisher_t * const * publishers,
+  size_t num_publishers,
+  const rcl_subscription_t * const * subscriptions,
+  size_t num_subscriptions,
+  rcl_network_flow_endpoint_buffer_t * buffer,
+  size_t * offsets);
+
 #ifdef __cplusplus
 }
 #endif
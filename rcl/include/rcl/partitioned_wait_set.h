@@ -0,0 +1,356 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__PARTITIONED_WAIT_SET_H_
+#define RCL__PARTITIONED_WAIT_SET_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rcl/allocator.h"
+#include "rcl/client.h"
+#include "rcl/context.h"
+#include "rcl/guard_condition.h"
+#include "rcl/macros.h"
+#include "rcl/service.h"
+#include "rcl/subscription.h"
+#include "rcl/timer.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+#include "rcl/wait.h"
+
+struct rcl_partitioned_wait_set_impl_t;
+
+/// Entities split into partitions, each waited on by its own thread.
+/**
+ * Every partition has its own wait set, and so its own rmw wait set to block
+ * on, a guard condition to wake it from other threads, and an optional CPU
+ * affinity for the thread serving it.
+ * Entities are registered once with the partition they belong to, and the
+ * wait set of each partition is sized and filled from them.
+ *
+ * A typical runtime starts one thread per partition, which pins itself with
+ * rcl_partitioned_wait_set_pin_thread() and then loops on
+ * rcl_partitioned_wait_set_wait().
+ */
+typedef struct rcl_partitioned_wait_set_t
+{
+  /// Pointer to the partitioned wait set implementation.
+  struct rcl_partitioned_wait_set_impl_t * impl;
+} rcl_partitioned_wait_set_t;
+
+/// Return a rcl_partitioned_wait_set_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_partitioned_wait_set_t
+rcl_get_zero_initialized_partitioned_wait_set(void);
+
+/// Initialize a partitioned wait set with a fixed number of partitions.
+/**
+ * The wake guard condition of every partition is created here, the wait sets
+ * on the first wait of each partition.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] partitioned_wait_set zero initialized partitioned wait set
+ * \param[in] number_of_partitions non-zero number of partitions
+ * \param[in] context the context the wait sets and guard conditions are associated with
+ * \param[in] allocator the allocator used for the partitions and their wait sets
+ * \return #RCL_RET_OK if initialized successfully, or
+ * \return #RCL_RET_ALREADY_INIT if it was already initialized, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_init(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t number_of_partitions,
+  rcl_context_t * context,
+  rcl_allocator_t allocator);
+
+/// Finalize a partitioned wait set.
+/**
+ * No thread may be waiting on any of its partitions.
+ * Calling it on a zero initialized partitioned wait set is a no-op.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] partitioned_wait_set the partitioned wait set to finalize
+ * \return #RCL_RET_OK if finalized successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_fini(rcl_partitioned_wait_set_t * partitioned_wait_set);
+
+/// Register a subscription with a partition.
+/**
+ * The entity must outlive the partitioned wait set.
+ * Entities may only be registered with a partition no thread is waiting on.
+ * The index is the one of the subscription in the wait set returned by
+ * rcl_partitioned_wait_set_wait() for this partition.
+ *
+ * The same applies to the other rcl_partitioned_wait_set_add_*() functions.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] partitioned_wait_set the partitioned wait set
+ * \param[in] partition index of the partition
+ * \param[in] subscription the subscription to register
+ * \param[out] index optional index of the subscription in the partition wait set
+ * \return #RCL_RET_OK if registered successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_add_subscription(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_subscription_t * subscription,
+  size_t * index);
+
+/// Register a guard condition with a partition.
+/**
+ * \see rcl_partitioned_wait_set_add_subscription()
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_add_guard_condition(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_guard_condition_t * guard_condition,
+  size_t * index);
+
+/// Register a timer with a partition.
+/**
+ * \see rcl_partitioned_wait_set_add_subscription()
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_add_timer(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_timer_t * timer,
+  size_t * index);
+
+/// Register a client with a partition.
+/**
+ * \see rcl_partitioned_wait_set_add_subscription()
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_add_client(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_client_t * client,
+  size_t * index);
+
+/// Register a service with a partition.
+/**
+ * \see rcl_partitioned_wait_set_add_subscription()
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_add_service(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_service_t * service,
+  size_t * index);
+
+/// Set the CPU affinity of the thread serving a partition.
+/**
+ * Bit `n` of the mask stands for CPU `n`, so only the first 64 CPUs can be
+ * selected.
+ * A mask of 0, the default, leaves the affinity of the thread untouched.
+ * The affinity is applied by rcl_partitioned_wait_set_pin_thread().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] partitioned_wait_set the partitioned wait set
+ * \param[in] partition index of the partition
+ * \param[in] cpu_affinity_mask mask of the CPUs the serving thread may run on
+ * \return #RCL_RET_OK if set successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_set_cpu_affinity(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  uint64_t cpu_affinity_mask);
+
+/// Restrict the calling thread to the CPUs of a partition.
+/**
+ * Does nothing if the partition has no CPU affinity.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] partitioned_wait_set the partitioned wait set
+ * \param[in] partition index of the partition
+ * \return #RCL_RET_OK if the thread was pinned, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_UNSUPPORTED if the platform cannot set thread affinities, or
+ * \return #RCL_RET_ERROR if the affinity could not be set.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_pin_thread(
+  const rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition);
+
+/// Wait on the entities of a partition.
+/**
+ * The wait set of the partition is (re)created when entities were registered
+ * since the last wait, otherwise it is reused without allocating.
+ * It is cleared, filled with the registered entities and the wake guard
+ * condition, and passed to rcl_wait(), whose return value is returned.
+ *
+ * The ready entities are then found at the indices returned at registration
+ * in the returned wait set, which stays valid until the next wait on the
+ * partition.
+ *
+ * Distinct partitions may be waited on concurrently, a single partition only
+ * by one thread at a time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | Yes [2]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only on the first wait after registering entities</i>
+ * <i>[2] for distinct partitions</i>
+ *
+ * \param[inout] partitioned_wait_set the partitioned wait set
+ * \param[in] partition index of the partition
+ * \param[in] timeout the duration to wait, see rcl_wait()
+ * \param[out] wait_set the wait set of the partition after the wait
+ * \return #RCL_RET_OK if an entity became ready or the partition was woken, or
+ * \return #RCL_RET_TIMEOUT if the timeout expired first, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_wait(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  int64_t timeout,
+  rcl_wait_set_t ** wait_set);
+
+/// Wake the thread waiting on a partition.
+/**
+ * Triggers the wake guard condition of the partition, so its current or next
+ * wait returns.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] partitioned_wait_set the partitioned wait set
+ * \param[in] partition index of the partition to wake
+ * \return #RCL_RET_OK if the partition was woken, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_partitioned_wait_set_wake(
+  const rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition);
+
+/// Return `true` if the last wait on a partition was woken by rcl_partitioned_wait_set_wake().
+/**
+ * Also return `false` if any arguments are invalid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] partitioned_wait_set the partitioned wait set
+ * \param[in] partition index of the partition
+ * \return `true` if the partition was woken, otherwise `false`.
+ */
+RCL_PUBLIC
+bool
+rcl_partitioned_wait_set_is_woken(
+  const rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__PARTITIONED_WAIT_SET_H_
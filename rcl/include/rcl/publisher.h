@@ -24,8 +24,10 @@ extern "C"
 
 #include "rosidl_runtime_c/message_type_support_struct.h"
 
+#include "rcl/compression.h"
 #include "rcl/macros.h"
 #include "rcl/node.h"
+#include "rcl/time.h"
 #include "rcl/visibility_control.h"
 
 /// Internal rcl publisher implementation struct.
@@ -48,6 +50,21 @@ typedef struct rcl_publisher_options_t
   rcl_allocator_t allocator;
   /// rmw specific publisher options, e.g. the rmw implementation specific payload.
   rmw_publisher_options_t rmw_publisher_options;
+  /// If true, rcl_publish() returns without publishing while no subscription is matched.
+  /** Not allowed with transient local durability, which must keep history for late joiners. */
+  bool skip_when_unmatched;
+  /// Age after which the cached count of matched subscriptions is read again from the rmw.
+  /**
+   * With 0, the count is read on every publish, so that no message is dropped
+   * once a subscription is matched.
+   * A larger age saves those reads, but drops the messages published to a
+   * subscription matched within that age, unless
+   * rcl_publisher_update_matched_subscription_count() is called on graph changes.
+   */
+  rcl_duration_value_t matched_count_max_age;
+  /// Codec compressing the serialized messages, compression is disabled if its name is `NULL`.
+  /** Only subscriptions using the same codec receive the messages, see rcl_compression_codec_t. */
+  rcl_compression_codec_t compression;
 } rcl_publisher_options_t;
 
 /// Return a rcl_publisher_t struct with members set to `NULL`.
@@ -193,6 +210,9 @@ rcl_publisher_fini(rcl_publisher_t * publisher, rcl_node_t * node);
  * - qos = rmw_qos_profile_default
  * - allocator = rcl_get_default_allocator()
  * - rmw_publisher_options = rmw_get_default_publisher_options()
+ * - skip_when_unmatched = false
+ * - matched_count_max_age = 0, i.e. the count is read on every publish
+ * - compression = rcl_get_zero_initialized_compression_codec()
  *
  * \return A structure with the default publisher options.
  */
@@ -303,19 +323,32 @@ rcl_return_loaned_message_from_publisher(
  * rcl_publish() simultaneously, even if the publishers differ.
  * The `ros_message` is unmodified by rcl_publish().
  *
+ * If the publisher was created with `skip_when_unmatched`, the message is
+ * neither serialized nor published while the cached count of matched
+ * subscriptions is zero, see rcl_publisher_has_matched_subscriptions().
+ *
+ * If the publisher was created with a compression codec, the message is
+ * serialized, compressed and published as a serialized message.
+ * The intermediate buffers are kept by the publisher and only grow, so
+ * publishing stops allocating once they fit the largest message; a publish
+ * concurrent with another one on the same publisher uses temporary buffers.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | No
+ * Allocates Memory   | Maybe [2]
  * Thread-Safe        | Yes [1]
- * Uses Atomics       | No
+ * Uses Atomics       | Maybe [3]
  * Lock-Free          | Yes
  * <i>[1] for unique pairs of publishers and messages, see above for more</i>
+ * <i>[2] only with a compression codec, while the buffers grow or are in use</i>
+ * <i>[3] only when skipping unmatched publishes or with a compression codec</i>
  *
  * \param[in] publisher handle to the publisher which will do the publishing
  * \param[in] ros_message type-erased pointer to the ROS message
  * \param[in] allocation structure pointer, used for memory preallocation (may be NULL)
  * \return #RCL_RET_OK if the message was published successfully, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory for compression failed, or
  * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
  * \return #RCL_RET_PUBLISHER_INVALID if the publisher is invalid, or
  * \return #RCL_RET_ERROR if an unspecified error occurs.
@@ -341,15 +374,18 @@ rcl_publish(
  *
  * Apart from this, the `publish_serialized` function has the same behavior as rcl_publish()
  * expect that no serialization step is done.
+ * With a compression codec, the serialized message is compressed before being published.
  *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | No
+ * Allocates Memory   | Maybe [2]
  * Thread-Safe        | Yes [1]
- * Uses Atomics       | No
+ * Uses Atomics       | Maybe [3]
  * Lock-Free          | Yes
  * <i>[1] for unique pairs of publishers and messages, see above for more</i>
+ * <i>[2] only with a compression codec, while the buffers grow or are in use</i>
+ * <i>[3] only with a compression codec</i>
  *
  * \param[in] publisher handle to the publisher which will do the publishing
  * \param[in] serialized_message  pointer to the already serialized message in raw form
@@ -609,6 +645,69 @@ rcl_publisher_get_subscription_count(
   const rcl_publisher_t * publisher,
   size_t * subscription_count);
 
+/// Check if any subscription is matched to a publisher, using the cached count.
+/**
+ * Unlike rcl_publisher_get_subscription_count(), this does not query the rmw
+ * on each call.
+ * The count is cached in the publisher and only read again from the rmw once
+ * it is older than the `matched_count_max_age` publisher option, or when
+ * rcl_publisher_update_matched_subscription_count() is called.
+ * Producers can use it to skip building messages nobody would receive.
+ *
+ * With a non zero max age, a subscription which has just been matched may go
+ * unnoticed until the cache is refreshed, so calling
+ * rcl_publisher_update_matched_subscription_count() when the graph guard
+ * condition of the node is triggered keeps that window short.
+ * If the count cannot be read, e.g. because the rmw does not support it, it is
+ * unknown until it is as old as the max age, true is returned and the error is
+ * reset, so messages are published rather than silently dropped.
+ * Only publishers created with `skip_when_unmatched` read the count when
+ * initialized, the others read it on the first call.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Maybe [1]
+ * <i>[1] only when the cached count is not refreshed from the rmw</i>
+ *
+ * \param[in] publisher pointer to the rcl publisher
+ * \return `true` if a subscription is matched or the count is unknown, or
+ * \return `false` if no subscription is matched or the publisher is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+bool
+rcl_publisher_has_matched_subscriptions(const rcl_publisher_t * publisher);
+
+/// Read again the count of subscriptions matched to a publisher into its cache.
+/**
+ * Meant to be called when the graph guard condition of the node is triggered,
+ * see rcl_node_get_graph_guard_condition(), so the cache used by
+ * rcl_publisher_has_matched_subscriptions() and rcl_publish() follows
+ * subscriptions joining or leaving.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Maybe [1]
+ * <i>[1] only if the underlying rmw doesn't make use of this feature </i>
+ *
+ * \param[in] publisher pointer to the rcl publisher
+ * \return #RCL_RET_OK if the count was updated, or
+ * \return #RCL_RET_PUBLISHER_INVALID if the publisher is invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_update_matched_subscription_count(const rcl_publisher_t * publisher);
+
 /// Get the actual qos settings of the publisher.
 /**
  * Used to get the actual qos settings of the publisher.
@@ -640,6 +739,7 @@ rcl_publisher_get_actual_qos(const rcl_publisher_t * publisher);
 /**
  * Depending on the middleware and the message type, this will return true if the middleware
  * can allocate a ROS message instance.
+ * Publishers compressing their messages never loan them.
  */
 RCL_PUBLIC
 bool
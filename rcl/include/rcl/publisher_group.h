@@ -0,0 +1,153 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file
+
+#ifndef RCL__PUBLISHER_GROUP_H_
+#define RCL__PUBLISHER_GROUP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcl/allocator.h"
+#include "rcl/macros.h"
+#include "rcl/publisher.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+struct rcl_publisher_group_impl_t;
+
+/// Publishers of the same message type which publish a message serialized once.
+/**
+ * Publishing the same message on several topics, e.g. a raw topic and its
+ * aliases, with rcl_publish() serializes it once per publisher.
+ * A group serializes it once into a buffer it keeps between calls, and hands
+ * the result to rcl_publish_serialized_message() for each publisher.
+ */
+typedef struct rcl_publisher_group_t
+{
+  /// Pointer to the publisher group implementation.
+  struct rcl_publisher_group_impl_t * impl;
+} rcl_publisher_group_t;
+
+/// Return a rcl_publisher_group_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_publisher_group_t
+rcl_get_zero_initialized_publisher_group(void);
+
+/// Initialize a publisher group.
+/**
+ * All publishers must be valid and have been initialized with the same
+ * message type support, which is checked here rather than on each publish.
+ * The group keeps pointers to the publishers, which must outlive it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] group zero initialized publisher group
+ * \param[in] publishers array of pointers to the publishers of the group
+ * \param[in] count number of publishers, greater than zero
+ * \param[in] allocator allocator for the group and its serialization buffer
+ * \return #RCL_RET_OK if the group was initialized, or
+ * \return #RCL_RET_ALREADY_INIT if the group is already initialized, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or if the
+ *   publishers do not share their message type support, or
+ * \return #RCL_RET_PUBLISHER_INVALID if a publisher is invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_group_init(
+  rcl_publisher_group_t * group,
+  const rcl_publisher_t * const * publishers,
+  size_t count,
+  rcl_allocator_t allocator);
+
+/// Finalize a publisher group, the publishers themselves are left alone.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] group publisher group to be finalized
+ * \return #RCL_RET_OK if the group was finalized or was zero initialized, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_group_fini(rcl_publisher_group_t * group);
+
+/// Publish a ROS message with every publisher of a group, serializing it once.
+/**
+ * Publishers created with `skip_when_unmatched` and without matched
+ * subscriptions are left out, as in rcl_publish(), and the message is not
+ * serialized at all when every publisher is left out.
+ * A publisher which fails does not stop the others from publishing, and the
+ * error of the first one which failed is returned.
+ *
+ * The serialization buffer is reused between calls and only grows, so after
+ * the first few messages publishing does not allocate.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No [2]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] when the serialization buffer has to grow</i>
+ * <i>[2] the serialization buffer is shared by all calls on the group</i>
+ *
+ * \param[inout] group publisher group to publish with, its buffer is reused
+ * \param[in] ros_message type-erased pointer to the ROS message
+ * \param[in] allocation structure pointer, used for memory preallocation (may be NULL)
+ * \return #RCL_RET_OK if the message was published by every publisher, or
+ *   skipped by those without matched subscriptions, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_PUBLISHER_INVALID if a publisher is invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_UNSUPPORTED if the rmw cannot serialize messages, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_to_many(
+  rcl_publisher_group_t * group,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__PUBLISHER_GROUP_H_
@@ -22,8 +22,10 @@ extern "C"
 {
 #endif
 
+#include "rosidl_runtime_c/message_type_support_struct.h"
 #include "rosidl_runtime_c/service_type_support_struct.h"
 
+#include "rcl/dispatch.h"
 #include "rcl/macros.h"
 #include "rcl/node.h"
 #include "rcl/visibility_control.h"
@@ -38,6 +40,107 @@ typedef struct rcl_service_t
   struct rcl_service_impl_t * impl;
 } rcl_service_t;
 
+/// Options of the response cache of a rcl service.
+/**
+ * Meant for idempotent services, the response cache answers requests whose
+ * serialized bytes match those of a request answered less than `ttl` ago with
+ * the same response, without the request being returned by
+ * rcl_take_request_with_info().
+ * Identical requests taken while one is still being handled are held back as
+ * well, and answered by rcl_send_response() along with the handled one.
+ *
+ * The requests being handled count against the `capacity` along with the
+ * cached responses.
+ * One which is released with rcl_service_release_request(), whose response
+ * cannot be sent, or which is handled for longer than `pending_timeout`, stops
+ * holding back identical requests.
+ * Requests which do not fit are handled on their own and their response is
+ * not cached.
+ */
+typedef struct rcl_service_response_cache_options_t
+{
+  /// Maximum memory, in bytes, of the cached entries and pending requests, or 0 to disable it.
+  size_t capacity;
+  /// Duration, in nanoseconds, a response is served from the cache, or 0 to only coalesce.
+  int64_t ttl;
+  /// Duration, in nanoseconds, a request being handled holds back others, or 0 for no timeout.
+  /**
+   * Once it has passed, the requests held back are dropped without a response,
+   * as the request they wait on is not expected to be answered anymore.
+   * Defaults to 10 seconds, so that a request which is neither answered nor
+   * released does not hold back identical requests forever.
+   */
+  int64_t pending_timeout;
+  /// Type support of the request message of the service, to serialize requests.
+  const rosidl_message_type_support_t * request_type_support;
+  /// Type support of the response message of the service, to serialize responses.
+  const rosidl_message_type_support_t * response_type_support;
+  /// Initialized response message into which cached responses are deserialized to be sent.
+  /** It is owned by the caller and must outlive the service. */
+  void * response_buffer;
+} rcl_service_response_cache_options_t;
+
+/// Counters of the response cache of a rcl service.
+typedef struct rcl_service_response_cache_stats_t
+{
+  /// Number of requests answered from the cache.
+  uint64_t hits;
+  /// Number of requests returned to be handled.
+  uint64_t misses;
+  /// Number of requests answered along with an identical request being handled.
+  uint64_t coalesced;
+  /// Number of entries evicted to make room for newer ones.
+  uint64_t evictions;
+  /// Number of entries currently cached.
+  size_t num_entries;
+  /// Memory, in bytes, currently used by the cached entries and the requests being handled.
+  size_t size;
+} rcl_service_response_cache_stats_t;
+
+/// Options of the admission control of a rcl service.
+/**
+ * Under overload, the admission control sheds the requests which cannot be
+ * handled in time rather than letting them queue up in the middleware.
+ * Requests taken while `max_in_flight` requests are still awaiting a response,
+ * or taken more than `deadline` after they were sent, as given by the
+ * `source_timestamp` of their rmw_service_info_t, are not returned by
+ * rcl_take_request_with_info().
+ * Shed requests are answered with the `busy_response`, if any, or dropped
+ * without a response otherwise.
+ *
+ * A taken request stops awaiting a response once it is answered, once it is
+ * released with rcl_service_release_request(), or once it has awaited for
+ * longer than `in_flight_timeout`, so that requests never answered do not
+ * keep the service overloaded.
+ */
+typedef struct rcl_service_admission_options_t
+{
+  /// Maximum number of taken requests awaiting a response, or 0 for no maximum.
+  size_t max_in_flight;
+  /// Duration, in nanoseconds, after which a request is shed, or 0 for no deadline.
+  /** Ignored for requests without a source timestamp, which not every middleware sets. */
+  int64_t deadline;
+  /// Duration, in nanoseconds, after which a request stops awaiting a response, or 0 for none.
+  /** Only used with a `max_in_flight`. */
+  int64_t in_flight_timeout;
+  /// Response message sent to shed requests, or `NULL` to drop them silently.
+  /** It is owned by the caller and must outlive the service. */
+  void * busy_response;
+} rcl_service_admission_options_t;
+
+/// Counters of the admission control of a rcl service.
+typedef struct rcl_service_admission_stats_t
+{
+  /// Number of requests shed because `max_in_flight` requests were awaiting a response.
+  uint64_t shed_overload;
+  /// Number of requests shed because their deadline had passed.
+  uint64_t shed_deadline;
+  /// Number of busy responses sent to shed requests.
+  uint64_t busy_responses;
+  /// Number of taken requests currently awaiting a response.
+  size_t in_flight;
+} rcl_service_admission_stats_t;
+
 /// Options available for a rcl service.
 typedef struct rcl_service_options_t
 {
@@ -46,6 +149,12 @@ typedef struct rcl_service_options_t
   /// Custom allocator for the service, used for incidental allocations.
   /** For default behavior (malloc/free), see: rcl_get_default_allocator() */
   rcl_allocator_t allocator;
+  /// Response cache settings for the service.
+  rcl_service_response_cache_options_t response_cache;
+  /// Admission control settings for the service.
+  rcl_service_admission_options_t admission;
+  /// Scheduling attributes used to order the service among ready entities.
+  rcl_dispatch_attributes_t dispatch;
 } rcl_service_options_t;
 
 /// Return a rcl_service_t struct with members set to `NULL`.
@@ -197,6 +306,10 @@ rcl_service_fini(rcl_service_t * service, rcl_node_t * node);
  *
  * - qos = rmw_qos_profile_services_default
  * - allocator = rcl_get_default_allocator()
+ * - response_cache = disabled, i.e. a zero capacity, with a 10 seconds pending_timeout
+ * - admission = disabled, i.e. no maximum number of in flight requests, no deadline and
+ *   no in flight timeout
+ * - dispatch = rcl_dispatch_get_default_attributes()
  */
 RCL_PUBLIC
 RCL_WARN_UNUSED
@@ -228,6 +341,19 @@ rcl_service_get_default_options(void);
  * request_header is a pointer to pre-allocated a rmw struct containing
  * meta-information about the request (e.g. the sequence number).
  *
+ * If the service has a response cache, see rcl_service_response_cache_options_t,
+ * pending requests answered from the cache or held back behind an identical
+ * request are skipped, and the ROS request may then be modified even if no
+ * request is taken.
+ *
+ * If the service has an admission control, see rcl_service_admission_options_t,
+ * pending requests past their deadline are skipped as well, and a returned
+ * request counts as in flight until it is answered with rcl_send_response()
+ * or rcl_send_response_sequence(), released with rcl_service_release_request()
+ * or timed out.
+ * Under overload, a single pending request is shed per call, so that requests
+ * still queued can be taken once in flight ones are answered.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
@@ -280,6 +406,56 @@ rcl_take_request(
   rmw_request_id_t * request_header,
   void * ros_request);
 
+/// Take a sequence of pending ROS requests using a rcl service.
+/**
+ * In contrast to rcl_take_request_with_info(), this function can take multiple
+ * requests at the same time.
+ * See rcl_take_request_with_info() for the requirements on the type of the
+ * requests.
+ *
+ * The ros_requests array should hold `count` pointers to already allocated
+ * ROS request messages of the correct type, and request_headers should point
+ * to an array of at least `count` pre-allocated rmw_service_info_t structs.
+ * Requests are taken in order until `count` requests were taken or no request
+ * is pending anymore, and `taken` is set to the number of requests taken.
+ * The request at index `i` of ros_requests is described by the header at
+ * index `i` of request_headers.
+ *
+ * The middleware is asked for one request at a time, but the arguments are
+ * only validated once for the whole sequence.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling the requests, avoided for fixed sizes</i>
+ *
+ * \param[in] service the handle to the service from which to take
+ * \param[in] count number of requests to attempt to take
+ * \param[inout] request_headers array of at least `count` request metadata structs
+ * \param[inout] ros_requests array of `count` type-erased ptrs to allocated ROS requests
+ * \param[out] taken number of requests taken, set even if an error occurs
+ * \return #RCL_RET_OK if one or more requests were taken, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_SERVICE_TAKE_FAILED if no request was taken but no error
+ *         occurred in the middleware, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_request_sequence(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_service_info_t * request_headers,
+  void ** ros_requests,
+  size_t * taken);
+
 /// Send a ROS response to a client using a service.
 /**
  * It is the job of the caller to ensure that the type of the `ros_response`
@@ -308,6 +484,12 @@ rcl_take_request(
  * rcl_send_response() simultaneously, even if the services differ.
  * The `ros_response` is unmodified by rcl_send_response().
  *
+ * If the service has a response cache, the response is cached and also sent
+ * to the requests held back behind the answered one, in which case the
+ * function is not thread safe.
+ * The same goes for a service with an admission control limiting the number
+ * of in flight requests, as the response ends one.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
@@ -333,6 +515,133 @@ rcl_send_response(
   rmw_request_id_t * response_header,
   void * ros_response);
 
+/// Send a sequence of ROS responses to clients using a service.
+/**
+ * In contrast to rcl_send_response(), this function can send multiple
+ * responses at the same time, e.g. those answering requests taken with
+ * rcl_take_request_sequence().
+ * See rcl_send_response() for the requirements on the type and the ownership
+ * of the responses.
+ *
+ * The response at index `i` of ros_responses is sent to the client that made
+ * the request identified by the header at index `i` of response_headers.
+ * Responses are sent in order, stopping at the first one that fails to be
+ * sent, and `sent` is set to the number of responses sent.
+ *
+ * The middleware is given one response at a time, but the arguments are only
+ * validated once for the whole sequence.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] for unique pairs of services and responses, see rcl_send_response()</i>
+ *
+ * \param[in] service handle to the service which will make the responses
+ * \param[in] count number of responses to send
+ * \param[inout] response_headers array of at least `count` request ID structs
+ * \param[in] ros_responses array of `count` type-erased ptrs to ROS response messages
+ * \param[out] sent number of responses sent, set even if an error occurs
+ * \return #RCL_RET_OK if all the responses were sent successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_response_sequence(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_request_id_t * response_headers,
+  void ** ros_responses,
+  size_t * sent);
+
+/// Get the counters of the response cache of a service.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] service the service whose response cache is queried
+ * \param[out] stats the counters of the response cache
+ * \return #RCL_RET_OK if the counters were retrieved, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid, or
+ * \return #RCL_RET_ERROR if the service has no response cache.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_get_response_cache_stats(
+  const rcl_service_t * service,
+  rcl_service_response_cache_stats_t * stats);
+
+/// Get the counters of the admission control of a service.
+/**
+ * The counters are all zero if the service has no admission control.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] service the service whose admission control is queried
+ * \param[out] stats the counters of the admission control
+ * \return #RCL_RET_OK if the counters were retrieved, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_get_admission_stats(
+  const rcl_service_t * service,
+  rcl_service_admission_stats_t * stats);
+
+/// Stop counting a taken request as in flight, without answering it.
+/**
+ * A request which is never going to be answered, e.g. because handling it
+ * failed, must be released, or it counts against the `max_in_flight` of the
+ * admission control until its `in_flight_timeout`, if any.
+ * If the service has a response cache, the request also stops holding back
+ * identical requests, and those held back so far are dropped without a
+ * response.
+ * Nothing is done if the request is not in flight, e.g. it was already
+ * answered, or if the service neither has a maximum number of in flight
+ * requests nor a response cache.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] service the service which took the request
+ * \param[in] request_header the id of the request, as returned by rcl_take_request()
+ * \return #RCL_RET_OK if the request is not in flight anymore, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_SERVICE_INVALID if the service is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_release_request(
+  const rcl_service_t * service,
+  const rmw_request_id_t * request_header);
+
 /// Get the topic name for the service.
 /**
  * This function returns the service's internal topic name string.
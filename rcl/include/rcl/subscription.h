@@ -24,6 +24,8 @@ extern "C"
 
 #include "rosidl_runtime_c/message_type_support_struct.h"
 
+#include "rcl/compression.h"
+#include "rcl/dispatch.h"
 #include "rcl/macros.h"
 #include "rcl/node.h"
 #include "rcl/visibility_control.h"
@@ -50,6 +52,14 @@ typedef struct rcl_subscription_options_t
   rcl_allocator_t allocator;
   /// rmw specific subscription options, e.g. the rmw implementation specific payload.
   rmw_subscription_options_t rmw_subscription_options;
+  /// Scheduling attributes used to order the subscription among ready entities.
+  rcl_dispatch_attributes_t dispatch;
+  /// Codec decompressing the messages, which must match the one of the publishers.
+  /**
+   * When its name is set, only publishers compressing with the same codec are
+   * matched and messages are decompressed when taken, see rcl_compression_codec_t.
+   */
+  rcl_compression_codec_t compression;
 } rcl_subscription_options_t;
 
 /// Return a rcl_subscription_t struct with members set to `NULL`.
@@ -200,6 +210,8 @@ rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node);
  * - qos = rmw_qos_profile_default
  * - allocator = rcl_get_default_allocator()
  * - rmw_subscription_options = rmw_get_default_subscription_options();
+ * - dispatch = rcl_dispatch_get_default_attributes()
+ * - compression = rcl_get_zero_initialized_compression_codec()
  *
  * \return A structure containing the default options for a subscription.
  */
@@ -243,6 +255,10 @@ rcl_subscription_get_default_options(void);
  * structure.
  * Passing `NULL` for message_info will result in the argument being ignored.
  *
+ * When the subscription was created with a compression codec, the message is
+ * taken serialized, decompressed and deserialized, transparently for the caller.
+ * The intermediate buffers are kept by the subscription and only grow.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
@@ -250,7 +266,8 @@ rcl_subscription_get_default_options(void);
  * Thread-Safe        | No
  * Uses Atomics       | No
  * Lock-Free          | Yes
- * <i>[1] only if required when filling the message, avoided for fixed sizes</i>
+ * <i>[1] only if required when filling the message, avoided for fixed sizes,
+ *   and when decompressing while the buffers of the subscription grow</i>
  *
  * \param[in] subscription the handle to the subscription from which to take
  * \param[inout] ros_message type-erased ptr to a allocated ROS message
@@ -313,6 +330,7 @@ rcl_take(
  * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
  * \return #RCL_RET_SUBSCRIPTION_TAKE_FAILED if take failed but no error
  *         occurred in the middleware, or
+ * \return #RCL_RET_UNSUPPORTED if the subscription decompresses its messages, or
  * \return #RCL_RET_ERROR if an unspecified error occurs.
  */
 RCL_PUBLIC
@@ -340,6 +358,8 @@ rcl_take_sequence(
  * be checked by this function and therefore no deliberate error will occur.
  *
  * Apart from the differences above, this function behaves like rcl_take().
+ * In particular, messages compressed by the publisher are decompressed into
+ * `serialized_message`, which then holds the original serialization.
  *
  * <hr>
  * Attribute          | Adherence
@@ -348,7 +368,8 @@ rcl_take_sequence(
  * Thread-Safe        | No
  * Uses Atomics       | No
  * Lock-Free          | Yes
- * <i>[1] only if storage in the serialized_message is insufficient</i>
+ * <i>[1] only if storage in the serialized_message is insufficient, or when
+ *   decompressing while the buffers of the subscription grow</i>
  *
  * \param[in] subscription the handle to the subscription from which to take
  * \param[inout] serialized_message pointer to a (pre-allocated) serialized message.
@@ -378,6 +399,7 @@ rcl_take_serialized_message(
  * The implicit contract here is that the middleware owns the memory allocated for this message.
  * The user must not destroy the message, but rather has to return it with a call to
  * \sa rcl_return_loaned_message to the middleware.
+ * Subscriptions decompressing their messages never loan them.
  *
  * <hr>
  * Attribute          | Adherence
@@ -398,6 +420,7 @@ rcl_take_serialized_message(
  * \return #RCL_RET_SUBSCRIPTION_TAKE_FAILED if take failed but no error
  *         occurred in the middleware, or
  * \return #RCL_RET_UNSUPPORTED if the middleware does not support that feature, or
+ *         if the subscription decompresses its messages, or
  * \return #RCL_RET_ERROR if an unspecified error occurs.
  */
 RCL_PUBLIC
@@ -603,6 +626,7 @@ rcl_subscription_get_actual_qos(const rcl_subscription_t * subscription);
 /**
  * Depending on the middleware and the message type, this will return true if the middleware
  * can allocate a ROS message instance.
+ * Subscriptions decompressing their messages never loan them.
  *
  * \param[in] subscription The subscription instance to check for the ability to loan messages
  * \return `true` if the subscription instance can loan messages, `false` otherwise.
@@ -26,6 +26,7 @@ extern "C"
 
 #include "rcl/allocator.h"
 #include "rcl/context.h"
+#include "rcl/dispatch.h"
 #include "rcl/guard_condition.h"
 #include "rcl/macros.h"
 #include "rcl/time.h"
@@ -212,6 +213,9 @@ rcl_timer_fini(rcl_timer_t * timer);
  * During the callback the timer can be canceled or have its period and/or
  * callback modified.
  *
+ * Calling a canceled timer is an expected outcome for executors, so
+ * #RCL_RET_TIMER_CANCELED is returned without setting the error state.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
@@ -589,6 +593,56 @@ RCL_WARN_UNUSED
 rcl_guard_condition_t *
 rcl_timer_get_guard_condition(const rcl_timer_t * timer);
 
+/// Set the scheduling attributes used to order the timer among ready entities.
+/**
+ * Timers start with rcl_dispatch_get_default_attributes().
+ * The release time of a timer is the time at which it was scheduled to be
+ * called, so its deadline is relative to that.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] timer the timer to set the attributes of
+ * \param[in] attributes the scheduling attributes
+ * \return #RCL_RET_OK if the attributes were set, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_TIMER_INVALID if the timer is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_set_dispatch_attributes(
+  rcl_timer_t * timer,
+  const rcl_dispatch_attributes_t * attributes);
+
+/// Retrieve the scheduling attributes of the timer.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] timer the timer to be queried
+ * \param[out] attributes the scheduling attributes of the timer
+ * \return #RCL_RET_OK if the attributes were retrieved, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_TIMER_INVALID if the timer is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_get_dispatch_attributes(
+  const rcl_timer_t * timer,
+  rcl_dispatch_attributes_t * attributes);
+
 #ifdef __cplusplus
 }
 #endif
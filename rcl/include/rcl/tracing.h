@@ -0,0 +1,482 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// @file
+
+#ifndef RCL__TRACING_H_
+#define RCL__TRACING_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tracetools/tracetools.h"
+
+#include "rcl/allocator.h"
+#include "rcl/macros.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// Maximum number of threads which can own a trace buffer at a time.
+#define RCL_TRACING_MAX_THREADS 64
+
+/// Size of the text of an event, including the terminating null characters.
+#define RCL_TRACING_EVENT_TEXT_SIZE 48
+
+/// Type of the events recorded by the in-process tracer.
+/**
+ * The types up to RCL_TRACING_EVENT_RCL_LIFECYCLE_TRANSITION match the tracetools tracepoint of
+ * the same name, the others are only recorded by the in-process tracer.
+ */
+typedef enum rcl_tracing_event_type_e
+{
+  RCL_TRACING_EVENT_RCL_INIT = 0,
+  RCL_TRACING_EVENT_RCL_NODE_INIT,
+  RCL_TRACING_EVENT_RCL_PUBLISHER_INIT,
+  RCL_TRACING_EVENT_RCL_SUBSCRIPTION_INIT,
+  RCL_TRACING_EVENT_RCL_SERVICE_INIT,
+  RCL_TRACING_EVENT_RCL_CLIENT_INIT,
+  RCL_TRACING_EVENT_RCL_TIMER_INIT,
+  RCL_TRACING_EVENT_RCL_PUBLISH,
+  RCL_TRACING_EVENT_RCL_LIFECYCLE_STATE_MACHINE_INIT,
+  RCL_TRACING_EVENT_RCL_LIFECYCLE_TRANSITION,
+  RCL_TRACING_EVENT_RCL_TAKE,
+  RCL_TRACING_EVENT_RCL_SEND_REQUEST,
+  RCL_TRACING_EVENT_RCL_TAKE_REQUEST,
+  RCL_TRACING_EVENT_RCL_SEND_RESPONSE,
+  RCL_TRACING_EVENT_RCL_TAKE_RESPONSE,
+  RCL_TRACING_EVENT_RCL_WAIT_ENTER,
+  RCL_TRACING_EVENT_RCL_WAIT_EXIT,
+  RCL_TRACING_EVENT_RCL_TIMER_CALL,
+  RCL_TRACING_EVENT_RCL_TIMER_CALLBACK_START,
+  RCL_TRACING_EVENT_RCL_TIMER_CALLBACK_END,
+  RCL_TRACING_EVENT_RCL_ACTION_ACCEPT_NEW_GOAL,
+  RCL_TRACING_EVENT_RCL_ACTION_UPDATE_GOAL_STATE,
+  RCL_TRACING_EVENT_RCL_ACTION_EXPIRE_GOALS,
+  /// Number of event types, not an event type itself.
+  RCL_TRACING_EVENT_TYPE_COUNT
+} rcl_tracing_event_type_t;
+
+/// Event recorded by the in-process tracer, as stored in the trace buffers and files.
+/**
+ * Events have a fixed size so recording one is a copy into a ring buffer.
+ * Pointers and integers are stored in `args`, in the order of the tracepoint arguments.
+ * Strings are stored one after the other in `text`, each null terminated, and are
+ * truncated when they do not fit.
+ */
+typedef struct rcl_tracing_event_t
+{
+  /// Steady time of the event, in nanoseconds.
+  int64_t timestamp;
+  /// One of rcl_tracing_event_type_t.
+  uint32_t type;
+  /// Index of the trace buffer of the recording thread, shared by threads reusing the buffer.
+  uint32_t thread;
+  /// Pointer and integer arguments of the tracepoint, unused ones are zero.
+  uint64_t args[4];
+  /// String arguments of the tracepoint.
+  char text[RCL_TRACING_EVENT_TEXT_SIZE];
+} rcl_tracing_event_t;
+
+/// Start recording tracepoints in per-thread trace buffers.
+/**
+ * Each thread hitting a tracepoint gets a ring buffer of `events_per_thread` events the first
+ * time it records one, allocated with `allocator`.
+ * Recording never blocks: when the buffer of a thread is full, its events are dropped until the
+ * buffer is drained by rcl_tracing_flush() or rcl_tracing_dump_chrome_json().
+ *
+ * Recording again after rcl_tracing_stop() keeps the events recorded so far.
+ * At most #RCL_TRACING_MAX_THREADS threads own a buffer at a time.
+ * A thread releases its buffer when it exits, and the next thread to record an event reuses it
+ * after the events left in it.
+ *
+ * Without RCL_TRACING_ENABLED, rcl is built with a tracer which never records, and this
+ * returns `RCL_RET_UNSUPPORTED`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] events_per_thread capacity of the buffer of each thread, must not be zero
+ * \param[in] allocator allocator used for the trace buffers, must be thread-safe
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ALREADY_INIT` if already recording, or
+ * \return `RCL_RET_UNSUPPORTED` if rcl was built without RCL_TRACING_ENABLED, or
+ * \return `RCL_RET_ERROR` if the tracer was started before with a different capacity, or
+ * the thread exit key of the buffers cannot be created.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_tracing_start(size_t events_per_thread, rcl_allocator_t allocator);
+
+/// Stop recording tracepoints, the recorded events stay in the trace buffers.
+/**
+ * Tracepoints being recorded concurrently may still complete after this returns.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_NOT_INIT` if not recording.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_tracing_stop(void);
+
+/// Return `true` if tracepoints are being recorded, otherwise `false`.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCL_PUBLIC
+bool
+rcl_tracing_is_recording(void);
+
+/// Record an event in the trace buffer of the calling thread.
+/**
+ * This is the entry point of the tracepoint macros, use RCL_TRACEPOINT() instead.
+ * Nothing is recorded if the tracer is not recording.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] only the first time a thread records an event after rcl_tracing_start()</i>
+ *
+ * \param[in] type type of the event
+ * \param[in] arg0 first pointer or integer argument
+ * \param[in] arg1 second pointer or integer argument
+ * \param[in] arg2 third pointer or integer argument
+ * \param[in] arg3 fourth pointer or integer argument
+ * \param[in] text0 first string argument, or `NULL`
+ * \param[in] text1 second string argument, or `NULL`
+ */
+RCL_PUBLIC
+void
+rcl_tracing_record(
+  rcl_tracing_event_type_t type,
+  uint64_t arg0,
+  uint64_t arg1,
+  uint64_t arg2,
+  uint64_t arg3,
+  const char * text0,
+  const char * text1);
+
+/// Move the recorded events to a binary trace file.
+/**
+ * The events of all the trace buffers are appended to the file at `file_path`, which is
+ * created if needed, and the buffers are drained.
+ * Flushing periodically while recording keeps the buffers from dropping events.
+ * The file can be converted for viewing with rcl_tracing_convert_to_chrome_json().
+ *
+ * Events are flushed buffer by buffer, so they are only ordered in time per thread.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] safe to call while other threads record events, but not concurrently with
+ * itself, rcl_tracing_dump_chrome_json() or rcl_tracing_fini()</i>
+ *
+ * \param[in] file_path path of the binary trace file
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if rcl was built without RCL_TRACING_ENABLED, or
+ * \return `RCL_RET_ERROR` if the file cannot be written.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_tracing_flush(const char * file_path);
+
+/// Move the recorded events to a Chrome trace JSON file.
+/**
+ * The events of all the trace buffers are written to the file at `file_path`, which is
+ * replaced if it exists, and the buffers are drained.
+ * The file uses the Chrome trace event format, which both chrome://tracing and the Perfetto UI
+ * open.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] safe to call while other threads record events, but not concurrently with
+ * itself, rcl_tracing_flush() or rcl_tracing_fini()</i>
+ *
+ * \param[in] file_path path of the JSON file
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if rcl was built without RCL_TRACING_ENABLED, or
+ * \return `RCL_RET_ERROR` if the file cannot be written.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_tracing_dump_chrome_json(const char * file_path);
+
+/// Convert a binary trace file written by rcl_tracing_flush() to a Chrome trace JSON file.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] binary_path path of the binary trace file
+ * \param[in] json_path path of the JSON file, replaced if it exists
+ * \return `RCL_RET_OK` if successful, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if rcl was built without RCL_TRACING_ENABLED, or
+ * \return `RCL_RET_ERROR` if a file cannot be read or written, or is not a binary trace.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_tracing_convert_to_chrome_json(const char * binary_path, const char * json_path);
+
+/// Return the number of events dropped because a trace buffer was full or none was left.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+uint64_t
+rcl_tracing_get_dropped_event_count(void);
+
+/// Stop recording and free the trace buffers, discarding the events they hold.
+/**
+ * No thread may be recording an event while this is called, nor afterwards until
+ * rcl_tracing_start() is called again.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \return `RCL_RET_OK` if successful.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_tracing_fini(void);
+
+/// Store a pointer tracepoint argument in an event argument.
+#define RCL_TRACING_POINTER(pointer) ((uint64_t)(uintptr_t)(const void *)(pointer))
+
+/// Store an integer tracepoint argument in an event argument.
+#define RCL_TRACING_INTEGER(value) ((uint64_t)(value))
+
+/// Return half of a 16 bytes UUID as an event argument, so that it prints in byte order.
+static inline uint64_t
+rcl_tracing_uuid_half(const uint8_t * uuid, size_t half)
+{
+  uint64_t value = 0u;
+  for (size_t i = half * 8u; i < half * 8u + 8u; ++i) {
+    value = (value << 8u) | uuid[i];
+  }
+  return value;
+}
+
+#define RCL_TRACING_RECORD_rcl_init(context) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_INIT, RCL_TRACING_POINTER(context), 0u, 0u, 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_node_init(node, rmw_handle, node_name, node_namespace) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_NODE_INIT, RCL_TRACING_POINTER(node), RCL_TRACING_POINTER(rmw_handle), \
+    0u, 0u, node_name, node_namespace)
+
+#define RCL_TRACING_RECORD_rcl_publisher_init( \
+    publisher, node, rmw_handle, topic_name, queue_depth) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_PUBLISHER_INIT, RCL_TRACING_POINTER(publisher), \
+    RCL_TRACING_POINTER(node), RCL_TRACING_POINTER(rmw_handle), \
+    RCL_TRACING_INTEGER(queue_depth), topic_name, NULL)
+
+#define RCL_TRACING_RECORD_rcl_subscription_init( \
+    subscription, node, rmw_handle, topic_name, queue_depth) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_SUBSCRIPTION_INIT, RCL_TRACING_POINTER(subscription), \
+    RCL_TRACING_POINTER(node), RCL_TRACING_POINTER(rmw_handle), \
+    RCL_TRACING_INTEGER(queue_depth), topic_name, NULL)
+
+#define RCL_TRACING_RECORD_rcl_service_init(service, node, rmw_handle, service_name) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_SERVICE_INIT, RCL_TRACING_POINTER(service), \
+    RCL_TRACING_POINTER(node), RCL_TRACING_POINTER(rmw_handle), 0u, service_name, NULL)
+
+#define RCL_TRACING_RECORD_rcl_client_init(client, node, rmw_handle, service_name) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_CLIENT_INIT, RCL_TRACING_POINTER(client), \
+    RCL_TRACING_POINTER(node), RCL_TRACING_POINTER(rmw_handle), 0u, service_name, NULL)
+
+#define RCL_TRACING_RECORD_rcl_timer_init(timer, period) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_TIMER_INIT, RCL_TRACING_POINTER(timer), RCL_TRACING_INTEGER(period), \
+    0u, 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_publish(publisher, message) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_PUBLISH, RCL_TRACING_POINTER(publisher), RCL_TRACING_POINTER(message), \
+    0u, 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_lifecycle_state_machine_init(node, state_machine) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_LIFECYCLE_STATE_MACHINE_INIT, RCL_TRACING_POINTER(node), \
+    RCL_TRACING_POINTER(state_machine), 0u, 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_lifecycle_transition(state_machine, start_label, goal_label) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_LIFECYCLE_TRANSITION, RCL_TRACING_POINTER(state_machine), 0u, 0u, 0u, \
+    start_label, goal_label)
+
+#define RCL_TRACING_RECORD_rcl_take(subscription, message, source_timestamp, received_timestamp) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_TAKE, RCL_TRACING_POINTER(subscription), RCL_TRACING_POINTER(message), \
+    RCL_TRACING_INTEGER(source_timestamp), RCL_TRACING_INTEGER(received_timestamp), NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_send_request(client, request, sequence_number) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_SEND_REQUEST, RCL_TRACING_POINTER(client), RCL_TRACING_POINTER(request), \
+    RCL_TRACING_INTEGER(sequence_number), 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_take_request(service, request, sequence_number, source_timestamp) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_TAKE_REQUEST, RCL_TRACING_POINTER(service), \
+    RCL_TRACING_POINTER(request), RCL_TRACING_INTEGER(sequence_number), \
+    RCL_TRACING_INTEGER(source_timestamp), NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_send_response(service, response, sequence_number) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_SEND_RESPONSE, RCL_TRACING_POINTER(service), \
+    RCL_TRACING_POINTER(response), RCL_TRACING_INTEGER(sequence_number), 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_take_response(client, response, sequence_number, source_timestamp) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_TAKE_RESPONSE, RCL_TRACING_POINTER(client), \
+    RCL_TRACING_POINTER(response), RCL_TRACING_INTEGER(sequence_number), \
+    RCL_TRACING_INTEGER(source_timestamp), NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_wait_enter(wait_set, timeout) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_WAIT_ENTER, RCL_TRACING_POINTER(wait_set), \
+    RCL_TRACING_INTEGER(timeout), 0u, 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_wait_exit(wait_set, ret) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_WAIT_EXIT, RCL_TRACING_POINTER(wait_set), RCL_TRACING_INTEGER(ret), \
+    0u, 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_timer_call(timer, call_time, scheduled_time) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_TIMER_CALL, RCL_TRACING_POINTER(timer), \
+    RCL_TRACING_INTEGER(call_time), RCL_TRACING_INTEGER(scheduled_time), 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_timer_callback_start(timer, callback) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_TIMER_CALLBACK_START, RCL_TRACING_POINTER(timer), \
+    (uint64_t)(uintptr_t)(callback), 0u, 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_timer_callback_end(timer) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_TIMER_CALLBACK_END, RCL_TRACING_POINTER(timer), 0u, 0u, 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_action_accept_new_goal(action_server, goal_handle, goal_uuid) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_ACTION_ACCEPT_NEW_GOAL, RCL_TRACING_POINTER(action_server), \
+    RCL_TRACING_POINTER(goal_handle), rcl_tracing_uuid_half(goal_uuid, 0u), \
+    rcl_tracing_uuid_half(goal_uuid, 1u), NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_action_update_goal_state(goal_handle, goal_event, goal_state) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_ACTION_UPDATE_GOAL_STATE, RCL_TRACING_POINTER(goal_handle), \
+    RCL_TRACING_INTEGER(goal_event), RCL_TRACING_INTEGER(goal_state), 0u, NULL, NULL)
+
+#define RCL_TRACING_RECORD_rcl_action_expire_goals(action_server, num_expired) \
+  rcl_tracing_record( \
+    RCL_TRACING_EVENT_RCL_ACTION_EXPIRE_GOALS, RCL_TRACING_POINTER(action_server), \
+    RCL_TRACING_INTEGER(num_expired), 0u, 0u, NULL, NULL)
+
+/// Trace an event with tracetools and, when built with RCL_TRACING_ENABLED, the in-process tracer.
+/**
+ * Takes the same arguments as the tracetools TRACEPOINT() macro.
+ * rcl exports RCL_TRACING_ENABLED when built with it, so packages using rcl match its setting.
+ * Without RCL_TRACING_ENABLED this is TRACEPOINT() alone, and with it the in-process tracer only
+ * costs a load of the recording flag while it is not recording.
+ */
+#ifdef RCL_TRACING_ENABLED
+# define RCL_TRACEPOINT(event_name, ...) \
+  do { \
+    TRACEPOINT(event_name, __VA_ARGS__); \
+    if (rcl_tracing_is_recording()) { \
+      RCL_TRACING_RECORD_ ## event_name(__VA_ARGS__); \
+    } \
+  } while (0)
+#else
+# define RCL_TRACEPOINT(event_name, ...) TRACEPOINT(event_name, __VA_ARGS__)
+#endif
+
+/// Trace an event which has no tracetools tracepoint with the in-process tracer.
+/**
+ * Without RCL_TRACING_ENABLED this expands to nothing, and the arguments are not evaluated.
+ */
+#ifdef RCL_TRACING_ENABLED
+# define RCL_IN_PROCESS_TRACEPOINT(event_name, ...) \
+  do { \
+    if (rcl_tracing_is_recording()) { \
+      RCL_TRACING_RECORD_ ## event_name(__VA_ARGS__); \
+    } \
+  } while (0)
+#else
+# define RCL_IN_PROCESS_TRACEPOINT(event_name, ...) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__TRACING_H_
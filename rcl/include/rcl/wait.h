@@ -24,8 +24,10 @@ extern "C"
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "rcl/client.h"
+#include "rcl/dispatch.h"
 #include "rcl/guard_condition.h"
 #include "rcl/macros.h"
 #include "rcl/service.h"
@@ -38,6 +40,45 @@ extern "C"
 struct rcl_wait_set_impl_t;
 
 /// Container for subscription's, guard condition's, etc to be waited on.
+/// How rcl_wait() waits for entities to become ready.
+typedef enum rcl_wait_mode_e
+{
+  /// Block in the middleware until something is ready or the timeout expires.
+  RCL_WAIT_MODE_BLOCK = 0,
+  /// Poll the middleware for up to the spin budget, then block.
+  RCL_WAIT_MODE_SPIN,
+  /// Like #RCL_WAIT_MODE_SPIN, but only spin while the next wake-up is expected soon.
+  /**
+   * The expected time of the next wake-up is estimated from a moving average
+   * of the intervals between past wake-ups.
+   * If it falls within the spin budget, rcl_wait() spins until a little past
+   * it, otherwise it blocks right away.
+   */
+  RCL_WAIT_MODE_ADAPTIVE
+} rcl_wait_mode_t;
+
+/// Wait mode settings of a wait set.
+typedef struct rcl_wait_mode_options_t
+{
+  /// How rcl_wait() waits.
+  rcl_wait_mode_t mode;
+  /// Longest duration, in nanoseconds, rcl_wait() polls before blocking.
+  int64_t spin_budget;
+} rcl_wait_mode_options_t;
+
+/// Counters of how the waits of a wait set were satisfied.
+typedef struct rcl_wait_mode_stats_t
+{
+  /// Number of waits that returned while spinning.
+  uint64_t spin_wakeups;
+  /// Number of waits that spun for their whole budget and then blocked.
+  uint64_t spin_misses;
+  /// Number of waits that blocked without spinning.
+  uint64_t blocking_waits;
+  /// Moving average of the interval, in nanoseconds, between waits returning ready.
+  int64_t mean_inter_arrival;
+} rcl_wait_mode_stats_t;
+
 typedef struct rcl_wait_set_t
 {
   /// Storage for subscription pointers.
@@ -472,6 +513,70 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout);
 
+/// Return the default wait mode options, blocking without spinning.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_wait_mode_options_t
+rcl_wait_mode_get_default_options(void);
+
+/// Set how rcl_wait() waits on a wait set.
+/**
+ * Blocking in the middleware costs a futex wake-up and a reschedule, which
+ * can be a large share of the period of a fast control loop.
+ * In the spinning modes rcl_wait() first polls the middleware with zero
+ * timeout rmw_wait() calls for up to the spin budget, and only then blocks
+ * for the rest of the timeout.
+ * Spinning keeps a core busy, so the budget should stay well below the period
+ * of the loop.
+ *
+ * Spinning never outlasts the timeout passed to rcl_wait() nor the time until
+ * the next timer of the wait set is due, and a zero timeout never spins.
+ *
+ * The first spinning wait after the wait set grew allocates the storage used
+ * to restore the middleware handles between polls.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set the wait set to configure
+ * \param[in] options the wait mode options
+ * \return #RCL_RET_OK if the wait mode was set, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_WAIT_SET_INVALID if the wait set is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_set_wait_mode(rcl_wait_set_t * wait_set, const rcl_wait_mode_options_t * options);
+
+/// Retrieve the wait mode counters of a wait set.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] wait_set the wait set to query
+ * \param[out] stats the wait mode counters
+ * \return #RCL_RET_OK if the counters were retrieved, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_WAIT_SET_INVALID if the wait set is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_get_wait_mode_stats(
+  const rcl_wait_set_t * wait_set,
+  rcl_wait_mode_stats_t * stats);
+
 /// Return `true` if the wait set is valid, else `false`.
 /**
  * A wait set is invalid if:
@@ -495,6 +600,53 @@ RCL_PUBLIC
 bool
 rcl_wait_set_is_valid(const rcl_wait_set_t * wait_set);
 
+/// Get the ready subscriptions, timers and services of a wait set in dispatch order.
+/**
+ * After rcl_wait() returns, the ready entities are left in the wait set arrays
+ * in the order they were added.
+ * This function collects them into `entries`, with the dispatch attributes of
+ * each entity, and sorts them with rcl_dispatch_order() so that they can be
+ * taken and executed in the returned order.
+ *
+ * The release time of a timer is the time it was scheduled to be called.
+ * The source timestamp of a message or request is only known once it is taken,
+ * so until then their release time is the current system time.
+ * Callers which take all ready data before executing it can set the release
+ * time of each entry to the `source_timestamp` of what they took and sort the
+ * entries again with rcl_dispatch_order(), which then orders them by the
+ * deadlines of the actual data.
+ *
+ * Guard conditions, clients and events are not collected.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] wait_set the wait set rcl_wait() returned on
+ * \param[in] policy the dispatch policy to sort by
+ * \param[out] entries storage for the ready entities
+ * \param[in] capacity the number of entries `entries` can hold
+ * \param[out] count the number of ready entities stored in `entries`
+ * \return #RCL_RET_OK if the ready entities were collected, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ *   if there are more ready entities than `capacity`, or
+ * \return #RCL_RET_WAIT_SET_INVALID if the wait set is invalid, or
+ * \return #RCL_RET_ERROR if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_get_dispatch_order(
+  const rcl_wait_set_t * wait_set,
+  rcl_dispatch_policy_t policy,
+  rcl_dispatch_entry_t * entries,
+  size_t capacity,
+  size_t * count);
+
 #ifdef __cplusplus
 }
 #endif
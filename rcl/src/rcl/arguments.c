@@ -128,7 +128,7 @@ rcl_arguments_get_param_overrides(
   }
   *parameter_overrides = NULL;
   if (NULL != arguments->impl->parameter_overrides) {
-    *parameter_overrides = rcl_yaml_node_struct_copy(arguments->impl->parameter_overrides);
+    *parameter_overrides = rcl_yaml_node_struct_share(arguments->impl->parameter_overrides);
     if (NULL == *parameter_overrides) {
       return RCL_RET_BAD_ALLOC;
     }
@@ -890,7 +890,7 @@ rcl_arguments_copy(
   // Copy parameter rules
   if (args->impl->parameter_overrides) {
     args_out->impl->parameter_overrides =
-      rcl_yaml_node_struct_copy(args->impl->parameter_overrides);
+      rcl_yaml_node_struct_share(args->impl->parameter_overrides);
   }
 
   // Copy parameter files
@@ -24,12 +24,12 @@ extern "C"
 
 #include "rcl/error_handling.h"
 #include "rcl/node.h"
+#include "rcl/tracing.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/macros.h"
 #include "rcutils/stdatomic_helper.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
-#include "tracetools/tracetools.h"
 
 #include "./common.h"
 
@@ -116,7 +116,7 @@ rcl_client_init(
   atomic_init(&client->impl->sequence_number, 0);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client initialized");
   ret = RCL_RET_OK;
-  TRACEPOINT(
+  RCL_TRACEPOINT(
     rcl_client_init,
     (const void *)client,
     (const void *)node,
@@ -216,13 +216,16 @@ rcl_send_request(const rcl_client_t * client, const void * ros_request, int64_t
   RCL_CHECK_ARGUMENT_FOR_NULL(ros_request, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(sequence_number, RCL_RET_INVALID_ARGUMENT);
   *sequence_number = rcutils_atomic_load_int64_t(&client->impl->sequence_number);
+  RCL_CLEAR_STALE_ERROR();
   if (rmw_send_request(
       client->impl->rmw_handle, ros_request, sequence_number) != RMW_RET_OK)
   {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return RCL_RET_ERROR;
   }
   rcutils_atomic_exchange_int64_t(&client->impl->sequence_number, *sequence_number);
+  RCL_IN_PROCESS_TRACEPOINT(
+    rcl_send_request, (const void *)client, ros_request, *sequence_number);
   return RCL_RET_OK;
 }
 
@@ -243,10 +246,11 @@ rcl_take_response_with_info(
   bool taken = false;
   request_header->source_timestamp = 0;
   request_header->received_timestamp = 0;
+  RCL_CLEAR_STALE_ERROR();
   if (rmw_take_response(
       client->impl->rmw_handle, request_header, ros_response, &taken) != RMW_RET_OK)
   {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return RCL_RET_ERROR;
   }
   RCUTILS_LOG_DEBUG_NAMED(
@@ -254,6 +258,9 @@ rcl_take_response_with_info(
   if (!taken) {
     return RCL_RET_CLIENT_TAKE_FAILED;
   }
+  RCL_IN_PROCESS_TRACEPOINT(
+    rcl_take_response, (const void *)client, (const void *)ros_response,
+    request_header->request_id.sequence_number, request_header->source_timestamp);
   return RCL_RET_OK;
 }
 
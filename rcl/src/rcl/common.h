@@ -20,12 +20,40 @@ extern "C"
 {
 #endif
 
+#include "rcl/error_handling.h"
 #include "rcl/types.h"
 
 /// Convenience function for converting common rmw_ret_t return codes to rcl.
 rcl_ret_t
 rcl_convert_rmw_ret_to_rcl_ret(rmw_ret_t rmw_ret);
 
+/// Clear an error left set by an earlier call, before an rmw call.
+/**
+ * An error set after the rmw call then comes from the rmw implementation, which
+ * RCL_SET_ERROR_MSG_FROM_RMW() relies on.
+ * Checking the error state is cheap, it is only reset when it was set.
+ */
+#define RCL_CLEAR_STALE_ERROR() \
+  do { \
+    if (rcl_error_is_set()) { \
+      rcl_reset_error(); \
+    } \
+  } while (0)
+
+/// Set the rcl error state after a failed rmw call.
+/**
+ * rmw shares the rcutils error state with rcl, so the error set by the rmw
+ * implementation is kept as is, rather than formatted and copied over itself.
+ * A generic message is only set if the rmw implementation did not set one, which
+ * requires RCL_CLEAR_STALE_ERROR() before the rmw call.
+ */
+#define RCL_SET_ERROR_MSG_FROM_RMW() \
+  do { \
+    if (!rcl_error_is_set()) { \
+      RCL_SET_ERROR_MSG("rmw call failed without setting an error message"); \
+    } \
+  } while (0)
+
 #ifdef __cplusplus
 }
 #endif
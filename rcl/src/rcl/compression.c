@@ -0,0 +1,512 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/compression.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#ifdef RCL_COMPRESSION_ZSTD_ENABLED
+#include <zstd.h>
+#endif
+
+#include "rcl/error_handling.h"
+#include "rcutils/format_string.h"
+#include "rmw/serialized_message.h"
+
+#include "./common.h"
+#include "./compression_impl.h"
+
+// LZ4 block format: sequences of a token, literals and a match copied from up to
+// 64 KiB back, the last sequence holding literals only.
+#define LZ4_MIN_MATCH 4u
+// The last literals and the distance from the last match start to the end of the block.
+#define LZ4_LAST_LITERALS 5u
+#define LZ4_MATCH_FIND_LIMIT 12u
+#define LZ4_MAX_OFFSET 65535u
+#define LZ4_HASH_LOG 12u
+#define LZ4_TABLE_SIZE (((size_t)1u << LZ4_HASH_LOG) * sizeof(uint32_t))
+// Each byte of a match length extends the match by at most 255 bytes.
+#define LZ4_MAX_RATIO 255u
+
+rcl_compression_codec_t
+rcl_get_zero_initialized_compression_codec(void)
+{
+  static rcl_compression_codec_t null_codec = {0};
+  return null_codec;
+}
+
+static uint32_t
+_rcl_lz4_read32(const uint8_t * p)
+{
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static size_t
+_rcl_lz4_hash(uint32_t sequence)
+{
+  return (size_t)((sequence * 2654435761u) >> (32u - LZ4_HASH_LOG));
+}
+
+static uint8_t *
+_rcl_lz4_write_length(uint8_t * op, size_t length)
+{
+  for (; length >= 255u; length -= 255u) {
+    *op++ = 255u;
+  }
+  *op++ = (uint8_t)length;
+  return op;
+}
+
+static size_t
+_rcl_lz4_compress_bound(size_t size)
+{
+  return size + size / 255u + 16u;
+}
+
+static size_t
+_rcl_lz4_decompress_bound(size_t size)
+{
+  return size > SIZE_MAX / LZ4_MAX_RATIO ? SIZE_MAX : size * LZ4_MAX_RATIO;
+}
+
+/// Resize a serialized message, mapping the failure to a rcl return code.
+static rcl_ret_t
+_rcl_compression_reserve(rcl_serialized_message_t * message, size_t size)
+{
+  if (message->buffer_capacity >= size) {
+    return RCL_RET_OK;
+  }
+  RCL_CLEAR_STALE_ERROR();
+  if (RMW_RET_OK != rmw_serialized_message_resize(message, size)) {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    return RCL_RET_BAD_ALLOC;
+  }
+  return RCL_RET_OK;
+}
+
+/// Write a sequence, the match being omitted for the last one, and return the new end.
+static uint8_t *
+_rcl_lz4_write_sequence(
+  uint8_t * op, const uint8_t * literals, size_t literal_length,
+  size_t offset, size_t match_length, bool is_last)
+{
+  uint8_t * token = op++;
+  *token = (uint8_t)((literal_length >= 15u ? 15u : literal_length) << 4);
+  if (literal_length >= 15u) {
+    op = _rcl_lz4_write_length(op, literal_length - 15u);
+  }
+  if (literal_length > 0u) {
+    memcpy(op, literals, literal_length);
+    op += literal_length;
+  }
+  if (is_last) {
+    return op;
+  }
+  *op++ = (uint8_t)(offset & 0xffu);
+  *op++ = (uint8_t)(offset >> 8);
+  match_length -= LZ4_MIN_MATCH;
+  *token |= (uint8_t)(match_length >= 15u ? 15u : match_length);
+  if (match_length >= 15u) {
+    op = _rcl_lz4_write_length(op, match_length - 15u);
+  }
+  return op;
+}
+
+static rcl_ret_t
+_rcl_lz4_compress(
+  const uint8_t * input, size_t input_size,
+  uint8_t * output, size_t output_capacity, size_t * output_size,
+  rcl_serialized_message_t * scratch, void * state)
+{
+  (void)state;
+  if (output_capacity < _rcl_lz4_compress_bound(input_size) || input_size > UINT32_MAX) {
+    RCL_SET_ERROR_MSG("lz4 output capacity is below the compress bound, or input is too large");
+    return RCL_RET_ERROR;
+  }
+  const uint8_t * ip = input;
+  const uint8_t * anchor = input;
+  const uint8_t * const iend = input + input_size;
+  uint8_t * op = output;
+
+  if (input_size > LZ4_MATCH_FIND_LIMIT) {
+    // Positions of the last occurrence of each hashed 4 byte sequence, kept in the scratch
+    // message which is only resized the first time.
+    rcl_ret_t ret = _rcl_compression_reserve(scratch, LZ4_TABLE_SIZE);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    uint32_t * table = (uint32_t *)scratch->buffer;
+    memset(table, 0, LZ4_TABLE_SIZE);
+    const uint8_t * const match_find_limit = iend - LZ4_MATCH_FIND_LIMIT;
+    const uint8_t * const match_limit = iend - LZ4_LAST_LITERALS;
+    while (ip <= match_find_limit) {
+      const uint32_t sequence = _rcl_lz4_read32(ip);
+      const size_t hash = _rcl_lz4_hash(sequence);
+      const uint8_t * match = input + table[hash];
+      table[hash] = (uint32_t)(ip - input);
+      if (match >= ip || (size_t)(ip - match) > LZ4_MAX_OFFSET ||
+        _rcl_lz4_read32(match) != sequence)
+      {
+        ++ip;
+        continue;
+      }
+      // Extend backwards over the pending literals, then forwards.
+      while (ip > anchor && match > input && ip[-1] == match[-1]) {
+        --ip;
+        --match;
+      }
+      const uint8_t * match_end = ip + LZ4_MIN_MATCH;
+      const uint8_t * reference = match + LZ4_MIN_MATCH;
+      while (match_end < match_limit && *match_end == *reference) {
+        ++match_end;
+        ++reference;
+      }
+      op = _rcl_lz4_write_sequence(
+        op, anchor, (size_t)(ip - anchor), (size_t)(ip - match), (size_t)(match_end - ip), false);
+      ip = match_end;
+      anchor = ip;
+    }
+  }
+  op = _rcl_lz4_write_sequence(op, anchor, (size_t)(iend - anchor), 0u, 0u, true);
+  *output_size = (size_t)(op - output);
+  return RCL_RET_OK;
+}
+
+/// Read the extra bytes of a length, returning false if the input ends first.
+static bool
+_rcl_lz4_read_length(const uint8_t ** ip, const uint8_t * iend, size_t * length)
+{
+  uint8_t byte;
+  do {
+    if (*ip >= iend) {
+      return false;
+    }
+    byte = *(*ip)++;
+    *length += byte;
+  } while (255u == byte);
+  return true;
+}
+
+static rcl_ret_t
+_rcl_lz4_decompress(
+  const uint8_t * input, size_t input_size,
+  uint8_t * output, size_t output_capacity, size_t * output_size,
+  rcl_serialized_message_t * scratch, void * state)
+{
+  (void)scratch;
+  (void)state;
+  const uint8_t * ip = input;
+  const uint8_t * const iend = input + input_size;
+  uint8_t * op = output;
+  uint8_t * const oend = output + output_capacity;
+  while (ip < iend) {
+    const uint8_t token = *ip++;
+    size_t literal_length = token >> 4;
+    if (15u == literal_length && !_rcl_lz4_read_length(&ip, iend, &literal_length)) {
+      break;
+    }
+    if ((size_t)(iend - ip) < literal_length || (size_t)(oend - op) < literal_length) {
+      break;
+    }
+    if (literal_length > 0u) {
+      memcpy(op, ip, literal_length);
+      ip += literal_length;
+      op += literal_length;
+    }
+    if (ip == iend) {
+      *output_size = (size_t)(op - output);
+      return RCL_RET_OK;
+    }
+    if (iend - ip < 2) {
+      break;
+    }
+    const size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+    ip += 2;
+    size_t match_length = token & 15u;
+    if (15u == match_length && !_rcl_lz4_read_length(&ip, iend, &match_length)) {
+      break;
+    }
+    match_length += LZ4_MIN_MATCH;
+    if (0u == offset || offset > (size_t)(op - output) || (size_t)(oend - op) < match_length) {
+      break;
+    }
+    // Byte by byte, as the match may overlap what it produces.
+    const uint8_t * reference = op - offset;
+    for (size_t i = 0u; i < match_length; ++i) {
+      op[i] = reference[i];
+    }
+    op += match_length;
+  }
+  RCL_SET_ERROR_MSG("lz4 compressed data is corrupted");
+  return RCL_RET_ERROR;
+}
+
+rcl_compression_codec_t
+rcl_get_lz4_compression_codec(void)
+{
+  rcl_compression_codec_t codec = rcl_get_zero_initialized_compression_codec();
+  codec.name = "lz4";
+  codec.compress_bound = _rcl_lz4_compress_bound;
+  codec.decompress_bound = _rcl_lz4_decompress_bound;
+  codec.compress = _rcl_lz4_compress;
+  codec.decompress = _rcl_lz4_decompress;
+  return codec;
+}
+
+#ifdef RCL_COMPRESSION_ZSTD_ENABLED
+// Default level of the zstd command line tool.
+#define RCL_ZSTD_LEVEL 3
+
+static size_t
+_rcl_zstd_compress_bound(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
+
+static size_t
+_rcl_zstd_decompress_bound(size_t size)
+{
+  // Repeated bytes expand without a useful bound, so only the max decompressed size applies.
+  (void)size;
+  return SIZE_MAX;
+}
+
+static rcl_ret_t
+_rcl_zstd_compress(
+  const uint8_t * input, size_t input_size,
+  uint8_t * output, size_t output_capacity, size_t * output_size,
+  rcl_serialized_message_t * scratch, void * state)
+{
+  (void)scratch;
+  (void)state;
+  const size_t size = ZSTD_compress(output, output_capacity, input, input_size, RCL_ZSTD_LEVEL);
+  if (ZSTD_isError(size)) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("zstd compression failed: %s", ZSTD_getErrorName(size));
+    return RCL_RET_ERROR;
+  }
+  *output_size = size;
+  return RCL_RET_OK;
+}
+
+static rcl_ret_t
+_rcl_zstd_decompress(
+  const uint8_t * input, size_t input_size,
+  uint8_t * output, size_t output_capacity, size_t * output_size,
+  rcl_serialized_message_t * scratch, void * state)
+{
+  (void)scratch;
+  (void)state;
+  const size_t size = ZSTD_decompress(output, output_capacity, input, input_size);
+  if (ZSTD_isError(size)) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "zstd compressed data is corrupted: %s", ZSTD_getErrorName(size));
+    return RCL_RET_ERROR;
+  }
+  *output_size = size;
+  return RCL_RET_OK;
+}
+#endif  // RCL_COMPRESSION_ZSTD_ENABLED
+
+rcl_ret_t
+rcl_get_zstd_compression_codec(rcl_compression_codec_t * codec)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(codec, RCL_RET_INVALID_ARGUMENT);
+#ifdef RCL_COMPRESSION_ZSTD_ENABLED
+  *codec = rcl_get_zero_initialized_compression_codec();
+  codec->name = "zstd";
+  codec->compress_bound = _rcl_zstd_compress_bound;
+  codec->decompress_bound = _rcl_zstd_decompress_bound;
+  codec->compress = _rcl_zstd_compress;
+  codec->decompress = _rcl_zstd_decompress;
+  return RCL_RET_OK;
+#else
+  RCL_SET_ERROR_MSG("rcl was built without zstd, see the RCL_COMPRESSION_ZSTD_ENABLED option");
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
+
+bool
+rcl_compression_codec_is_valid(const rcl_compression_codec_t * codec)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(codec, "codec argument is null", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(codec->name, "codec name is null", return false);
+  if (!codec->compress_bound || !codec->decompress_bound || !codec->compress ||
+    !codec->decompress)
+  {
+    RCL_SET_ERROR_MSG("codec functions must not be null");
+    return false;
+  }
+  // The name starts the last token of the topic name, which a leading underscore would hide.
+  bool is_valid_name = (codec->name[0] >= 'a' && codec->name[0] <= 'z') ||
+    (codec->name[0] >= 'A' && codec->name[0] <= 'Z');
+  for (const char * c = codec->name; is_valid_name && '\0' != *c; ++c) {
+    is_valid_name = '_' == *c || (*c >= '0' && *c <= '9') ||
+      (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z');
+  }
+  if (!is_valid_name) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("invalid codec name '%s'", codec->name);
+    return false;
+  }
+  return true;
+}
+
+rcl_ret_t
+rcl_compression_get_topic_name(
+  const char * topic_name,
+  const rcl_compression_codec_t * codec,
+  rcl_allocator_t allocator,
+  char ** output_topic_name)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_topic_name, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_compression_codec_is_valid(codec)) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  *output_topic_name =
+    rcutils_format_string(allocator, "%s/%s_compressed", topic_name, codec->name);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    *output_topic_name, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_compression_buffers_init(rcl_compression_buffers_t * buffers, rcl_allocator_t allocator)
+{
+  buffers->serialized_message = rmw_get_zero_initialized_serialized_message();
+  buffers->compressed_message = rmw_get_zero_initialized_serialized_message();
+  buffers->scratch = rmw_get_zero_initialized_serialized_message();
+  RCL_CLEAR_STALE_ERROR();
+  if (RMW_RET_OK != rmw_serialized_message_init(&buffers->serialized_message, 0u, &allocator) ||
+    RMW_RET_OK != rmw_serialized_message_init(&buffers->compressed_message, 0u, &allocator) ||
+    RMW_RET_OK != rmw_serialized_message_init(&buffers->scratch, 0u, &allocator))
+  {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    rcl_compression_buffers_fini(buffers);
+    return RCL_RET_BAD_ALLOC;
+  }
+  return RCL_RET_OK;
+}
+
+void
+rcl_compression_buffers_fini(rcl_compression_buffers_t * buffers)
+{
+  rcl_serialized_message_t * messages[] = {
+    &buffers->serialized_message, &buffers->compressed_message, &buffers->scratch};
+  for (size_t i = 0u; i < sizeof(messages) / sizeof(messages[0]); ++i) {
+    if (messages[i]->allocator.deallocate) {
+      (void)rmw_serialized_message_fini(messages[i]);
+    }
+    *messages[i] = rmw_get_zero_initialized_serialized_message();
+  }
+}
+
+rcl_ret_t
+rcl_compress_serialized_message(
+  const rcl_compression_codec_t * codec,
+  const rcl_serialized_message_t * input,
+  rcl_serialized_message_t * output,
+  rcl_serialized_message_t * scratch)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(input, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(scratch, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_compression_codec_is_valid(codec)) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  rcl_ret_t ret = _rcl_compression_reserve(
+    output, RCL_COMPRESSION_HEADER_SIZE + codec->compress_bound(input->buffer_length));
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  uint64_t size = (uint64_t)input->buffer_length;
+  for (size_t i = 0u; i < RCL_COMPRESSION_HEADER_SIZE; ++i, size >>= 8) {
+    output->buffer[i] = (uint8_t)(size & 0xffu);
+  }
+  size_t compressed_size = 0u;
+  ret = codec->compress(
+    input->buffer, input->buffer_length,
+    output->buffer + RCL_COMPRESSION_HEADER_SIZE,
+    output->buffer_capacity - RCL_COMPRESSION_HEADER_SIZE,
+    &compressed_size, scratch, codec->state);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  output->buffer_length = RCL_COMPRESSION_HEADER_SIZE + compressed_size;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_decompress_serialized_message(
+  const rcl_compression_codec_t * codec,
+  const rcl_serialized_message_t * input,
+  rcl_serialized_message_t * output,
+  rcl_serialized_message_t * scratch)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(input, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(scratch, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_compression_codec_is_valid(codec)) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  if (input->buffer_length < RCL_COMPRESSION_HEADER_SIZE) {
+    RCL_SET_ERROR_MSG("compressed message is shorter than its header");
+    return RCL_RET_ERROR;
+  }
+  uint64_t size = 0u;
+  for (size_t i = RCL_COMPRESSION_HEADER_SIZE; i > 0u; --i) {
+    size = (size << 8) | input->buffer[i - 1u];
+  }
+  // The header comes from the publisher, check it before reserving memory for it.
+  const size_t payload_size = input->buffer_length - RCL_COMPRESSION_HEADER_SIZE;
+  const size_t max_decompressed_size = 0u != codec->max_decompressed_size ?
+    codec->max_decompressed_size : RCL_COMPRESSION_DEFAULT_MAX_DECOMPRESSED_SIZE;
+  if (size > (uint64_t)codec->decompress_bound(payload_size) ||
+    size > (uint64_t)max_decompressed_size)
+  {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "compressed message announces %" PRIu64 " bytes, more than its payload of %zu "
+      "bytes can hold or than the codec accepts", size, payload_size);
+    return RCL_RET_ERROR;
+  }
+  rcl_ret_t ret = _rcl_compression_reserve(output, (size_t)size);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  size_t decompressed_size = 0u;
+  ret = codec->decompress(
+    input->buffer + RCL_COMPRESSION_HEADER_SIZE, payload_size,
+    output->buffer, (size_t)size, &decompressed_size, scratch, codec->state);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (decompressed_size != size) {
+    RCL_SET_ERROR_MSG("compressed message does not match the size in its header");
+    return RCL_RET_ERROR;
+  }
+  output->buffer_length = decompressed_size;
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,60 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__COMPRESSION_IMPL_H_
+#define RCL__COMPRESSION_IMPL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/allocator.h"
+#include "rcl/compression.h"
+#include "rcl/types.h"
+
+/// Buffers of a compressing publisher or decompressing subscription, reused between messages.
+/**
+ * They only grow, so once they fit the largest message, compressing and
+ * decompressing do not allocate.
+ */
+typedef struct rcl_compression_buffers_t
+{
+  /// The message serialized, before compression or after decompression.
+  rcl_serialized_message_t serialized_message;
+  /// The message compressed, as it goes through the rmw.
+  rcl_serialized_message_t compressed_message;
+  /// Working memory of the codec.
+  rcl_serialized_message_t scratch;
+} rcl_compression_buffers_t;
+
+/// Initialize empty buffers, which does not allocate.
+/**
+ * \param[out] buffers the buffers to initialize
+ * \param[in] allocator the allocator the buffers grow with
+ * \return #RCL_RET_OK if the buffers were initialized, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed.
+ */
+rcl_ret_t
+rcl_compression_buffers_init(rcl_compression_buffers_t * buffers, rcl_allocator_t allocator);
+
+/// Release the memory of the buffers, which may be zero initialized.
+void
+rcl_compression_buffers_fini(rcl_compression_buffers_t * buffers);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__COMPRESSION_IMPL_H_
@@ -0,0 +1,91 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/dispatch.h"
+
+#include <stdbool.h>
+
+#include "rcl/error_handling.h"
+
+rcl_dispatch_attributes_t
+rcl_dispatch_get_default_attributes(void)
+{
+  static rcl_dispatch_attributes_t default_attributes = {0, 0};
+  return default_attributes;
+}
+
+rcl_time_point_value_t
+rcl_dispatch_entry_get_deadline(const rcl_dispatch_entry_t * entry)
+{
+  if (entry->attributes.relative_deadline <= 0) {
+    return INT64_MAX;
+  }
+  if (entry->release_time > INT64_MAX - entry->attributes.relative_deadline) {
+    return INT64_MAX;
+  }
+  return entry->release_time + entry->attributes.relative_deadline;
+}
+
+/// Return true if entry a must be dispatched strictly before entry b.
+static bool
+_rcl_dispatch_precedes(
+  const rcl_dispatch_entry_t * a, const rcl_dispatch_entry_t * b, rcl_dispatch_policy_t policy)
+{
+  if (RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST == policy) {
+    rcl_time_point_value_t deadline_a = rcl_dispatch_entry_get_deadline(a);
+    rcl_time_point_value_t deadline_b = rcl_dispatch_entry_get_deadline(b);
+    if (deadline_a != deadline_b) {
+      return deadline_a < deadline_b;
+    }
+  }
+  return a->attributes.priority > b->attributes.priority;
+}
+
+rcl_ret_t
+rcl_dispatch_order(rcl_dispatch_entry_t * entries, size_t count, rcl_dispatch_policy_t policy)
+{
+  if (0u == count) {
+    return RCL_RET_OK;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(entries, RCL_RET_INVALID_ARGUMENT);
+  switch (policy) {
+    case RCL_DISPATCH_POLICY_ADDED_ORDER:
+      return RCL_RET_OK;
+    case RCL_DISPATCH_POLICY_FIXED_PRIORITY:
+    case RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST:
+      break;
+    default:
+      RCL_SET_ERROR_MSG("unknown dispatch policy");
+      return RCL_RET_INVALID_ARGUMENT;
+  }
+  for (size_t i = 1u; i < count; ++i) {
+    rcl_dispatch_entry_t entry = entries[i];
+    size_t j = i;
+    while (j > 0u && _rcl_dispatch_precedes(&entry, &entries[j - 1u], policy)) {
+      entries[j] = entries[j - 1u];
+      --j;
+    }
+    entries[j] = entry;
+  }
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,353 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/environment.h"
+
+#include <string.h>
+
+#include "rcl/domain_id.h"
+#include "rcl/error_handling.h"
+#include "rcl/localhost.h"
+#include "rcl/security.h"
+#include "rcutils/filesystem.h"
+#include "rcutils/get_env.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/strdup.h"
+
+#include "./environment_impl.h"
+#include "./security_impl.h"
+
+/// Secure root resolved for an enclave name.
+typedef struct rcl_environment_enclave_t
+{
+  char * name;
+  /// Secure root path, or `NULL` if it could not be built.
+  char * secure_root;
+  bool is_directory;
+  /// Next enclave resolved with the same snapshot.
+  struct rcl_environment_enclave_t * next;
+} rcl_environment_enclave_t;
+
+typedef struct rcl_environment_snapshot_t
+{
+  /// Kept first, so that the snapshot can be retrieved from the environment given to users.
+  rcl_environment_t environment;
+  /// Number of references, including the one held by g_snapshot while it is current.
+  size_t num_references;
+  rcl_allocator_t allocator;
+  /// Enclaves resolved with this snapshot, which are never modified once added.
+  rcl_environment_enclave_t * enclaves;
+} rcl_environment_snapshot_t;
+
+// Current snapshot of the process, kept until rcl_reload_environment() is called.
+static rcl_environment_snapshot_t * g_snapshot;
+// Guards g_snapshot, the reference counts and the enclave lists.
+static atomic_bool g_snapshot_locked;
+
+static void
+_lock_snapshot(void)
+{
+  // Only held to swap pointers and update counts, never while reading the environment or
+  // looking up the filesystem, so spinning is enough
+  while (rcutils_atomic_exchange_bool(&g_snapshot_locked, true)) {
+  }
+}
+
+static void
+_unlock_snapshot(void)
+{
+  rcutils_atomic_store(&g_snapshot_locked, false);
+}
+
+static rcl_ret_t
+_dupenv(const char * name, const rcl_allocator_t * allocator, const char ** value)
+{
+  const char * buffer = NULL;
+  const char * error = rcutils_get_env(name, &buffer);
+  if (NULL != error) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("failed to get %s: %s", name, error);
+    return RCL_RET_ERROR;
+  }
+  *value = NULL;
+  if (0 != strcmp("", buffer)) {
+    *value = rcutils_strdup(buffer, *allocator);
+    RCL_CHECK_FOR_NULL_WITH_MSG(*value, "string duplication failed", return RCL_RET_BAD_ALLOC);
+  }
+  return RCL_RET_OK;
+}
+
+static void
+_fini_enclave(rcl_environment_enclave_t * enclave, const rcl_allocator_t * allocator)
+{
+  allocator->deallocate(enclave->name, allocator->state);
+  allocator->deallocate(enclave->secure_root, allocator->state);
+  allocator->deallocate(enclave, allocator->state);
+}
+
+static void
+_fini_snapshot(rcl_environment_snapshot_t * snapshot)
+{
+  rcl_allocator_t allocator = snapshot->allocator;
+  allocator.deallocate((char *)snapshot->environment.security_keystore, allocator.state);
+  allocator.deallocate((char *)snapshot->environment.security_enclave_override, allocator.state);
+  rcl_environment_enclave_t * enclave = snapshot->enclaves;
+  while (NULL != enclave) {
+    rcl_environment_enclave_t * next = enclave->next;
+    _fini_enclave(enclave, &allocator);
+    enclave = next;
+  }
+  allocator.deallocate(snapshot, allocator.state);
+}
+
+/// Read the environment into a new snapshot, with the given number of references.
+static rcl_ret_t
+_init_snapshot(size_t num_references, rcl_environment_snapshot_t ** snapshot)
+{
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_environment_snapshot_t * new_snapshot =
+    allocator.zero_allocate(1u, sizeof(rcl_environment_snapshot_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    new_snapshot, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  new_snapshot->allocator = allocator;
+  new_snapshot->num_references = num_references;
+
+  rcl_environment_t * environment = &new_snapshot->environment;
+  environment->domain_id = RCL_DEFAULT_DOMAIN_ID;
+  rcl_ret_t ret = rcl_get_default_domain_id(&environment->domain_id);
+  if (RCL_RET_OK == ret) {
+    ret = rcl_get_localhost_only(&environment->localhost_only);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_security_enabled(&environment->security_enabled);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_get_enforcement_policy(&environment->security_enforcement);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = _dupenv(
+      ROS_SECURITY_KEYSTORE_VAR_NAME, &allocator, &environment->security_keystore);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = _dupenv(
+      ROS_SECURITY_ENCLAVE_OVERRIDE, &allocator, &environment->security_enclave_override);
+  }
+  if (RCL_RET_OK != ret) {
+    _fini_snapshot(new_snapshot);
+    return ret;  // error already set
+  }
+  *snapshot = new_snapshot;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_get_environment(const rcl_environment_t ** environment)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(environment, RCL_RET_INVALID_ARGUMENT);
+  _lock_snapshot();
+  rcl_environment_snapshot_t * snapshot = g_snapshot;
+  if (NULL != snapshot) {
+    ++snapshot->num_references;
+  }
+  _unlock_snapshot();
+
+  if (NULL == snapshot) {
+    // Read the environment without holding the lock, with a reference for the caller and
+    // one for g_snapshot, and only publish it if no other thread did in the meantime.
+    rcl_ret_t ret = _init_snapshot(2u, &snapshot);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    rcl_environment_snapshot_t * unused_snapshot = NULL;
+    _lock_snapshot();
+    if (NULL == g_snapshot) {
+      g_snapshot = snapshot;
+    } else {
+      unused_snapshot = snapshot;
+      snapshot = g_snapshot;
+      ++snapshot->num_references;
+    }
+    _unlock_snapshot();
+    if (NULL != unused_snapshot) {
+      _fini_snapshot(unused_snapshot);
+    } else {
+      RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Captured environment snapshot");
+    }
+  }
+  *environment = &snapshot->environment;
+  return RCL_RET_OK;
+}
+
+void
+rcl_release_environment(const rcl_environment_t * environment)
+{
+  if (NULL == environment) {
+    return;
+  }
+  rcl_environment_snapshot_t * snapshot = (rcl_environment_snapshot_t *)environment;
+  _lock_snapshot();
+  const bool is_last_reference = 0u == --snapshot->num_references;
+  _unlock_snapshot();
+  if (is_last_reference) {
+    RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Discarding environment snapshot");
+    _fini_snapshot(snapshot);
+  }
+}
+
+void
+rcl_reload_environment(void)
+{
+  _lock_snapshot();
+  rcl_environment_snapshot_t * snapshot = g_snapshot;
+  g_snapshot = NULL;
+  _unlock_snapshot();
+  if (NULL != snapshot) {
+    rcl_release_environment(&snapshot->environment);
+  }
+}
+
+/// Find a resolved enclave of a snapshot, with the lock held.
+static const rcl_environment_enclave_t *
+_find_enclave(const rcl_environment_snapshot_t * snapshot, const char * name)
+{
+  for (const rcl_environment_enclave_t * enclave = snapshot->enclaves;
+    NULL != enclave; enclave = enclave->next)
+  {
+    if (0 == strcmp(enclave->name, name)) {
+      return enclave;
+    }
+  }
+  return NULL;
+}
+
+/// Find the resolved enclave of a name, resolving and adding it to the snapshot if needed.
+static const rcl_environment_enclave_t *
+_get_enclave(rcl_environment_snapshot_t * snapshot, const char * name)
+{
+  _lock_snapshot();
+  const rcl_environment_enclave_t * enclave = _find_enclave(snapshot, name);
+  _unlock_snapshot();
+  if (NULL != enclave) {
+    return enclave;
+  }
+
+  // Look the enclave up without holding the lock, and only add it if no other thread did
+  // in the meantime.
+  rcl_allocator_t * allocator = &snapshot->allocator;
+  rcl_environment_enclave_t * new_enclave =
+    allocator->zero_allocate(1u, sizeof(rcl_environment_enclave_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(new_enclave, "allocating memory failed", return NULL);
+  new_enclave->name = rcutils_strdup(name, *allocator);
+  if (NULL == new_enclave->name) {
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    _fini_enclave(new_enclave, allocator);
+    return NULL;
+  }
+  new_enclave->secure_root =
+    exact_match_lookup(name, snapshot->environment.security_keystore, allocator);
+  new_enclave->is_directory =
+    NULL != new_enclave->secure_root && rcutils_is_directory(new_enclave->secure_root);
+
+  _lock_snapshot();
+  enclave = _find_enclave(snapshot, name);
+  if (NULL == enclave) {
+    new_enclave->next = snapshot->enclaves;
+    snapshot->enclaves = new_enclave;
+    enclave = new_enclave;
+    new_enclave = NULL;
+  }
+  _unlock_snapshot();
+  if (NULL != new_enclave) {
+    _fini_enclave(new_enclave, allocator);
+  }
+  return enclave;
+}
+
+rcl_ret_t
+rcl_environment_get_security_options(
+  const rcl_environment_t * environment,
+  const char * name,
+  const rcl_allocator_t * allocator,
+  rmw_security_options_t * security_options)
+{
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Using security: %s", environment->security_enabled ? "true" : "false");
+
+  if (!environment->security_enabled) {
+    security_options->enforce_security = RMW_SECURITY_ENFORCEMENT_PERMISSIVE;
+    return RCL_RET_OK;
+  }
+  security_options->enforce_security = environment->security_enforcement;
+
+  char * secure_root = NULL;
+  if (NULL != environment->security_keystore) {
+    const char * lookup_name = environment->security_enclave_override ?
+      environment->security_enclave_override : name;
+    const rcl_environment_enclave_t * enclave =
+      _get_enclave((rcl_environment_snapshot_t *)environment, lookup_name);
+    if (NULL == enclave) {
+      return RCL_RET_BAD_ALLOC;  // error already set
+    }
+    if (NULL == enclave->secure_root) {
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "SECURITY ERROR: unable to find a folder matching the name '%s' in '%s'. ",
+        name, environment->security_keystore);
+    } else if (!enclave->is_directory) {
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "SECURITY ERROR: directory '%s' does not exist.", enclave->secure_root);
+    } else {
+      secure_root = rcutils_strdup(enclave->secure_root, *allocator);
+      RCL_CHECK_FOR_NULL_WITH_MSG(
+        secure_root, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    }
+  }
+
+  if (secure_root) {
+    RCUTILS_LOG_INFO_NAMED(ROS_PACKAGE_NAME, "Found security directory: %s", secure_root);
+    security_options->security_root_path = secure_root;
+  } else {
+    if (RMW_SECURITY_ENFORCEMENT_ENFORCE == security_options->enforce_security) {
+      return RCL_RET_ERROR;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_get_security_options_from_environment_snapshot(
+  const char * name,
+  const rcl_allocator_t * allocator,
+  rmw_security_options_t * security_options)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(security_options, RCL_RET_INVALID_ARGUMENT);
+  const rcl_environment_t * environment = NULL;
+  rcl_ret_t ret = rcl_get_environment(&environment);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  ret = rcl_environment_get_security_options(environment, name, allocator, security_options);
+  rcl_release_environment(environment);
+  return ret;
+}
+
+#ifdef __cplusplus
+}
+#endif
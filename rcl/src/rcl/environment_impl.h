@@ -0,0 +1,51 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ENVIRONMENT_IMPL_H_
+#define RCL__ENVIRONMENT_IMPL_H_
+
+#include "rcl/environment.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Initialize security options from a given environment snapshot and enclave name.
+/**
+ * This is rcl_get_security_options_from_environment_snapshot() for a
+ * snapshot the caller already holds, so that all the settings of a context
+ * come from the same snapshot.
+ *
+ * \param[in] environment a snapshot returned by rcl_get_environment()
+ * \param[in] name name used to find the security root path
+ * \param[in] allocator used to allocate the security root path
+ * \param[out] security_options security options that will be configured according to
+ *  the snapshot
+ * \return #RCL_RET_OK If the security options are returned properly, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed, or
+ * \return #RCL_RET_ERROR if an unexpected error happened
+ */
+rcl_ret_t
+rcl_environment_get_security_options(
+  const rcl_environment_t * environment,
+  const char * name,
+  const rcl_allocator_t * allocator,
+  rmw_security_options_t * security_options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ENVIRONMENT_IMPL_H_
@@ -23,6 +23,7 @@ extern "C"
 
 #include "rcl/error_handling.h"
 #include "rcl/expand_topic_name.h"
+#include "rcl/node.h"
 #include "rcl/remap.h"
 #include "rcutils/allocator.h"
 #include "rcutils/logging_macros.h"
@@ -157,9 +158,10 @@ rcl_take_event(
     return RCL_RET_EVENT_INVALID;
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(event_info, RCL_RET_INVALID_ARGUMENT);
+  RCL_CLEAR_STALE_ERROR();
   rmw_ret_t ret = rmw_take_event(&event->impl->rmw_handle, event_info, &taken);
   if (RMW_RET_OK != ret) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return rcl_convert_rmw_ret_to_rcl_ret(ret);
   }
   if (!taken) {
@@ -181,9 +183,10 @@ rcl_event_fini(rcl_event_t * event)
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Finalizing event");
   if (NULL != event->impl) {
     rcl_allocator_t allocator = event->impl->allocator;
+    RCL_CLEAR_STALE_ERROR();
     rmw_ret_t ret = rmw_event_fini(&event->impl->rmw_handle);
     if (ret != RMW_RET_OK) {
-      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      RCL_SET_ERROR_MSG_FROM_RMW();
       result = rcl_convert_rmw_ret_to_rcl_ret(ret);
     }
     allocator.deallocate(event->impl, allocator.state);
@@ -218,6 +221,252 @@ rcl_event_is_valid(const rcl_event_t * event)
   return true;
 }
 
+typedef struct rcl_event_group_member_t
+{
+  rcl_event_t event;
+  /// Publisher or subscription the event belongs to.
+  const void * entity;
+  bool is_publisher;
+} rcl_event_group_member_t;
+
+typedef struct rcl_event_group_impl_t
+{
+  rcl_allocator_t allocator;
+  /// Rmw handle of the node the endpoints of the group must belong to.
+  const rmw_node_t * rmw_node_handle;
+  rcl_event_group_member_t * members;
+  size_t size;
+  size_t capacity;
+  /// Index of the member polled first by the next take.
+  size_t next;
+} rcl_event_group_impl_t;
+
+rcl_event_group_t
+rcl_get_zero_initialized_event_group()
+{
+  static rcl_event_group_t null_group = {0};
+  return null_group;
+}
+
+rcl_ret_t
+rcl_event_group_init(
+  rcl_event_group_t * group,
+  const rcl_node_t * node)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != group->impl) {
+    RCL_SET_ERROR_MSG("event group already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  const rcl_node_options_t * node_options = rcl_node_get_options(node);
+  if (NULL == node_options) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  const rcl_allocator_t * allocator = &node_options->allocator;
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+
+  group->impl = (rcl_event_group_impl_t *) allocator->zero_allocate(
+    1, sizeof(rcl_event_group_impl_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  group->impl->allocator = *allocator;
+  group->impl->rmw_node_handle = rcl_node_get_rmw_handle(node);
+  return RCL_RET_OK;
+}
+
+/// Make room for one more member, returning it or `NULL` on failure.
+static rcl_event_group_member_t *
+_rcl_event_group_next_member(rcl_event_group_t * group)
+{
+  rcl_event_group_impl_t * impl = group->impl;
+  if (impl->size == impl->capacity) {
+    size_t capacity = 0u == impl->capacity ? 4u : 2u * impl->capacity;
+    rcl_event_group_member_t * members = (rcl_event_group_member_t *)
+      impl->allocator.reallocate(
+      impl->members, capacity * sizeof(rcl_event_group_member_t), impl->allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(members, "allocating memory failed", return NULL);
+    impl->members = members;
+    impl->capacity = capacity;
+  }
+  rcl_event_group_member_t * member = &impl->members[impl->size];
+  member->event = rcl_get_zero_initialized_event();
+  return member;
+}
+
+rcl_ret_t
+rcl_event_group_add_publisher_event(
+  rcl_event_group_t * group,
+  const rcl_publisher_t * publisher,
+  const rcl_publisher_event_type_t event_type)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "event group is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(publisher, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  if (publisher->impl->rmw_node_handle != group->impl->rmw_node_handle) {
+    RCL_SET_ERROR_MSG("publisher does not belong to the node of the event group");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_event_group_member_t * member = _rcl_event_group_next_member(group);
+  if (NULL == member) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  rcl_ret_t ret = rcl_publisher_event_init(&member->event, publisher, event_type);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  member->entity = publisher;
+  member->is_publisher = true;
+  ++group->impl->size;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_event_group_add_subscription_event(
+  rcl_event_group_t * group,
+  const rcl_subscription_t * subscription,
+  const rcl_subscription_event_type_t event_type)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "event group is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  if (subscription->impl->rmw_node_handle != group->impl->rmw_node_handle) {
+    RCL_SET_ERROR_MSG("subscription does not belong to the node of the event group");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_event_group_member_t * member = _rcl_event_group_next_member(group);
+  if (NULL == member) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  rcl_ret_t ret = rcl_subscription_event_init(&member->event, subscription, event_type);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  member->entity = subscription;
+  member->is_publisher = false;
+  ++group->impl->size;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_event_group_remove(
+  rcl_event_group_t * group,
+  const void * entity)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "event group is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(entity, RCL_RET_INVALID_ARGUMENT);
+  rcl_event_group_impl_t * impl = group->impl;
+  rcl_ret_t result = RCL_RET_OK;
+  size_t kept = 0u;
+  for (size_t i = 0u; i < impl->size; ++i) {
+    if (impl->members[i].entity != entity) {
+      impl->members[kept++] = impl->members[i];
+    } else if (RCL_RET_OK != rcl_event_fini(&impl->members[i].event)) {
+      result = RCL_RET_ERROR;  // error already set
+    }
+  }
+  impl->size = kept;
+  if (impl->next >= impl->size) {
+    impl->next = 0u;
+  }
+  return result;
+}
+
+/// Check whether a status taken from an event reports any change.
+static bool
+_rcl_event_status_changed(rmw_event_type_t event_type, const rcl_event_group_status_t * status)
+{
+  switch (event_type) {
+    case RMW_EVENT_LIVELINESS_CHANGED:
+      return 0 != status->status.liveliness_changed.alive_count_change ||
+             0 != status->status.liveliness_changed.not_alive_count_change;
+    case RMW_EVENT_REQUESTED_DEADLINE_MISSED:
+      return 0 != status->status.requested_deadline_missed.total_count_change;
+    case RMW_EVENT_REQUESTED_QOS_INCOMPATIBLE:
+      return 0 != status->status.requested_incompatible_qos.total_count_change;
+    case RMW_EVENT_MESSAGE_LOST:
+      return 0u != status->status.message_lost.total_count_change;
+    case RMW_EVENT_LIVELINESS_LOST:
+      return 0 != status->status.liveliness_lost.total_count_change;
+    case RMW_EVENT_OFFERED_DEADLINE_MISSED:
+      return 0 != status->status.offered_deadline_missed.total_count_change;
+    case RMW_EVENT_OFFERED_QOS_INCOMPATIBLE:
+      return 0 != status->status.offered_incompatible_qos.total_count_change;
+    default:
+      return false;
+  }
+}
+
+rcl_ret_t
+rcl_event_group_take(
+  rcl_event_group_t * group,
+  rcl_event_group_status_t * statuses,
+  size_t count,
+  size_t * taken)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0u;
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "event group is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(statuses, RCL_RET_INVALID_ARGUMENT);
+  rcl_event_group_impl_t * impl = group->impl;
+  for (size_t polled = 0u; polled < impl->size && *taken < count; ++polled) {
+    const rcl_event_group_member_t * member = &impl->members[impl->next];
+    impl->next = (impl->next + 1u) % impl->size;
+    const rmw_event_t * rmw_handle = &member->event.impl->rmw_handle;
+    rcl_event_group_status_t * status = &statuses[*taken];
+    bool event_taken = false;
+    RCL_CLEAR_STALE_ERROR();
+    rmw_ret_t ret = rmw_take_event(rmw_handle, &status->status, &event_taken);
+    if (RMW_RET_OK != ret) {
+      RCL_SET_ERROR_MSG_FROM_RMW();
+      return rcl_convert_rmw_ret_to_rcl_ret(ret);
+    }
+    if (!event_taken || !_rcl_event_status_changed(rmw_handle->event_type, status)) {
+      continue;
+    }
+    status->publisher = member->is_publisher ? member->entity : NULL;
+    status->subscription = member->is_publisher ? NULL : member->entity;
+    status->event_type = rmw_handle->event_type;
+    ++(*taken);
+  }
+  if (0u == *taken) {
+    RCUTILS_LOG_DEBUG_NAMED(
+      ROS_PACKAGE_NAME, "event group take request complete, no status changed");
+    return RCL_RET_EVENT_TAKE_FAILED;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_event_group_fini(rcl_event_group_t * group)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t result = RCL_RET_OK;
+  if (NULL != group->impl) {
+    rcl_allocator_t allocator = group->impl->allocator;
+    for (size_t i = 0u; i < group->impl->size; ++i) {
+      if (RCL_RET_OK != rcl_event_fini(&group->impl->members[i].event)) {
+        result = RCL_RET_ERROR;  // error already set
+      }
+    }
+    allocator.deallocate(group->impl->members, allocator.state);
+    allocator.deallocate(group->impl, allocator.state);
+    group->impl = NULL;
+  }
+  return result;
+}
+
 #ifdef __cplusplus
 }
 #endif
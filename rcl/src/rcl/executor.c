@@ -0,0 +1,746 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/executor.h"
+
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+
+typedef enum rcl_executor_handle_type_e
+{
+  RCL_EXECUTOR_HANDLE_SUBSCRIPTION,
+  RCL_EXECUTOR_HANDLE_TIMER,
+  RCL_EXECUTOR_HANDLE_SERVICE,
+  RCL_EXECUTOR_HANDLE_CLIENT,
+  RCL_EXECUTOR_HANDLE_GUARD_CONDITION,
+  RCL_EXECUTOR_HANDLE_WAITABLE
+} rcl_executor_handle_type_t;
+
+typedef struct rcl_executor_handle_t
+{
+  rcl_executor_handle_type_t type;
+  union
+  {
+    rcl_subscription_t * subscription;
+    rcl_timer_t * timer;
+    rcl_service_t * service;
+    rcl_client_t * client;
+    rcl_guard_condition_t * guard_condition;
+  } entity;
+  union
+  {
+    rcl_executor_subscription_callback_t subscription;
+    rcl_executor_service_callback_t service;
+    rcl_executor_client_callback_t client;
+    rcl_executor_guard_condition_callback_t guard_condition;
+  } callback;
+  rcl_executor_waitable_t waitable;
+  // Message, request or response storage the data is taken into.
+  void * data;
+  // Response storage of a service.
+  void * response;
+  void * context;
+  rmw_request_id_t request_header;
+  // Information of the taken message, or request of a service.
+  rmw_message_info_t message_info;
+  rmw_service_info_t service_info;
+  // Index of the entity in the wait set, set on every spin.
+  size_t index;
+  // Whether data was taken for the callback.
+  bool is_taken;
+} rcl_executor_handle_t;
+
+typedef struct rcl_executor_impl_t
+{
+  rcl_executor_options_t options;
+  rcl_context_t * context;
+  rcl_executor_handle_t * handles;
+  // Readiness of the handles after the last wait, in table order.
+  bool * is_ready;
+  // The ready handles in dispatch order, at most one entry per handle.
+  rcl_dispatch_entry_t * order;
+  size_t capacity;
+  size_t size;
+  rcl_wait_set_t wait_set;
+  // Set when handles were added since the wait set was sized.
+  bool is_wait_set_stale;
+} rcl_executor_impl_t;
+
+rcl_executor_t
+rcl_get_zero_initialized_executor(void)
+{
+  static rcl_executor_t null_executor = {0};
+  return null_executor;
+}
+
+rcl_executor_options_t
+rcl_executor_get_default_options(void)
+{
+  static rcl_executor_options_t default_options;
+  default_options.trigger = RCL_EXECUTOR_TRIGGER_ANY;
+  default_options.trigger_predicate = NULL;
+  default_options.trigger_context = NULL;
+  default_options.semantics = RCL_EXECUTOR_SEMANTICS_TAKE_AND_EXECUTE;
+  default_options.dispatch_policy = RCL_DISPATCH_POLICY_ADDED_ORDER;
+  default_options.allocator = rcl_get_default_allocator();
+  return default_options;
+}
+
+rcl_ret_t
+rcl_executor_init(
+  rcl_executor_t * executor,
+  rcl_context_t * context,
+  size_t number_of_handles,
+  const rcl_executor_options_t * options)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+  const rcl_allocator_t * allocator = &options->allocator;
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (executor->impl) {
+    RCL_SET_ERROR_MSG("executor already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (0u == number_of_handles) {
+    RCL_SET_ERROR_MSG("number_of_handles must be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (RCL_EXECUTOR_TRIGGER_PREDICATE == options->trigger && !options->trigger_predicate) {
+    RCL_SET_ERROR_MSG("trigger_predicate is required with RCL_EXECUTOR_TRIGGER_PREDICATE");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (
+    RCL_DISPATCH_POLICY_ADDED_ORDER != options->dispatch_policy &&
+    RCL_DISPATCH_POLICY_FIXED_PRIORITY != options->dispatch_policy &&
+    RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST != options->dispatch_policy)
+  {
+    RCL_SET_ERROR_MSG("unknown dispatch policy");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rcl_executor_impl_t * impl = (rcl_executor_impl_t *)allocator->zero_allocate(
+    1u, sizeof(rcl_executor_impl_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  impl->handles = (rcl_executor_handle_t *)allocator->zero_allocate(
+    number_of_handles, sizeof(rcl_executor_handle_t), allocator->state);
+  impl->is_ready = (bool *)allocator->zero_allocate(
+    number_of_handles, sizeof(bool), allocator->state);
+  impl->order = (rcl_dispatch_entry_t *)allocator->zero_allocate(
+    number_of_handles, sizeof(rcl_dispatch_entry_t), allocator->state);
+  if (!impl->handles || !impl->is_ready || !impl->order) {
+    allocator->deallocate(impl->handles, allocator->state);
+    allocator->deallocate(impl->is_ready, allocator->state);
+    allocator->deallocate(impl->order, allocator->state);
+    allocator->deallocate(impl, allocator->state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  impl->options = *options;
+  impl->context = context;
+  impl->capacity = number_of_handles;
+  impl->size = 0u;
+  impl->wait_set = rcl_get_zero_initialized_wait_set();
+  impl->is_wait_set_stale = true;
+  executor->impl = impl;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_executor_fini(rcl_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rcl_executor_impl_t * impl = executor->impl;
+  if (!impl) {
+    return RCL_RET_OK;
+  }
+  rcl_ret_t ret = RCL_RET_OK;
+  if (rcl_wait_set_is_valid(&impl->wait_set)) {
+    ret = rcl_wait_set_fini(&impl->wait_set);
+  }
+  rcl_allocator_t allocator = impl->options.allocator;
+  allocator.deallocate(impl->handles, allocator.state);
+  allocator.deallocate(impl->is_ready, allocator.state);
+  allocator.deallocate(impl->order, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  executor->impl = NULL;
+  return ret;
+}
+
+/// Return the next free handle of the table, or NULL with the error set.
+static rcl_executor_handle_t *
+_rcl_executor_add_handle(rcl_executor_t * executor, rcl_executor_handle_type_t type)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(executor, "executor argument is null", return NULL);
+  rcl_executor_impl_t * impl = executor->impl;
+  RCL_CHECK_FOR_NULL_WITH_MSG(impl, "executor is not initialized", return NULL);
+  if (impl->size == impl->capacity) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "executor handle table is full, capacity is %zu", impl->capacity);
+    return NULL;
+  }
+  rcl_executor_handle_t * handle = &impl->handles[impl->size];
+  memset(handle, 0, sizeof(rcl_executor_handle_t));
+  handle->type = type;
+  return handle;
+}
+
+/// Make the handle returned by _rcl_executor_add_handle() part of the table.
+static void
+_rcl_executor_commit_handle(rcl_executor_t * executor)
+{
+  ++executor->impl->size;
+  executor->impl->is_wait_set_stale = true;
+}
+
+rcl_ret_t
+rcl_executor_add_subscription(
+  rcl_executor_t * executor,
+  rcl_subscription_t * subscription,
+  void * message,
+  rcl_executor_subscription_callback_t callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(subscription, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(message, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rcl_executor_handle_t * handle =
+    _rcl_executor_add_handle(executor, RCL_EXECUTOR_HANDLE_SUBSCRIPTION);
+  if (!handle) {
+    return executor && executor->impl ? RCL_RET_ERROR : RCL_RET_INVALID_ARGUMENT;
+  }
+  handle->entity.subscription = subscription;
+  handle->data = message;
+  handle->callback.subscription = callback;
+  handle->context = context;
+  _rcl_executor_commit_handle(executor);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_executor_add_timer(
+  rcl_executor_t * executor,
+  rcl_timer_t * timer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  rcl_executor_handle_t * handle = _rcl_executor_add_handle(executor, RCL_EXECUTOR_HANDLE_TIMER);
+  if (!handle) {
+    return executor && executor->impl ? RCL_RET_ERROR : RCL_RET_INVALID_ARGUMENT;
+  }
+  handle->entity.timer = timer;
+  _rcl_executor_commit_handle(executor);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_executor_add_service(
+  rcl_executor_t * executor,
+  rcl_service_t * service,
+  void * request,
+  void * response,
+  rcl_executor_service_callback_t callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(request, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rcl_executor_handle_t * handle = _rcl_executor_add_handle(executor, RCL_EXECUTOR_HANDLE_SERVICE);
+  if (!handle) {
+    return executor && executor->impl ? RCL_RET_ERROR : RCL_RET_INVALID_ARGUMENT;
+  }
+  handle->entity.service = service;
+  handle->data = request;
+  handle->response = response;
+  handle->callback.service = callback;
+  handle->context = context;
+  _rcl_executor_commit_handle(executor);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_executor_add_client(
+  rcl_executor_t * executor,
+  rcl_client_t * client,
+  void * response,
+  rcl_executor_client_callback_t callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(response, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rcl_executor_handle_t * handle = _rcl_executor_add_handle(executor, RCL_EXECUTOR_HANDLE_CLIENT);
+  if (!handle) {
+    return executor && executor->impl ? RCL_RET_ERROR : RCL_RET_INVALID_ARGUMENT;
+  }
+  handle->entity.client = client;
+  handle->data = response;
+  handle->callback.client = callback;
+  handle->context = context;
+  _rcl_executor_commit_handle(executor);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_executor_add_guard_condition(
+  rcl_executor_t * executor,
+  rcl_guard_condition_t * guard_condition,
+  rcl_executor_guard_condition_callback_t callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  rcl_executor_handle_t * handle =
+    _rcl_executor_add_handle(executor, RCL_EXECUTOR_HANDLE_GUARD_CONDITION);
+  if (!handle) {
+    return executor && executor->impl ? RCL_RET_ERROR : RCL_RET_INVALID_ARGUMENT;
+  }
+  handle->entity.guard_condition = guard_condition;
+  handle->callback.guard_condition = callback;
+  handle->context = context;
+  _rcl_executor_commit_handle(executor);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_executor_add_waitable(
+  rcl_executor_t * executor,
+  const rcl_executor_waitable_t * waitable)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(waitable, RCL_RET_INVALID_ARGUMENT);
+  if (
+    !waitable->get_number_of_entities || !waitable->add_to_wait_set ||
+    !waitable->is_ready || !waitable->execute)
+  {
+    RCL_SET_ERROR_MSG("waitable functions must all be set");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_executor_handle_t * handle =
+    _rcl_executor_add_handle(executor, RCL_EXECUTOR_HANDLE_WAITABLE);
+  if (!handle) {
+    return executor && executor->impl ? RCL_RET_ERROR : RCL_RET_INVALID_ARGUMENT;
+  }
+  handle->waitable = *waitable;
+  _rcl_executor_commit_handle(executor);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_executor_prepare(rcl_executor_t * executor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  rcl_executor_impl_t * impl = executor->impl;
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    impl, "executor is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  if (!impl->is_wait_set_stale) {
+    return RCL_RET_OK;
+  }
+  if (0u == impl->size) {
+    RCL_SET_ERROR_MSG("executor has no handles");
+    return RCL_RET_ERROR;
+  }
+  size_t number_of_subscriptions = 0u;
+  size_t number_of_guard_conditions = 0u;
+  size_t number_of_timers = 0u;
+  size_t number_of_clients = 0u;
+  size_t number_of_services = 0u;
+  rcl_ret_t ret = RCL_RET_OK;
+  for (size_t i = 0u; i < impl->size; ++i) {
+    rcl_executor_handle_t * handle = &impl->handles[i];
+    switch (handle->type) {
+      case RCL_EXECUTOR_HANDLE_SUBSCRIPTION:
+        ++number_of_subscriptions;
+        break;
+      case RCL_EXECUTOR_HANDLE_TIMER:
+        ++number_of_timers;
+        break;
+      case RCL_EXECUTOR_HANDLE_SERVICE:
+        ++number_of_services;
+        break;
+      case RCL_EXECUTOR_HANDLE_CLIENT:
+        ++number_of_clients;
+        break;
+      case RCL_EXECUTOR_HANDLE_GUARD_CONDITION:
+        ++number_of_guard_conditions;
+        break;
+      case RCL_EXECUTOR_HANDLE_WAITABLE:
+        {
+          size_t subscriptions = 0u;
+          size_t guard_conditions = 0u;
+          size_t timers = 0u;
+          size_t clients = 0u;
+          size_t services = 0u;
+          ret = handle->waitable.get_number_of_entities(
+            handle->waitable.data, &subscriptions, &guard_conditions, &timers, &clients,
+            &services);
+          if (RCL_RET_OK != ret) {
+            return ret;  // error already set
+          }
+          number_of_subscriptions += subscriptions;
+          number_of_guard_conditions += guard_conditions;
+          number_of_timers += timers;
+          number_of_clients += clients;
+          number_of_services += services;
+        }
+        break;
+    }
+  }
+  // The rmw wait set is sized on creation, so it cannot simply be resized.
+  if (rcl_wait_set_is_valid(&impl->wait_set)) {
+    ret = rcl_wait_set_fini(&impl->wait_set);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  ret = rcl_wait_set_init(
+    &impl->wait_set, number_of_subscriptions, number_of_guard_conditions, number_of_timers,
+    number_of_clients, number_of_services, 0u, impl->context, impl->options.allocator);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  impl->is_wait_set_stale = false;
+  return RCL_RET_OK;
+}
+
+static rcl_ret_t
+_rcl_executor_add_to_wait_set(rcl_executor_handle_t * handle, rcl_wait_set_t * wait_set)
+{
+  switch (handle->type) {
+    case RCL_EXECUTOR_HANDLE_SUBSCRIPTION:
+      return rcl_wait_set_add_subscription(
+        wait_set, handle->entity.subscription, &handle->index);
+    case RCL_EXECUTOR_HANDLE_TIMER:
+      return rcl_wait_set_add_timer(wait_set, handle->entity.timer, &handle->index);
+    case RCL_EXECUTOR_HANDLE_SERVICE:
+      return rcl_wait_set_add_service(wait_set, handle->entity.service, &handle->index);
+    case RCL_EXECUTOR_HANDLE_CLIENT:
+      return rcl_wait_set_add_client(wait_set, handle->entity.client, &handle->index);
+    case RCL_EXECUTOR_HANDLE_GUARD_CONDITION:
+      return rcl_wait_set_add_guard_condition(
+        wait_set, handle->entity.guard_condition, &handle->index);
+    case RCL_EXECUTOR_HANDLE_WAITABLE:
+      return handle->waitable.add_to_wait_set(handle->waitable.data, wait_set);
+  }
+  RCL_SET_ERROR_MSG("unknown executor handle type");
+  return RCL_RET_ERROR;
+}
+
+static rcl_ret_t
+_rcl_executor_is_ready(
+  rcl_executor_handle_t * handle, const rcl_wait_set_t * wait_set, bool * is_ready)
+{
+  switch (handle->type) {
+    case RCL_EXECUTOR_HANDLE_SUBSCRIPTION:
+      *is_ready = NULL != wait_set->subscriptions[handle->index];
+      return RCL_RET_OK;
+    case RCL_EXECUTOR_HANDLE_TIMER:
+      *is_ready = NULL != wait_set->timers[handle->index];
+      return RCL_RET_OK;
+    case RCL_EXECUTOR_HANDLE_SERVICE:
+      *is_ready = NULL != wait_set->services[handle->index];
+      return RCL_RET_OK;
+    case RCL_EXECUTOR_HANDLE_CLIENT:
+      *is_ready = NULL != wait_set->clients[handle->index];
+      return RCL_RET_OK;
+    case RCL_EXECUTOR_HANDLE_GUARD_CONDITION:
+      *is_ready = NULL != wait_set->guard_conditions[handle->index];
+      return RCL_RET_OK;
+    case RCL_EXECUTOR_HANDLE_WAITABLE:
+      return handle->waitable.is_ready(handle->waitable.data, wait_set, is_ready);
+  }
+  RCL_SET_ERROR_MSG("unknown executor handle type");
+  return RCL_RET_ERROR;
+}
+
+/// Take the data of a ready handle, nothing to take is not an error.
+static rcl_ret_t
+_rcl_executor_take(rcl_executor_handle_t * handle)
+{
+  rcl_ret_t ret = RCL_RET_OK;
+  switch (handle->type) {
+    case RCL_EXECUTOR_HANDLE_SUBSCRIPTION:
+      ret = rcl_take(handle->entity.subscription, handle->data, &handle->message_info, NULL);
+      if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+        handle->is_taken = false;
+        return RCL_RET_OK;
+      }
+      break;
+    case RCL_EXECUTOR_HANDLE_SERVICE:
+      ret = rcl_take_request_with_info(
+        handle->entity.service, &handle->service_info, handle->data);
+      if (RCL_RET_SERVICE_TAKE_FAILED == ret) {
+        handle->is_taken = false;
+        return RCL_RET_OK;
+      }
+      handle->request_header = handle->service_info.request_id;
+      break;
+    case RCL_EXECUTOR_HANDLE_CLIENT:
+      ret = rcl_take_response(handle->entity.client, &handle->request_header, handle->data);
+      if (RCL_RET_CLIENT_TAKE_FAILED == ret) {
+        handle->is_taken = false;
+        return RCL_RET_OK;
+      }
+      break;
+    case RCL_EXECUTOR_HANDLE_TIMER:
+    case RCL_EXECUTOR_HANDLE_GUARD_CONDITION:
+    case RCL_EXECUTOR_HANDLE_WAITABLE:
+      // Taken and executed in one step.
+      break;
+  }
+  handle->is_taken = RCL_RET_OK == ret;
+  return ret;
+}
+
+static rcl_ret_t
+_rcl_executor_execute(rcl_executor_handle_t * handle)
+{
+  if (!handle->is_taken) {
+    return RCL_RET_OK;
+  }
+  handle->is_taken = false;
+  rcl_ret_t ret = RCL_RET_OK;
+  switch (handle->type) {
+    case RCL_EXECUTOR_HANDLE_SUBSCRIPTION:
+      handle->callback.subscription(handle->data, handle->context);
+      break;
+    case RCL_EXECUTOR_HANDLE_SERVICE:
+      handle->callback.service(handle->data, handle->response, handle->context);
+      ret = rcl_send_response(
+        handle->entity.service, &handle->request_header, handle->response);
+      break;
+    case RCL_EXECUTOR_HANDLE_CLIENT:
+      handle->callback.client(handle->data, &handle->request_header, handle->context);
+      break;
+    case RCL_EXECUTOR_HANDLE_TIMER:
+      ret = rcl_timer_call(handle->entity.timer);
+      if (RCL_RET_TIMER_CANCELED == ret) {
+        // Canceled after the wait returned.
+        ret = RCL_RET_OK;
+      }
+      break;
+    case RCL_EXECUTOR_HANDLE_GUARD_CONDITION:
+      handle->callback.guard_condition(handle->context);
+      break;
+    case RCL_EXECUTOR_HANDLE_WAITABLE:
+      ret = handle->waitable.execute(handle->waitable.data);
+      break;
+  }
+  return ret;
+}
+
+/// Fill the dispatch entry of a ready handle, after its data was taken if it was.
+static rcl_ret_t
+_rcl_executor_get_dispatch_entry(
+  const rcl_executor_handle_t * handle,
+  rcl_time_point_value_t now,
+  rcl_dispatch_entry_t * entry)
+{
+  entry->type = RCL_DISPATCH_ENTITY_OTHER;
+  entry->attributes = rcl_dispatch_get_default_attributes();
+  entry->release_time = now;
+  switch (handle->type) {
+    case RCL_EXECUTOR_HANDLE_SUBSCRIPTION:
+      {
+        const rcl_subscription_options_t * options =
+          rcl_subscription_get_options(handle->entity.subscription);
+        if (!options) {
+          return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+        }
+        entry->type = RCL_DISPATCH_ENTITY_SUBSCRIPTION;
+        entry->attributes = options->dispatch;
+        // Not every middleware sets the source timestamp.
+        if (handle->is_taken && 0 != handle->message_info.source_timestamp) {
+          entry->release_time = handle->message_info.source_timestamp;
+        }
+      }
+      break;
+    case RCL_EXECUTOR_HANDLE_SERVICE:
+      {
+        const rcl_service_options_t * options = rcl_service_get_options(handle->entity.service);
+        if (!options) {
+          return RCL_RET_SERVICE_INVALID;  // error already set
+        }
+        entry->type = RCL_DISPATCH_ENTITY_SERVICE;
+        entry->attributes = options->dispatch;
+        if (handle->is_taken && 0 != handle->service_info.source_timestamp) {
+          entry->release_time = handle->service_info.source_timestamp;
+        }
+      }
+      break;
+    case RCL_EXECUTOR_HANDLE_TIMER:
+      {
+        entry->type = RCL_DISPATCH_ENTITY_TIMER;
+        rcl_ret_t ret = rcl_timer_get_dispatch_attributes(handle->entity.timer, &entry->attributes);
+        int64_t time_until_next_call = 0;
+        if (RCL_RET_OK == ret) {
+          ret = rcl_timer_get_time_until_next_call(handle->entity.timer, &time_until_next_call);
+        }
+        if (RCL_RET_OK != ret) {
+          return ret;  // error already set
+        }
+        entry->release_time = now + time_until_next_call;
+      }
+      break;
+    case RCL_EXECUTOR_HANDLE_CLIENT:
+    case RCL_EXECUTOR_HANDLE_GUARD_CONDITION:
+    case RCL_EXECUTOR_HANDLE_WAITABLE:
+      break;
+  }
+  return RCL_RET_OK;
+}
+
+/// Collect the ready handles into the order array and sort it by the dispatch policy.
+static rcl_ret_t
+_rcl_executor_order_ready(rcl_executor_impl_t * impl, size_t * count)
+{
+  const rcl_dispatch_policy_t policy = impl->options.dispatch_policy;
+  rcutils_time_point_value_t now = 0;
+  if (
+    RCL_DISPATCH_POLICY_ADDED_ORDER != policy &&
+    RCUTILS_RET_OK != rcutils_system_time_now(&now))
+  {
+    RCL_SET_ERROR_MSG("failed to get the current system time");
+    return RCL_RET_ERROR;
+  }
+  *count = 0u;
+  for (size_t i = 0u; i < impl->size; ++i) {
+    if (!impl->is_ready[i]) {
+      continue;
+    }
+    rcl_dispatch_entry_t * entry = &impl->order[(*count)++];
+    if (RCL_DISPATCH_POLICY_ADDED_ORDER != policy) {
+      rcl_ret_t ret = _rcl_executor_get_dispatch_entry(&impl->handles[i], now, entry);
+      if (RCL_RET_OK != ret) {
+        return ret;  // error already set
+      }
+    }
+    entry->index = i;
+  }
+  return rcl_dispatch_order(impl->order, *count, policy);
+}
+
+static bool
+_rcl_executor_is_triggered(const rcl_executor_impl_t * impl, size_t number_ready)
+{
+  switch (impl->options.trigger) {
+    case RCL_EXECUTOR_TRIGGER_ANY:
+      return number_ready > 0u;
+    case RCL_EXECUTOR_TRIGGER_ALL:
+      return number_ready == impl->size;
+    case RCL_EXECUTOR_TRIGGER_PREDICATE:
+      return impl->options.trigger_predicate(
+        impl->is_ready, impl->size, impl->options.trigger_context);
+  }
+  return false;
+}
+
+rcl_ret_t
+rcl_executor_spin_some(rcl_executor_t * executor, int64_t timeout)
+{
+  rcl_ret_t ret = rcl_executor_prepare(executor);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_executor_impl_t * impl = executor->impl;
+  rcl_wait_set_t * wait_set = &impl->wait_set;
+  ret = rcl_wait_set_clear(wait_set);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  for (size_t i = 0u; i < impl->size; ++i) {
+    ret = _rcl_executor_add_to_wait_set(&impl->handles[i], wait_set);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  ret = rcl_wait(wait_set, timeout);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set, if any
+  }
+
+  size_t number_ready = 0u;
+  for (size_t i = 0u; i < impl->size; ++i) {
+    ret = _rcl_executor_is_ready(&impl->handles[i], wait_set, &impl->is_ready[i]);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    number_ready += impl->is_ready[i] ? 1u : 0u;
+    // Drop what an earlier failed dispatch may have left taken.
+    impl->handles[i].is_taken = false;
+  }
+  if (!_rcl_executor_is_triggered(impl, number_ready)) {
+    RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Executor trigger condition not met");
+    return RCL_RET_OK;
+  }
+
+  // Deadlines depend on the source timestamps, which are only known once taken.
+  const bool take_first =
+    RCL_EXECUTOR_SEMANTICS_TAKE_ALL_THEN_EXECUTE == impl->options.semantics ||
+    RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST == impl->options.dispatch_policy;
+  if (take_first) {
+    for (size_t i = 0u; i < impl->size; ++i) {
+      if (impl->is_ready[i]) {
+        ret = _rcl_executor_take(&impl->handles[i]);
+        if (RCL_RET_OK != ret) {
+          return ret;  // error already set
+        }
+      }
+    }
+  }
+  size_t count = 0u;
+  ret = _rcl_executor_order_ready(impl, &count);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  for (size_t i = 0u; i < count; ++i) {
+    rcl_executor_handle_t * handle = &impl->handles[impl->order[i].index];
+    if (!take_first) {
+      ret = _rcl_executor_take(handle);
+      if (RCL_RET_OK != ret) {
+        return ret;  // error already set
+      }
+    }
+    ret = _rcl_executor_execute(handle);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_executor_spin(rcl_executor_t * executor, int64_t timeout)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(executor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    executor->impl, "executor is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  while (rcl_context_is_valid(executor->impl->context)) {
+    rcl_ret_t ret = rcl_executor_spin_some(executor, timeout);
+    if (RCL_RET_OK != ret && RCL_RET_TIMEOUT != ret) {
+      return ret;  // error already set
+    }
+  }
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -24,6 +24,7 @@ extern "C"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 
+#include "./common.h"
 #include "./context_impl.h"
 
 typedef struct rcl_guard_condition_impl_t
@@ -157,8 +158,9 @@ rcl_trigger_guard_condition(rcl_guard_condition_t * guard_condition)
     return RCL_RET_INVALID_ARGUMENT;  // error already set
   }
   // Trigger the guard condition.
+  RCL_CLEAR_STALE_ERROR();
   if (rmw_trigger_guard_condition(guard_condition->impl->rmw_handle) != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return RCL_RET_ERROR;
   }
   return RCL_RET_OK;
@@ -25,18 +25,16 @@ extern "C"
 
 #include "rmw/error_handling.h"
 
-#include "tracetools/tracetools.h"
-
 #ifdef RCL_COMMAND_LINE_ENABLED
 #include "rcl/arguments.h"
 #endif // RCL_COMMAND_LINE_ENABLED
 #include "rcl/domain_id.h"
 #include "rcl/error_handling.h"
-#include "rcl/localhost.h"
 #ifdef RCL_LOGGING_ENABLED
 #include "rcl/logging.h"
 #endif // RCL_LOGGING_ENABLED
 #include "rcl/security.h"
+#include "rcl/tracing.h"
 #include "rcl/validate_enclave_name.h"
 
 #ifdef RCL_COMMAND_LINE_ENABLED
@@ -44,17 +42,29 @@ extern "C"
 #endif // RCL_COMMAND_LINE_ENABLED
 #include "./common.h"
 #include "./context_impl.h"
+#include "./environment_impl.h"
 #include "./init_options_impl.h"
 
-rcl_ret_t
-rcl_init(
-  int argc,
-  char const * const * argv,
-  const rcl_init_options_t * options,
-  rcl_context_t * context)
+/// \internal
+typedef struct rcl_context_template_impl_t
 {
-  rcl_ret_t fail_ret = RCL_RET_ERROR;
+  /// Allocator used by the template and by the contexts initialized from it.
+  rcl_allocator_t allocator;
+  /// Copy of the init options, with the environment and enclave already resolved.
+  rcl_init_options_t init_options;
+  /// Length of argv (may be `0`).
+  int64_t argc;
+  /// Copy of argv (may be `NULL`).
+  char ** argv;
+#ifdef RCL_COMMAND_LINE_ENABLED
+  /// Global arguments parsed from argv.
+  rcl_arguments_t global_arguments;
+#endif // RCL_COMMAND_LINE_ENABLED
+} rcl_context_template_impl_t;
 
+static rcl_ret_t
+_rcl_check_argv(int argc, char const * const * argv)
+{
   if (argc > 0) {
     RCL_CHECK_ARGUMENT_FOR_NULL(argv, RCL_RET_INVALID_ARGUMENT);
     for (int i = 0; i < argc; ++i) {
@@ -66,16 +76,57 @@ rcl_init(
       return RCL_RET_INVALID_ARGUMENT;
     }
   }
-  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(options->impl, RCL_RET_INVALID_ARGUMENT);
-  rcl_allocator_t allocator = options->impl->allocator;
-  RCL_CHECK_ALLOCATOR(&allocator, return RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  return RCL_RET_OK;
+}
 
-  RCUTILS_LOG_DEBUG_NAMED(
-    ROS_PACKAGE_NAME,
-    "Initializing ROS client library, for context at address: %p", (void *) context);
+/// Copy argv, if argc >= 0; on failure the partial copy is left in argv_out for cleanup.
+static rcl_ret_t
+_rcl_copy_argv(
+  int64_t argc,
+  char const * const * argv,
+  rcl_allocator_t allocator,
+  char *** argv_out)
+{
+  *argv_out = NULL;
+  if (0 == argc || NULL == argv) {
+    return RCL_RET_OK;
+  }
+  *argv_out = (char **)allocator.zero_allocate((size_t)argc, sizeof(char *), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    *argv_out, "failed to allocate memory for argv", return RCL_RET_BAD_ALLOC);
+  for (int64_t i = 0; i < argc; ++i) {
+    size_t argv_i_length = strlen(argv[i]);
+    (*argv_out)[i] = (char *)allocator.allocate(argv_i_length + 1, allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      (*argv_out)[i],
+      "failed to allocate memory for string entry in argv",
+      return RCL_RET_BAD_ALLOC);
+    memcpy((*argv_out)[i], argv[i], argv_i_length + 1);
+  }
+  return RCL_RET_OK;
+}
+
+static void
+_rcl_fini_argv(int64_t argc, char ** argv, rcl_allocator_t allocator)
+{
+  if (NULL == argv) {
+    return;
+  }
+  for (int64_t i = 0; i < argc; ++i) {
+    allocator.deallocate(argv[i], allocator.state);
+  }
+  allocator.deallocate(argv, allocator.state);
+}
 
+/// Allocate the impl of a zero initialized context and copy the options and argv into it.
+static rcl_ret_t
+_rcl_context_prepare(
+  int64_t argc,
+  char const * const * argv,
+  const rcl_init_options_t * options,
+  rcl_allocator_t allocator,
+  rcl_context_t * context)
+{
   // test expectation that given context is zero initialized
   if (NULL != context->impl) {
     // note that this can also occur when the given context is used before initialization
@@ -104,41 +155,93 @@ rcl_init(
   // Copy the options into the context for future reference.
   rcl_ret_t ret = rcl_init_options_copy(options, &(context->impl->init_options));
   if (RCL_RET_OK != ret) {
-    fail_ret = ret;  // error message already set
-    goto fail;
+    return ret;  // error message already set
   }
 
-  // Copy the argc and argv into the context, if argc >= 0.
+  // Copy the argc and argv into the context.
   context->impl->argc = argc;
-  context->impl->argv = NULL;
-  if (0 != argc && argv != NULL) {
-    context->impl->argv = (char **)allocator.zero_allocate(argc, sizeof(char *), allocator.state);
-    RCL_CHECK_FOR_NULL_WITH_MSG(
-      context->impl->argv,
-      "failed to allocate memory for argv",
-      fail_ret = RCL_RET_BAD_ALLOC; goto fail);
-    int64_t i;
-    for (i = 0; i < argc; ++i) {
-      size_t argv_i_length = strlen(argv[i]);
-      context->impl->argv[i] = (char *)allocator.allocate(argv_i_length, allocator.state);
-      RCL_CHECK_FOR_NULL_WITH_MSG(
-        context->impl->argv[i],
-        "failed to allocate memory for string entry in argv",
-        fail_ret = RCL_RET_BAD_ALLOC; goto fail);
-      memcpy(context->impl->argv[i], argv[i], argv_i_length);
+  return _rcl_copy_argv(argc, argv, allocator, &context->impl->argv);
+}
+
+/// Resolve the domain id, localhost only, enclave and security options of init options.
+/**
+ * If `enclave` is `NULL`, the enclave already stored in the init options is used.
+ */
+static rcl_ret_t
+_rcl_resolve_init_options(
+  const char * enclave,
+  rcl_allocator_t allocator,
+  rcl_init_options_t * init_options)
+{
+  rmw_init_options_t * rmw_init_options = &init_options->impl->rmw_init_options;
+
+  // The environment is read once per process, unless rcl_reload_environment() is called.
+  const rcl_environment_t * environment = NULL;
+  rcl_ret_t ret = rcl_get_environment(&environment);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+
+  if (RCL_DEFAULT_DOMAIN_ID == rmw_init_options->domain_id) {
+    // Get actual domain id based on environment variable.
+    rmw_init_options->domain_id = environment->domain_id;
+  }
+
+  if (RMW_LOCALHOST_ONLY_DEFAULT == rmw_init_options->localhost_only) {
+    // Get actual localhost_only value based on environment variable, if needed.
+    rmw_init_options->localhost_only = environment->localhost_only;
+  }
+
+  if (NULL != enclave) {
+    rmw_init_options->enclave = rcutils_strdup(enclave, allocator);
+    if (!rmw_init_options->enclave) {
+      RCL_SET_ERROR_MSG("failed to set context name");
+      ret = RCL_RET_BAD_ALLOC;
+      goto cleanup;
     }
   }
 
-#ifdef RCL_COMMAND_LINE_ENABLED
-  // Parse the ROS specific arguments.
-  ret = rcl_parse_arguments(argc, argv, allocator, &context->global_arguments);
+  int validation_result;
+  size_t invalid_index;
+  ret = rcl_validate_enclave_name(
+    rmw_init_options->enclave,
+    &validation_result,
+    &invalid_index);
   if (RCL_RET_OK != ret) {
-    fail_ret = ret;
-    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to parse global arguments");
-    goto fail;
+    RCL_SET_ERROR_MSG("rcl_validate_enclave_name() failed");
+    goto cleanup;
+  }
+  if (RCL_ENCLAVE_NAME_VALID != validation_result) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Enclave name is not valid: '%s'. Invalid index: %zu",
+      rcl_enclave_name_validation_result_string(validation_result),
+      invalid_index);
+    ret = RCL_RET_ERROR;
+    goto cleanup;
   }
+
+  ret = rcl_environment_get_security_options(
+    environment,
+    rmw_init_options->enclave,
+    &allocator,
+    &rmw_init_options->security_options);
+cleanup:
+  rcl_release_environment(environment);
+  return ret;
+}
+
+#ifdef RCL_COMMAND_LINE_ENABLED
+static const char *
+_rcl_enclave_from_arguments(const rcl_arguments_t * global_arguments)
+{
+  return global_arguments->impl->enclave ? global_arguments->impl->enclave : "/";
+}
 #endif // RCL_COMMAND_LINE_ENABLED
 
+/// Assign a new instance id to a prepared context and initialize its rmw context.
+static rcl_ret_t
+_rcl_context_start(rcl_context_t * context)
+{
   // Set the instance id.
   static uint32_t next_instance_id = 0;
   next_instance_id++;
@@ -149,91 +252,216 @@ rcl_init(
   context->instance_id_storage = next_instance_id;
   context->impl->init_options.impl->rmw_init_options.instance_id = next_instance_id;
 
-  size_t * domain_id = &context->impl->init_options.impl->rmw_init_options.domain_id;
-  if (RCL_DEFAULT_DOMAIN_ID == *domain_id) {
-    // Get actual domain id based on environment variable.
-    ret = rcl_get_default_domain_id(domain_id);
-    if (RCL_RET_OK != ret) {
-      fail_ret = ret;
-      goto fail;
-    }
+  // Initialize rmw_init.
+  rmw_ret_t rmw_ret = rmw_init(
+    &(context->impl->init_options.impl->rmw_init_options),
+    &(context->impl->rmw_context));
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
   }
 
-  rmw_localhost_only_t * localhost_only =
-    &context->impl->init_options.impl->rmw_init_options.localhost_only;
-  if (RMW_LOCALHOST_ONLY_DEFAULT == *localhost_only) {
-    // Get actual localhost_only value based on environment variable, if needed.
-    ret = rcl_get_localhost_only(localhost_only);
-    if (RCL_RET_OK != ret) {
-      fail_ret = ret;
-      goto fail;
-    }
+  RCL_TRACEPOINT(rcl_init, (const void *)context);
+
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_init(
+  int argc,
+  char const * const * argv,
+  const rcl_init_options_t * options,
+  rcl_context_t * context)
+{
+  rcl_ret_t ret = _rcl_check_argv(argc, argv);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(options->impl, RCL_RET_INVALID_ARGUMENT);
+  rcl_allocator_t allocator = options->impl->allocator;
+  RCL_CHECK_ALLOCATOR(&allocator, return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME,
+    "Initializing ROS client library, for context at address: %p", (void *) context);
+
+  ret = _rcl_context_prepare(argc, argv, options, allocator, context);
+  if (RCL_RET_ALREADY_INIT == ret) {
+    return ret;
+  }
+  if (RCL_RET_OK != ret) {
+    goto fail;
   }
 
+  const char * enclave = NULL;
 #ifdef RCL_COMMAND_LINE_ENABLED
-  if (context->global_arguments.impl->enclave) {
-    context->impl->init_options.impl->rmw_init_options.enclave = rcutils_strdup(
-      context->global_arguments.impl->enclave,
-      context->impl->allocator);
-  } else {
-    context->impl->init_options.impl->rmw_init_options.enclave = rcutils_strdup(
-      "/", context->impl->allocator);
+  // Parse the ROS specific arguments.
+  ret = rcl_parse_arguments(argc, argv, allocator, &context->global_arguments);
+  if (RCL_RET_OK != ret) {
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to parse global arguments");
+    goto fail;
   }
+  enclave = _rcl_enclave_from_arguments(&context->global_arguments);
+#endif // RCL_COMMAND_LINE_ENABLED
 
-  if (!context->impl->init_options.impl->rmw_init_options.enclave) {
-    RCL_SET_ERROR_MSG("failed to set context name");
-    fail_ret = RCL_RET_BAD_ALLOC;
+  ret = _rcl_resolve_init_options(enclave, allocator, &context->impl->init_options);
+  if (RCL_RET_OK != ret) {
     goto fail;
   }
-#endif //RCL_COMMAND_LINE_ENABLED
 
-  int validation_result;
-  size_t invalid_index;
-  ret = rcl_validate_enclave_name(
-    context->impl->init_options.impl->rmw_init_options.enclave,
-    &validation_result,
-    &invalid_index);
+  ret = _rcl_context_start(context);
   if (RCL_RET_OK != ret) {
-    RCL_SET_ERROR_MSG("rcl_validate_enclave_name() failed");
-    fail_ret = ret;
     goto fail;
   }
-  if (RCL_ENCLAVE_NAME_VALID != validation_result) {
-    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "Enclave name is not valid: '%s'. Invalid index: %zu",
-      rcl_enclave_name_validation_result_string(validation_result),
-      invalid_index);
-    fail_ret = RCL_RET_ERROR;
+  return RCL_RET_OK;
+fail:
+  __cleanup_context(context);
+  return ret;
+}
+
+rcl_context_template_t
+rcl_get_zero_initialized_context_template(void)
+{
+  static rcl_context_template_t zero_template = {
+    .impl = NULL
+  };
+  return zero_template;
+}
+
+rcl_ret_t
+rcl_context_template_init(
+  int argc,
+  char const * const * argv,
+  const rcl_init_options_t * options,
+  rcl_context_template_t * context_template)
+{
+  rcl_ret_t ret = _rcl_check_argv(argc, argv);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(options->impl, RCL_RET_INVALID_ARGUMENT);
+  rcl_allocator_t allocator = options->impl->allocator;
+  RCL_CHECK_ALLOCATOR(&allocator, return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context_template, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != context_template->impl) {
+    RCL_SET_ERROR_MSG("context template already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+
+  rcl_context_template_impl_t * impl = allocator.zero_allocate(
+    1, sizeof(rcl_context_template_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    impl, "failed to allocate memory for context template impl", return RCL_RET_BAD_ALLOC);
+  context_template->impl = impl;
+  impl->allocator = allocator;
+  impl->argc = argc;
+
+  ret = rcl_init_options_copy(options, &impl->init_options);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
+  ret = _rcl_copy_argv(argc, argv, allocator, &impl->argv);
+  if (RCL_RET_OK != ret) {
     goto fail;
   }
 
-  rmw_security_options_t * security_options =
-    &context->impl->init_options.impl->rmw_init_options.security_options;
-  ret = rcl_get_security_options_from_environment(
-    context->impl->init_options.impl->rmw_init_options.enclave,
-    &context->impl->allocator,
-    security_options);
+  const char * enclave = NULL;
+#ifdef RCL_COMMAND_LINE_ENABLED
+  impl->global_arguments = rcl_get_zero_initialized_arguments();
+  ret = rcl_parse_arguments(argc, argv, allocator, &impl->global_arguments);
   if (RCL_RET_OK != ret) {
-    fail_ret = ret;
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to parse global arguments");
     goto fail;
   }
+  enclave = _rcl_enclave_from_arguments(&impl->global_arguments);
+#endif // RCL_COMMAND_LINE_ENABLED
 
-  // Initialize rmw_init.
-  rmw_ret_t rmw_ret = rmw_init(
-    &(context->impl->init_options.impl->rmw_init_options),
-    &(context->impl->rmw_context));
-  if (RMW_RET_OK != rmw_ret) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    fail_ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  ret = _rcl_resolve_init_options(enclave, allocator, &impl->init_options);
+  if (RCL_RET_OK != ret) {
     goto fail;
   }
+  return RCL_RET_OK;
+fail:
+  if (RCL_RET_OK != rcl_context_template_fini(context_template)) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "[rcl|init.c:" RCUTILS_STRINGIFY(__LINE__)
+      "] failed to finalize context template after error, memory may be leaked\n");
+  }
+  return ret;
+}
 
-  TRACEPOINT(rcl_init, (const void *)context);
+rcl_ret_t
+rcl_init_from_template(
+  const rcl_context_template_t * context_template,
+  rcl_context_t * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context_template, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context_template->impl, "context template is zero-initialized",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  const rcl_context_template_impl_t * impl = context_template->impl;
 
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME,
+    "Initializing ROS client library from template, for context at address: %p",
+    (void *) context);
+
+  rcl_ret_t ret = _rcl_context_prepare(
+    impl->argc, (char const * const *)impl->argv, &impl->init_options, impl->allocator, context);
+  if (RCL_RET_ALREADY_INIT == ret) {
+    return ret;
+  }
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
+
+#ifdef RCL_COMMAND_LINE_ENABLED
+  // The arguments were parsed once by the template, copying them is enough.
+  ret = rcl_arguments_copy(&impl->global_arguments, &context->global_arguments);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
+#endif // RCL_COMMAND_LINE_ENABLED
+
+  ret = _rcl_context_start(context);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
   return RCL_RET_OK;
 fail:
   __cleanup_context(context);
-  return fail_ret;
+  return ret;
+}
+
+rcl_ret_t
+rcl_context_template_fini(rcl_context_template_t * context_template)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context_template, RCL_RET_INVALID_ARGUMENT);
+  rcl_context_template_impl_t * impl = context_template->impl;
+  if (NULL == impl) {
+    return RCL_RET_OK;
+  }
+  rcl_ret_t ret = RCL_RET_OK;
+#ifdef RCL_COMMAND_LINE_ENABLED
+  if (NULL != impl->global_arguments.impl) {
+    ret = rcl_arguments_fini(&impl->global_arguments);
+  }
+#endif // RCL_COMMAND_LINE_ENABLED
+  if (NULL != impl->init_options.impl) {
+    rcl_ret_t init_options_fini_ret = rcl_init_options_fini(&impl->init_options);
+    if (RCL_RET_OK == ret) {
+      ret = init_options_fini_ret;
+    }
+  }
+  rcl_allocator_t allocator = impl->allocator;
+  _rcl_fini_argv(impl->argc, impl->argv, allocator);
+  allocator.deallocate(impl, allocator.state);
+  context_template->impl = NULL;
+  return ret;
 }
 
 rcl_ret_t
@@ -17,6 +17,9 @@ extern "C"
 {
 #endif
 
+#include <stdint.h>
+#include <string.h>
+
 #include "rcl/error_handling.h"
 #include "rcl/graph.h"
 #include "rcl/network_flow_endpoints.h"
@@ -116,6 +119,272 @@ rcl_subscription_get_network_flow_endpoints(
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
+rcl_network_flow_endpoint_buffer_t
+rcl_get_zero_initialized_network_flow_endpoint_buffer(void)
+{
+  static rcl_network_flow_endpoint_buffer_t zero_buffer = {
+    .network_flow_endpoint = NULL,
+    .size = 0u,
+    .capacity = 0u,
+  };
+  return zero_buffer;
+}
+
+/// Grow the storage of a buffer so that it can hold at least `capacity` network flow endpoints.
+static rcl_ret_t
+_rcl_network_flow_endpoint_buffer_reserve(
+  rcl_network_flow_endpoint_buffer_t * buffer,
+  size_t capacity)
+{
+  if (capacity <= buffer->capacity) {
+    return RCL_RET_OK;
+  }
+  if (capacity < 2u * buffer->capacity) {
+    capacity = 2u * buffer->capacity;
+  }
+  if (capacity > SIZE_MAX / sizeof(rcl_network_flow_endpoint_t)) {
+    RCL_SET_ERROR_MSG("network flow endpoint buffer capacity overflows");
+    return RCL_RET_BAD_ALLOC;
+  }
+  rcl_network_flow_endpoint_t * network_flow_endpoint = buffer->allocator.reallocate(
+    buffer->network_flow_endpoint, capacity * sizeof(rcl_network_flow_endpoint_t),
+    buffer->allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    network_flow_endpoint, "failed to grow network flow endpoint buffer",
+    return RCL_RET_BAD_ALLOC);
+  buffer->network_flow_endpoint = network_flow_endpoint;
+  buffer->capacity = capacity;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_network_flow_endpoint_buffer_init(
+  rcl_network_flow_endpoint_buffer_t * buffer,
+  size_t capacity,
+  rcl_allocator_t allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != buffer->network_flow_endpoint || 0u != buffer->capacity) {
+    RCL_SET_ERROR_MSG(
+      "rcl_network_flow_endpoint_buffer_t must be zero initialized,\n"
+      "Use rcl_get_zero_initialized_network_flow_endpoint_buffer");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  buffer->allocator = allocator;
+  buffer->size = 0u;
+  return _rcl_network_flow_endpoint_buffer_reserve(buffer, capacity);
+}
+
+rcl_ret_t
+rcl_network_flow_endpoint_buffer_fini(rcl_network_flow_endpoint_buffer_t * buffer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != buffer->network_flow_endpoint) {
+    buffer->allocator.deallocate(buffer->network_flow_endpoint, buffer->allocator.state);
+  }
+  *buffer = rcl_get_zero_initialized_network_flow_endpoint_buffer();
+  return RCL_RET_OK;
+}
+
+// The middleware allocates the network flow endpoint array it returns with the
+// allocator it is given. The allocator below hands out the unused tail of a
+// buffer instead, so that the array can be kept in the buffer and never freed.
+// This relies on the middleware making a single allocation, the array itself:
+// deallocating and reallocating are no-ops, a second allocation would get the
+// same tail, and growing the buffer moves the memory of an earlier allocation.
+
+static void *
+__buffer_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  rcl_network_flow_endpoint_buffer_t * buffer = (rcl_network_flow_endpoint_buffer_t *)state;
+  if (0u != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  size_t bytes = number_of_elements * size_of_element;
+  size_t count = bytes / sizeof(rcl_network_flow_endpoint_t) +
+    (0u != bytes % sizeof(rcl_network_flow_endpoint_t) ? 1u : 0u);
+  // An empty array must still be a valid allocation.
+  size_t required = buffer->size + (0u != count ? count : 1u);
+  if (RCL_RET_OK != _rcl_network_flow_endpoint_buffer_reserve(buffer, required)) {
+    return NULL;
+  }
+  rcl_network_flow_endpoint_t * tail = buffer->network_flow_endpoint + buffer->size;
+  memset(tail, 0, count * sizeof(rcl_network_flow_endpoint_t));
+  return tail;
+}
+
+static void *
+__buffer_allocate(size_t size, void * state)
+{
+  return __buffer_zero_allocate(1u, size, state);
+}
+
+static void *
+__buffer_reallocate(void * pointer, size_t size, void * state)
+{
+  (void)pointer;
+  (void)size;
+  (void)state;
+  // The tail of the buffer cannot be resized in place.
+  return NULL;
+}
+
+static void
+__buffer_deallocate(void * pointer, void * state)
+{
+  // The tail of the buffer is owned by the buffer.
+  (void)pointer;
+  (void)state;
+}
+
+static rcutils_allocator_t
+__get_buffer_allocator(rcl_network_flow_endpoint_buffer_t * buffer)
+{
+  rcutils_allocator_t allocator = {
+    .allocate = __buffer_allocate,
+    .deallocate = __buffer_deallocate,
+    .reallocate = __buffer_reallocate,
+    .zero_allocate = __buffer_zero_allocate,
+    .state = buffer,
+  };
+  return allocator;
+}
+
+/// Keep the network flow endpoints the middleware wrote at the tail of the buffer.
+static rcl_ret_t
+__commit_to_buffer(
+  rmw_ret_t rmw_ret,
+  const rcl_network_flow_endpoint_array_t * network_flow_endpoint_array,
+  rcl_network_flow_endpoint_buffer_t * buffer)
+{
+  if (rmw_ret != RMW_RET_OK) {
+    rmw_error_string_t error_string = rmw_get_error_string();
+    rmw_reset_error();
+    RCL_SET_ERROR_MSG(error_string.str);
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  if (0u != network_flow_endpoint_array->size &&
+    network_flow_endpoint_array->network_flow_endpoint !=
+    buffer->network_flow_endpoint + buffer->size)
+  {
+    RCL_SET_ERROR_MSG("middleware did not return network flow endpoints in the buffer");
+    return RCL_RET_ERROR;
+  }
+  buffer->size += network_flow_endpoint_array->size;
+  return RCL_RET_OK;
+}
+
+static rcl_ret_t
+__append_publisher_network_flow_endpoints(
+  const rcl_publisher_t * publisher,
+  rcl_network_flow_endpoint_buffer_t * buffer)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcutils_allocator_t allocator = __get_buffer_allocator(buffer);
+  rcl_network_flow_endpoint_array_t network_flow_endpoint_array =
+    rcl_get_zero_initialized_network_flow_endpoint_array();
+  rmw_ret_t rmw_ret = rmw_publisher_get_network_flow_endpoints(
+    rcl_publisher_get_rmw_handle(publisher),
+    &allocator,
+    &network_flow_endpoint_array);
+  return __commit_to_buffer(rmw_ret, &network_flow_endpoint_array, buffer);
+}
+
+static rcl_ret_t
+__append_subscription_network_flow_endpoints(
+  const rcl_subscription_t * subscription,
+  rcl_network_flow_endpoint_buffer_t * buffer)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcutils_allocator_t allocator = __get_buffer_allocator(buffer);
+  rcl_network_flow_endpoint_array_t network_flow_endpoint_array =
+    rcl_get_zero_initialized_network_flow_endpoint_array();
+  rmw_ret_t rmw_ret = rmw_subscription_get_network_flow_endpoints(
+    rcl_subscription_get_rmw_handle(subscription),
+    &allocator,
+    &network_flow_endpoint_array);
+  return __commit_to_buffer(rmw_ret, &network_flow_endpoint_array, buffer);
+}
+
+static rcl_ret_t
+__validate_network_flow_endpoint_buffer(rcl_network_flow_endpoint_buffer_t * buffer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    &buffer->allocator, "network flow endpoint buffer is not initialized",
+    return RCL_RET_INVALID_ARGUMENT);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publisher_fill_network_flow_endpoint_buffer(
+  const rcl_publisher_t * publisher,
+  rcl_network_flow_endpoint_buffer_t * buffer)
+{
+  return rcl_fill_network_flow_endpoint_buffer(&publisher, 1u, NULL, 0u, buffer, NULL);
+}
+
+rcl_ret_t
+rcl_subscription_fill_network_flow_endpoint_buffer(
+  const rcl_subscription_t * subscription,
+  rcl_network_flow_endpoint_buffer_t * buffer)
+{
+  return rcl_fill_network_flow_endpoint_buffer(NULL, 0u, &subscription, 1u, buffer, NULL);
+}
+
+rcl_ret_t
+rcl_fill_network_flow_endpoint_buffer(
+  const rcl_publisher_t * const * publishers,
+  size_t num_publishers,
+  const rcl_subscription_t * const * subscriptions,
+  size_t num_subscriptions,
+  rcl_network_flow_endpoint_buffer_t * buffer,
+  size_t * offsets)
+{
+  if (0u != num_publishers) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(publishers, RCL_RET_INVALID_ARGUMENT);
+  }
+  if (0u != num_subscriptions) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(subscriptions, RCL_RET_INVALID_ARGUMENT);
+  }
+  rcl_ret_t ret = __validate_network_flow_endpoint_buffer(buffer);
+  if (ret != RCL_RET_OK) {
+    return ret;
+  }
+
+  buffer->size = 0u;
+  size_t entity = 0u;
+  for (size_t i = 0u; i < num_publishers; ++i, ++entity) {
+    if (NULL != offsets) {
+      offsets[entity] = buffer->size;
+    }
+    ret = __append_publisher_network_flow_endpoints(publishers[i], buffer);
+    if (ret != RCL_RET_OK) {
+      buffer->size = 0u;
+      return ret;
+    }
+  }
+  for (size_t i = 0u; i < num_subscriptions; ++i, ++entity) {
+    if (NULL != offsets) {
+      offsets[entity] = buffer->size;
+    }
+    ret = __append_subscription_network_flow_endpoints(subscriptions[i], buffer);
+    if (ret != RCL_RET_OK) {
+      buffer->size = 0u;
+      return ret;
+    }
+  }
+  if (NULL != offsets) {
+    offsets[entity] = buffer->size;
+  }
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,6 +37,7 @@ extern "C"
 #include "rcl/rcl.h"
 #include "rcl/remap.h"
 #include "rcl/security.h"
+#include "rcl/tracing.h"
 
 #include "rcutils/filesystem.h"
 #include "rcutils/find.h"
@@ -53,7 +54,6 @@ extern "C"
 #include "rmw/rmw.h"
 #include "rmw/validate_namespace.h"
 #include "rmw/validate_node_name.h"
-#include "tracetools/tracetools.h"
 
 #include "./context_impl.h"
 
@@ -303,7 +303,7 @@ rcl_node_init(
 #endif // RCL_LOGGING_ENABLED
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Node initialized");
   ret = RCL_RET_OK;
-  TRACEPOINT(
+  RCL_TRACEPOINT(
     rcl_node_init,
     (const void *)node,
     (const void *)rcl_node_get_rmw_handle(node),
@@ -0,0 +1,461 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+// For sched_setaffinity() and the CPU_* macros.
+# define _GNU_SOURCE
+#endif
+
+#include "rcl/partitioned_wait_set.h"
+
+#if defined(__linux__)
+# include <sched.h>
+#elif defined(_WIN32)
+# include <windows.h>
+#endif
+
+#include "rcl/error_handling.h"
+
+typedef enum rcl_partition_entity_type_e
+{
+  RCL_PARTITION_ENTITY_SUBSCRIPTION,
+  RCL_PARTITION_ENTITY_GUARD_CONDITION,
+  RCL_PARTITION_ENTITY_TIMER,
+  RCL_PARTITION_ENTITY_CLIENT,
+  RCL_PARTITION_ENTITY_SERVICE,
+  RCL_PARTITION_ENTITY_TYPE_COUNT
+} rcl_partition_entity_type_t;
+
+typedef struct rcl_partition_entity_t
+{
+  rcl_partition_entity_type_t type;
+  const void * entity;
+} rcl_partition_entity_t;
+
+typedef struct rcl_partition_t
+{
+  // Registered entities, added to the wait set in this order.
+  rcl_partition_entity_t * entities;
+  size_t size;
+  size_t capacity;
+  // Number of registered entities of each type.
+  size_t counts[RCL_PARTITION_ENTITY_TYPE_COUNT];
+  rcl_wait_set_t wait_set;
+  // Set when entities were registered since the wait set was sized.
+  bool is_wait_set_stale;
+  // Added last to the guard conditions of the wait set.
+  rcl_guard_condition_t wake_guard_condition;
+  uint64_t cpu_affinity_mask;
+} rcl_partition_t;
+
+typedef struct rcl_partitioned_wait_set_impl_t
+{
+  rcl_partition_t * partitions;
+  size_t number_of_partitions;
+  rcl_context_t * context;
+  rcl_allocator_t allocator;
+} rcl_partitioned_wait_set_impl_t;
+
+rcl_partitioned_wait_set_t
+rcl_get_zero_initialized_partitioned_wait_set(void)
+{
+  static rcl_partitioned_wait_set_t null_partitioned_wait_set = {0};
+  return null_partitioned_wait_set;
+}
+
+/// Finalize the first number_of_partitions partitions, keeping the first error.
+static rcl_ret_t
+_rcl_partitions_fini(rcl_partitioned_wait_set_impl_t * impl, size_t number_of_partitions)
+{
+  rcl_ret_t ret = RCL_RET_OK;
+  for (size_t i = 0u; i < number_of_partitions; ++i) {
+    rcl_partition_t * partition = &impl->partitions[i];
+    rcl_ret_t fini_ret = RCL_RET_OK;
+    if (rcl_wait_set_is_valid(&partition->wait_set)) {
+      fini_ret = rcl_wait_set_fini(&partition->wait_set);
+      ret = RCL_RET_OK == ret ? fini_ret : ret;
+    }
+    fini_ret = rcl_guard_condition_fini(&partition->wake_guard_condition);
+    ret = RCL_RET_OK == ret ? fini_ret : ret;
+    impl->allocator.deallocate(partition->entities, impl->allocator.state);
+  }
+  return ret;
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_init(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t number_of_partitions,
+  rcl_context_t * context,
+  rcl_allocator_t allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(partitioned_wait_set, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (partitioned_wait_set->impl) {
+    RCL_SET_ERROR_MSG("partitioned wait set already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (0u == number_of_partitions) {
+    RCL_SET_ERROR_MSG("number_of_partitions must be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rcl_partitioned_wait_set_impl_t * impl = (rcl_partitioned_wait_set_impl_t *)
+    allocator.zero_allocate(1u, sizeof(rcl_partitioned_wait_set_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  impl->partitions = (rcl_partition_t *)allocator.zero_allocate(
+    number_of_partitions, sizeof(rcl_partition_t), allocator.state);
+  if (!impl->partitions) {
+    allocator.deallocate(impl, allocator.state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  impl->number_of_partitions = number_of_partitions;
+  impl->context = context;
+  impl->allocator = allocator;
+
+  rcl_guard_condition_options_t guard_condition_options =
+    rcl_guard_condition_get_default_options();
+  guard_condition_options.allocator = allocator;
+  for (size_t i = 0u; i < number_of_partitions; ++i) {
+    rcl_partition_t * partition = &impl->partitions[i];
+    partition->wait_set = rcl_get_zero_initialized_wait_set();
+    partition->is_wait_set_stale = true;
+    partition->wake_guard_condition = rcl_get_zero_initialized_guard_condition();
+    rcl_ret_t ret = rcl_guard_condition_init(
+      &partition->wake_guard_condition, context, guard_condition_options);
+    if (RCL_RET_OK != ret) {
+      (void)_rcl_partitions_fini(impl, i);
+      allocator.deallocate(impl->partitions, allocator.state);
+      allocator.deallocate(impl, allocator.state);
+      return ret;  // error already set
+    }
+  }
+  partitioned_wait_set->impl = impl;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_fini(rcl_partitioned_wait_set_t * partitioned_wait_set)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(partitioned_wait_set, RCL_RET_INVALID_ARGUMENT);
+  rcl_partitioned_wait_set_impl_t * impl = partitioned_wait_set->impl;
+  if (!impl) {
+    return RCL_RET_OK;
+  }
+  rcl_ret_t ret = _rcl_partitions_fini(impl, impl->number_of_partitions);
+  rcl_allocator_t allocator = impl->allocator;
+  allocator.deallocate(impl->partitions, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  partitioned_wait_set->impl = NULL;
+  return ret;
+}
+
+/// Return the partition at the given index, or NULL with the error set.
+static rcl_partition_t *
+_rcl_partitioned_wait_set_get_partition(
+  const rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    partitioned_wait_set, "partitioned_wait_set argument is null", return NULL);
+  rcl_partitioned_wait_set_impl_t * impl = partitioned_wait_set->impl;
+  RCL_CHECK_FOR_NULL_WITH_MSG(impl, "partitioned wait set is not initialized", return NULL);
+  if (partition >= impl->number_of_partitions) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "partition %zu out of range, there are %zu partitions",
+      partition, impl->number_of_partitions);
+    return NULL;
+  }
+  return &impl->partitions[partition];
+}
+
+static rcl_ret_t
+_rcl_partitioned_wait_set_add(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition_index,
+  rcl_partition_entity_type_t type,
+  const void * entity,
+  size_t * index)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(entity, RCL_RET_INVALID_ARGUMENT);
+  rcl_partition_t * partition =
+    _rcl_partitioned_wait_set_get_partition(partitioned_wait_set, partition_index);
+  if (!partition) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  if (partition->size == partition->capacity) {
+    rcl_allocator_t * allocator = &partitioned_wait_set->impl->allocator;
+    size_t capacity = 0u == partition->capacity ? 4u : 2u * partition->capacity;
+    rcl_partition_entity_t * entities = (rcl_partition_entity_t *)allocator->reallocate(
+      partition->entities, capacity * sizeof(rcl_partition_entity_t), allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(entities, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    partition->entities = entities;
+    partition->capacity = capacity;
+  }
+  partition->entities[partition->size].type = type;
+  partition->entities[partition->size].entity = entity;
+  ++partition->size;
+  if (index) {
+    *index = partition->counts[type];
+  }
+  ++partition->counts[type];
+  partition->is_wait_set_stale = true;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_add_subscription(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_subscription_t * subscription,
+  size_t * index)
+{
+  return _rcl_partitioned_wait_set_add(
+    partitioned_wait_set, partition, RCL_PARTITION_ENTITY_SUBSCRIPTION, subscription, index);
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_add_guard_condition(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_guard_condition_t * guard_condition,
+  size_t * index)
+{
+  return _rcl_partitioned_wait_set_add(
+    partitioned_wait_set, partition, RCL_PARTITION_ENTITY_GUARD_CONDITION, guard_condition,
+    index);
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_add_timer(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_timer_t * timer,
+  size_t * index)
+{
+  return _rcl_partitioned_wait_set_add(
+    partitioned_wait_set, partition, RCL_PARTITION_ENTITY_TIMER, timer, index);
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_add_client(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_client_t * client,
+  size_t * index)
+{
+  return _rcl_partitioned_wait_set_add(
+    partitioned_wait_set, partition, RCL_PARTITION_ENTITY_CLIENT, client, index);
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_add_service(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition,
+  const rcl_service_t * service,
+  size_t * index)
+{
+  return _rcl_partitioned_wait_set_add(
+    partitioned_wait_set, partition, RCL_PARTITION_ENTITY_SERVICE, service, index);
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_set_cpu_affinity(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition_index,
+  uint64_t cpu_affinity_mask)
+{
+  rcl_partition_t * partition =
+    _rcl_partitioned_wait_set_get_partition(partitioned_wait_set, partition_index);
+  if (!partition) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  partition->cpu_affinity_mask = cpu_affinity_mask;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_pin_thread(
+  const rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition_index)
+{
+  const rcl_partition_t * partition =
+    _rcl_partitioned_wait_set_get_partition(partitioned_wait_set, partition_index);
+  if (!partition) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  const uint64_t mask = partition->cpu_affinity_mask;
+  if (0u == mask) {
+    return RCL_RET_OK;
+  }
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+    if (mask & (UINT64_C(1) << cpu)) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  // A pid of 0 is the calling thread.
+  if (0 != sched_setaffinity(0, sizeof(cpu_set), &cpu_set)) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "failed to set the CPU affinity of the thread to 0x%llx", (unsigned long long)mask);
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+#elif defined(_WIN32)
+  if (0 == SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)mask)) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "failed to set the CPU affinity of the thread to 0x%llx", (unsigned long long)mask);
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+#else
+  RCL_SET_ERROR_MSG("setting thread CPU affinities is not supported on this platform");
+  return RCL_RET_UNSUPPORTED;
+#endif
+}
+
+/// Size the wait set of a partition for its registered entities and wake guard condition.
+static rcl_ret_t
+_rcl_partition_prepare(rcl_partitioned_wait_set_impl_t * impl, rcl_partition_t * partition)
+{
+  // The rmw wait set is sized on creation, so it cannot simply be resized.
+  rcl_ret_t ret = RCL_RET_OK;
+  if (rcl_wait_set_is_valid(&partition->wait_set)) {
+    ret = rcl_wait_set_fini(&partition->wait_set);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  ret = rcl_wait_set_init(
+    &partition->wait_set,
+    partition->counts[RCL_PARTITION_ENTITY_SUBSCRIPTION],
+    partition->counts[RCL_PARTITION_ENTITY_GUARD_CONDITION] + 1u,
+    partition->counts[RCL_PARTITION_ENTITY_TIMER],
+    partition->counts[RCL_PARTITION_ENTITY_CLIENT],
+    partition->counts[RCL_PARTITION_ENTITY_SERVICE],
+    0u, impl->context, impl->allocator);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  partition->is_wait_set_stale = false;
+  return RCL_RET_OK;
+}
+
+static rcl_ret_t
+_rcl_partition_entity_add_to_wait_set(
+  const rcl_partition_entity_t * entity, rcl_wait_set_t * wait_set)
+{
+  switch (entity->type) {
+    case RCL_PARTITION_ENTITY_SUBSCRIPTION:
+      return rcl_wait_set_add_subscription(
+        wait_set, (const rcl_subscription_t *)entity->entity, NULL);
+    case RCL_PARTITION_ENTITY_GUARD_CONDITION:
+      return rcl_wait_set_add_guard_condition(
+        wait_set, (const rcl_guard_condition_t *)entity->entity, NULL);
+    case RCL_PARTITION_ENTITY_TIMER:
+      return rcl_wait_set_add_timer(wait_set, (const rcl_timer_t *)entity->entity, NULL);
+    case RCL_PARTITION_ENTITY_CLIENT:
+      return rcl_wait_set_add_client(wait_set, (const rcl_client_t *)entity->entity, NULL);
+    case RCL_PARTITION_ENTITY_SERVICE:
+      return rcl_wait_set_add_service(wait_set, (const rcl_service_t *)entity->entity, NULL);
+    case RCL_PARTITION_ENTITY_TYPE_COUNT:
+      break;
+  }
+  RCL_SET_ERROR_MSG("unknown partition entity type");
+  return RCL_RET_ERROR;
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_wait(
+  rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition_index,
+  int64_t timeout,
+  rcl_wait_set_t ** wait_set)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  rcl_partition_t * partition =
+    _rcl_partitioned_wait_set_get_partition(partitioned_wait_set, partition_index);
+  if (!partition) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  rcl_ret_t ret = RCL_RET_OK;
+  if (partition->is_wait_set_stale) {
+    ret = _rcl_partition_prepare(partitioned_wait_set->impl, partition);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  ret = rcl_wait_set_clear(&partition->wait_set);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  for (size_t i = 0u; i < partition->size; ++i) {
+    ret = _rcl_partition_entity_add_to_wait_set(&partition->entities[i], &partition->wait_set);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  ret = rcl_wait_set_add_guard_condition(
+    &partition->wait_set, &partition->wake_guard_condition, NULL);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  *wait_set = &partition->wait_set;
+  return rcl_wait(&partition->wait_set, timeout);
+}
+
+rcl_ret_t
+rcl_partitioned_wait_set_wake(
+  const rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition_index)
+{
+  rcl_partition_t * partition =
+    _rcl_partitioned_wait_set_get_partition(partitioned_wait_set, partition_index);
+  if (!partition) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  return rcl_trigger_guard_condition(&partition->wake_guard_condition);
+}
+
+bool
+rcl_partitioned_wait_set_is_woken(
+  const rcl_partitioned_wait_set_t * partitioned_wait_set,
+  size_t partition_index)
+{
+  if (
+    !partitioned_wait_set || !partitioned_wait_set->impl ||
+    partition_index >= partitioned_wait_set->impl->number_of_partitions)
+  {
+    return false;
+  }
+  const rcl_partition_t * partition = &partitioned_wait_set->impl->partitions[partition_index];
+  if (partition->is_wait_set_stale) {
+    return false;
+  }
+  const size_t wake_index = partition->counts[RCL_PARTITION_ENTITY_GUARD_CONDITION];
+  return NULL != partition->wait_set.guard_conditions[wake_index];
+}
+
+#ifdef __cplusplus
+}
+#endif
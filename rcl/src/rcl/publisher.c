@@ -23,14 +23,18 @@ extern "C"
 #include <string.h>
 
 #include "rcl/allocator.h"
+#include "rcl/compression.h"
 #include "rcl/error_handling.h"
 #include "rcl/node.h"
+#include "rcl/tracing.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/macros.h"
+#include "rcutils/time.h"
 #include "rmw/error_handling.h"
-#include "tracetools/tracetools.h"
+#include "rmw/serialized_message.h"
 
 #include "./common.h"
+#include "./compression_impl.h"
 #include "./publisher_impl.h"
 
 rcl_publisher_t
@@ -40,6 +44,59 @@ rcl_get_zero_initialized_publisher()
   return null_publisher;
 }
 
+static rcl_ret_t
+_rcl_publisher_update_matched_subscription_count(rcl_publisher_impl_t * impl)
+{
+  // Stamp before querying so that a subscription matched meanwhile is seen by the next refresh.
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG("failed to get the current steady time");
+    return RCL_RET_ERROR;
+  }
+  size_t subscription_count = 0u;
+  RCL_CLEAR_STALE_ERROR();
+  rmw_ret_t rmw_ret =
+    rmw_publisher_count_matched_subscriptions(impl->rmw_handle, &subscription_count);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  rcutils_atomic_store(&impl->matched_subscription_count, (uint64_t)subscription_count);
+  rcutils_atomic_store(&impl->matched_count_update_time, now);
+  return RCL_RET_OK;
+}
+
+/// Refresh the cached count, treating it as unknown, i.e. matched, if the rmw cannot tell.
+static void
+_rcl_publisher_try_update_matched_subscription_count(rcl_publisher_impl_t * impl)
+{
+  if (RCL_RET_OK == _rcl_publisher_update_matched_subscription_count(impl)) {
+    return;
+  }
+  // Rather publish needlessly than drop messages a subscription is waiting for, and only
+  // ask the rmw again once the unknown count is as old as the max age.
+  rcl_reset_error();
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK == rcutils_steady_time_now(&now)) {
+    rcutils_atomic_store(&impl->matched_subscription_count, (uint64_t)1u);
+    rcutils_atomic_store(&impl->matched_count_update_time, now);
+  }
+}
+
+static bool
+_rcl_publisher_has_matched_subscriptions(rcl_publisher_impl_t * impl)
+{
+  rcutils_time_point_value_t now;
+  const bool is_stale = 0 == impl->options.matched_count_max_age ||
+    RCUTILS_RET_OK != rcutils_steady_time_now(&now) ||
+    now - rcutils_atomic_load_int64_t(&impl->matched_count_update_time) >=
+    impl->options.matched_count_max_age;
+  if (is_stale) {
+    _rcl_publisher_try_update_matched_subscription_count(impl);
+  }
+  return rcutils_atomic_load_uint64_t(&impl->matched_subscription_count) > 0u;
+}
+
 rcl_ret_t
 rcl_publisher_init(
   rcl_publisher_t * publisher,
@@ -73,6 +130,19 @@ rcl_publisher_init(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(type_support, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
+  if (options->matched_count_max_age < 0) {
+    RCL_SET_ERROR_MSG("matched count max age must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (options->skip_when_unmatched &&
+    RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL == options->qos.durability)
+  {
+    RCL_SET_ERROR_MSG("cannot skip unmatched publishes with transient local durability");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (options->compression.name && !rcl_compression_codec_is_valid(&options->compression)) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Initializing publisher for topic name '%s'", topic_name);
 
@@ -95,12 +165,31 @@ rcl_publisher_init(
   }
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Expanded and remapped topic name '%s'", remapped_topic_name);
+  // Only subscriptions using the same codec match the compressed topic.
+  if (options->compression.name) {
+    char * compressed_topic_name = NULL;
+    ret = rcl_compression_get_topic_name(
+      remapped_topic_name, &options->compression, *allocator, &compressed_topic_name);
+    if (RCL_RET_OK != ret) {
+      goto cleanup;
+    }
+    allocator->deallocate(remapped_topic_name, allocator->state);
+    remapped_topic_name = compressed_topic_name;
+  }
 
   // Allocate space for the implementation struct.
   publisher->impl = (rcl_publisher_impl_t *)allocator->allocate(
     sizeof(rcl_publisher_impl_t), allocator->state);
   RCL_CHECK_FOR_NULL_WITH_MSG(
     publisher->impl, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto cleanup);
+  // compression buffers, empty until the first compressed publish
+  atomic_init(&publisher->impl->compression_buffers_in_use, false);
+  ret = rcl_compression_buffers_init(&publisher->impl->compression_buffers, *allocator);
+  if (RCL_RET_OK != ret) {
+    allocator->deallocate(publisher->impl, allocator->state);
+    publisher->impl = NULL;
+    goto cleanup;  // error already set
+  }
 
   // Fill out implementation struct.
   // rmw handle (create rmw publisher)
@@ -123,12 +212,20 @@ rcl_publisher_init(
   }
   publisher->impl->actual_qos.avoid_ros_namespace_conventions =
     options->qos.avoid_ros_namespace_conventions;
+  publisher->impl->type_support = type_support;
+  publisher->impl->rmw_node_handle = rcl_node_get_rmw_handle(node);
   // options
   publisher->impl->options = *options;
+  // matched subscriptions, seeded only for publishers which skip, the others query lazily
+  atomic_init(&publisher->impl->matched_subscription_count, 0u);
+  atomic_init(&publisher->impl->matched_count_update_time, 0);
+  if (options->skip_when_unmatched) {
+    _rcl_publisher_try_update_matched_subscription_count(publisher->impl);
+  }
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Publisher initialized");
   // context
   publisher->impl->context = node->context;
-  TRACEPOINT(
+  RCL_TRACEPOINT(
     rcl_publisher_init,
     (const void *)publisher,
     (const void *)node,
@@ -146,6 +243,7 @@ fail:
         RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
       }
     }
+    rcl_compression_buffers_fini(&publisher->impl->compression_buffers);
 
     allocator->deallocate(publisher->impl, allocator->state);
     publisher->impl = NULL;
@@ -185,6 +283,7 @@ rcl_publisher_fini(rcl_publisher_t * publisher, rcl_node_t * node)
       RCL_SET_ERROR_MSG(rmw_get_error_string().str);
       result = RCL_RET_ERROR;
     }
+    rcl_compression_buffers_fini(&publisher->impl->compression_buffers);
     allocator.deallocate(publisher->impl, allocator.state);
     publisher->impl = NULL;
   }
@@ -201,6 +300,9 @@ rcl_publisher_get_default_options()
   default_options.qos = rmw_qos_profile_default;
   default_options.allocator = rcl_get_default_allocator();
   default_options.rmw_publisher_options = rmw_get_default_publisher_options();
+  default_options.skip_when_unmatched = false;
+  default_options.matched_count_max_age = 0;
+  default_options.compression = rcl_get_zero_initialized_compression_codec();
   return default_options;
 }
 
@@ -213,6 +315,10 @@ rcl_borrow_loaned_message(
   if (!rcl_publisher_is_valid(publisher)) {
     return RCL_RET_PUBLISHER_INVALID;  // error already set
   }
+  if (publisher->impl->options.compression.name) {
+    RCL_SET_ERROR_MSG("publishers compressing their messages cannot loan them");
+    return RCL_RET_UNSUPPORTED;
+  }
   return rcl_convert_rmw_ret_to_rcl_ret(
     rmw_borrow_loaned_message(publisher->impl->rmw_handle, type_support, ros_message));
 }
@@ -230,6 +336,101 @@ rcl_return_loaned_message_from_publisher(
     rmw_return_loaned_message_from_publisher(publisher->impl->rmw_handle, loaned_message));
 }
 
+/// Take the reusable compression buffers, or temporary ones if another publish holds them.
+static rcl_compression_buffers_t *
+_rcl_publisher_acquire_compression_buffers(
+  rcl_publisher_impl_t * impl, rcl_compression_buffers_t * temporary_buffers)
+{
+  if (!rcutils_atomic_exchange_bool(&impl->compression_buffers_in_use, true)) {
+    return &impl->compression_buffers;
+  }
+  if (RCL_RET_OK != rcl_compression_buffers_init(temporary_buffers, impl->options.allocator)) {
+    return NULL;  // error already set
+  }
+  return temporary_buffers;
+}
+
+static void
+_rcl_publisher_release_compression_buffers(
+  rcl_publisher_impl_t * impl, rcl_compression_buffers_t * buffers)
+{
+  if (buffers == &impl->compression_buffers) {
+    rcutils_atomic_store(&impl->compression_buffers_in_use, false);
+  } else {
+    rcl_compression_buffers_fini(buffers);
+  }
+}
+
+/// Compress a serialized message and publish the result.
+static rcl_ret_t
+_rcl_publish_compressed_serialized_message(
+  rcl_publisher_impl_t * impl,
+  const rcl_serialized_message_t * serialized_message,
+  rcl_compression_buffers_t * buffers,
+  rmw_publisher_allocation_t * allocation)
+{
+  rcl_ret_t ret = rcl_compress_serialized_message(
+    &impl->options.compression, serialized_message, &buffers->compressed_message,
+    &buffers->scratch);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  RCL_CLEAR_STALE_ERROR();
+  rmw_ret_t rmw_ret = rmw_publish_serialized_message(
+    impl->rmw_handle, &buffers->compressed_message, allocation);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    return RMW_RET_BAD_ALLOC == rmw_ret ? RCL_RET_BAD_ALLOC : RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+/// Compress a serialized message and publish the result, with the reusable buffers if free.
+static rcl_ret_t
+_rcl_publish_compressed_serialized(
+  rcl_publisher_impl_t * impl,
+  const rcl_serialized_message_t * serialized_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  rcl_compression_buffers_t temporary_buffers;
+  rcl_compression_buffers_t * buffers =
+    _rcl_publisher_acquire_compression_buffers(impl, &temporary_buffers);
+  if (!buffers) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  rcl_ret_t ret = _rcl_publish_compressed_serialized_message(
+    impl, serialized_message, buffers, allocation);
+  _rcl_publisher_release_compression_buffers(impl, buffers);
+  return ret;
+}
+
+/// Serialize a message, then compress and publish it, with the reusable buffers if free.
+static rcl_ret_t
+_rcl_publish_compressed(
+  rcl_publisher_impl_t * impl,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  rcl_compression_buffers_t temporary_buffers;
+  rcl_compression_buffers_t * buffers =
+    _rcl_publisher_acquire_compression_buffers(impl, &temporary_buffers);
+  if (!buffers) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  rcl_ret_t ret = RCL_RET_OK;
+  RCL_CLEAR_STALE_ERROR();
+  rmw_ret_t rmw_ret = rmw_serialize(ros_message, impl->type_support, &buffers->serialized_message);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  } else {
+    ret = _rcl_publish_compressed_serialized_message(
+      impl, &buffers->serialized_message, buffers, allocation);
+  }
+  _rcl_publisher_release_compression_buffers(impl, buffers);
+  return ret;
+}
+
 rcl_ret_t
 rcl_publish(
   const rcl_publisher_t * publisher,
@@ -243,9 +444,18 @@ rcl_publish(
     return RCL_RET_PUBLISHER_INVALID;  // error already set
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
-  TRACEPOINT(rcl_publish, (const void *)publisher, (const void *)ros_message);
+  if (publisher->impl->options.skip_when_unmatched &&
+    !_rcl_publisher_has_matched_subscriptions(publisher->impl))
+  {
+    return RCL_RET_OK;
+  }
+  RCL_TRACEPOINT(rcl_publish, (const void *)publisher, (const void *)ros_message);
+  if (publisher->impl->options.compression.name) {
+    return _rcl_publish_compressed(publisher->impl, ros_message, allocation);
+  }
+  RCL_CLEAR_STALE_ERROR();
   if (rmw_publish(publisher->impl->rmw_handle, ros_message, allocation) != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return RCL_RET_ERROR;
   }
   return RCL_RET_OK;
@@ -261,10 +471,14 @@ rcl_publish_serialized_message(
     return RCL_RET_PUBLISHER_INVALID;  // error already set
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(serialized_message, RCL_RET_INVALID_ARGUMENT);
+  if (publisher->impl->options.compression.name) {
+    return _rcl_publish_compressed_serialized(publisher->impl, serialized_message, allocation);
+  }
+  RCL_CLEAR_STALE_ERROR();
   rmw_ret_t ret = rmw_publish_serialized_message(
     publisher->impl->rmw_handle, serialized_message, allocation);
   if (ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     if (ret == RMW_RET_BAD_ALLOC) {
       return RCL_RET_BAD_ALLOC;
     }
@@ -283,9 +497,14 @@ rcl_publish_loaned_message(
     return RCL_RET_PUBLISHER_INVALID;  // error already set
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  if (publisher->impl->options.compression.name) {
+    RCL_SET_ERROR_MSG("publishers compressing their messages cannot loan them");
+    return RCL_RET_UNSUPPORTED;
+  }
+  RCL_CLEAR_STALE_ERROR();
   rmw_ret_t ret = rmw_publish_loaned_message(publisher->impl->rmw_handle, ros_message, allocation);
   if (ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return RCL_RET_ERROR;
   }
   return RCL_RET_OK;
@@ -297,8 +516,9 @@ rcl_publisher_assert_liveliness(const rcl_publisher_t * publisher)
   if (!rcl_publisher_is_valid(publisher)) {
     return RCL_RET_PUBLISHER_INVALID;  // error already set
   }
+  RCL_CLEAR_STALE_ERROR();
   if (rmw_publisher_assert_liveliness(publisher->impl->rmw_handle) != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return RCL_RET_ERROR;
   }
   return RCL_RET_OK;
@@ -388,6 +608,24 @@ rcl_publisher_get_subscription_count(
   return RCL_RET_OK;
 }
 
+bool
+rcl_publisher_has_matched_subscriptions(const rcl_publisher_t * publisher)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return false;  // error already set
+  }
+  return _rcl_publisher_has_matched_subscriptions(publisher->impl);
+}
+
+rcl_ret_t
+rcl_publisher_update_matched_subscription_count(const rcl_publisher_t * publisher)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  return _rcl_publisher_update_matched_subscription_count(publisher->impl);
+}
+
 const rmw_qos_profile_t *
 rcl_publisher_get_actual_qos(const rcl_publisher_t * publisher)
 {
@@ -403,6 +641,9 @@ rcl_publisher_can_loan_messages(const rcl_publisher_t * publisher)
   if (!rcl_publisher_is_valid(publisher)) {
     return false;  // error message already set
   }
+  if (publisher->impl->options.compression.name) {
+    return false;
+  }
   return publisher->impl->rmw_handle->can_loan_messages;
 }
 
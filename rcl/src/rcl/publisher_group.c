@@ -0,0 +1,187 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/publisher_group.h"
+
+#include <stdbool.h>
+
+#include "rcl/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw/serialized_message.h"
+
+#include "./common.h"
+#include "./publisher_impl.h"
+
+typedef struct rcl_publisher_group_impl_t
+{
+  const rcl_publisher_t ** publishers;
+  // Whether each publisher takes part in the ongoing publish.
+  bool * is_publishing;
+  size_t count;
+  const rosidl_message_type_support_t * type_support;
+  // Reused by every publish, it only grows.
+  rcl_serialized_message_t serialized_message;
+  rcl_allocator_t allocator;
+} rcl_publisher_group_impl_t;
+
+rcl_publisher_group_t
+rcl_get_zero_initialized_publisher_group(void)
+{
+  static rcl_publisher_group_t null_publisher_group = {0};
+  return null_publisher_group;
+}
+
+rcl_ret_t
+rcl_publisher_group_init(
+  rcl_publisher_group_t * group,
+  const rcl_publisher_t * const * publishers,
+  size_t count,
+  rcl_allocator_t allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(publishers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (group->impl) {
+    RCL_SET_ERROR_MSG("publisher group already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (0u == count) {
+    RCL_SET_ERROR_MSG("count must be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0u; i < count; ++i) {
+    if (!rcl_publisher_is_valid(publishers[i])) {
+      return RCL_RET_PUBLISHER_INVALID;  // error already set
+    }
+    if (publishers[i]->impl->type_support != publishers[0]->impl->type_support) {
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "publisher %zu does not share the message type support of publisher 0", i);
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+  }
+
+  rcl_publisher_group_impl_t * impl = (rcl_publisher_group_impl_t *)
+    allocator.zero_allocate(1u, sizeof(rcl_publisher_group_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  impl->publishers = (const rcl_publisher_t **)allocator.allocate(
+    count * sizeof(rcl_publisher_t *), allocator.state);
+  impl->is_publishing = (bool *)allocator.allocate(count * sizeof(bool), allocator.state);
+  if (!impl->publishers || !impl->is_publishing) {
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    goto fail;
+  }
+  for (size_t i = 0u; i < count; ++i) {
+    impl->publishers[i] = publishers[i];
+  }
+  impl->count = count;
+  impl->type_support = publishers[0]->impl->type_support;
+  impl->serialized_message = rmw_get_zero_initialized_serialized_message();
+  RCL_CLEAR_STALE_ERROR();
+  if (RMW_RET_OK != rmw_serialized_message_init(&impl->serialized_message, 0u, &allocator)) {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    goto fail;
+  }
+  impl->allocator = allocator;
+  group->impl = impl;
+  return RCL_RET_OK;
+fail:
+  allocator.deallocate(impl->is_publishing, allocator.state);
+  allocator.deallocate(impl->publishers, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  return RCL_RET_BAD_ALLOC;
+}
+
+rcl_ret_t
+rcl_publisher_group_fini(rcl_publisher_group_t * group)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  rcl_publisher_group_impl_t * impl = group->impl;
+  if (!impl) {
+    return RCL_RET_OK;
+  }
+  rcl_ret_t ret = RCL_RET_OK;
+  RCL_CLEAR_STALE_ERROR();
+  if (RMW_RET_OK != rmw_serialized_message_fini(&impl->serialized_message)) {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    ret = RCL_RET_ERROR;
+  }
+  rcl_allocator_t allocator = impl->allocator;
+  allocator.deallocate(impl->is_publishing, allocator.state);
+  allocator.deallocate(impl->publishers, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  group->impl = NULL;
+  return ret;
+}
+
+rcl_ret_t
+rcl_publish_to_many(
+  rcl_publisher_group_t * group,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "publisher group is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  rcl_publisher_group_impl_t * impl = group->impl;
+
+  bool is_any_publishing = false;
+  for (size_t i = 0u; i < impl->count; ++i) {
+    const rcl_publisher_t * publisher = impl->publishers[i];
+    if (!rcl_publisher_is_valid(publisher)) {
+      return RCL_RET_PUBLISHER_INVALID;  // error already set
+    }
+    impl->is_publishing[i] = !publisher->impl->options.skip_when_unmatched ||
+      rcl_publisher_has_matched_subscriptions(publisher);
+    is_any_publishing = is_any_publishing || impl->is_publishing[i];
+  }
+  if (!is_any_publishing) {
+    return RCL_RET_OK;
+  }
+
+  RCL_CLEAR_STALE_ERROR();
+  rmw_ret_t rmw_ret = rmw_serialize(ros_message, impl->type_support, &impl->serialized_message);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  // A failing publisher does not deprive the others of the message, the first error is kept.
+  rcl_ret_t first_ret = RCL_RET_OK;
+  rcutils_error_string_t first_error = {{0}};
+  for (size_t i = 0u; i < impl->count; ++i) {
+    if (!impl->is_publishing[i]) {
+      continue;
+    }
+    rcl_ret_t ret = rcl_publish_serialized_message(
+      impl->publishers[i], &impl->serialized_message, allocation);
+    if (RCL_RET_OK != ret && RCL_RET_OK == first_ret) {
+      first_ret = ret;
+      first_error = rcl_get_error_string();
+    }
+    rcl_reset_error();
+  }
+  if (RCL_RET_OK != first_ret) {
+    RCL_SET_ERROR_MSG(first_error.str);
+  }
+  return first_ret;
+}
+
+#ifdef __cplusplus
+}
+#endif
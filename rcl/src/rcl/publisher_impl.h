@@ -15,16 +15,30 @@
 #ifndef RCL__PUBLISHER_IMPL_H_
 #define RCL__PUBLISHER_IMPL_H_
 
+#include "rcutils/stdatomic_helper.h"
 #include "rmw/rmw.h"
 
 #include "rcl/publisher.h"
 
+#include "./compression_impl.h"
+
 typedef struct rcl_publisher_impl_t
 {
   rcl_publisher_options_t options;
   rmw_qos_profile_t actual_qos;
   rcl_context_t * context;
   rmw_publisher_t * rmw_handle;
+  /// Rmw handle of the node the publisher was created with.
+  const rmw_node_t * rmw_node_handle;
+  const rosidl_message_type_support_t * type_support;
+  /// Cached count of matched subscriptions, see rcl_publisher_has_matched_subscriptions().
+  atomic_uint_least64_t matched_subscription_count;
+  /// Steady time at which the cached count was last read from the rmw.
+  atomic_int_least64_t matched_count_update_time;
+  /// Buffers reused by compressing publishes, held by one publish at a time.
+  rcl_compression_buffers_t compression_buffers;
+  /// Whether a publish holds the compression buffers, the others use temporary ones.
+  atomic_bool compression_buffers_in_use;
 } rcl_publisher_impl_t;
 
 #endif  // RCL__PUBLISHER_IMPL_H_
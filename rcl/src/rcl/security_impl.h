@@ -0,0 +1,41 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__SECURITY_IMPL_H_
+#define RCL__SECURITY_IMPL_H_
+
+#include "rcl/allocator.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Build the path of an enclave within a keystore, without checking that it exists.
+/**
+ * \param[in] name the enclave name
+ * \param[in] ros_secure_keystore_env the keystore root path
+ * \param[in] allocator the allocator used for the returned path
+ * \return the enclave path, or `NULL` if allocating memory failed.
+ */
+char * exact_match_lookup(
+  const char * name,
+  const char * ros_secure_keystore_env,
+  const rcl_allocator_t * allocator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__SECURITY_IMPL_H_
@@ -19,21 +19,38 @@ extern "C"
 
 #include "rcl/service.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "rcl/error_handling.h"
 #include "rcl/node.h"
+#include "rcl/tracing.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/macros.h"
+#include "rcutils/time.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
-#include "tracetools/tracetools.h"
+
+#include "./common.h"
+#include "./service_response_cache.h"
+
+/// A request taken but not answered yet, counted against the maximum in flight.
+typedef struct rcl_service_in_flight_request_t
+{
+  rmw_request_id_t request_id;
+  /// Steady time at which the request was taken.
+  rcutils_time_point_value_t taken_time;
+} rcl_service_in_flight_request_t;
 
 typedef struct rcl_service_impl_t
 {
   rcl_service_options_t options;
   rmw_service_t * rmw_handle;
+  rcl_service_response_cache_t * response_cache;
+  rcl_service_admission_stats_t admission_stats;
+  /// Requests in flight, of which there are `admission_stats.in_flight` out of `max_in_flight`.
+  rcl_service_in_flight_request_t * in_flight_requests;
 } rcl_service_impl_t;
 
 rcl_service_t
@@ -77,6 +94,18 @@ rcl_service_init(
     RCL_SET_ERROR_MSG("service already initialized, or memory was unintialized");
     return RCL_RET_ALREADY_INIT;
   }
+  if (options->admission.deadline < 0) {
+    RCL_SET_ERROR_MSG("service admission deadline must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (options->admission.in_flight_timeout < 0) {
+    RCL_SET_ERROR_MSG("service admission in flight timeout must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (options->dispatch.relative_deadline < 0) {
+    RCL_SET_ERROR_MSG("service relative deadline must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
 
   // Expand and remap the given service name.
   char * remapped_service_name = NULL;
@@ -103,6 +132,30 @@ rcl_service_init(
     sizeof(rcl_service_impl_t), allocator->state);
   RCL_CHECK_FOR_NULL_WITH_MSG(
     service->impl, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto cleanup);
+  service->impl->rmw_handle = NULL;
+  service->impl->response_cache = NULL;
+  memset(&service->impl->admission_stats, 0, sizeof(service->impl->admission_stats));
+  service->impl->in_flight_requests = NULL;
+  if (0u != options->admission.max_in_flight) {
+    if (options->admission.max_in_flight <= SIZE_MAX / sizeof(rcl_service_in_flight_request_t)) {
+      service->impl->in_flight_requests = (rcl_service_in_flight_request_t *)allocator->allocate(
+        sizeof(rcl_service_in_flight_request_t) * options->admission.max_in_flight,
+        allocator->state);
+    }
+    if (!service->impl->in_flight_requests) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      fail_ret = RCL_RET_BAD_ALLOC;
+      goto fail;
+    }
+  }
+  if (0u != options->response_cache.capacity) {
+    fail_ret = rcl_service_response_cache_init(
+      &options->response_cache, *allocator, &service->impl->response_cache);
+    if (RCL_RET_OK != fail_ret) {
+      goto fail;  // error already set
+    }
+    fail_ret = RCL_RET_ERROR;
+  }
 
   if (RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL == options->qos.durability) {
     RCUTILS_LOG_WARN_NAMED(
@@ -126,7 +179,7 @@ rcl_service_init(
   service->impl->options = *options;
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service initialized");
   ret = RCL_RET_OK;
-  TRACEPOINT(
+  RCL_TRACEPOINT(
     rcl_service_init,
     (const void *)service,
     (const void *)node,
@@ -135,6 +188,8 @@ rcl_service_init(
   goto cleanup;
 fail:
   if (service->impl) {
+    rcl_service_response_cache_fini(service->impl->response_cache);
+    allocator->deallocate(service->impl->in_flight_requests, allocator->state);
     allocator->deallocate(service->impl, allocator->state);
     service->impl = NULL;
   }
@@ -171,6 +226,8 @@ rcl_service_fini(rcl_service_t * service, rcl_node_t * node)
       RCL_SET_ERROR_MSG(rmw_get_error_string().str);
       result = RCL_RET_ERROR;
     }
+    rcl_service_response_cache_fini(service->impl->response_cache);
+    allocator.deallocate(service->impl->in_flight_requests, allocator.state);
     allocator.deallocate(service->impl, allocator.state);
     service->impl = NULL;
   }
@@ -186,9 +243,44 @@ rcl_service_get_default_options()
   // Must set the allocator and qos after because they are not a compile time constant.
   default_options.qos = rmw_qos_profile_services_default;
   default_options.allocator = rcl_get_default_allocator();
+  default_options.response_cache.capacity = 0u;
+  default_options.response_cache.pending_timeout = RCUTILS_S_TO_NS(10);
+  default_options.admission.max_in_flight = 0u;
+  default_options.admission.deadline = 0;
+  default_options.admission.in_flight_timeout = 0;
+  default_options.admission.busy_response = NULL;
+  default_options.dispatch = rcl_dispatch_get_default_attributes();
   return default_options;
 }
 
+rcl_ret_t
+rcl_service_get_response_cache_stats(
+  const rcl_service_t * service,
+  rcl_service_response_cache_stats_t * stats)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    service->impl->response_cache, "service has no response cache", return RCL_RET_ERROR);
+  rcl_service_response_cache_get_stats(service->impl->response_cache, stats);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_service_get_admission_stats(
+  const rcl_service_t * service,
+  rcl_service_admission_stats_t * stats)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  *stats = service->impl->admission_stats;
+  return RCL_RET_OK;
+}
+
 const char *
 rcl_service_get_service_name(const rcl_service_t * service)
 {
@@ -220,6 +312,253 @@ rcl_service_get_rmw_handle(const rcl_service_t * service)
   return service->impl->rmw_handle;
 }
 
+static bool
+_rcl_request_id_equal(const rmw_request_id_t * lhs, const rmw_request_id_t * rhs)
+{
+  return lhs->sequence_number == rhs->sequence_number &&
+         0 == memcmp(lhs->writer_guid, rhs->writer_guid, sizeof(lhs->writer_guid));
+}
+
+/// Stop counting a request as in flight, returning whether it was.
+static bool
+_rcl_end_in_flight_request(rcl_service_impl_t * impl, const rmw_request_id_t * request_id)
+{
+  size_t * in_flight = &impl->admission_stats.in_flight;
+  for (size_t i = 0u; i < *in_flight; ++i) {
+    if (_rcl_request_id_equal(&impl->in_flight_requests[i].request_id, request_id)) {
+      impl->in_flight_requests[i] = impl->in_flight_requests[--(*in_flight)];
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Stop counting as in flight the requests taken more than the in flight timeout ago.
+static void
+_rcl_expire_in_flight_requests(rcl_service_impl_t * impl, rcutils_time_point_value_t now)
+{
+  int64_t timeout = impl->options.admission.in_flight_timeout;
+  size_t * in_flight = &impl->admission_stats.in_flight;
+  for (size_t i = 0u; i < *in_flight; ) {
+    if (now - impl->in_flight_requests[i].taken_time > timeout) {
+      RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service request in flight timed out");
+      impl->in_flight_requests[i] = impl->in_flight_requests[--(*in_flight)];
+    } else {
+      ++i;
+    }
+  }
+}
+
+/// Shed a taken request if the service is overloaded or the request is past its deadline.
+/**
+ * `now` is the steady time, only used to expire requests in flight.
+ * `overloaded` is set if the request was shed because of the requests in flight.
+ */
+static rcl_ret_t
+_rcl_admit_request(
+  const rcl_service_t * service,
+  const rmw_service_info_t * request_header,
+  rcutils_time_point_value_t now,
+  bool * admitted,
+  bool * overloaded)
+{
+  rcl_service_impl_t * impl = service->impl;
+  const rcl_service_admission_options_t * admission = &impl->options.admission;
+  uint64_t * shed_counter = NULL;
+  if (0u != admission->max_in_flight &&
+    impl->admission_stats.in_flight >= admission->max_in_flight &&
+    0 != admission->in_flight_timeout)
+  {
+    _rcl_expire_in_flight_requests(impl, now);
+  }
+  if (0u != admission->max_in_flight &&
+    impl->admission_stats.in_flight >= admission->max_in_flight)
+  {
+    shed_counter = &impl->admission_stats.shed_overload;
+  } else if (0 != admission->deadline && 0 != request_header->source_timestamp) {
+    rcutils_time_point_value_t system_now = 0;
+    if (RCUTILS_RET_OK != rcutils_system_time_now(&system_now)) {
+      RCL_SET_ERROR_MSG("failed to get current time");
+      return RCL_RET_ERROR;
+    }
+    if (system_now - request_header->source_timestamp > admission->deadline) {
+      shed_counter = &impl->admission_stats.shed_deadline;
+    }
+  }
+  *admitted = !shed_counter;
+  *overloaded = shed_counter == &impl->admission_stats.shed_overload;
+  if (*admitted) {
+    return RCL_RET_OK;
+  }
+  ++(*shed_counter);
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Service request shed for %s",
+    *overloaded ? "overload" : "deadline");
+  if (admission->busy_response) {
+    rmw_request_id_t request_id = request_header->request_id;
+    RCL_CLEAR_STALE_ERROR();
+    if (rmw_send_response(
+        impl->rmw_handle, &request_id, admission->busy_response) != RMW_RET_OK)
+    {
+      RCL_SET_ERROR_MSG_FROM_RMW();
+      return RCL_RET_ERROR;
+    }
+    ++impl->admission_stats.busy_responses;
+  }
+  return RCL_RET_OK;
+}
+
+/// Take a request from the middleware, skipping those shed or answered through the cache.
+/**
+ * Under overload, a single request is shed and none is taken, so that the
+ * requests still queued are left to the middleware.
+ */
+static rcl_ret_t
+_rcl_take_request(
+  const rcl_service_t * service,
+  rmw_service_info_t * request_header,
+  void * ros_request,
+  bool * taken)
+{
+  rcl_service_impl_t * impl = service->impl;
+  rcl_service_response_cache_t * cache = impl->response_cache;
+  bool tracks_in_flight = 0u != impl->options.admission.max_in_flight;
+  rcutils_time_point_value_t now = 0;
+  bool needs_time = cache || (tracks_in_flight && 0 != impl->options.admission.in_flight_timeout);
+  if (needs_time && RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG("failed to get current time");
+    return RCL_RET_ERROR;
+  }
+  for (;;) {
+    *taken = false;
+    RCL_CLEAR_STALE_ERROR();
+    rmw_ret_t ret = rmw_take_request(
+      service->impl->rmw_handle, request_header, ros_request, taken);
+    if (RMW_RET_OK != ret) {
+      RCL_SET_ERROR_MSG_FROM_RMW();
+      if (RMW_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    if (!*taken) {
+      return RCL_RET_OK;
+    }
+    bool admitted = true;
+    bool overloaded = false;
+    rcl_ret_t admit_ret = _rcl_admit_request(
+      service, request_header, now, &admitted, &overloaded);
+    if (RCL_RET_OK != admit_ret) {
+      return admit_ret;  // error already set
+    }
+    if (overloaded) {
+      *taken = false;
+      return RCL_RET_OK;
+    }
+    if (!admitted) {
+      continue;
+    }
+    if (cache) {
+      rcl_service_response_cache_result_t result = rcl_service_response_cache_lookup(
+        cache, &request_header->request_id, ros_request, now);
+      if (RCL_SERVICE_RESPONSE_CACHE_HIT == result) {
+        RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service request answered from cache");
+        RCL_CLEAR_STALE_ERROR();
+        if (rmw_send_response(
+            service->impl->rmw_handle, &request_header->request_id,
+            service->impl->options.response_cache.response_buffer) != RMW_RET_OK)
+        {
+          RCL_SET_ERROR_MSG_FROM_RMW();
+          return RCL_RET_ERROR;
+        }
+        continue;
+      }
+      if (RCL_SERVICE_RESPONSE_CACHE_COALESCED == result) {
+        RCUTILS_LOG_DEBUG_NAMED(
+          ROS_PACKAGE_NAME, "Service request held back behind an identical request");
+        continue;
+      }
+    }
+    if (tracks_in_flight) {
+      rcl_service_in_flight_request_t * request =
+        &impl->in_flight_requests[impl->admission_stats.in_flight++];
+      request->request_id = request_header->request_id;
+      request->taken_time = now;
+    }
+    RCL_IN_PROCESS_TRACEPOINT(
+      rcl_take_request, (const void *)service, ros_request,
+      request_header->request_id.sequence_number, request_header->source_timestamp);
+    return RCL_RET_OK;
+  }
+}
+
+/// Send a response to the middleware, as well as to the requests held back behind it.
+static rcl_ret_t
+_rcl_send_response(
+  const rcl_service_t * service,
+  rmw_request_id_t * request_header,
+  void * ros_response)
+{
+  RCL_CLEAR_STALE_ERROR();
+  if (rmw_send_response(
+      service->impl->rmw_handle, request_header, ros_response) != RMW_RET_OK)
+  {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    // Identical requests must not keep waiting on a response which was not sent
+    if (service->impl->response_cache) {
+      rcl_service_response_cache_release(service->impl->response_cache, request_header);
+    }
+    return RCL_RET_ERROR;
+  }
+  RCL_IN_PROCESS_TRACEPOINT(
+    rcl_send_response, (const void *)service, ros_response, request_header->sequence_number);
+  if (0u != service->impl->admission_stats.in_flight) {
+    (void)_rcl_end_in_flight_request(service->impl, request_header);
+  }
+  rcl_service_response_cache_t * cache = service->impl->response_cache;
+  if (!cache) {
+    return RCL_RET_OK;
+  }
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG("failed to get current time");
+    return RCL_RET_ERROR;
+  }
+  const rmw_request_id_t * waiters = NULL;
+  size_t num_waiters = 0u;
+  rcl_service_response_cache_store(
+    cache, request_header, ros_response, now, &waiters, &num_waiters);
+  rcl_ret_t ret = RCL_RET_OK;
+  // Cleared once, so that a failure is still reported after the responses that follow it.
+  RCL_CLEAR_STALE_ERROR();
+  for (size_t i = 0u; i < num_waiters; ++i) {
+    rmw_request_id_t waiter = waiters[i];
+    if (rmw_send_response(service->impl->rmw_handle, &waiter, ros_response) != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG_FROM_RMW();
+      ret = RCL_RET_ERROR;
+    }
+  }
+  return ret;
+}
+
+rcl_ret_t
+rcl_service_release_request(
+  const rcl_service_t * service,
+  const rmw_request_id_t * request_header)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_header, RCL_RET_INVALID_ARGUMENT);
+  if (_rcl_end_in_flight_request(service->impl, request_header)) {
+    RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service request released");
+  }
+  if (service->impl->response_cache) {
+    rcl_service_response_cache_release(service->impl->response_cache, request_header);
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_take_request_with_info(
   const rcl_service_t * service,
@@ -236,14 +575,9 @@ rcl_take_request_with_info(
   RCL_CHECK_FOR_NULL_WITH_MSG(options, "Failed to get service options", return RCL_RET_ERROR);
 
   bool taken = false;
-  rmw_ret_t ret = rmw_take_request(
-    service->impl->rmw_handle, request_header, ros_request, &taken);
-  if (RMW_RET_OK != ret) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    if (RMW_RET_BAD_ALLOC == ret) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
+  rcl_ret_t ret = _rcl_take_request(service, request_header, ros_request, &taken);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
   }
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Service take request succeeded: %s", taken ? "true" : "false");
@@ -266,6 +600,47 @@ rcl_take_request(
   return ret;
 }
 
+rcl_ret_t
+rcl_take_request_sequence(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_service_info_t * request_headers,
+  void ** ros_requests,
+  size_t * taken)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service server taking service request sequence");
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0u;
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_headers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_requests, RCL_RET_INVALID_ARGUMENT);
+  for (size_t i = 0; i < count; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(ros_requests[i], RCL_RET_INVALID_ARGUMENT);
+  }
+
+  // rmw has no batched take for services, so requests are taken one by one
+  while (*taken < count) {
+    bool request_taken = false;
+    rcl_ret_t ret = _rcl_take_request(
+      service, &request_headers[*taken], ros_requests[*taken], &request_taken);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    if (!request_taken) {
+      break;
+    }
+    ++(*taken);
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Service take request sequence succeeded: %zu of %zu", *taken, count);
+  if (0u == *taken) {
+    return RCL_RET_SERVICE_TAKE_FAILED;
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_send_response(
   const rcl_service_t * service,
@@ -281,11 +656,36 @@ rcl_send_response(
   const rcl_service_options_t * options = rcl_service_get_options(service);
   RCL_CHECK_FOR_NULL_WITH_MSG(options, "Failed to get service options", return RCL_RET_ERROR);
 
-  if (rmw_send_response(
-      service->impl->rmw_handle, request_header, ros_response) != RMW_RET_OK)
-  {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    return RCL_RET_ERROR;
+  return _rcl_send_response(service, request_header, ros_response);
+}
+
+rcl_ret_t
+rcl_send_response_sequence(
+  const rcl_service_t * service,
+  size_t count,
+  rmw_request_id_t * response_headers,
+  void ** ros_responses,
+  size_t * sent)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Sending service response sequence");
+  RCL_CHECK_ARGUMENT_FOR_NULL(sent, RCL_RET_INVALID_ARGUMENT);
+  *sent = 0u;
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_headers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_responses, RCL_RET_INVALID_ARGUMENT);
+  for (size_t i = 0; i < count; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(ros_responses[i], RCL_RET_INVALID_ARGUMENT);
+  }
+
+  // rmw has no batched send for services, so responses are sent one by one
+  for (*sent = 0u; *sent < count; ++(*sent)) {
+    rcl_ret_t ret = _rcl_send_response(
+      service, &response_headers[*sent], ros_responses[*sent]);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
   }
   return RCL_RET_OK;
 }
@@ -0,0 +1,563 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./service_response_cache.h"
+
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw/serialized_message.h"
+
+#define RCL_SERVICE_RESPONSE_CACHE_INITIAL_NUM_BUCKETS 16u
+
+typedef struct rcl_service_response_cache_entry_t
+{
+  /// Neighbours in the least recently used order, most recent first.
+  struct rcl_service_response_cache_entry_t * prev;
+  struct rcl_service_response_cache_entry_t * next;
+  /// Next entry in the same hash bucket.
+  struct rcl_service_response_cache_entry_t * bucket_next;
+  uint64_t hash;
+  rcutils_time_point_value_t stored_at;
+  size_t request_size;
+  size_t response_size;
+  /// Serialized request followed by the serialized response.
+  uint8_t * data;
+} rcl_service_response_cache_entry_t;
+
+typedef struct rcl_service_response_cache_pending_t
+{
+  struct rcl_service_response_cache_pending_t * next;
+  uint64_t hash;
+  rmw_request_id_t request_id;
+  rcutils_time_point_value_t taken_at;
+  size_t request_size;
+  uint8_t * request;
+  rmw_request_id_t * waiters;
+  size_t num_waiters;
+  size_t waiters_capacity;
+} rcl_service_response_cache_pending_t;
+
+struct rcl_service_response_cache_t
+{
+  rcl_service_response_cache_options_t options;
+  rcl_allocator_t allocator;
+  rcl_serialized_message_t scratch;
+  rcl_service_response_cache_entry_t ** buckets;
+  size_t num_buckets;
+  size_t num_entries;
+  rcl_service_response_cache_entry_t * most_recent;
+  rcl_service_response_cache_entry_t * least_recent;
+  /// Memory used by the entries and the pending requests, bounded by the capacity.
+  size_t size;
+  rcl_service_response_cache_pending_t * pending;
+  /// Waiters of the last answered request, handed out by rcl_service_response_cache_store().
+  rmw_request_id_t * answered_waiters;
+  rcl_service_response_cache_stats_t stats;
+};
+
+static uint64_t
+_hash_bytes(const uint8_t * data, size_t size)
+{
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+static bool
+_request_id_equal(const rmw_request_id_t * lhs, const rmw_request_id_t * rhs)
+{
+  return lhs->sequence_number == rhs->sequence_number &&
+         0 == memcmp(lhs->writer_guid, rhs->writer_guid, sizeof(lhs->writer_guid));
+}
+
+static size_t
+_entry_footprint(const rcl_service_response_cache_entry_t * entry)
+{
+  return sizeof(*entry) + entry->request_size + entry->response_size;
+}
+
+static size_t
+_pending_footprint(const rcl_service_response_cache_pending_t * pending)
+{
+  return sizeof(*pending) + pending->request_size +
+         pending->waiters_capacity * sizeof(*pending->waiters);
+}
+
+static void
+_lru_unlink(rcl_service_response_cache_t * cache, rcl_service_response_cache_entry_t * entry)
+{
+  if (entry->prev) {
+    entry->prev->next = entry->next;
+  } else {
+    cache->most_recent = entry->next;
+  }
+  if (entry->next) {
+    entry->next->prev = entry->prev;
+  } else {
+    cache->least_recent = entry->prev;
+  }
+  entry->prev = NULL;
+  entry->next = NULL;
+}
+
+static void
+_lru_push_front(rcl_service_response_cache_t * cache, rcl_service_response_cache_entry_t * entry)
+{
+  entry->prev = NULL;
+  entry->next = cache->most_recent;
+  if (cache->most_recent) {
+    cache->most_recent->prev = entry;
+  } else {
+    cache->least_recent = entry;
+  }
+  cache->most_recent = entry;
+}
+
+static void
+_remove_entry(rcl_service_response_cache_t * cache, rcl_service_response_cache_entry_t * entry)
+{
+  rcl_service_response_cache_entry_t ** link =
+    &cache->buckets[entry->hash & (cache->num_buckets - 1u)];
+  while (*link != entry) {
+    link = &(*link)->bucket_next;
+  }
+  *link = entry->bucket_next;
+  _lru_unlink(cache, entry);
+  cache->size -= _entry_footprint(entry);
+  --cache->num_entries;
+  cache->allocator.deallocate(entry->data, cache->allocator.state);
+  cache->allocator.deallocate(entry, cache->allocator.state);
+}
+
+static void
+_grow_buckets(rcl_service_response_cache_t * cache)
+{
+  const size_t num_buckets = cache->num_buckets * 2u;
+  rcl_service_response_cache_entry_t ** buckets = cache->allocator.zero_allocate(
+    num_buckets, sizeof(*buckets), cache->allocator.state);
+  if (!buckets) {
+    // Longer chains are still correct
+    return;
+  }
+  for (size_t i = 0; i < cache->num_buckets; ++i) {
+    rcl_service_response_cache_entry_t * entry = cache->buckets[i];
+    while (entry) {
+      rcl_service_response_cache_entry_t * next = entry->bucket_next;
+      const size_t index = entry->hash & (num_buckets - 1u);
+      entry->bucket_next = buckets[index];
+      buckets[index] = entry;
+      entry = next;
+    }
+  }
+  cache->allocator.deallocate(cache->buckets, cache->allocator.state);
+  cache->buckets = buckets;
+  cache->num_buckets = num_buckets;
+}
+
+static rcl_service_response_cache_entry_t *
+_find_entry(
+  const rcl_service_response_cache_t * cache,
+  uint64_t hash,
+  const uint8_t * request,
+  size_t request_size)
+{
+  rcl_service_response_cache_entry_t * entry = cache->buckets[hash & (cache->num_buckets - 1u)];
+  for (; entry; entry = entry->bucket_next) {
+    if (entry->hash == hash && entry->request_size == request_size &&
+      0 == memcmp(entry->data, request, request_size))
+    {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+/// Evict the least recently used entries until `footprint` more bytes fit in the capacity.
+static bool
+_make_room(rcl_service_response_cache_t * cache, size_t footprint)
+{
+  if (footprint > cache->options.capacity) {
+    return false;
+  }
+  while (cache->least_recent && cache->size + footprint > cache->options.capacity) {
+    _remove_entry(cache, cache->least_recent);
+    ++cache->stats.evictions;
+  }
+  return cache->size + footprint <= cache->options.capacity;
+}
+
+static void
+_fini_pending(
+  rcl_service_response_cache_t * cache,
+  rcl_service_response_cache_pending_t * pending)
+{
+  cache->allocator.deallocate(pending->request, cache->allocator.state);
+  cache->allocator.deallocate(pending->waiters, cache->allocator.state);
+  cache->allocator.deallocate(pending, cache->allocator.state);
+}
+
+/// Unlink a pending request, which stops counting against the capacity.
+static rcl_service_response_cache_pending_t *
+_unlink_pending(
+  rcl_service_response_cache_t * cache,
+  rcl_service_response_cache_pending_t ** link)
+{
+  rcl_service_response_cache_pending_t * pending = *link;
+  *link = pending->next;
+  cache->size -= _pending_footprint(pending);
+  return pending;
+}
+
+/// Find the link to the pending request of an id, pointing to `NULL` if there is none.
+static rcl_service_response_cache_pending_t **
+_find_pending(rcl_service_response_cache_t * cache, const rmw_request_id_t * request_id)
+{
+  rcl_service_response_cache_pending_t ** link = &cache->pending;
+  while (*link && !_request_id_equal(&(*link)->request_id, request_id)) {
+    link = &(*link)->next;
+  }
+  return link;
+}
+
+/// Drop the requests handled for longer than the pending timeout, along with their waiters.
+static void
+_expire_pending(rcl_service_response_cache_t * cache, rcutils_time_point_value_t now)
+{
+  if (0 == cache->options.pending_timeout) {
+    return;
+  }
+  rcl_service_response_cache_pending_t ** link = &cache->pending;
+  while (*link) {
+    if (now - (*link)->taken_at > cache->options.pending_timeout) {
+      rcl_service_response_cache_pending_t * pending = _unlink_pending(cache, link);
+      RCUTILS_LOG_DEBUG_NAMED(
+        ROS_PACKAGE_NAME, "Service request pending for too long, dropping %zu waiters",
+        pending->num_waiters);
+      _fini_pending(cache, pending);
+    } else {
+      link = &(*link)->next;
+    }
+  }
+}
+
+rcl_ret_t
+rcl_service_response_cache_init(
+  const rcl_service_response_cache_options_t * options,
+  rcl_allocator_t allocator,
+  rcl_service_response_cache_t ** cache)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(cache, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    options->request_type_support, "response cache request type support is invalid",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    options->response_type_support, "response cache response type support is invalid",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    options->response_buffer, "response cache response buffer is invalid",
+    return RCL_RET_INVALID_ARGUMENT);
+  if (options->ttl < 0) {
+    RCL_SET_ERROR_MSG("response cache ttl must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (options->pending_timeout < 0) {
+    RCL_SET_ERROR_MSG("response cache pending timeout must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  rcl_service_response_cache_t * new_cache = allocator.zero_allocate(
+    1u, sizeof(rcl_service_response_cache_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(new_cache, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  new_cache->options = *options;
+  new_cache->allocator = allocator;
+  new_cache->scratch = rmw_get_zero_initialized_serialized_message();
+  new_cache->buckets = allocator.zero_allocate(
+    RCL_SERVICE_RESPONSE_CACHE_INITIAL_NUM_BUCKETS, sizeof(*new_cache->buckets),
+    allocator.state);
+  if (!new_cache->buckets ||
+    RMW_RET_OK != rmw_serialized_message_init(&new_cache->scratch, 0u, &allocator))
+  {
+    allocator.deallocate(new_cache->buckets, allocator.state);
+    allocator.deallocate(new_cache, allocator.state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  new_cache->num_buckets = RCL_SERVICE_RESPONSE_CACHE_INITIAL_NUM_BUCKETS;
+  *cache = new_cache;
+  return RCL_RET_OK;
+}
+
+void
+rcl_service_response_cache_fini(rcl_service_response_cache_t * cache)
+{
+  if (!cache) {
+    return;
+  }
+  rcl_allocator_t allocator = cache->allocator;
+  while (cache->most_recent) {
+    _remove_entry(cache, cache->most_recent);
+  }
+  while (cache->pending) {
+    rcl_service_response_cache_pending_t * next = cache->pending->next;
+    _fini_pending(cache, cache->pending);
+    cache->pending = next;
+  }
+  if (RMW_RET_OK != rmw_serialized_message_fini(&cache->scratch)) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "Failed to finalize response cache scratch: %s",
+      rmw_get_error_string().str);
+    rmw_reset_error();
+  }
+  allocator.deallocate(cache->answered_waiters, allocator.state);
+  allocator.deallocate(cache->buckets, allocator.state);
+  allocator.deallocate(cache, allocator.state);
+}
+
+rcl_service_response_cache_result_t
+rcl_service_response_cache_lookup(
+  rcl_service_response_cache_t * cache,
+  const rmw_request_id_t * request_id,
+  const void * ros_request,
+  rcutils_time_point_value_t now)
+{
+  if (RMW_RET_OK != rmw_serialize(
+      ros_request, cache->options.request_type_support, &cache->scratch))
+  {
+    RCUTILS_LOG_DEBUG_NAMED(
+      ROS_PACKAGE_NAME, "Failed to serialize request, not caching it: %s",
+      rmw_get_error_string().str);
+    rmw_reset_error();
+    ++cache->stats.misses;
+    return RCL_SERVICE_RESPONSE_CACHE_MISS;
+  }
+  const uint8_t * request = cache->scratch.buffer;
+  const size_t request_size = cache->scratch.buffer_length;
+  const uint64_t hash = _hash_bytes(request, request_size);
+  _expire_pending(cache, now);
+
+  rcl_service_response_cache_entry_t * entry = _find_entry(cache, hash, request, request_size);
+  if (entry && now - entry->stored_at > cache->options.ttl) {
+    _remove_entry(cache, entry);
+    entry = NULL;
+  }
+  if (entry) {
+    rcl_serialized_message_t response = rmw_get_zero_initialized_serialized_message();
+    response.buffer = entry->data + entry->request_size;
+    response.buffer_length = entry->response_size;
+    response.buffer_capacity = entry->response_size;
+    if (RMW_RET_OK == rmw_deserialize(
+        &response, cache->options.response_type_support, cache->options.response_buffer))
+    {
+      _lru_unlink(cache, entry);
+      _lru_push_front(cache, entry);
+      ++cache->stats.hits;
+      return RCL_SERVICE_RESPONSE_CACHE_HIT;
+    }
+    RCUTILS_LOG_DEBUG_NAMED(
+      ROS_PACKAGE_NAME, "Failed to deserialize cached response, dropping it: %s",
+      rmw_get_error_string().str);
+    rmw_reset_error();
+    _remove_entry(cache, entry);
+  }
+
+  rcl_service_response_cache_pending_t * pending = cache->pending;
+  for (; pending; pending = pending->next) {
+    if (pending->hash == hash && pending->request_size == request_size &&
+      0 == memcmp(pending->request, request, request_size))
+    {
+      break;
+    }
+  }
+  if (pending) {
+    if (pending->num_waiters == pending->waiters_capacity) {
+      // Past the capacity, the request is handled on its own rather than held back
+      const size_t capacity = pending->waiters_capacity ? pending->waiters_capacity * 2u : 4u;
+      const size_t growth = (capacity - pending->waiters_capacity) * sizeof(*pending->waiters);
+      rmw_request_id_t * waiters = NULL;
+      if (_make_room(cache, growth)) {
+        waiters = cache->allocator.reallocate(
+          pending->waiters, capacity * sizeof(*waiters), cache->allocator.state);
+      }
+      if (!waiters) {
+        ++cache->stats.misses;
+        return RCL_SERVICE_RESPONSE_CACHE_MISS;
+      }
+      pending->waiters = waiters;
+      pending->waiters_capacity = capacity;
+      cache->size += growth;
+    }
+    pending->waiters[pending->num_waiters++] = *request_id;
+    ++cache->stats.coalesced;
+    return RCL_SERVICE_RESPONSE_CACHE_COALESCED;
+  }
+
+  ++cache->stats.misses;
+  if (!_make_room(cache, sizeof(*pending) + request_size)) {
+    // Too large to track, the response will not be cached either
+    return RCL_SERVICE_RESPONSE_CACHE_MISS;
+  }
+  pending = cache->allocator.zero_allocate(1u, sizeof(*pending), cache->allocator.state);
+  if (!pending) {
+    return RCL_SERVICE_RESPONSE_CACHE_MISS;
+  }
+  pending->request = cache->allocator.allocate(
+    request_size ? request_size : 1u, cache->allocator.state);
+  if (!pending->request) {
+    cache->allocator.deallocate(pending, cache->allocator.state);
+    return RCL_SERVICE_RESPONSE_CACHE_MISS;
+  }
+  memcpy(pending->request, request, request_size);
+  pending->request_size = request_size;
+  pending->hash = hash;
+  pending->request_id = *request_id;
+  pending->taken_at = now;
+  pending->next = cache->pending;
+  cache->pending = pending;
+  cache->size += _pending_footprint(pending);
+  return RCL_SERVICE_RESPONSE_CACHE_MISS;
+}
+
+void
+rcl_service_response_cache_store(
+  rcl_service_response_cache_t * cache,
+  const rmw_request_id_t * request_id,
+  const void * ros_response,
+  rcutils_time_point_value_t now,
+  const rmw_request_id_t ** waiters,
+  size_t * num_waiters)
+{
+  *waiters = NULL;
+  *num_waiters = 0u;
+  rcl_service_response_cache_pending_t ** link = _find_pending(cache, request_id);
+  if (!*link) {
+    // Not a pending request, e.g. too large to track or timed out
+    return;
+  }
+  rcl_service_response_cache_pending_t * pending = _unlink_pending(cache, link);
+
+  // Hand out the waiters, keeping them until the next call
+  cache->allocator.deallocate(cache->answered_waiters, cache->allocator.state);
+  cache->answered_waiters = pending->waiters;
+  *waiters = pending->waiters;
+  *num_waiters = pending->num_waiters;
+  pending->waiters = NULL;
+
+  if (0 == cache->options.ttl) {
+    // Only coalescing identical requests
+    _fini_pending(cache, pending);
+    return;
+  }
+  if (RMW_RET_OK != rmw_serialize(
+      ros_response, cache->options.response_type_support, &cache->scratch))
+  {
+    RCUTILS_LOG_DEBUG_NAMED(
+      ROS_PACKAGE_NAME, "Failed to serialize response, not caching it: %s",
+      rmw_get_error_string().str);
+    rmw_reset_error();
+    _fini_pending(cache, pending);
+    return;
+  }
+  const size_t response_size = cache->scratch.buffer_length;
+  const size_t footprint =
+    sizeof(rcl_service_response_cache_entry_t) + pending->request_size + response_size;
+  rcl_service_response_cache_entry_t * entry = NULL;
+  if (footprint <= cache->options.capacity) {
+    entry = cache->allocator.zero_allocate(1u, sizeof(*entry), cache->allocator.state);
+  }
+  uint8_t * data = NULL;
+  if (entry) {
+    data = cache->allocator.reallocate(
+      pending->request, pending->request_size + response_size, cache->allocator.state);
+  }
+  if (!data) {
+    cache->allocator.deallocate(entry, cache->allocator.state);
+    _fini_pending(cache, pending);
+    return;
+  }
+  memcpy(data + pending->request_size, cache->scratch.buffer, response_size);
+  entry->hash = pending->hash;
+  entry->stored_at = now;
+  entry->request_size = pending->request_size;
+  entry->response_size = response_size;
+  entry->data = data;
+  pending->request = NULL;
+  _fini_pending(cache, pending);
+
+  // Replace any stale entry for the same request, then make room
+  rcl_service_response_cache_entry_t * previous =
+    _find_entry(cache, entry->hash, entry->data, entry->request_size);
+  if (previous) {
+    _remove_entry(cache, previous);
+  }
+  if (!_make_room(cache, footprint)) {
+    // The pending requests use the rest of the capacity
+    cache->allocator.deallocate(entry->data, cache->allocator.state);
+    cache->allocator.deallocate(entry, cache->allocator.state);
+    return;
+  }
+  if (cache->num_entries >= cache->num_buckets) {
+    _grow_buckets(cache);
+  }
+  rcl_service_response_cache_entry_t ** bucket =
+    &cache->buckets[entry->hash & (cache->num_buckets - 1u)];
+  entry->bucket_next = *bucket;
+  *bucket = entry;
+  _lru_push_front(cache, entry);
+  cache->size += footprint;
+  ++cache->num_entries;
+}
+
+void
+rcl_service_response_cache_release(
+  rcl_service_response_cache_t * cache,
+  const rmw_request_id_t * request_id)
+{
+  rcl_service_response_cache_pending_t ** link = _find_pending(cache, request_id);
+  if (!*link) {
+    // Not a pending request, e.g. too large to track, timed out or already answered
+    return;
+  }
+  rcl_service_response_cache_pending_t * pending = _unlink_pending(cache, link);
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Service request released, dropping %zu waiters", pending->num_waiters);
+  _fini_pending(cache, pending);
+}
+
+void
+rcl_service_response_cache_get_stats(
+  const rcl_service_response_cache_t * cache,
+  rcl_service_response_cache_stats_t * stats)
+{
+  *stats = cache->stats;
+  stats->num_entries = cache->num_entries;
+  stats->size = cache->size;
+}
+
+#ifdef __cplusplus
+}
+#endif
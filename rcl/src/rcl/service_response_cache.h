@@ -0,0 +1,123 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__SERVICE_RESPONSE_CACHE_H_
+#define RCL__SERVICE_RESPONSE_CACHE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/service.h"
+#include "rcutils/time.h"
+#include "rmw/types.h"
+
+/// Cache of the responses of a service, keyed by serialized request.
+typedef struct rcl_service_response_cache_t rcl_service_response_cache_t;
+
+/// Outcome of looking up a taken request in the response cache.
+typedef enum rcl_service_response_cache_result_t
+{
+  /// The request has to be handled, its response will be cached once sent.
+  RCL_SERVICE_RESPONSE_CACHE_MISS,
+  /// A cached response to the request was deserialized into the response buffer.
+  RCL_SERVICE_RESPONSE_CACHE_HIT,
+  /// An identical request is being handled, the request will be answered with its response.
+  RCL_SERVICE_RESPONSE_CACHE_COALESCED,
+} rcl_service_response_cache_result_t;
+
+/// Create a response cache.
+/**
+ * \param[in] options the response cache options, with a non zero capacity
+ * \param[in] allocator the allocator used for the cache and its entries
+ * \param[out] cache the created cache
+ * \return #RCL_RET_OK if the cache was created, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any option is invalid, or
+ * \return #RCL_RET_BAD_ALLOC if allocating memory failed.
+ */
+rcl_ret_t
+rcl_service_response_cache_init(
+  const rcl_service_response_cache_options_t * options,
+  rcl_allocator_t allocator,
+  rcl_service_response_cache_t ** cache);
+
+/// Destroy a response cache, `NULL` is ignored.
+void
+rcl_service_response_cache_fini(rcl_service_response_cache_t * cache);
+
+/// Look up a request just taken by the service.
+/**
+ * Requests that cannot be serialized or tracked, e.g. for lack of memory, are
+ * reported as misses and are not cached.
+ *
+ * \param[in] cache the response cache
+ * \param[in] request_id the id of the taken request
+ * \param[in] ros_request the taken request
+ * \param[in] now the current steady time
+ * \return what has to be done with the request.
+ */
+rcl_service_response_cache_result_t
+rcl_service_response_cache_lookup(
+  rcl_service_response_cache_t * cache,
+  const rmw_request_id_t * request_id,
+  const void * ros_request,
+  rcutils_time_point_value_t now);
+
+/// Store the response sent for a request reported as a miss.
+/**
+ * The ids of the requests coalesced with the answered one are returned,
+ * valid until the next call on the cache, and must be sent the same response.
+ *
+ * \param[in] cache the response cache
+ * \param[in] request_id the id of the answered request
+ * \param[in] ros_response the response sent
+ * \param[in] now the current steady time
+ * \param[out] waiters the ids of the coalesced requests
+ * \param[out] num_waiters the number of coalesced requests
+ */
+void
+rcl_service_response_cache_store(
+  rcl_service_response_cache_t * cache,
+  const rmw_request_id_t * request_id,
+  const void * ros_response,
+  rcutils_time_point_value_t now,
+  const rmw_request_id_t ** waiters,
+  size_t * num_waiters);
+
+/// Forget a request reported as a miss, which is not going to be answered.
+/**
+ * The requests coalesced with it are dropped without a response, as they
+ * would be once the pending timeout passed.
+ * Nothing is done if the request is not pending.
+ *
+ * \param[in] cache the response cache
+ * \param[in] request_id the id of the released request
+ */
+void
+rcl_service_response_cache_release(
+  rcl_service_response_cache_t * cache,
+  const rmw_request_id_t * request_id);
+
+/// Get the counters of a response cache.
+void
+rcl_service_response_cache_get_stats(
+  const rcl_service_response_cache_t * cache,
+  rcl_service_response_cache_stats_t * stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__SERVICE_RESPONSE_CACHE_H_
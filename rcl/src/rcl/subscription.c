@@ -21,12 +21,14 @@ extern "C"
 
 #include <stdio.h>
 
+#include "rcl/compression.h"
 #include "rcl/error_handling.h"
 #include "rcl/node.h"
+#include "rcl/tracing.h"
 #include "rcutils/logging_macros.h"
 #include "rmw/error_handling.h"
+#include "rmw/serialized_message.h"
 #include "rmw/validate_full_topic_name.h"
-#include "tracetools/tracetools.h"
 
 #include "./common.h"
 #include "./subscription_impl.h"
@@ -66,6 +68,13 @@ rcl_subscription_init(
     RCL_SET_ERROR_MSG("subscription already initialized, or memory was uninitialized");
     return RCL_RET_ALREADY_INIT;
   }
+  if (options->dispatch.relative_deadline < 0) {
+    RCL_SET_ERROR_MSG("subscription relative deadline must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (options->compression.name && !rcl_compression_codec_is_valid(&options->compression)) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
 
   // Expand and remap the given topic name.
   char * remapped_topic_name = NULL;
@@ -86,12 +95,30 @@ rcl_subscription_init(
   }
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Expanded and remapped topic name '%s'", remapped_topic_name);
+  // Only publishers using the same codec match the compressed topic.
+  if (options->compression.name) {
+    char * compressed_topic_name = NULL;
+    ret = rcl_compression_get_topic_name(
+      remapped_topic_name, &options->compression, *allocator, &compressed_topic_name);
+    if (RCL_RET_OK != ret) {
+      goto cleanup;
+    }
+    allocator->deallocate(remapped_topic_name, allocator->state);
+    remapped_topic_name = compressed_topic_name;
+  }
 
   // Allocate memory for the implementation struct.
   subscription->impl = (rcl_subscription_impl_t *)allocator->allocate(
     sizeof(rcl_subscription_impl_t), allocator->state);
   RCL_CHECK_FOR_NULL_WITH_MSG(
     subscription->impl, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto cleanup);
+  // compression buffers, empty until the first decompressing take
+  ret = rcl_compression_buffers_init(&subscription->impl->compression_buffers, *allocator);
+  if (RCL_RET_OK != ret) {
+    allocator->deallocate(subscription->impl, allocator->state);
+    subscription->impl = NULL;
+    goto cleanup;  // error already set
+  }
   // Fill out the implemenation struct.
   // rmw_handle
   // TODO(wjwwood): pass allocator once supported in rmw api.
@@ -115,11 +142,13 @@ rcl_subscription_init(
   }
   subscription->impl->actual_qos.avoid_ros_namespace_conventions =
     options->qos.avoid_ros_namespace_conventions;
+  subscription->impl->type_support = type_support;
+  subscription->impl->rmw_node_handle = rcl_node_get_rmw_handle(node);
   // options
   subscription->impl->options = *options;
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription initialized");
   ret = RCL_RET_OK;
-  TRACEPOINT(
+  RCL_TRACEPOINT(
     rcl_subscription_init,
     (const void *)subscription,
     (const void *)node,
@@ -137,6 +166,7 @@ fail:
         RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
       }
     }
+    rcl_compression_buffers_fini(&subscription->impl->compression_buffers);
 
     allocator->deallocate(subscription->impl, allocator->state);
     subscription->impl = NULL;
@@ -174,6 +204,7 @@ rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node)
       RCL_SET_ERROR_MSG(rmw_get_error_string().str);
       result = RCL_RET_ERROR;
     }
+    rcl_compression_buffers_fini(&subscription->impl->compression_buffers);
     allocator.deallocate(subscription->impl, allocator.state);
     subscription->impl = NULL;
   }
@@ -190,9 +221,59 @@ rcl_subscription_get_default_options()
   default_options.qos = rmw_qos_profile_default;
   default_options.allocator = rcl_get_default_allocator();
   default_options.rmw_subscription_options = rmw_get_default_subscription_options();
+  default_options.dispatch = rcl_dispatch_get_default_attributes();
+  default_options.compression = rcl_get_zero_initialized_compression_codec();
   return default_options;
 }
 
+/// Take a compressed message and decompress it into a serialized message.
+static rcl_ret_t
+_rcl_take_decompressed_serialized_message(
+  rcl_subscription_impl_t * impl,
+  rcl_serialized_message_t * serialized_message,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  rcl_compression_buffers_t * buffers = &impl->compression_buffers;
+  bool taken = false;
+  RCL_CLEAR_STALE_ERROR();
+  rmw_ret_t rmw_ret = rmw_take_serialized_message_with_info(
+    impl->rmw_handle, &buffers->compressed_message, &taken, message_info, allocation);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  if (!taken) {
+    return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+  }
+  return rcl_decompress_serialized_message(
+    &impl->options.compression, &buffers->compressed_message, serialized_message,
+    &buffers->scratch);
+}
+
+/// Take a compressed message, then decompress and deserialize it.
+static rcl_ret_t
+_rcl_take_decompressed(
+  rcl_subscription_impl_t * impl,
+  void * ros_message,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  rcl_serialized_message_t * serialized_message = &impl->compression_buffers.serialized_message;
+  rcl_ret_t ret = _rcl_take_decompressed_serialized_message(
+    impl, serialized_message, message_info, allocation);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set, unless nothing was taken
+  }
+  RCL_CLEAR_STALE_ERROR();
+  rmw_ret_t rmw_ret = rmw_deserialize(serialized_message, impl->type_support, ros_message);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG_FROM_RMW();
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_take(
   const rcl_subscription_t * subscription,
@@ -211,12 +292,24 @@ rcl_take(
   rmw_message_info_t dummy_message_info;
   rmw_message_info_t * message_info_local = message_info ? message_info : &dummy_message_info;
   *message_info_local = rmw_get_zero_initialized_message_info();
+  if (subscription->impl->options.compression.name) {
+    rcl_ret_t decompressed_ret = _rcl_take_decompressed(
+      subscription->impl, ros_message, message_info_local, allocation);
+    if (RCL_RET_OK != decompressed_ret) {
+      return decompressed_ret;  // error already set, unless nothing was taken
+    }
+    RCL_IN_PROCESS_TRACEPOINT(
+      rcl_take, (const void *)subscription, (const void *)ros_message,
+      message_info_local->source_timestamp, message_info_local->received_timestamp);
+    return RCL_RET_OK;
+  }
   // Call rmw_take_with_info.
   bool taken = false;
+  RCL_CLEAR_STALE_ERROR();
   rmw_ret_t ret = rmw_take_with_info(
     subscription->impl->rmw_handle, ros_message, &taken, message_info_local, allocation);
   if (ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return rcl_convert_rmw_ret_to_rcl_ret(ret);
   }
   RCUTILS_LOG_DEBUG_NAMED(
@@ -224,6 +317,9 @@ rcl_take(
   if (!taken) {
     return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
   }
+  RCL_IN_PROCESS_TRACEPOINT(
+    rcl_take, (const void *)subscription, (const void *)ros_message,
+    message_info_local->source_timestamp, message_info_local->received_timestamp);
   return RCL_RET_OK;
 }
 
@@ -242,6 +338,10 @@ rcl_take_sequence(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(message_sequence, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(message_info_sequence, RCL_RET_INVALID_ARGUMENT);
+  if (subscription->impl->options.compression.name) {
+    RCL_SET_ERROR_MSG("subscriptions decompressing their messages cannot take sequences");
+    return RCL_RET_UNSUPPORTED;
+  }
 
   if (message_sequence->capacity < count) {
     RCL_SET_ERROR_MSG("Insufficient message sequence capacity for requested count");
@@ -258,11 +358,12 @@ rcl_take_sequence(
   message_info_sequence->size = 0u;
 
   size_t taken = 0u;
+  RCL_CLEAR_STALE_ERROR();
   rmw_ret_t ret = rmw_take_sequence(
     subscription->impl->rmw_handle, count, message_sequence, message_info_sequence, &taken,
     allocation);
   if (ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return rcl_convert_rmw_ret_to_rcl_ret(ret);
   }
   RCUTILS_LOG_DEBUG_NAMED(
@@ -270,6 +371,14 @@ rcl_take_sequence(
   if (0u == taken) {
     return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
   }
+#ifdef RCL_TRACING_ENABLED
+  for (size_t i = 0u; i < taken; ++i) {
+    RCL_IN_PROCESS_TRACEPOINT(
+      rcl_take, (const void *)subscription, (const void *)message_sequence->data[i],
+      message_info_sequence->data[i].source_timestamp,
+      message_info_sequence->data[i].received_timestamp);
+  }
+#endif
   return RCL_RET_OK;
 }
 
@@ -290,12 +399,24 @@ rcl_take_serialized_message(
   rmw_message_info_t dummy_message_info;
   rmw_message_info_t * message_info_local = message_info ? message_info : &dummy_message_info;
   *message_info_local = rmw_get_zero_initialized_message_info();
+  if (subscription->impl->options.compression.name) {
+    rcl_ret_t decompressed_ret = _rcl_take_decompressed_serialized_message(
+      subscription->impl, serialized_message, message_info_local, allocation);
+    if (RCL_RET_OK != decompressed_ret) {
+      return decompressed_ret;  // error already set, unless nothing was taken
+    }
+    RCL_IN_PROCESS_TRACEPOINT(
+      rcl_take, (const void *)subscription, (const void *)serialized_message,
+      message_info_local->source_timestamp, message_info_local->received_timestamp);
+    return RCL_RET_OK;
+  }
   // Call rmw_take_with_info.
   bool taken = false;
+  RCL_CLEAR_STALE_ERROR();
   rmw_ret_t ret = rmw_take_serialized_message_with_info(
     subscription->impl->rmw_handle, serialized_message, &taken, message_info_local, allocation);
   if (ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return rcl_convert_rmw_ret_to_rcl_ret(ret);
   }
   RCUTILS_LOG_DEBUG_NAMED(
@@ -303,6 +424,9 @@ rcl_take_serialized_message(
   if (!taken) {
     return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
   }
+  RCL_IN_PROCESS_TRACEPOINT(
+    rcl_take, (const void *)subscription, (const void *)serialized_message,
+    message_info_local->source_timestamp, message_info_local->received_timestamp);
   return RCL_RET_OK;
 }
 
@@ -322,16 +446,21 @@ rcl_take_loaned_message(
     RCL_SET_ERROR_MSG("loaned message is already initialized");
     return RCL_RET_INVALID_ARGUMENT;
   }
+  if (subscription->impl->options.compression.name) {
+    RCL_SET_ERROR_MSG("subscriptions decompressing their messages cannot loan them");
+    return RCL_RET_UNSUPPORTED;
+  }
   // If message_info is NULL, use a place holder which can be discarded.
   rmw_message_info_t dummy_message_info;
   rmw_message_info_t * message_info_local = message_info ? message_info : &dummy_message_info;
   *message_info_local = rmw_get_zero_initialized_message_info();
   // Call rmw_take_with_info.
   bool taken = false;
+  RCL_CLEAR_STALE_ERROR();
   rmw_ret_t ret = rmw_take_loaned_message_with_info(
     subscription->impl->rmw_handle, loaned_message, &taken, message_info_local, allocation);
   if (ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return rcl_convert_rmw_ret_to_rcl_ret(ret);
   }
   RCUTILS_LOG_DEBUG_NAMED(
@@ -339,6 +468,9 @@ rcl_take_loaned_message(
   if (!taken) {
     return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
   }
+  RCL_IN_PROCESS_TRACEPOINT(
+    rcl_take, (const void *)subscription, (const void *)*loaned_message,
+    message_info_local->source_timestamp, message_info_local->received_timestamp);
   return RCL_RET_OK;
 }
 
@@ -434,6 +566,9 @@ rcl_subscription_can_loan_messages(const rcl_subscription_t * subscription)
   if (!rcl_subscription_is_valid(subscription)) {
     return false;  // error message already set
   }
+  if (subscription->impl->options.compression.name) {
+    return false;
+  }
   return subscription->impl->rmw_handle->can_loan_messages;
 }
 
@@ -19,11 +19,18 @@
 
 #include "rcl/subscription.h"
 
+#include "./compression_impl.h"
+
 typedef struct rcl_subscription_impl_t
 {
   rcl_subscription_options_t options;
   rmw_qos_profile_t actual_qos;
   rmw_subscription_t * rmw_handle;
+  /// Rmw handle of the node the subscription was created with.
+  const rmw_node_t * rmw_node_handle;
+  const rosidl_message_type_support_t * type_support;
+  /// Buffers reused by decompressing takes, which are not thread-safe.
+  rcl_compression_buffers_t compression_buffers;
 } rcl_subscription_impl_t;
 
 #endif  // RCL__SUBSCRIPTION_IMPL_H_
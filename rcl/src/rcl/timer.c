@@ -22,10 +22,10 @@ extern "C"
 #include <inttypes.h>
 
 #include "rcl/error_handling.h"
+#include "rcl/tracing.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/stdatomic_helper.h"
 #include "rcutils/time.h"
-#include "tracetools/tracetools.h"
 
 typedef struct rcl_timer_impl_t
 {
@@ -48,6 +48,8 @@ typedef struct rcl_timer_impl_t
   atomic_int_least64_t time_credit;
   // A flag which indicates if the timer is canceled.
   atomic_bool canceled;
+  // Scheduling attributes, see rcl/dispatch.h.
+  rcl_dispatch_attributes_t dispatch;
   // The user supplied allocator.
   rcl_allocator_t allocator;
 } rcl_timer_impl_t;
@@ -180,6 +182,7 @@ rcl_timer_init(
   atomic_init(&impl.last_call_time, now);
   atomic_init(&impl.next_call_time, now + period);
   atomic_init(&impl.canceled, false);
+  impl.dispatch = rcl_dispatch_get_default_attributes();
   impl.allocator = allocator;
   timer->impl = (rcl_timer_impl_t *)allocator.allocate(sizeof(rcl_timer_impl_t), allocator.state);
   if (NULL == timer->impl) {
@@ -196,7 +199,7 @@ rcl_timer_init(
     return RCL_RET_BAD_ALLOC;
   }
   *timer->impl = impl;
-  TRACEPOINT(rcl_timer_init, (const void *)timer, period);
+  RCL_TRACEPOINT(rcl_timer_init, (const void *)timer, period);
   return RCL_RET_OK;
 }
 
@@ -245,7 +248,7 @@ rcl_timer_call(rcl_timer_t * timer)
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Calling timer");
   RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
   if (rcutils_atomic_load_bool(&timer->impl->canceled)) {
-    RCL_SET_ERROR_MSG("timer is canceled");
+    // An expected outcome for executors, not an error worth formatting.
     return RCL_RET_TIMER_CANCELED;
   }
   rcl_time_point_value_t now;
@@ -264,6 +267,7 @@ rcl_timer_call(rcl_timer_t * timer)
 
   int64_t next_call_time = rcutils_atomic_load_int64_t(&timer->impl->next_call_time);
   int64_t period = rcutils_atomic_load_uint64_t(&timer->impl->period);
+  RCL_IN_PROCESS_TRACEPOINT(rcl_timer_call, (const void *)timer, now, next_call_time);
   // always move the next call time by exactly period forward
   // don't use now as the base to avoid extending each cycle by the time
   // between the timer being ready and the callback being triggered
@@ -285,7 +289,9 @@ rcl_timer_call(rcl_timer_t * timer)
 
   if (typed_callback != NULL) {
     int64_t since_last_call = now - previous_ns;
+    RCL_IN_PROCESS_TRACEPOINT(rcl_timer_callback_start, (const void *)timer, typed_callback);
     typed_callback(timer, since_last_call);
+    RCL_IN_PROCESS_TRACEPOINT(rcl_timer_callback_end, (const void *)timer);
   }
   return RCL_RET_OK;
 }
@@ -439,6 +445,34 @@ rcl_timer_get_guard_condition(const rcl_timer_t * timer)
   return &timer->impl->guard_condition;
 }
 
+rcl_ret_t
+rcl_timer_set_dispatch_attributes(
+  rcl_timer_t * timer,
+  const rcl_dispatch_attributes_t * attributes)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(attributes, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
+  if (attributes->relative_deadline < 0) {
+    RCL_SET_ERROR_MSG("relative deadline must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  timer->impl->dispatch = *attributes;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_get_dispatch_attributes(
+  const rcl_timer_t * timer,
+  rcl_dispatch_attributes_t * attributes)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(attributes, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
+  *attributes = timer->impl->dispatch;
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
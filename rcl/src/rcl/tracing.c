@@ -0,0 +1,767 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/tracing.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/macros.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rcutils/time.h"
+
+#ifdef RCL_TRACING_ENABLED
+
+#if defined(_WIN32)
+# include <windows.h>
+#else
+# include <pthread.h>
+#endif
+
+#define RCL_TRACING_FILE_MAGIC "RCLTRACE"
+#define RCL_TRACING_FILE_VERSION 1u
+
+// Header of the binary trace files, followed by the events.
+typedef struct rcl_tracing_file_header_t
+{
+  char magic[8];
+  uint32_t version;
+  // Size of an event, to reject files written by a build with a different event layout.
+  uint32_t event_size;
+} rcl_tracing_file_header_t;
+
+// Ring buffer of the events of one thread.
+// Only the owning thread advances `head` and only the draining thread advances `tail`.
+typedef struct rcl_tracing_buffer_t
+{
+  atomic_uint_least64_t head;
+  atomic_uint_least64_t tail;
+  rcl_tracing_event_t events[];
+} rcl_tracing_buffer_t;
+
+typedef enum rcl_tracing_argument_kind_e
+{
+  // Unused argument.
+  RCL_TRACING_ARGUMENT_NONE = 0,
+  // Pointer or identifier, exported as a hexadecimal string.
+  RCL_TRACING_ARGUMENT_POINTER,
+  RCL_TRACING_ARGUMENT_UNSIGNED,
+  // Stored as the two's complement of a signed integer, e.g. a timeout or a timestamp.
+  RCL_TRACING_ARGUMENT_SIGNED
+} rcl_tracing_argument_kind_t;
+
+typedef struct rcl_tracing_argument_description_t
+{
+  // Name of the argument in the exported traces.
+  const char * name;
+  rcl_tracing_argument_kind_t kind;
+} rcl_tracing_argument_description_t;
+
+typedef struct rcl_tracing_event_description_t
+{
+  const char * name;
+  // Chrome trace phase, "B" and "E" delimit a duration on the recording thread.
+  const char * phase;
+  rcl_tracing_argument_description_t args[4];
+  const char * texts[2];
+} rcl_tracing_event_description_t;
+
+#define POINTER(name) {name, RCL_TRACING_ARGUMENT_POINTER}
+#define UNSIGNED(name) {name, RCL_TRACING_ARGUMENT_UNSIGNED}
+#define SIGNED(name) {name, RCL_TRACING_ARGUMENT_SIGNED}
+
+// Indexed by rcl_tracing_event_type_t, the arguments are named after the tracetools ones.
+static const rcl_tracing_event_description_t
+  g_rcl_tracing_events[RCL_TRACING_EVENT_TYPE_COUNT] = {
+  {"rcl_init", "i", {POINTER("context")}, {NULL}},
+  {
+    "rcl_node_init", "i", {POINTER("node_handle"), POINTER("rmw_handle")},
+    {"node_name", "namespace"}
+  },
+  {
+    "rcl_publisher_init", "i",
+    {POINTER("publisher_handle"), POINTER("node_handle"), POINTER("rmw_publisher_handle"),
+      UNSIGNED("queue_depth")},
+    {"topic_name"}
+  },
+  {
+    "rcl_subscription_init", "i",
+    {POINTER("subscription_handle"), POINTER("node_handle"), POINTER("rmw_subscription_handle"),
+      UNSIGNED("queue_depth")},
+    {"topic_name"}
+  },
+  {
+    "rcl_service_init", "i",
+    {POINTER("service_handle"), POINTER("node_handle"), POINTER("rmw_service_handle")},
+    {"service_name"}
+  },
+  {
+    "rcl_client_init", "i",
+    {POINTER("client_handle"), POINTER("node_handle"), POINTER("rmw_client_handle")},
+    {"service_name"}
+  },
+  {"rcl_timer_init", "i", {POINTER("timer_handle"), SIGNED("period")}, {NULL}},
+  {"rcl_publish", "i", {POINTER("publisher_handle"), POINTER("message")}, {NULL}},
+  {
+    "rcl_lifecycle_state_machine_init", "i",
+    {POINTER("node_handle"), POINTER("state_machine")}, {NULL}
+  },
+  {"rcl_lifecycle_transition", "i", {POINTER("state_machine")}, {"start_label", "goal_label"}},
+  {
+    "rcl_take", "i",
+    {POINTER("subscription_handle"), POINTER("message"), SIGNED("source_timestamp"),
+      SIGNED("received_timestamp")},
+    {NULL}
+  },
+  {
+    "rcl_send_request", "i",
+    {POINTER("client_handle"), POINTER("request"), SIGNED("sequence_number")}, {NULL}
+  },
+  {
+    "rcl_take_request", "i",
+    {POINTER("service_handle"), POINTER("request"), SIGNED("sequence_number"),
+      SIGNED("source_timestamp")},
+    {NULL}
+  },
+  {
+    "rcl_send_response", "i",
+    {POINTER("service_handle"), POINTER("response"), SIGNED("sequence_number")}, {NULL}
+  },
+  {
+    "rcl_take_response", "i",
+    {POINTER("client_handle"), POINTER("response"), SIGNED("sequence_number"),
+      SIGNED("source_timestamp")},
+    {NULL}
+  },
+  {"rcl_wait", "B", {POINTER("wait_set"), SIGNED("timeout")}, {NULL}},
+  {"rcl_wait", "E", {POINTER("wait_set"), SIGNED("return_code")}, {NULL}},
+  {
+    "rcl_timer_call", "i",
+    {POINTER("timer_handle"), SIGNED("call_time"), SIGNED("scheduled_time")}, {NULL}
+  },
+  {"rcl_timer_callback", "B", {POINTER("timer_handle"), POINTER("callback")}, {NULL}},
+  {"rcl_timer_callback", "E", {POINTER("timer_handle")}, {NULL}},
+  {
+    "rcl_action_accept_new_goal", "i",
+    {POINTER("action_server"), POINTER("goal_handle"), POINTER("goal_id_high"),
+      POINTER("goal_id_low")},
+    {NULL}
+  },
+  {
+    "rcl_action_update_goal_state", "i",
+    {POINTER("goal_handle"), UNSIGNED("goal_event"), UNSIGNED("goal_state")}, {NULL}
+  },
+  {
+    "rcl_action_expire_goals", "i",
+    {POINTER("action_server"), UNSIGNED("num_expired")}, {NULL}
+  },
+};
+
+#undef POINTER
+#undef UNSIGNED
+#undef SIGNED
+
+static atomic_bool g_rcl_tracing_is_recording;
+// Bumped when the buffers are freed, so that threads claim a new one.
+static atomic_uint_least64_t g_rcl_tracing_generation;
+static atomic_uintptr_t g_rcl_tracing_buffers[RCL_TRACING_MAX_THREADS];
+// Generation plus one of the thread owning each buffer, zero while the buffer is free.
+// A buffer is kept with its events when its thread exits, and reused by the next thread.
+static atomic_uint_least64_t g_rcl_tracing_buffer_owners[RCL_TRACING_MAX_THREADS];
+static atomic_uint_least64_t g_rcl_tracing_dropped_event_count;
+// Written before recording starts, so read safely by the recording threads.
+static size_t g_rcl_tracing_capacity = 0u;
+static rcl_allocator_t g_rcl_tracing_allocator;
+
+// Buffer of the calling thread, valid while its generation is the current one.
+static RCUTILS_THREAD_LOCAL rcl_tracing_buffer_t * g_rcl_tracing_thread_buffer = NULL;
+// Generation plus one of the buffer of the calling thread, zero if it never claimed one.
+static RCUTILS_THREAD_LOCAL uint64_t g_rcl_tracing_thread_generation = 0u;
+
+// Release the buffer of an exiting thread, `value` is the index of the buffer plus one.
+static void
+rcl_tracing_release_thread_buffer(void * value)
+{
+  const size_t index = (size_t)((uintptr_t)value - 1u);
+  uint64_t generation = g_rcl_tracing_thread_generation;
+  // Fails if the buffers were freed since, the buffer then belongs to another generation.
+  bool released;
+  rcutils_atomic_compare_exchange_strong(
+    &g_rcl_tracing_buffer_owners[index], released, &generation, 0u);
+  (void)released;
+}
+
+// Key of the thread specific value which releases the buffer of a thread when it exits.
+#if defined(_WIN32)
+static VOID NTAPI
+rcl_tracing_on_thread_exit(PVOID value)
+{
+  if (NULL != value) {
+    rcl_tracing_release_thread_buffer(value);
+  }
+}
+
+static DWORD g_rcl_tracing_thread_exit_key = FLS_OUT_OF_INDEXES;
+
+static bool
+rcl_tracing_create_thread_exit_key(void)
+{
+  if (FLS_OUT_OF_INDEXES == g_rcl_tracing_thread_exit_key) {
+    g_rcl_tracing_thread_exit_key = FlsAlloc(rcl_tracing_on_thread_exit);
+  }
+  return FLS_OUT_OF_INDEXES != g_rcl_tracing_thread_exit_key;
+}
+
+static void
+rcl_tracing_set_thread_exit_value(size_t index)
+{
+  (void)FlsSetValue(g_rcl_tracing_thread_exit_key, (PVOID)(uintptr_t)(index + 1u));
+}
+#else
+static pthread_key_t g_rcl_tracing_thread_exit_key;
+static bool g_rcl_tracing_has_thread_exit_key = false;
+
+static bool
+rcl_tracing_create_thread_exit_key(void)
+{
+  if (!g_rcl_tracing_has_thread_exit_key) {
+    g_rcl_tracing_has_thread_exit_key =
+      0 == pthread_key_create(&g_rcl_tracing_thread_exit_key, rcl_tracing_release_thread_buffer);
+  }
+  return g_rcl_tracing_has_thread_exit_key;
+}
+
+static void
+rcl_tracing_set_thread_exit_value(size_t index)
+{
+  (void)pthread_setspecific(g_rcl_tracing_thread_exit_key, (void *)(uintptr_t)(index + 1u));
+}
+#endif
+
+rcl_ret_t
+rcl_tracing_start(size_t events_per_thread, rcl_allocator_t allocator)
+{
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (0u == events_per_thread) {
+    RCL_SET_ERROR_MSG("events_per_thread must not be zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (rcutils_atomic_load_bool(&g_rcl_tracing_is_recording)) {
+    RCL_SET_ERROR_MSG("tracing already started");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (0u != g_rcl_tracing_capacity && events_per_thread != g_rcl_tracing_capacity) {
+    RCL_SET_ERROR_MSG("trace buffers already exist with a different capacity, call fini first");
+    return RCL_RET_ERROR;
+  }
+  // Created once and kept, the key is never deleted.
+  if (!rcl_tracing_create_thread_exit_key()) {
+    RCL_SET_ERROR_MSG("failed to create the thread exit key of the trace buffers");
+    return RCL_RET_ERROR;
+  }
+  g_rcl_tracing_capacity = events_per_thread;
+  g_rcl_tracing_allocator = allocator;
+  rcutils_atomic_store(&g_rcl_tracing_is_recording, true);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_tracing_stop(void)
+{
+  if (!rcutils_atomic_exchange_bool(&g_rcl_tracing_is_recording, false)) {
+    RCL_SET_ERROR_MSG("tracing not started");
+    return RCL_RET_NOT_INIT;
+  }
+  return RCL_RET_OK;
+}
+
+bool
+rcl_tracing_is_recording(void)
+{
+  return rcutils_atomic_load_bool(&g_rcl_tracing_is_recording);
+}
+
+static rcl_tracing_buffer_t *
+rcl_tracing_get_thread_buffer(void)
+{
+  const uint64_t generation = rcutils_atomic_load_uint64_t(&g_rcl_tracing_generation) + 1u;
+  if (generation == g_rcl_tracing_thread_generation) {
+    return g_rcl_tracing_thread_buffer;
+  }
+  // First event of this thread since the buffers were last freed, claim a free buffer.
+  // A thread which finds none records nothing until then.
+  g_rcl_tracing_thread_generation = generation;
+  g_rcl_tracing_thread_buffer = NULL;
+  for (size_t index = 0u; index < RCL_TRACING_MAX_THREADS; ++index) {
+    uint64_t owner = 0u;
+    bool claimed;
+    rcutils_atomic_compare_exchange_strong(
+      &g_rcl_tracing_buffer_owners[index], claimed, &owner, generation);
+    if (!claimed) {
+      continue;
+    }
+    rcl_tracing_buffer_t * buffer =
+      (rcl_tracing_buffer_t *)rcutils_atomic_load_uintptr_t(&g_rcl_tracing_buffers[index]);
+    if (NULL == buffer) {
+      buffer = g_rcl_tracing_allocator.zero_allocate(
+        1u, sizeof(rcl_tracing_buffer_t) + g_rcl_tracing_capacity * sizeof(rcl_tracing_event_t),
+        g_rcl_tracing_allocator.state);
+      if (NULL == buffer) {
+        rcutils_atomic_store(&g_rcl_tracing_buffer_owners[index], 0u);
+        return NULL;
+      }
+      rcutils_atomic_store(&buffer->head, 0u);
+      rcutils_atomic_store(&buffer->tail, 0u);
+      rcutils_atomic_store(&g_rcl_tracing_buffers[index], (uintptr_t)buffer);
+    }
+    rcl_tracing_set_thread_exit_value(index);
+    g_rcl_tracing_thread_buffer = buffer;
+    return buffer;
+  }
+  return NULL;
+}
+
+// Copy the texts one after the other, each null terminated, truncating them to fit.
+static void
+rcl_tracing_copy_texts(char * text, const char * text0, const char * text1)
+{
+  memset(text, 0, RCL_TRACING_EVENT_TEXT_SIZE);
+  size_t length = 0u;
+  if (NULL != text0) {
+    // Keep room for the terminating null characters of both texts.
+    length = strlen(text0);
+    if (length > RCL_TRACING_EVENT_TEXT_SIZE - 2u) {
+      length = RCL_TRACING_EVENT_TEXT_SIZE - 2u;
+    }
+    memcpy(text, text0, length);
+  }
+  if (NULL != text1) {
+    char * second = text + length + 1u;
+    size_t second_length = strlen(text1);
+    const size_t room = RCL_TRACING_EVENT_TEXT_SIZE - length - 2u;
+    if (second_length > room) {
+      second_length = room;
+    }
+    memcpy(second, text1, second_length);
+  }
+}
+
+static void
+rcl_tracing_count_dropped_event(void)
+{
+  uint64_t previous_count;
+  rcutils_atomic_fetch_add(&g_rcl_tracing_dropped_event_count, previous_count, 1u);
+  (void)previous_count;
+}
+
+void
+rcl_tracing_record(
+  rcl_tracing_event_type_t type,
+  uint64_t arg0,
+  uint64_t arg1,
+  uint64_t arg2,
+  uint64_t arg3,
+  const char * text0,
+  const char * text1)
+{
+  if (!rcutils_atomic_load_bool(&g_rcl_tracing_is_recording)) {
+    return;
+  }
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    rcutils_reset_error();
+    return;
+  }
+  rcl_tracing_buffer_t * buffer = rcl_tracing_get_thread_buffer();
+  if (NULL == buffer) {
+    rcl_tracing_count_dropped_event();
+    return;
+  }
+  const uint64_t head = rcutils_atomic_load_uint64_t(&buffer->head);
+  const uint64_t tail = rcutils_atomic_load_uint64_t(&buffer->tail);
+  if (head - tail >= g_rcl_tracing_capacity) {
+    rcl_tracing_count_dropped_event();
+    return;
+  }
+  rcl_tracing_event_t * event = &buffer->events[head % g_rcl_tracing_capacity];
+  event->timestamp = now;
+  event->type = (uint32_t)type;
+  // The thread is the index of the buffer, set when draining.
+  event->thread = 0u;
+  event->args[0] = arg0;
+  event->args[1] = arg1;
+  event->args[2] = arg2;
+  event->args[3] = arg3;
+  rcl_tracing_copy_texts(event->text, text0, text1);
+  // Publish the event to the draining thread.
+  rcutils_atomic_store(&buffer->head, head + 1u);
+}
+
+typedef bool (* rcl_tracing_event_handler_t)(const rcl_tracing_event_t * event, void * data);
+
+// Pass the events of every buffer to the handler and drain the buffers.
+static bool
+rcl_tracing_drain(rcl_tracing_event_handler_t handler, void * data)
+{
+  // The buffers of exited threads are drained too.
+  for (size_t i = 0u; i < RCL_TRACING_MAX_THREADS; ++i) {
+    rcl_tracing_buffer_t * buffer =
+      (rcl_tracing_buffer_t *)rcutils_atomic_load_uintptr_t(&g_rcl_tracing_buffers[i]);
+    if (NULL == buffer) {
+      // Not allocated yet, or the allocation failed.
+      continue;
+    }
+    const uint64_t head = rcutils_atomic_load_uint64_t(&buffer->head);
+    uint64_t tail = rcutils_atomic_load_uint64_t(&buffer->tail);
+    for (; tail != head; ++tail) {
+      rcl_tracing_event_t event = buffer->events[tail % g_rcl_tracing_capacity];
+      event.thread = (uint32_t)i;
+      if (!handler(&event, data)) {
+        rcutils_atomic_store(&buffer->tail, tail);
+        return false;
+      }
+    }
+    rcutils_atomic_store(&buffer->tail, tail);
+  }
+  return true;
+}
+
+static bool
+rcl_tracing_write_binary_event(const rcl_tracing_event_t * event, void * data)
+{
+  return 1u == fwrite(event, sizeof(*event), 1u, (FILE *)data);
+}
+
+rcl_ret_t
+rcl_tracing_flush(const char * file_path)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(file_path, RCL_RET_INVALID_ARGUMENT);
+  FILE * file = fopen(file_path, "ab");
+  if (NULL == file) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("failed to open trace file '%s'", file_path);
+    return RCL_RET_ERROR;
+  }
+  bool ok = 0 == fseek(file, 0, SEEK_END);
+  if (ok && 0 == ftell(file)) {
+    rcl_tracing_file_header_t header = {
+      RCL_TRACING_FILE_MAGIC, RCL_TRACING_FILE_VERSION, (uint32_t)sizeof(rcl_tracing_event_t)
+    };
+    ok = 1u == fwrite(&header, sizeof(header), 1u, file);
+  }
+  ok = ok && rcl_tracing_drain(rcl_tracing_write_binary_event, file);
+  ok = (0 == fclose(file)) && ok;
+  if (!ok) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("failed to write trace file '%s'", file_path);
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+typedef struct rcl_tracing_json_writer_t
+{
+  FILE * file;
+  bool is_first;
+} rcl_tracing_json_writer_t;
+
+// Length of a string of at most `size` characters which may not be null terminated.
+static size_t
+rcl_tracing_bounded_length(const char * string, size_t size)
+{
+  size_t length = 0u;
+  while (length < size && '\0' != string[length]) {
+    ++length;
+  }
+  return length;
+}
+
+static bool
+rcl_tracing_write_json_string(FILE * file, const char * string, size_t length)
+{
+  if (EOF == fputc('"', file)) {
+    return false;
+  }
+  for (size_t i = 0u; i < length; ++i) {
+    const unsigned char c = (unsigned char)string[i];
+    int written;
+    if ('"' == c || '\\' == c) {
+      written = fprintf(file, "\\%c", c);
+    } else if (c < 0x20u) {
+      written = fprintf(file, "\\u%04x", c);
+    } else {
+      written = fputc(c, file);
+    }
+    if (written < 0) {
+      return false;
+    }
+  }
+  return EOF != fputc('"', file);
+}
+
+static bool
+rcl_tracing_write_json_event(const rcl_tracing_event_t * event, void * data)
+{
+  rcl_tracing_json_writer_t * writer = (rcl_tracing_json_writer_t *)data;
+  FILE * file = writer->file;
+  if (
+    event->type >= RCL_TRACING_EVENT_TYPE_COUNT ||
+    NULL == g_rcl_tracing_events[event->type].name)
+  {
+    // Written by a newer build, skip it rather than guess its layout.
+    return true;
+  }
+  const rcl_tracing_event_description_t * description = &g_rcl_tracing_events[event->type];
+  // Chrome traces are in microseconds, keep the nanoseconds as decimals.
+  // Instant events are scoped to their thread.
+  const bool is_instant = 0 == strcmp("i", description->phase);
+  int written = fprintf(
+    file, "%s\n{\"name\":\"%s\",\"cat\":\"rcl\",\"ph\":\"%s\",%s"
+    "\"ts\":%" PRId64 ".%03" PRId64 ",\"pid\":0,\"tid\":%" PRIu32 ",\"args\":{",
+    writer->is_first ? "" : ",", description->name, description->phase,
+    is_instant ? "\"s\":\"t\"," : "",
+    event->timestamp / 1000, event->timestamp % 1000, event->thread);
+  writer->is_first = false;
+  bool is_first_arg = true;
+  for (size_t i = 0u; written >= 0 && i < 4u; ++i) {
+    const rcl_tracing_argument_description_t * arg = &description->args[i];
+    const char * separator = is_first_arg ? "" : ",";
+    switch (arg->kind) {
+      case RCL_TRACING_ARGUMENT_POINTER:
+        written = fprintf(
+          file, "%s\"%s\":\"0x%" PRIx64 "\"", separator, arg->name, event->args[i]);
+        break;
+      case RCL_TRACING_ARGUMENT_UNSIGNED:
+        written = fprintf(file, "%s\"%s\":%" PRIu64, separator, arg->name, event->args[i]);
+        break;
+      case RCL_TRACING_ARGUMENT_SIGNED:
+        written = fprintf(
+          file, "%s\"%s\":%" PRId64, separator, arg->name, (int64_t)event->args[i]);
+        break;
+      default:
+        continue;
+    }
+    is_first_arg = false;
+  }
+  const char * text = event->text;
+  size_t remaining = RCL_TRACING_EVENT_TEXT_SIZE;
+  for (size_t i = 0u; written >= 0 && i < 2u && remaining > 0u; ++i) {
+    const size_t length = rcl_tracing_bounded_length(text, remaining);
+    if (NULL != description->texts[i]) {
+      written = fprintf(file, "%s\"%s\":", is_first_arg ? "" : ",", description->texts[i]);
+      if (written >= 0 && !rcl_tracing_write_json_string(file, text, length)) {
+        written = -1;
+      }
+      is_first_arg = false;
+    }
+    text += length + 1u;
+    remaining = remaining > length ? remaining - length - 1u : 0u;
+  }
+  return written >= 0 && fputs("}}", file) >= 0;
+}
+
+static FILE *
+rcl_tracing_open_json(const char * json_path, rcl_tracing_json_writer_t * writer)
+{
+  writer->file = fopen(json_path, "w");
+  writer->is_first = true;
+  if (NULL != writer->file && fputs("{\"traceEvents\":[", writer->file) < 0) {
+    (void)fclose(writer->file);
+    writer->file = NULL;
+  }
+  if (NULL == writer->file) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("failed to open JSON file '%s'", json_path);
+  }
+  return writer->file;
+}
+
+static rcl_ret_t
+rcl_tracing_close_json(const char * json_path, rcl_tracing_json_writer_t * writer, bool ok)
+{
+  ok = ok && fputs("\n],\"displayTimeUnit\":\"ns\"}\n", writer->file) >= 0;
+  ok = (0 == fclose(writer->file)) && ok;
+  if (!ok) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("failed to write JSON file '%s'", json_path);
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_tracing_dump_chrome_json(const char * file_path)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(file_path, RCL_RET_INVALID_ARGUMENT);
+  rcl_tracing_json_writer_t writer;
+  if (NULL == rcl_tracing_open_json(file_path, &writer)) {
+    return RCL_RET_ERROR;
+  }
+  const bool ok = rcl_tracing_drain(rcl_tracing_write_json_event, &writer);
+  return rcl_tracing_close_json(file_path, &writer, ok);
+}
+
+rcl_ret_t
+rcl_tracing_convert_to_chrome_json(const char * binary_path, const char * json_path)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(binary_path, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(json_path, RCL_RET_INVALID_ARGUMENT);
+  FILE * binary_file = fopen(binary_path, "rb");
+  if (NULL == binary_file) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("failed to open trace file '%s'", binary_path);
+    return RCL_RET_ERROR;
+  }
+  rcl_tracing_file_header_t header;
+  if (
+    1u != fread(&header, sizeof(header), 1u, binary_file) ||
+    0 != memcmp(header.magic, RCL_TRACING_FILE_MAGIC, sizeof(header.magic)) ||
+    RCL_TRACING_FILE_VERSION != header.version ||
+    sizeof(rcl_tracing_event_t) != header.event_size)
+  {
+    (void)fclose(binary_file);
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("'%s' is not a trace file of this version", binary_path);
+    return RCL_RET_ERROR;
+  }
+  rcl_tracing_json_writer_t writer;
+  if (NULL == rcl_tracing_open_json(json_path, &writer)) {
+    (void)fclose(binary_file);
+    return RCL_RET_ERROR;
+  }
+  bool ok = true;
+  rcl_tracing_event_t event;
+  while (ok && 1u == fread(&event, sizeof(event), 1u, binary_file)) {
+    ok = rcl_tracing_write_json_event(&event, &writer);
+  }
+  ok = ok && !ferror(binary_file);
+  (void)fclose(binary_file);
+  return rcl_tracing_close_json(json_path, &writer, ok);
+}
+
+uint64_t
+rcl_tracing_get_dropped_event_count(void)
+{
+  return rcutils_atomic_load_uint64_t(&g_rcl_tracing_dropped_event_count);
+}
+
+rcl_ret_t
+rcl_tracing_fini(void)
+{
+  rcutils_atomic_store(&g_rcl_tracing_is_recording, false);
+  for (size_t i = 0u; i < RCL_TRACING_MAX_THREADS; ++i) {
+    uintptr_t buffer = rcutils_atomic_exchange_uintptr_t(&g_rcl_tracing_buffers[i], 0u);
+    if (0u != buffer) {
+      g_rcl_tracing_allocator.deallocate((void *)buffer, g_rcl_tracing_allocator.state);
+    }
+  }
+  for (size_t i = 0u; i < RCL_TRACING_MAX_THREADS; ++i) {
+    rcutils_atomic_store(&g_rcl_tracing_buffer_owners[i], 0u);
+  }
+  rcutils_atomic_store(&g_rcl_tracing_dropped_event_count, 0u);
+  uint64_t previous_generation;
+  rcutils_atomic_fetch_add(&g_rcl_tracing_generation, previous_generation, 1u);
+  (void)previous_generation;
+  g_rcl_tracing_capacity = 0u;
+  return RCL_RET_OK;
+}
+
+#else  // RCL_TRACING_ENABLED
+
+// Without RCL_TRACING_ENABLED, the tracer is stubbed out and never records.
+
+rcl_ret_t
+rcl_tracing_start(size_t events_per_thread, rcl_allocator_t allocator)
+{
+  (void)events_per_thread;
+  (void)allocator;
+  RCL_SET_ERROR_MSG("rcl was built without RCL_TRACING_ENABLED");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_tracing_stop(void)
+{
+  RCL_SET_ERROR_MSG("tracing not started");
+  return RCL_RET_NOT_INIT;
+}
+
+bool
+rcl_tracing_is_recording(void)
+{
+  return false;
+}
+
+void
+rcl_tracing_record(
+  rcl_tracing_event_type_t type,
+  uint64_t arg0,
+  uint64_t arg1,
+  uint64_t arg2,
+  uint64_t arg3,
+  const char * text0,
+  const char * text1)
+{
+  (void)type;
+  (void)arg0;
+  (void)arg1;
+  (void)arg2;
+  (void)arg3;
+  (void)text0;
+  (void)text1;
+}
+
+rcl_ret_t
+rcl_tracing_flush(const char * file_path)
+{
+  (void)file_path;
+  RCL_SET_ERROR_MSG("rcl was built without RCL_TRACING_ENABLED");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_tracing_dump_chrome_json(const char * file_path)
+{
+  (void)file_path;
+  RCL_SET_ERROR_MSG("rcl was built without RCL_TRACING_ENABLED");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_tracing_convert_to_chrome_json(const char * binary_path, const char * json_path)
+{
+  (void)binary_path;
+  (void)json_path;
+  RCL_SET_ERROR_MSG("rcl was built without RCL_TRACING_ENABLED");
+  return RCL_RET_UNSUPPORTED;
+}
+
+uint64_t
+rcl_tracing_get_dropped_event_count(void)
+{
+  return 0u;
+}
+
+rcl_ret_t
+rcl_tracing_fini(void)
+{
+  return RCL_RET_OK;
+}
+
+#endif  // RCL_TRACING_ENABLED
+
+#ifdef __cplusplus
+}
+#endif
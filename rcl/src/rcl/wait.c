@@ -26,11 +26,13 @@ extern "C"
 
 #include "rcl/error_handling.h"
 #include "rcl/time.h"
+#include "rcl/tracing.h"
 #include "rcutils/logging_macros.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/event.h"
 
+#include "./common.h"
 #include "./context_impl.h"
 
 typedef struct rcl_wait_set_impl_t
@@ -58,6 +60,13 @@ typedef struct rcl_wait_set_impl_t
   rcl_context_t * context;
   // allocator used in the wait set
   rcl_allocator_t allocator;
+  rcl_wait_mode_options_t wait_mode;
+  rcl_wait_mode_stats_t wait_mode_stats;
+  // Steady time the last wait returned ready, or 0 before the first one.
+  rcutils_time_point_value_t last_ready_time;
+  // Copy of the rmw handles, restored after every poll that found nothing ready.
+  void ** rmw_handles_snapshot;
+  size_t rmw_handles_snapshot_capacity;
 } rcl_wait_set_impl_t;
 
 rcl_wait_set_t
@@ -94,6 +103,8 @@ __wait_set_clean_up(rcl_wait_set_t * wait_set)
   (void)ret;  // NO LINT
   assert(RCL_RET_OK == ret);  // Defensive, shouldn't fail with size 0.
   if (wait_set->impl) {
+    wait_set->impl->allocator.deallocate(
+      wait_set->impl->rmw_handles_snapshot, wait_set->impl->allocator.state);
     wait_set->impl->allocator.deallocate(wait_set->impl, wait_set->impl->allocator.state);
     wait_set->impl = NULL;
   }
@@ -215,6 +226,54 @@ rcl_wait_set_get_allocator(const rcl_wait_set_t * wait_set, rcl_allocator_t * al
   return RCL_RET_OK;
 }
 
+rcl_wait_mode_options_t
+rcl_wait_mode_get_default_options(void)
+{
+  static rcl_wait_mode_options_t default_options = {RCL_WAIT_MODE_BLOCK, 0};
+  return default_options;
+}
+
+rcl_ret_t
+rcl_wait_set_set_wait_mode(rcl_wait_set_t * wait_set, const rcl_wait_mode_options_t * options)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+  if (
+    RCL_WAIT_MODE_BLOCK != options->mode && RCL_WAIT_MODE_SPIN != options->mode &&
+    RCL_WAIT_MODE_ADAPTIVE != options->mode)
+  {
+    RCL_SET_ERROR_MSG("unknown wait mode");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (options->spin_budget < 0) {
+    RCL_SET_ERROR_MSG("spin budget must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  wait_set->impl->wait_mode = *options;
+  memset(&wait_set->impl->wait_mode_stats, 0, sizeof(rcl_wait_mode_stats_t));
+  wait_set->impl->last_ready_time = 0;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_get_wait_mode_stats(
+  const rcl_wait_set_t * wait_set,
+  rcl_wait_mode_stats_t * stats)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  *stats = wait_set->impl->wait_mode_stats;
+  return RCL_RET_OK;
+}
+
 #define SET_ADD(Type) \
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT); \
   if (!rcl_wait_set_is_valid(wait_set)) { \
@@ -518,8 +577,131 @@ rcl_wait_set_add_event(
   return RCL_RET_OK;
 }
 
-rcl_ret_t
-rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
+/// Copy the rmw handles to the snapshot, or restore them from it.
+static void
+_rcl_wait_copy_rmw_handles(rcl_wait_set_impl_t * impl, bool restore)
+{
+  struct
+  {
+    void ** handles;
+    size_t count;
+  } arrays[5] = {
+    {impl->rmw_subscriptions.subscribers, impl->rmw_subscriptions.subscriber_count},
+    {impl->rmw_guard_conditions.guard_conditions,
+      impl->rmw_guard_conditions.guard_condition_count},
+    {impl->rmw_services.services, impl->rmw_services.service_count},
+    {impl->rmw_clients.clients, impl->rmw_clients.client_count},
+    {impl->rmw_events.events, impl->rmw_events.event_count},
+  };
+  void ** snapshot = impl->rmw_handles_snapshot;
+  for (size_t i = 0u; i < 5u; ++i) {
+    if (0u == arrays[i].count) {
+      continue;
+    }
+    if (restore) {
+      memcpy(arrays[i].handles, snapshot, arrays[i].count * sizeof(void *));
+    } else {
+      memcpy(snapshot, arrays[i].handles, arrays[i].count * sizeof(void *));
+    }
+    snapshot += arrays[i].count;
+  }
+}
+
+/// Poll rmw_wait() until something is ready or the spin budget is spent.
+/**
+ * rmw_wait() sets the handles that are not ready to NULL, so they are restored
+ * from a snapshot after every poll that found nothing.
+ * On return now holds the steady time at which spinning stopped.
+ */
+static rcl_ret_t
+_rcl_wait_spin(
+  rcl_wait_set_t * wait_set,
+  int64_t spin_budget,
+  rcutils_time_point_value_t * now,
+  rmw_ret_t * rmw_ret)
+{
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  const size_t number_of_handles =
+    impl->rmw_subscriptions.subscriber_count +
+    impl->rmw_guard_conditions.guard_condition_count +
+    impl->rmw_services.service_count +
+    impl->rmw_clients.client_count +
+    impl->rmw_events.event_count;
+  if (number_of_handles > impl->rmw_handles_snapshot_capacity) {
+    void ** snapshot = (void **)impl->allocator.reallocate(
+      impl->rmw_handles_snapshot, number_of_handles * sizeof(void *), impl->allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(snapshot, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    impl->rmw_handles_snapshot = snapshot;
+    impl->rmw_handles_snapshot_capacity = number_of_handles;
+  }
+  _rcl_wait_copy_rmw_handles(impl, false);
+
+  const rcutils_time_point_value_t spin_end = *now + spin_budget;
+  rmw_time_t zero_timeout = {0, 0};
+  do {
+    *rmw_ret = rmw_wait(
+      &impl->rmw_subscriptions,
+      &impl->rmw_guard_conditions,
+      &impl->rmw_services,
+      &impl->rmw_clients,
+      &impl->rmw_events,
+      impl->rmw_wait_set,
+      &zero_timeout);
+    if (RMW_RET_TIMEOUT != *rmw_ret) {
+      break;
+    }
+    _rcl_wait_copy_rmw_handles(impl, true);
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(now)) {
+      RCL_SET_ERROR_MSG("failed to get the current steady time");
+      return RCL_RET_ERROR;
+    }
+  } while (*now < spin_end);
+  return RCL_RET_OK;
+}
+
+/// Return how long the coming wait should spin before blocking, in nanoseconds.
+static int64_t
+_rcl_wait_get_spin_budget(const rcl_wait_set_impl_t * impl, rcutils_time_point_value_t now)
+{
+  const int64_t spin_budget = impl->wait_mode.spin_budget;
+  if (RCL_WAIT_MODE_SPIN == impl->wait_mode.mode) {
+    return spin_budget;
+  }
+  if (RCL_WAIT_MODE_ADAPTIVE != impl->wait_mode.mode) {
+    return 0;
+  }
+  const int64_t mean = impl->wait_mode_stats.mean_inter_arrival;
+  if (0 == impl->last_ready_time || mean <= 0 || mean > spin_budget) {
+    return 0;
+  }
+  // Spin until a quarter of an interval past the expected wake-up, to absorb jitter.
+  const int64_t budget = impl->last_ready_time + mean + mean / 4 - now;
+  if (budget <= 0) {
+    return 0;
+  }
+  return budget < spin_budget ? budget : spin_budget;
+}
+
+/// Fold the interval since the previous ready wait into the moving average.
+static rcl_ret_t
+_rcl_wait_record_ready(rcl_wait_set_impl_t * impl)
+{
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG("failed to get the current steady time");
+    return RCL_RET_ERROR;
+  }
+  if (0 != impl->last_ready_time) {
+    const int64_t interval = now - impl->last_ready_time;
+    int64_t * mean = &impl->wait_mode_stats.mean_inter_arrival;
+    *mean = 0 == *mean ? interval : *mean + (interval - *mean) / 8;
+  }
+  impl->last_ready_time = now;
+  return RCL_RET_OK;
+}
+
+static rcl_ret_t
+_rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
   if (!rcl_wait_set_is_valid(wait_set)) {
@@ -605,15 +787,56 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     ROS_PACKAGE_NAME, "Timeout calculated based on next scheduled timer: %s",
     is_timer_timeout ? "true" : "false");
 
+  // Spin first if the wait mode asks for it, never past the timeout.
+  RCL_CLEAR_STALE_ERROR();
+  rmw_ret_t ret = RMW_RET_TIMEOUT;
+  const bool is_spinning_mode = RCL_WAIT_MODE_BLOCK != wait_set->impl->wait_mode.mode;
+  int64_t spin_budget = 0;
+  if (is_spinning_mode && 0 != timeout) {
+    rcutils_time_point_value_t start;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&start)) {
+      RCL_SET_ERROR_MSG("failed to get the current steady time");
+      return RCL_RET_ERROR;
+    }
+    spin_budget = _rcl_wait_get_spin_budget(wait_set->impl, start);
+    if (timeout_argument && spin_budget > min_timeout) {
+      spin_budget = min_timeout;
+    }
+    if (spin_budget > 0) {
+      rcutils_time_point_value_t now = start;
+      rcl_ret_t spin_ret = _rcl_wait_spin(wait_set, spin_budget, &now, &ret);
+      if (RCL_RET_OK != spin_ret) {
+        return spin_ret;  // error already set
+      }
+      if (RMW_RET_TIMEOUT == ret && timeout_argument) {
+        int64_t remaining = min_timeout - (now - start);
+        remaining = remaining > 0 ? remaining : 0;
+        temporary_timeout_storage.sec = RCL_NS_TO_S(remaining);
+        temporary_timeout_storage.nsec = remaining % 1000000000;
+      }
+    }
+  }
+  if (is_spinning_mode) {
+    if (spin_budget <= 0) {
+      ++wait_set->impl->wait_mode_stats.blocking_waits;
+    } else if (RMW_RET_TIMEOUT == ret) {
+      ++wait_set->impl->wait_mode_stats.spin_misses;
+    } else {
+      ++wait_set->impl->wait_mode_stats.spin_wakeups;
+    }
+  }
+
   // Wait.
-  rmw_ret_t ret = rmw_wait(
-    &wait_set->impl->rmw_subscriptions,
-    &wait_set->impl->rmw_guard_conditions,
-    &wait_set->impl->rmw_services,
-    &wait_set->impl->rmw_clients,
-    &wait_set->impl->rmw_events,
-    wait_set->impl->rmw_wait_set,
-    timeout_argument);
+  if (RMW_RET_TIMEOUT == ret) {
+    ret = rmw_wait(
+      &wait_set->impl->rmw_subscriptions,
+      &wait_set->impl->rmw_guard_conditions,
+      &wait_set->impl->rmw_services,
+      &wait_set->impl->rmw_clients,
+      &wait_set->impl->rmw_events,
+      wait_set->impl->rmw_wait_set,
+      timeout_argument);
+  }
 
   // Items that are not ready will have been set to NULL by rmw_wait.
   // We now update our handles accordingly.
@@ -637,7 +860,7 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
   }
   // Check for timeout, return RCL_RET_TIMEOUT only if it wasn't a timer.
   if (ret != RMW_RET_OK && ret != RMW_RET_TIMEOUT) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    RCL_SET_ERROR_MSG_FROM_RMW();
     return RCL_RET_ERROR;
   }
   // Set corresponding rcl subscription handles NULL.
@@ -686,9 +909,117 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
   if (RMW_RET_TIMEOUT == ret && !is_timer_timeout) {
     return RCL_RET_TIMEOUT;
   }
+  if (is_spinning_mode) {
+    return _rcl_wait_record_ready(wait_set->impl);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
+{
+  RCL_IN_PROCESS_TRACEPOINT(rcl_wait_enter, (const void *)wait_set, timeout);
+  rcl_ret_t ret = _rcl_wait(wait_set, timeout);
+  RCL_IN_PROCESS_TRACEPOINT(rcl_wait_exit, (const void *)wait_set, ret);
+  return ret;
+}
+
+/// Append a dispatch entry, or set the error if there is no room left.
+static rcl_ret_t
+_rcl_wait_set_push_dispatch_entry(
+  rcl_dispatch_entry_t * entries,
+  size_t capacity,
+  size_t * count,
+  const rcl_dispatch_entry_t * entry)
+{
+  if (*count == capacity) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "more ready entities than the capacity of %zu dispatch entries", capacity);
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  entries[(*count)++] = *entry;
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_wait_set_get_dispatch_order(
+  const rcl_wait_set_t * wait_set,
+  rcl_dispatch_policy_t policy,
+  rcl_dispatch_entry_t * entries,
+  size_t capacity,
+  size_t * count)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  if (0u != capacity) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(entries, RCL_RET_INVALID_ARGUMENT);
+  }
+  *count = 0u;
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+    RCL_SET_ERROR_MSG("failed to get the current system time");
+    return RCL_RET_ERROR;
+  }
+  rcl_ret_t ret = RCL_RET_OK;
+  rcl_dispatch_entry_t entry;
+  // Nothing is taken here, so messages and requests are released now rather than
+  // at their source timestamp.
+  entry.release_time = now;
+  entry.type = RCL_DISPATCH_ENTITY_SUBSCRIPTION;
+  for (size_t i = 0u; i < wait_set->size_of_subscriptions; ++i) {
+    if (!wait_set->subscriptions[i]) {
+      continue;
+    }
+    const rcl_subscription_options_t * options =
+      rcl_subscription_get_options(wait_set->subscriptions[i]);
+    entry.index = i;
+    entry.attributes = options ? options->dispatch : rcl_dispatch_get_default_attributes();
+    ret = _rcl_wait_set_push_dispatch_entry(entries, capacity, count, &entry);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  entry.type = RCL_DISPATCH_ENTITY_SERVICE;
+  for (size_t i = 0u; i < wait_set->size_of_services; ++i) {
+    if (!wait_set->services[i]) {
+      continue;
+    }
+    const rcl_service_options_t * options = rcl_service_get_options(wait_set->services[i]);
+    entry.index = i;
+    entry.attributes = options ? options->dispatch : rcl_dispatch_get_default_attributes();
+    ret = _rcl_wait_set_push_dispatch_entry(entries, capacity, count, &entry);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  entry.type = RCL_DISPATCH_ENTITY_TIMER;
+  for (size_t i = 0u; i < wait_set->size_of_timers; ++i) {
+    if (!wait_set->timers[i]) {
+      continue;
+    }
+    ret = rcl_timer_get_dispatch_attributes(wait_set->timers[i], &entry.attributes);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    int64_t time_until_next_call = 0;
+    ret = rcl_timer_get_time_until_next_call(wait_set->timers[i], &time_until_next_call);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    entry.index = i;
+    entry.release_time = now + time_until_next_call;
+    ret = _rcl_wait_set_push_dispatch_entry(entries, capacity, count, &entry);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  return rcl_dispatch_order(entries, *count, policy);
+}
+
 #ifdef __cplusplus
 }
 #endif
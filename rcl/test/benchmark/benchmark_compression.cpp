@@ -0,0 +1,261 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "rcl/compression.h"
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+#include "rmw/serialized_message.h"
+
+#include "./rcl_benchmark_fixture.hpp"
+
+namespace
+{
+
+enum corpus_t
+{
+  CORPUS_OCCUPANCY_GRID,
+  CORPUS_POINT_CLOUD,
+  CORPUS_IMAGE,
+  CORPUS_RANDOM,
+};
+
+/// A 1024x1024 map: unknown around the explored area, free space crossed by walls.
+std::vector<uint8_t>
+make_occupancy_grid()
+{
+  constexpr size_t size = 1024u;
+  std::vector<uint8_t> grid(size * size, 0xffu);
+  std::mt19937 generator(1u);
+  for (size_t row = 128u; row < 896u; ++row) {
+    for (size_t column = 128u; column < 896u; ++column) {
+      bool is_wall = row % 96u < 2u || column % 128u < 2u || 0u == generator() % 500u;
+      grid[row * size + column] = is_wall ? 100u : 0u;
+    }
+  }
+  return grid;
+}
+
+/// A lidar scan of 64 rings, as x, y, z and intensity floats with padding to 32 bytes.
+std::vector<uint8_t>
+make_point_cloud()
+{
+  constexpr size_t rings = 64u;
+  constexpr size_t points_per_ring = 512u;
+  std::vector<uint8_t> cloud(rings * points_per_ring * 32u, 0u);
+  std::mt19937 generator(2u);
+  std::normal_distribution<float> noise(0.0f, 0.01f);
+  uint8_t * point = cloud.data();
+  for (size_t ring = 0u; ring < rings; ++ring) {
+    float elevation = -0.4f + 0.0125f * static_cast<float>(ring);
+    for (size_t i = 0u; i < points_per_ring; ++i, point += 32u) {
+      float azimuth = 6.2831853f * static_cast<float>(i) / static_cast<float>(points_per_ring);
+      float range = 10.0f + 2.0f * std::sin(3.0f * azimuth) + noise(generator);
+      float fields[4] = {
+        range * std::cos(elevation) * std::cos(azimuth),
+        range * std::cos(elevation) * std::sin(azimuth),
+        range * std::sin(elevation),
+        static_cast<float>(generator() % 256u)};
+      memcpy(point, fields, sizeof(fields));
+    }
+  }
+  return cloud;
+}
+
+/// A 640x480 rgb8 image of smooth gradients and flat areas, with sensor noise in the low bit.
+std::vector<uint8_t>
+make_image()
+{
+  constexpr size_t width = 640u;
+  constexpr size_t height = 480u;
+  std::vector<uint8_t> image(width * height * 3u);
+  std::mt19937 generator(3u);
+  for (size_t row = 0u; row < height; ++row) {
+    for (size_t column = 0u; column < width; ++column) {
+      uint8_t * pixel = &image[(row * width + column) * 3u];
+      bool is_sky = row < height / 3u;
+      pixel[0] = static_cast<uint8_t>(is_sky ? 120u : (column * 255u) / width);
+      pixel[1] = static_cast<uint8_t>(is_sky ? 180u : (row * 255u) / height);
+      pixel[2] = static_cast<uint8_t>(is_sky ? 240u : 64u);
+      pixel[generator() % 3u] ^= static_cast<uint8_t>(generator() & 1u);
+    }
+  }
+  return image;
+}
+
+/// Incompressible bytes, e.g. already compressed images, the worst case for the codec.
+std::vector<uint8_t>
+make_random()
+{
+  std::vector<uint8_t> data(1u << 20);
+  std::mt19937 generator(4u);
+  for (auto & byte : data) {
+    byte = static_cast<uint8_t>(generator());
+  }
+  return data;
+}
+
+std::vector<uint8_t>
+make_corpus(int64_t corpus)
+{
+  switch (corpus) {
+    case CORPUS_OCCUPANCY_GRID:
+      return make_occupancy_grid();
+    case CORPUS_POINT_CLOUD:
+      return make_point_cloud();
+    case CORPUS_IMAGE:
+      return make_image();
+    default:
+      return make_random();
+  }
+}
+
+const char *
+corpus_name(int64_t corpus)
+{
+  switch (corpus) {
+    case CORPUS_OCCUPANCY_GRID:
+      return "occupancy_grid";
+    case CORPUS_POINT_CLOUD:
+      return "point_cloud";
+    case CORPUS_IMAGE:
+      return "image";
+    default:
+      return "random";
+  }
+}
+
+/// Fill a serialized message with the corpus given as argument of the benchmark.
+bool
+set_corpus(benchmark::State & st, rcl_serialized_message_t * message)
+{
+  std::vector<uint8_t> data = make_corpus(st.range(0));
+  if (RMW_RET_OK != rmw_serialized_message_resize(message, data.size())) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+    return false;
+  }
+  memcpy(message->buffer, data.data(), data.size());
+  message->buffer_length = data.size();
+  st.SetLabel(corpus_name(st.range(0)));
+  return true;
+}
+
+void
+report_ratio(
+  benchmark::State & st, const rcl_serialized_message_t * original,
+  const rcl_serialized_message_t * compressed)
+{
+  if (0u == compressed->buffer_length) {
+    return;
+  }
+  st.counters["compressed_bytes"] = static_cast<double>(compressed->buffer_length);
+  st.counters["compression_ratio"] =
+    static_cast<double>(original->buffer_length) / static_cast<double>(compressed->buffer_length);
+}
+
+}  // namespace
+
+/// Throughput and ratio of the built-in codec compressing the payload of one message.
+/**
+ * The argument selects the corpus, the output message is reused between iterations.
+ * rmw_loopback does not serialize, so the codec is measured directly rather than
+ * through a compressing publisher.
+ */
+BENCHMARK_DEFINE_F(RclBenchmark, compression_compress)(benchmark::State & st)
+{
+  rcl_compression_codec_t codec = rcl_get_lz4_compression_codec();
+  rcl_serialized_message_t original = rmw_get_zero_initialized_serialized_message();
+  rcl_serialized_message_t compressed = rmw_get_zero_initialized_serialized_message();
+  rcl_serialized_message_t scratch = rmw_get_zero_initialized_serialized_message();
+  if (RMW_RET_OK != rmw_serialized_message_init(&original, 0u, &allocator) ||
+    RMW_RET_OK != rmw_serialized_message_init(&compressed, 0u, &allocator) ||
+    RMW_RET_OK != rmw_serialized_message_init(&scratch, 0u, &allocator))
+  {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  } else if (set_corpus(st, &original)) {
+    reset_allocation_counters();
+    for (auto _ : st) {
+      if (RCL_RET_OK !=
+        rcl_compress_serialized_message(&codec, &original, &compressed, &scratch))
+      {
+        st.SkipWithError(rcl_get_error_string().str);
+        rcl_reset_error();
+        break;
+      }
+    }
+    report_allocations(st);
+    st.SetBytesProcessed(
+      static_cast<int64_t>(st.iterations()) * static_cast<int64_t>(original.buffer_length));
+    report_ratio(st, &original, &compressed);
+  }
+  (void)rmw_serialized_message_fini(&scratch);
+  (void)rmw_serialized_message_fini(&compressed);
+  (void)rmw_serialized_message_fini(&original);
+  rcl_reset_error();
+}
+BENCHMARK_REGISTER_F(RclBenchmark, compression_compress)
+->DenseRange(CORPUS_OCCUPANCY_GRID, CORPUS_RANDOM);
+
+/// Throughput of the built-in codec restoring the payload of one message.
+/**
+ * Bytes processed are counted on the decompressed side, to compare with compression.
+ */
+BENCHMARK_DEFINE_F(RclBenchmark, compression_decompress)(benchmark::State & st)
+{
+  rcl_compression_codec_t codec = rcl_get_lz4_compression_codec();
+  rcl_serialized_message_t original = rmw_get_zero_initialized_serialized_message();
+  rcl_serialized_message_t compressed = rmw_get_zero_initialized_serialized_message();
+  rcl_serialized_message_t decompressed = rmw_get_zero_initialized_serialized_message();
+  rcl_serialized_message_t scratch = rmw_get_zero_initialized_serialized_message();
+  if (RMW_RET_OK != rmw_serialized_message_init(&original, 0u, &allocator) ||
+    RMW_RET_OK != rmw_serialized_message_init(&compressed, 0u, &allocator) ||
+    RMW_RET_OK != rmw_serialized_message_init(&decompressed, 0u, &allocator) ||
+    RMW_RET_OK != rmw_serialized_message_init(&scratch, 0u, &allocator))
+  {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  } else if (set_corpus(st, &original)) {
+    if (RCL_RET_OK != rcl_compress_serialized_message(&codec, &original, &compressed, &scratch)) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+    }
+    reset_allocation_counters();
+    for (auto _ : st) {
+      if (RCL_RET_OK !=
+        rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch))
+      {
+        st.SkipWithError(rcl_get_error_string().str);
+        rcl_reset_error();
+        break;
+      }
+    }
+    report_allocations(st);
+    st.SetBytesProcessed(
+      static_cast<int64_t>(st.iterations()) * static_cast<int64_t>(original.buffer_length));
+    report_ratio(st, &original, &compressed);
+  }
+  (void)rmw_serialized_message_fini(&scratch);
+  (void)rmw_serialized_message_fini(&decompressed);
+  (void)rmw_serialized_message_fini(&compressed);
+  (void)rmw_serialized_message_fini(&original);
+  rcl_reset_error();
+}
+BENCHMARK_REGISTER_F(RclBenchmark, compression_decompress)
+->DenseRange(CORPUS_OCCUPANCY_GRID, CORPUS_RANDOM);
@@ -0,0 +1,160 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "rcl/error_handling.h"
+#include "rcl/executor.h"
+#include "rcl/rcl.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "./rcl_benchmark_fixture.hpp"
+
+namespace
+{
+
+void
+executor_arguments(benchmark::internal::Benchmark * b)
+{
+  for (int64_t handles : {10, 100, 1000}) {
+    for (int64_t ready_percent : {0, 10, 100}) {
+      b->Args({handles, ready_percent});
+    }
+  }
+}
+
+void
+count_message(const void * message, void * context)
+{
+  (void)message;
+  ++*static_cast<size_t *>(context);
+}
+
+}  // namespace
+
+/// Spin an executor over timers of which a fixed percentage is always ready.
+/**
+ * Ready timers have a period of zero and idle ones a period of an hour, so every iteration
+ * dispatches the same handles.
+ */
+BENCHMARK_DEFINE_F(RclBenchmark, executor_spin_some_timers)(benchmark::State & st)
+{
+  const size_t count = static_cast<size_t>(st.range(0));
+  const size_t ready_count = count * static_cast<size_t>(st.range(1)) / 100u;
+  std::vector<rcl_timer_t> timers(count, rcl_get_zero_initialized_timer());
+  rcl_clock_t clock;
+  rcl_executor_t executor = rcl_get_zero_initialized_executor();
+  rcl_executor_options_t executor_options = rcl_executor_get_default_options();
+  executor_options.allocator = allocator;
+
+  rcl_ret_t ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  for (size_t i = 0u; i < count && RCL_RET_OK == ret; ++i) {
+    const int64_t period = i < ready_count ? 0 : RCL_S_TO_NS(3600);
+    ret = rcl_timer_init(&timers[i], &clock, &context, period, nullptr, allocator);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_executor_init(&executor, &context, count, &executor_options);
+  }
+  for (size_t i = 0u; i < count && RCL_RET_OK == ret; ++i) {
+    ret = rcl_executor_add_timer(&executor, &timers[i]);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_executor_prepare(&executor);
+  }
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  reset_allocation_counters();
+  for (auto _ : st) {
+    ret = rcl_executor_spin_some(&executor, 0);
+    if (RCL_RET_OK != ret && RCL_RET_TIMEOUT != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+  }
+  report_allocations(st);
+
+  (void)rcl_executor_fini(&executor);
+  for (rcl_timer_t & timer : timers) {
+    (void)rcl_timer_fini(&timer);
+  }
+  (void)rcl_clock_fini(&clock);
+  rcl_reset_error();
+}
+BENCHMARK_REGISTER_F(RclBenchmark, executor_spin_some_timers)->Apply(executor_arguments);
+
+/// Publish a message and dispatch it to its subscription callback through an executor.
+BENCHMARK_DEFINE_F(RclBenchmark, executor_dispatch_message)(benchmark::State & st)
+{
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.allocator = allocator;
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.allocator = allocator;
+  rcl_executor_t executor = rcl_get_zero_initialized_executor();
+  rcl_executor_options_t executor_options = rcl_executor_get_default_options();
+  executor_options.allocator = allocator;
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  size_t received = 0u;
+
+  rcl_ret_t ret = rcl_publisher_init(&publisher, &node, ts, "chatter", &publisher_options);
+  if (RCL_RET_OK == ret) {
+    ret = rcl_subscription_init(&subscription, &node, ts, "chatter", &subscription_options);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_executor_init(&executor, &context, 1u, &executor_options);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_executor_add_subscription(&executor, &subscription, &msg, count_message, &received);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_executor_prepare(&executor);
+  }
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  reset_allocation_counters();
+  for (auto _ : st) {
+    ret = rcl_publish(&publisher, &msg, nullptr);
+    if (RCL_RET_OK == ret) {
+      ret = rcl_executor_spin_some(&executor, 0);
+    }
+    if (RCL_RET_OK != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+  }
+  report_allocations(st);
+  if (received != static_cast<size_t>(st.iterations())) {
+    st.SkipWithError("not every message was dispatched");
+  }
+
+  (void)rcl_executor_fini(&executor);
+  (void)rcl_subscription_fini(&subscription, &node);
+  (void)rcl_publisher_fini(&publisher, &node);
+  test_msgs__msg__BasicTypes__fini(&msg);
+  rcl_reset_error();
+}
+BENCHMARK_REGISTER_F(RclBenchmark, executor_dispatch_message);
@@ -0,0 +1,92 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr const char * kArgs[] = {
+  "benchmark_init", "--ros-args", "-r", "__ns:=/tenant", "-p", "use_sim_time:=false",
+  "--log-level", "warn"};
+constexpr int kArgc = sizeof(kArgs) / sizeof(kArgs[0]);
+
+void
+shutdown_context(benchmark::State & st, rcl_context_t * context)
+{
+  if (RCL_RET_OK != rcl_shutdown(context)) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  if (RCL_RET_OK != rcl_context_fini(context)) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+}
+}  // namespace
+
+BENCHMARK_F(PerformanceTest, context_churn)(benchmark::State & st)
+{
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  if (RCL_RET_OK != rcl_init_options_init(&init_options, rcl_get_default_allocator())) {
+    st.SkipWithError(rcl_get_error_string().str);
+    return;
+  }
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    rcl_context_t context = rcl_get_zero_initialized_context();
+    if (RCL_RET_OK != rcl_init(kArgc, kArgs, &init_options, &context)) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+    shutdown_context(st, &context);
+  }
+
+  (void)rcl_init_options_fini(&init_options);
+}
+
+BENCHMARK_F(PerformanceTest, context_churn_from_template)(benchmark::State & st)
+{
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  if (RCL_RET_OK != rcl_init_options_init(&init_options, rcl_get_default_allocator())) {
+    st.SkipWithError(rcl_get_error_string().str);
+    return;
+  }
+  rcl_context_template_t context_template = rcl_get_zero_initialized_context_template();
+  rcl_ret_t ret = rcl_context_template_init(kArgc, kArgs, &init_options, &context_template);
+  (void)rcl_init_options_fini(&init_options);
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    return;
+  }
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    rcl_context_t context = rcl_get_zero_initialized_context();
+    if (RCL_RET_OK != rcl_init_from_template(&context_template, &context)) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+    shutdown_context(st, &context);
+  }
+
+  (void)rcl_context_template_fini(&context_template);
+}
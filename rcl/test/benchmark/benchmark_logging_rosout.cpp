@@ -0,0 +1,69 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef RCL_LOGGING_ENABLED
+
+#include <cstdarg>
+
+#include "rcl/error_handling.h"
+#include "rcl/logging_rosout.h"
+#include "rcl/rcl.h"
+
+#include "rcutils/logging.h"
+#include "rcutils/time.h"
+
+#include "./rcl_benchmark_fixture.hpp"
+
+namespace
+{
+
+void
+output(const char * name, const char * format, ...)
+{
+  static const rcutils_log_location_t location = {"output", __FILE__, __LINE__};
+  va_list args;
+  va_start(args, format);
+  rcl_logging_rosout_output_handler(
+    &location, RCUTILS_LOG_SEVERITY_INFO, name, 0, format, &args);
+  va_end(args);
+}
+
+}  // namespace
+
+/// Log a formatted message of the fixture node through its rosout publisher.
+BENCHMARK_F(RclBenchmark, logging_rosout_output)(benchmark::State & st)
+{
+  rcl_ret_t ret = rcl_logging_rosout_init(&allocator);
+  if (RCL_RET_OK == ret) {
+    ret = rcl_logging_rosout_init_publisher_for_node(&node);
+  }
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  const char * logger_name = rcl_node_get_logger_name(&node);
+
+  reset_allocation_counters();
+  int64_t i = 0;
+  for (auto _ : st) {
+    output(logger_name, "message %ld of the benchmark", static_cast<long>(i++));  // NOLINT
+  }
+  report_allocations(st);
+
+  (void)rcl_logging_rosout_fini_publisher_for_node(&node);
+  (void)rcl_logging_rosout_fini();
+  rcl_reset_error();
+}
+
+#endif  // RCL_LOGGING_ENABLED
@@ -0,0 +1,132 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rcl/error_handling.h"
+#include "rcl/expand_topic_name.h"
+#include "rcl/lexer.h"
+#include "rcl/rcl.h"
+
+#include "rcutils/types/string_map.h"
+
+#ifdef RCL_COMMAND_LINE_ENABLED
+#include "rcl/arguments.h"
+#endif  // RCL_COMMAND_LINE_ENABLED
+
+#include "./rcl_benchmark_fixture.hpp"
+
+namespace
+{
+
+void
+resolve_name_loop(
+  benchmark::State & st, const rcl_node_t * node, const char * name, rcl_allocator_t allocator)
+{
+  for (auto _ : st) {
+    char * resolved_name = nullptr;
+    if (RCL_RET_OK != rcl_node_resolve_name(node, name, allocator, false, false, &resolved_name)) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+    allocator.deallocate(resolved_name, allocator.state);
+  }
+}
+
+}  // namespace
+
+BENCHMARK_F(RclBenchmark, node_resolve_name)(benchmark::State & st)
+{
+  reset_allocation_counters();
+  resolve_name_loop(st, &node, "~/chatter", allocator);
+  report_allocations(st);
+}
+
+#ifdef RCL_COMMAND_LINE_ENABLED
+BENCHMARK_F(RclBenchmark, node_resolve_name_with_remaps)(benchmark::State & st)
+{
+  const char * const argv[] = {
+    "--ros-args", "-r", "foo:=bar", "-r", "/benchmark/baz:=/qux", "-r", "~/chatter:=/remapped"};
+  rcl_node_t remapped_node = rcl_get_zero_initialized_node();
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  node_options.allocator = allocator;
+  rcl_ret_t ret = rcl_parse_arguments(
+    sizeof(argv) / sizeof(argv[0]), argv, allocator, &node_options.arguments);
+  if (RCL_RET_OK == ret) {
+    ret = rcl_node_init(&remapped_node, "remapped_node", "/benchmark", &context, &node_options);
+  }
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  reset_allocation_counters();
+  resolve_name_loop(st, &remapped_node, "~/chatter", allocator);
+  report_allocations(st);
+
+  (void)rcl_node_fini(&remapped_node);
+  (void)rcl_node_options_fini(&node_options);
+  rcl_reset_error();
+}
+#endif  // RCL_COMMAND_LINE_ENABLED
+
+BENCHMARK_F(RclBenchmark, lexer_analyze)(benchmark::State & st)
+{
+  const char * text = "rostopic://~/foo/{bar}/baz__node:=__ns/qux";
+
+  reset_allocation_counters();
+  for (auto _ : st) {
+    rcl_lexeme_t lexeme = RCL_LEXEME_NONE;
+    size_t offset = 0u;
+    do {
+      size_t length = 0u;
+      if (RCL_RET_OK != rcl_lexer_analyze(text + offset, &lexeme, &length)) {
+        st.SkipWithError(rcl_get_error_string().str);
+        rcl_reset_error();
+        break;
+      }
+      offset += length;
+    } while (RCL_LEXEME_EOF != lexeme);
+  }
+  report_allocations(st);
+}
+
+BENCHMARK_F(RclBenchmark, expand_topic_name)(benchmark::State & st)
+{
+  rcutils_string_map_t substitutions = rcutils_get_zero_initialized_string_map();
+  rcl_ret_t ret = RCL_RET_ERROR;
+  if (RCUTILS_RET_OK == rcutils_string_map_init(&substitutions, 0, allocator)) {
+    ret = rcl_get_default_topic_name_substitutions(&substitutions);
+  }
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  reset_allocation_counters();
+  for (auto _ : st) {
+    char * expanded_name = nullptr;
+    ret = rcl_expand_topic_name(
+      "~/{node}/chatter", "rcl_benchmark_node", "/benchmark", &substitutions, allocator,
+      &expanded_name);
+    if (RCL_RET_OK != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+    allocator.deallocate(expanded_name, allocator.state);
+  }
+  report_allocations(st);
+
+  (void)rcutils_string_map_fini(&substitutions);
+}
@@ -0,0 +1,119 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+
+#include "rosidl_runtime_c/primitives_sequence_functions.h"
+#include "test_msgs/msg/unbounded_sequences.h"
+
+#include "./rcl_benchmark_fixture.hpp"
+
+namespace
+{
+
+/// Message with a payload of `size` bytes.
+class Payload
+{
+public:
+  explicit Payload(size_t size)
+  {
+    test_msgs__msg__UnboundedSequences__init(&msg);
+    ok = rosidl_runtime_c__uint8__Sequence__init(&msg.uint8_values, size);
+  }
+
+  ~Payload()
+  {
+    test_msgs__msg__UnboundedSequences__fini(&msg);
+  }
+
+  test_msgs__msg__UnboundedSequences msg;
+  bool ok;
+};
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(RclBenchmark, publish_take)(benchmark::State & st)
+{
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, UnboundedSequences);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.allocator = allocator;
+  rcl_ret_t ret = rcl_publisher_init(&publisher, &node, ts, "payload", &publisher_options);
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    return;
+  }
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.allocator = allocator;
+  ret = rcl_subscription_init(&subscription, &node, ts, "payload", &subscription_options);
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    (void)rcl_publisher_fini(&publisher, &node);
+    return;
+  }
+  Payload payload(static_cast<size_t>(st.range(0)));
+  Payload taken(0u);
+  if (!payload.ok) {
+    st.SkipWithError("failed to allocate the payload");
+  }
+
+  reset_allocation_counters();
+  for (auto _ : st) {
+    ret = rcl_publish(&publisher, &payload.msg, nullptr);
+    if (RCL_RET_OK == ret) {
+      ret = rcl_take(&subscription, &taken.msg, nullptr, nullptr);
+    }
+    if (RCL_RET_OK != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+  }
+  report_allocations(st);
+  st.SetBytesProcessed(static_cast<int64_t>(st.iterations()) * st.range(0));
+
+  (void)rcl_subscription_fini(&subscription, &node);
+  (void)rcl_publisher_fini(&publisher, &node);
+}
+BENCHMARK_REGISTER_F(RclBenchmark, publish_take)->RangeMultiplier(64)->Range(16, 1 << 20);
+
+BENCHMARK_F(RclBenchmark, publish_no_subscription)(benchmark::State & st)
+{
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, UnboundedSequences);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.allocator = allocator;
+  rcl_ret_t ret = rcl_publisher_init(&publisher, &node, ts, "unmatched", &publisher_options);
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    return;
+  }
+  Payload payload(1024u);
+
+  reset_allocation_counters();
+  for (auto _ : st) {
+    if (RCL_RET_OK != rcl_publish(&publisher, &payload.msg, nullptr)) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+  }
+  report_allocations(st);
+
+  (void)rcl_publisher_fini(&publisher, &node);
+}
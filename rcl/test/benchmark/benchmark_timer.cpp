@@ -0,0 +1,79 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+#include "rcl/timer.h"
+
+#include "./rcl_benchmark_fixture.hpp"
+
+/// Fixture with a steady clock timer whose period of zero makes it always ready.
+class TimerBenchmark : public RclBenchmark
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    RclBenchmark::SetUp(st);
+    clock = rcl_clock_t();
+    timer = rcl_get_zero_initialized_timer();
+    rcl_ret_t ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+    if (RCL_RET_OK == ret) {
+      ret = rcl_timer_init(&timer, &clock, &context, 0, nullptr, allocator);
+    }
+    if (RCL_RET_OK != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+    }
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    (void)rcl_timer_fini(&timer);
+    (void)rcl_clock_fini(&clock);
+    rcl_reset_error();
+    RclBenchmark::TearDown(st);
+  }
+
+protected:
+  rcl_clock_t clock;
+  rcl_timer_t timer;
+};
+
+BENCHMARK_F(TimerBenchmark, timer_call)(benchmark::State & st)
+{
+  reset_allocation_counters();
+  for (auto _ : st) {
+    if (RCL_RET_OK != rcl_timer_call(&timer)) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+  }
+  report_allocations(st);
+}
+
+BENCHMARK_F(TimerBenchmark, timer_is_ready)(benchmark::State & st)
+{
+  reset_allocation_counters();
+  for (auto _ : st) {
+    bool is_ready = false;
+    if (RCL_RET_OK != rcl_timer_is_ready(&timer, &is_ready)) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+    benchmark::DoNotOptimize(is_ready);
+  }
+  report_allocations(st);
+}
@@ -0,0 +1,60 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef RCL_TRACING_ENABLED
+
+#include "rcl/error_handling.h"
+#include "rcl/tracing.h"
+
+#include "./rcl_benchmark_fixture.hpp"
+
+/// Record an event in the in-process tracer, draining its buffer when full.
+BENCHMARK_F(RclBenchmark, tracing_record)(benchmark::State & st)
+{
+  const size_t capacity = 1u << 16;
+  if (RCL_RET_OK != rcl_tracing_start(capacity, allocator)) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+    return;
+  }
+  int message = 0;
+
+  reset_allocation_counters();
+  size_t recorded = 0u;
+  for (auto _ : st) {
+    RCL_TRACING_RECORD_rcl_publish(&node, &message);
+    if (++recorded == capacity) {
+      st.PauseTiming();
+      (void)rcl_tracing_dump_chrome_json("benchmark_tracing.json");
+      recorded = 0u;
+      st.ResumeTiming();
+    }
+  }
+  report_allocations(st);
+  st.counters["dropped_events"] = static_cast<double>(rcl_tracing_get_dropped_event_count());
+
+  (void)rcl_tracing_fini();
+  rcl_reset_error();
+}
+
+/// Hit a tracepoint while the in-process tracer is not recording.
+BENCHMARK_F(RclBenchmark, tracing_not_recording)(benchmark::State & st)
+{
+  int message = 0;
+  for (auto _ : st) {
+    RCL_TRACEPOINT(rcl_publish, (const void *)&node, (const void *)&message);
+  }
+}
+
+#endif  // RCL_TRACING_ENABLED
@@ -0,0 +1,146 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "./rcl_benchmark_fixture.hpp"
+
+namespace
+{
+
+void
+wait_arguments(benchmark::internal::Benchmark * b)
+{
+  for (int64_t entities : {10, 100, 1000}) {
+    for (int64_t ready_percent : {0, 10, 50, 100}) {
+      b->Args({entities, ready_percent});
+    }
+  }
+}
+
+}  // namespace
+
+/// Wait on subscriptions of which a fixed percentage has a message.
+/**
+ * Taking nothing keeps the same subscriptions ready, so every iteration sees the same ratio.
+ */
+BENCHMARK_DEFINE_F(RclBenchmark, wait_subscriptions)(benchmark::State & st)
+{
+  const size_t count = static_cast<size_t>(st.range(0));
+  const size_t ready_count = count * static_cast<size_t>(st.range(1)) / 100u;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+
+  std::vector<rcl_subscription_t> subscriptions(count, rcl_get_zero_initialized_subscription());
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.allocator = allocator;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.allocator = allocator;
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+
+  rcl_ret_t ret = rcl_publisher_init(&publisher, &node, ts, "ready", &publisher_options);
+  for (size_t i = 0u; i < count && RCL_RET_OK == ret; ++i) {
+    ret = rcl_subscription_init(
+      &subscriptions[i], &node, ts, i < ready_count ? "ready" : "idle", &subscription_options);
+  }
+  if (RCL_RET_OK == ret) {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    ret = rcl_publish(&publisher, &msg, nullptr);
+    test_msgs__msg__BasicTypes__fini(&msg);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_wait_set_init(&wait_set, count, 0, 0, 0, 0, 0, &context, allocator);
+  }
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  reset_allocation_counters();
+  for (auto _ : st) {
+    ret = rcl_wait_set_clear(&wait_set);
+    for (size_t i = 0u; i < count && RCL_RET_OK == ret; ++i) {
+      ret = rcl_wait_set_add_subscription(&wait_set, &subscriptions[i], nullptr);
+    }
+    if (RCL_RET_OK == ret) {
+      ret = rcl_wait(&wait_set, 0);
+    }
+    if (RCL_RET_OK != ret && RCL_RET_TIMEOUT != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+  }
+  report_allocations(st);
+
+  (void)rcl_wait_set_fini(&wait_set);
+  for (rcl_subscription_t & subscription : subscriptions) {
+    (void)rcl_subscription_fini(&subscription, &node);
+  }
+  (void)rcl_publisher_fini(&publisher, &node);
+  rcl_reset_error();
+}
+BENCHMARK_REGISTER_F(RclBenchmark, wait_subscriptions)->Apply(wait_arguments);
+
+/// Refill a wait set with guard conditions without waiting on it.
+BENCHMARK_DEFINE_F(RclBenchmark, wait_set_clear_add)(benchmark::State & st)
+{
+  const size_t count = static_cast<size_t>(st.range(0));
+  std::vector<rcl_guard_condition_t> guard_conditions(
+    count, rcl_get_zero_initialized_guard_condition());
+  rcl_guard_condition_options_t guard_condition_options =
+    rcl_guard_condition_get_default_options();
+  guard_condition_options.allocator = allocator;
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+
+  rcl_ret_t ret = RCL_RET_OK;
+  for (size_t i = 0u; i < count && RCL_RET_OK == ret; ++i) {
+    ret = rcl_guard_condition_init(&guard_conditions[i], &context, guard_condition_options);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_wait_set_init(&wait_set, 0, count, 0, 0, 0, 0, &context, allocator);
+  }
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  reset_allocation_counters();
+  for (auto _ : st) {
+    ret = rcl_wait_set_clear(&wait_set);
+    for (size_t i = 0u; i < count && RCL_RET_OK == ret; ++i) {
+      ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_conditions[i], nullptr);
+    }
+    if (RCL_RET_OK != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+  }
+  report_allocations(st);
+
+  (void)rcl_wait_set_fini(&wait_set);
+  for (rcl_guard_condition_t & guard_condition : guard_conditions) {
+    (void)rcl_guard_condition_fini(&guard_condition);
+  }
+  rcl_reset_error();
+}
+BENCHMARK_REGISTER_F(RclBenchmark, wait_set_clear_add)->Arg(10)->Arg(100)->Arg(1000);
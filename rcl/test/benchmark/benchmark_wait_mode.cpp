@@ -0,0 +1,135 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+
+#include "./rcl_benchmark_fixture.hpp"
+
+namespace
+{
+
+int64_t
+steady_now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Report percentiles of the latencies, in nanoseconds, as counters.
+void
+report_latency_histogram(benchmark::State & st, std::vector<int64_t> & latencies)
+{
+  if (latencies.empty()) {
+    return;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+      size_t index = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1u));
+      return static_cast<double>(latencies[index]);
+    };
+  st.counters["latency_p50_ns"] = percentile(0.5);
+  st.counters["latency_p90_ns"] = percentile(0.9);
+  st.counters["latency_p99_ns"] = percentile(0.99);
+  st.counters["latency_p999_ns"] = percentile(0.999);
+  st.counters["latency_max_ns"] = static_cast<double>(latencies.back());
+}
+
+}  // namespace
+
+/// Wake-up latency of rcl_wait() on a guard condition triggered at 1 kHz from another thread.
+/**
+ * The argument is the rcl_wait_mode_t, spinning modes get a budget of 2 ms.
+ * Each iteration is one wake-up, and the latency from the trigger to rcl_wait()
+ * returning is reported as percentiles.
+ */
+BENCHMARK_DEFINE_F(RclBenchmark, wait_mode_wakeup_latency)(benchmark::State & st)
+{
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_guard_condition_options_t guard_condition_options =
+    rcl_guard_condition_get_default_options();
+  guard_condition_options.allocator = allocator;
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_wait_mode_options_t wait_mode = rcl_wait_mode_get_default_options();
+  wait_mode.mode = static_cast<rcl_wait_mode_t>(st.range(0));
+  wait_mode.spin_budget = RCL_MS_TO_NS(2);
+
+  rcl_ret_t ret = rcl_guard_condition_init(&guard_condition, &context, guard_condition_options);
+  if (RCL_RET_OK == ret) {
+    ret = rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, 0, &context, allocator);
+  }
+  if (RCL_RET_OK == ret) {
+    ret = rcl_wait_set_set_wait_mode(&wait_set, &wait_mode);
+  }
+  if (RCL_RET_OK != ret) {
+    st.SkipWithError(rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+
+  std::atomic<int64_t> trigger_time{0};
+  std::atomic<bool> stop{false};
+  std::thread waker([&guard_condition, &trigger_time, &stop]() {
+      auto next = std::chrono::steady_clock::now();
+      while (!stop.load()) {
+        next += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next);
+        trigger_time.store(steady_now_ns());
+        (void)rcl_trigger_guard_condition(&guard_condition);
+      }
+    });
+  std::vector<int64_t> latencies;
+  latencies.reserve(100000u);
+
+  reset_allocation_counters();
+  for (auto _ : st) {
+    ret = rcl_wait_set_clear(&wait_set);
+    if (RCL_RET_OK == ret) {
+      ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, nullptr);
+    }
+    if (RCL_RET_OK == ret) {
+      ret = rcl_wait(&wait_set, RCL_S_TO_NS(1));
+    }
+    if (RCL_RET_OK != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+    latencies.push_back(steady_now_ns() - trigger_time.load());
+  }
+  report_allocations(st);
+  report_latency_histogram(st, latencies);
+  rcl_wait_mode_stats_t stats;
+  if (RCL_RET_OK == rcl_wait_set_get_wait_mode_stats(&wait_set, &stats)) {
+    st.counters["spin_wakeups"] = static_cast<double>(stats.spin_wakeups);
+    st.counters["blocking_waits"] = static_cast<double>(stats.blocking_waits + stats.spin_misses);
+  }
+
+  stop.store(true);
+  waker.join();
+  (void)rcl_wait_set_fini(&wait_set);
+  (void)rcl_guard_condition_fini(&guard_condition);
+  rcl_reset_error();
+}
+BENCHMARK_REGISTER_F(RclBenchmark, wait_mode_wakeup_latency)
+->Arg(RCL_WAIT_MODE_BLOCK)
+->Arg(RCL_WAIT_MODE_SPIN)
+->Arg(RCL_WAIT_MODE_ADAPTIVE)
+->Iterations(2000)
+->UseRealTime();
@@ -0,0 +1,92 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BENCHMARK__RCL_BENCHMARK_FIXTURE_HPP_
+#define BENCHMARK__RCL_BENCHMARK_FIXTURE_HPP_
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+
+#include "../rcl/counting_allocator.h"
+
+/// Benchmark fixture with a context and a node created with a counting allocator.
+/**
+ * Besides the heap counters of PerformanceTest, the benchmarks report the calls made to
+ * `allocator` as the "rcl_allocations" counter, averaged per iteration.
+ * Benchmarks call reset_allocation_counters() right before their loop and
+ * report_allocations() right after it.
+ */
+class RclBenchmark : public performance_test_fixture::PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    allocator = get_counting_allocator(&allocator_state);
+    context = rcl_get_zero_initialized_context();
+    node = rcl_get_zero_initialized_node();
+
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    rcl_ret_t ret = rcl_init_options_init(&init_options, allocator);
+    if (RCL_RET_OK == ret) {
+      ret = rcl_init(0, nullptr, &init_options, &context);
+      (void)rcl_init_options_fini(&init_options);
+    }
+    if (RCL_RET_OK == ret) {
+      rcl_node_options_t node_options = rcl_node_get_default_options();
+      node_options.allocator = allocator;
+      ret = rcl_node_init(&node, "rcl_benchmark_node", "/benchmark", &context, &node_options);
+    }
+    if (RCL_RET_OK != ret) {
+      st.SkipWithError(rcl_get_error_string().str);
+      rcl_reset_error();
+    }
+    performance_test_fixture::PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    performance_test_fixture::PerformanceTest::TearDown(st);
+    if (rcl_node_is_valid_except_context(&node)) {
+      (void)rcl_node_fini(&node);
+    }
+    if (rcl_context_is_valid(&context)) {
+      (void)rcl_shutdown(&context);
+    }
+    (void)rcl_context_fini(&context);
+    rcl_reset_error();
+  }
+
+protected:
+  void reset_allocation_counters()
+  {
+    reset_heap_counters();
+    reset_counting_allocator(&allocator_state);
+  }
+
+  void report_allocations(benchmark::State & st)
+  {
+    st.counters["rcl_allocations"] = benchmark::Counter(
+      static_cast<double>(get_counting_allocator_count(&allocator_state)),
+      benchmark::Counter::kAvgIterations);
+  }
+
+  counting_allocator_state allocator_state;
+  rcl_allocator_t allocator;
+  rcl_context_t context;
+  rcl_node_t node;
+};
+
+#endif  // BENCHMARK__RCL_BENCHMARK_FIXTURE_HPP_
@@ -0,0 +1,494 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcl/compression.h"
+#include "rcl/error_handling.h"
+#include "rmw/serialized_message.h"
+
+class TestCompression : public ::testing::Test
+{
+public:
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_compression_codec_t codec = rcl_get_lz4_compression_codec();
+  rcl_serialized_message_t original = rmw_get_zero_initialized_serialized_message();
+  rcl_serialized_message_t compressed = rmw_get_zero_initialized_serialized_message();
+  rcl_serialized_message_t decompressed = rmw_get_zero_initialized_serialized_message();
+  rcl_serialized_message_t scratch = rmw_get_zero_initialized_serialized_message();
+
+  void SetUp()
+  {
+    ASSERT_EQ(RMW_RET_OK, rmw_serialized_message_init(&original, 0u, &allocator));
+    ASSERT_EQ(RMW_RET_OK, rmw_serialized_message_init(&compressed, 0u, &allocator));
+    ASSERT_EQ(RMW_RET_OK, rmw_serialized_message_init(&decompressed, 0u, &allocator));
+    ASSERT_EQ(RMW_RET_OK, rmw_serialized_message_init(&scratch, 0u, &allocator));
+  }
+
+  void TearDown()
+  {
+    EXPECT_EQ(RMW_RET_OK, rmw_serialized_message_fini(&original));
+    EXPECT_EQ(RMW_RET_OK, rmw_serialized_message_fini(&compressed));
+    EXPECT_EQ(RMW_RET_OK, rmw_serialized_message_fini(&decompressed));
+    EXPECT_EQ(RMW_RET_OK, rmw_serialized_message_fini(&scratch));
+  }
+
+  void set_original(const std::vector<uint8_t> & data)
+  {
+    ASSERT_EQ(RMW_RET_OK, rmw_serialized_message_resize(&original, data.size() + 1u));
+    if (!data.empty()) {
+      memcpy(original.buffer, data.data(), data.size());
+    }
+    original.buffer_length = data.size();
+  }
+
+  void expect_round_trip(const std::vector<uint8_t> & data)
+  {
+    set_original(data);
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_compress_serialized_message(&codec, &original, &compressed, &scratch)) <<
+      rcl_get_error_string().str;
+    EXPECT_LE(
+      compressed.buffer_length,
+      RCL_COMPRESSION_HEADER_SIZE + codec.compress_bound(data.size()));
+    ASSERT_EQ(
+      RCL_RET_OK,
+      rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch)) <<
+      rcl_get_error_string().str;
+    ASSERT_EQ(data.size(), decompressed.buffer_length);
+    EXPECT_TRUE(data.empty() || 0 == memcmp(data.data(), decompressed.buffer, data.size()));
+  }
+};
+
+TEST_F(TestCompression, codec_validation) {
+  rcl_compression_codec_t disabled = rcl_get_zero_initialized_compression_codec();
+  EXPECT_EQ(nullptr, disabled.name);
+  EXPECT_FALSE(rcl_compression_codec_is_valid(&disabled));
+  rcl_reset_error();
+  EXPECT_FALSE(rcl_compression_codec_is_valid(nullptr));
+  rcl_reset_error();
+  EXPECT_TRUE(rcl_compression_codec_is_valid(&codec)) << rcl_get_error_string().str;
+  EXPECT_STREQ("lz4", codec.name);
+
+  rcl_compression_codec_t invalid = codec;
+  for (const char * name : {"", "1lz4", "_lz4", "lz/4", "lz-4", "lz 4"}) {
+    invalid.name = name;
+    EXPECT_FALSE(rcl_compression_codec_is_valid(&invalid)) << name;
+    rcl_reset_error();
+  }
+  invalid = codec;
+  invalid.decompress = nullptr;
+  EXPECT_FALSE(rcl_compression_codec_is_valid(&invalid));
+  rcl_reset_error();
+  invalid = codec;
+  invalid.decompress_bound = nullptr;
+  EXPECT_FALSE(rcl_compression_codec_is_valid(&invalid));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_compress_serialized_message(&invalid, &original, &compressed, &scratch));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_compress_serialized_message(&codec, nullptr, &compressed, &scratch));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_compress_serialized_message(&codec, &original, &compressed, nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_decompress_serialized_message(&codec, &compressed, nullptr, &scratch));
+  rcl_reset_error();
+}
+
+TEST_F(TestCompression, topic_name) {
+  char * topic_name = nullptr;
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_compression_get_topic_name("/ns/map", &codec, allocator, &topic_name)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(topic_name, allocator.state);
+  });
+  // Not hidden, as no token starts with an underscore.
+  EXPECT_STREQ("/ns/map/lz4_compressed", topic_name);
+
+  char * other_topic_name = nullptr;
+  rcl_compression_codec_t disabled = rcl_get_zero_initialized_compression_codec();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_compression_get_topic_name("/ns/map", &disabled, allocator, &other_topic_name));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_compression_get_topic_name(nullptr, &codec, allocator, &other_topic_name));
+  rcl_reset_error();
+  EXPECT_EQ(nullptr, other_topic_name);
+}
+
+TEST_F(TestCompression, round_trip) {
+  expect_round_trip({});
+  expect_round_trip({42});
+  expect_round_trip(std::vector<uint8_t>(13u, 7u));
+  expect_round_trip(std::vector<uint8_t>(1u << 20, 0u));
+
+  // An occupancy grid: mostly unknown, with free space and a few walls.
+  std::vector<uint8_t> grid(512u * 512u, 0xffu);
+  for (size_t row = 100u; row < 400u; ++row) {
+    for (size_t column = 100u; column < 400u; ++column) {
+      grid[row * 512u + column] = (row % 50u == 0u || column % 70u == 0u) ? 100u : 0u;
+    }
+  }
+  expect_round_trip(grid);
+  EXPECT_LT(compressed.buffer_length, grid.size() / 10u);
+
+  // Random bytes do not compress, but must not grow past the bound.
+  std::mt19937 generator(1234u);
+  std::vector<uint8_t> random(100000u);
+  for (auto & byte : random) {
+    byte = static_cast<uint8_t>(generator());
+  }
+  expect_round_trip(random);
+
+  // Short repeated patterns, overlapping their own copies.
+  std::vector<uint8_t> pattern;
+  for (size_t i = 0u; i < 70000u; ++i) {
+    pattern.push_back(static_cast<uint8_t>("abcab"[i % 5u]));
+  }
+  expect_round_trip(pattern);
+
+  // Every size around the minimum match and end of block limits.
+  for (size_t size = 0u; size < 40u; ++size) {
+    expect_round_trip(std::vector<uint8_t>(size, 3u));
+    std::vector<uint8_t> noise(random.begin(), random.begin() + size);
+    expect_round_trip(noise);
+  }
+}
+
+TEST_F(TestCompression, corrupted_input) {
+  std::vector<uint8_t> data(10000u);
+  for (size_t i = 0u; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>((i * 7u) % 31u);
+  }
+  set_original(data);
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_compress_serialized_message(&codec, &original, &compressed, &scratch));
+
+  // Shorter than the header.
+  rcl_serialized_message_t truncated = compressed;
+  truncated.buffer_length = RCL_COMPRESSION_HEADER_SIZE - 1u;
+  EXPECT_EQ(
+    RCL_RET_ERROR,
+    rcl_decompress_serialized_message(&codec, &truncated, &decompressed, &scratch));
+  rcl_reset_error();
+
+  // Missing the end of the payload.
+  truncated.buffer_length = compressed.buffer_length - 3u;
+  EXPECT_EQ(
+    RCL_RET_ERROR,
+    rcl_decompress_serialized_message(&codec, &truncated, &decompressed, &scratch));
+  rcl_reset_error();
+
+  // A header announcing a size which does not match the payload.
+  ++compressed.buffer[0];
+  EXPECT_EQ(
+    RCL_RET_ERROR,
+    rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch));
+  rcl_reset_error();
+  --compressed.buffer[0];
+
+  // Flipped bytes in the payload are either detected or produce a message of the original size.
+  for (size_t i = RCL_COMPRESSION_HEADER_SIZE; i < compressed.buffer_length; ++i) {
+    compressed.buffer[i] ^= 0xa5u;
+    rcl_ret_t ret =
+      rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch);
+    if (RCL_RET_OK == ret) {
+      EXPECT_EQ(data.size(), decompressed.buffer_length);
+    } else {
+      EXPECT_EQ(RCL_RET_ERROR, ret);
+      rcl_reset_error();
+    }
+    compressed.buffer[i] ^= 0xa5u;
+  }
+}
+
+namespace
+{
+// Blocks produced by the reference LZ4 library 1.9.4, with LZ4_compress_default() unless noted.
+struct ReferenceBlock
+{
+  std::vector<uint8_t> original;
+  std::vector<uint8_t> block;
+};
+
+std::vector<ReferenceBlock> get_reference_blocks()
+{
+  std::vector<ReferenceBlock> blocks;
+  blocks.push_back({{}, {0x00}});
+  const char text[] = "The quick brown fox jumps over the lazy dog.";
+  blocks.push_back(
+    {std::vector<uint8_t>(text, text + sizeof(text) - 1u),
+      {0xf0, 0x1d, 0x54, 0x68, 0x65, 0x20, 0x71, 0x75, 0x69, 0x63, 0x6b, 0x20,
+        0x62, 0x72, 0x6f, 0x77, 0x6e, 0x20, 0x66, 0x6f, 0x78, 0x20, 0x6a, 0x75,
+        0x6d, 0x70, 0x73, 0x20, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x74, 0x68, 0x65,
+        0x20, 0x6c, 0x61, 0x7a, 0x79, 0x20, 0x64, 0x6f, 0x67, 0x2e}});
+  // A match overlapping its own copy.
+  std::vector<uint8_t> abc(100u);
+  for (size_t i = 0u; i < abc.size(); ++i) {
+    abc[i] = static_cast<uint8_t>("abc"[i % 3u]);
+  }
+  blocks.push_back(
+    {abc, {0x3f, 0x61, 0x62, 0x63, 0x03, 0x00, 0x49, 0x50, 0x63, 0x61, 0x62, 0x63, 0x61}});
+  // Runs, with LZ4_compress_HC() at level 12, whose match lengths take several bytes.
+  std::vector<uint8_t> runs(1000u);
+  for (size_t i = 0u; i < runs.size(); ++i) {
+    runs[i] = static_cast<uint8_t>((i / 37u) % 5u);
+  }
+  blocks.push_back(
+    {runs,
+      {0x1f, 0x00, 0x01, 0x00, 0x11, 0x1f, 0x01, 0x01, 0x00, 0x11, 0x1f, 0x02,
+        0x01, 0x00, 0x11, 0x1f, 0x03, 0x01, 0x00, 0x11, 0x1f, 0x04, 0x01, 0x00,
+        0x11, 0x0f, 0xb9, 0x00, 0xff, 0xff, 0xff, 0x1a, 0x50, 0x01, 0x01, 0x01,
+        0x01, 0x02}});
+  return blocks;
+}
+}  // namespace
+
+TEST_F(TestCompression, reference_blocks) {
+  for (const ReferenceBlock & reference : get_reference_blocks()) {
+    // Blocks of the reference library are decoded.
+    std::vector<uint8_t> output(reference.original.size() + 1u);
+    size_t output_size = 0u;
+    ASSERT_EQ(
+      RCL_RET_OK,
+      codec.decompress(
+        reference.block.data(), reference.block.size(), output.data(),
+        reference.original.size(), &output_size, &scratch, codec.state)) <<
+      rcl_get_error_string().str;
+    ASSERT_EQ(reference.original.size(), output_size);
+    EXPECT_TRUE(std::equal(reference.original.begin(), reference.original.end(), output.begin()));
+
+    // And the same data round trips through the built-in compressor.
+    expect_round_trip(reference.original);
+  }
+}
+
+TEST_F(TestCompression, fuzzed_blocks) {
+  // Mutated and truncated blocks must be rejected or decoded within the given capacity,
+  // without reading or writing out of bounds, as checked when built with sanitizers.
+  std::mt19937 generator(4321u);
+  std::vector<uint8_t> output;
+  for (const ReferenceBlock & reference : get_reference_blocks()) {
+    for (size_t i = 0u; i < 2000u; ++i) {
+      std::vector<uint8_t> block(reference.block);
+      const size_t num_mutations = 1u + generator() % 4u;
+      for (size_t j = 0u; j < num_mutations; ++j) {
+        block[generator() % block.size()] ^= static_cast<uint8_t>(1u + generator() % 255u);
+      }
+      block.resize(generator() % 4u ? block.size() : generator() % (block.size() + 1u));
+      output.assign(reference.original.size(), 0u);
+      size_t output_size = 0u;
+      rcl_ret_t ret = codec.decompress(
+        block.data(), block.size(), output.data(), output.size(), &output_size, &scratch,
+        codec.state);
+      if (RCL_RET_OK == ret) {
+        EXPECT_LE(output_size, output.size());
+      } else {
+        EXPECT_EQ(RCL_RET_ERROR, ret);
+        rcl_reset_error();
+      }
+    }
+  }
+}
+
+TEST_F(TestCompression, oversized_header) {
+  set_original(std::vector<uint8_t>(1000u, 9u));
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_compress_serialized_message(&codec, &original, &compressed, &scratch));
+  size_t payload_size = compressed.buffer_length - RCL_COMPRESSION_HEADER_SIZE;
+
+  // A header announcing 2^60 bytes is rejected before anything is reserved for it.
+  std::vector<uint8_t> header(compressed.buffer, compressed.buffer + RCL_COMPRESSION_HEADER_SIZE);
+  memset(compressed.buffer, 0, RCL_COMPRESSION_HEADER_SIZE);
+  compressed.buffer[7] = 0x10u;
+  EXPECT_EQ(
+    RCL_RET_ERROR,
+    rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch));
+  rcl_reset_error();
+  EXPECT_EQ(0u, decompressed.buffer_capacity);
+
+  // So is a size one past what the payload can expand to.
+  size_t size = codec.decompress_bound(payload_size) + 1u;
+  for (size_t i = 0u; i < RCL_COMPRESSION_HEADER_SIZE; ++i, size >>= 8) {
+    compressed.buffer[i] = static_cast<uint8_t>(size & 0xffu);
+  }
+  EXPECT_EQ(
+    RCL_RET_ERROR,
+    rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch));
+  rcl_reset_error();
+  EXPECT_EQ(0u, decompressed.buffer_capacity);
+  memcpy(compressed.buffer, header.data(), header.size());
+
+  // A configured maximum below the original size rejects the message, one at it accepts it.
+  codec.max_decompressed_size = original.buffer_length - 1u;
+  EXPECT_EQ(
+    RCL_RET_ERROR,
+    rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch));
+  rcl_reset_error();
+  EXPECT_EQ(0u, decompressed.buffer_capacity);
+  codec.max_decompressed_size = original.buffer_length;
+  EXPECT_EQ(
+    RCL_RET_OK,
+    rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch)) <<
+    rcl_get_error_string().str;
+  EXPECT_EQ(original.buffer_length, decompressed.buffer_length);
+}
+
+TEST_F(TestCompression, default_max_decompressed_size) {
+  EXPECT_EQ(0u, codec.max_decompressed_size);
+  set_original(std::vector<uint8_t>(1000u, 9u));
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_compress_serialized_message(&codec, &original, &compressed, &scratch));
+
+  // A header announcing one byte past the default cap is rejected, even though a payload
+  // of this size could expand to it.
+  std::vector<uint8_t> payload(RCL_COMPRESSION_DEFAULT_MAX_DECOMPRESSED_SIZE / 255u + 1u, 0u);
+  ASSERT_EQ(
+    RMW_RET_OK,
+    rmw_serialized_message_resize(&compressed, RCL_COMPRESSION_HEADER_SIZE + payload.size()));
+  memcpy(compressed.buffer + RCL_COMPRESSION_HEADER_SIZE, payload.data(), payload.size());
+  compressed.buffer_length = RCL_COMPRESSION_HEADER_SIZE + payload.size();
+  ASSERT_LT(
+    RCL_COMPRESSION_DEFAULT_MAX_DECOMPRESSED_SIZE, codec.decompress_bound(payload.size()));
+  size_t size = RCL_COMPRESSION_DEFAULT_MAX_DECOMPRESSED_SIZE + 1u;
+  for (size_t i = 0u; i < RCL_COMPRESSION_HEADER_SIZE; ++i, size >>= 8) {
+    compressed.buffer[i] = static_cast<uint8_t>(size & 0xffu);
+  }
+  EXPECT_EQ(
+    RCL_RET_ERROR,
+    rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch));
+  rcl_reset_error();
+  EXPECT_EQ(0u, decompressed.buffer_capacity);
+}
+
+TEST_F(TestCompression, zstd) {
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_get_zstd_compression_codec(nullptr));
+  rcl_reset_error();
+#ifdef RCL_COMPRESSION_ZSTD_ENABLED
+  ASSERT_EQ(RCL_RET_OK, rcl_get_zstd_compression_codec(&codec)) << rcl_get_error_string().str;
+  EXPECT_STREQ("zstd", codec.name);
+  EXPECT_TRUE(rcl_compression_codec_is_valid(&codec)) << rcl_get_error_string().str;
+  expect_round_trip({});
+  expect_round_trip({42});
+  std::vector<uint8_t> runs(100000u);
+  for (size_t i = 0u; i < runs.size(); ++i) {
+    runs[i] = static_cast<uint8_t>((i / 37u) % 5u);
+  }
+  expect_round_trip(runs);
+  EXPECT_LT(compressed.buffer_length, runs.size() / 10u);
+
+  // Corrupted payloads are rejected or decoded to the original size.
+  for (size_t i = RCL_COMPRESSION_HEADER_SIZE; i < compressed.buffer_length; ++i) {
+    compressed.buffer[i] ^= 0xa5u;
+    rcl_ret_t ret =
+      rcl_decompress_serialized_message(&codec, &compressed, &decompressed, &scratch);
+    if (RCL_RET_OK == ret) {
+      EXPECT_EQ(runs.size(), decompressed.buffer_length);
+    } else {
+      EXPECT_EQ(RCL_RET_ERROR, ret);
+      rcl_reset_error();
+    }
+    compressed.buffer[i] ^= 0xa5u;
+  }
+#else
+  rcl_compression_codec_t zstd_codec = rcl_get_zero_initialized_compression_codec();
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, rcl_get_zstd_compression_codec(&zstd_codec));
+  rcl_reset_error();
+#endif
+}
+
+TEST_F(TestCompression, reused_buffers) {
+  std::vector<uint8_t> data(50000u);
+  for (size_t i = 0u; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>((i / 16u) % 7u);
+  }
+  expect_round_trip(data);
+  uint8_t * compressed_buffer = compressed.buffer;
+  uint8_t * decompressed_buffer = decompressed.buffer;
+  uint8_t * scratch_buffer = scratch.buffer;
+  EXPECT_NE(nullptr, scratch_buffer);
+
+  // Once large enough, the output and scratch messages are not reallocated.
+  expect_round_trip(data);
+  EXPECT_EQ(compressed_buffer, compressed.buffer);
+  EXPECT_EQ(decompressed_buffer, decompressed.buffer);
+  EXPECT_EQ(scratch_buffer, scratch.buffer);
+}
+
+namespace
+{
+
+size_t
+copy_bound(size_t size)
+{
+  return size;
+}
+
+size_t
+copy_decompress_bound(size_t size)
+{
+  return size;
+}
+
+rcl_ret_t
+copy(
+  const uint8_t * input, size_t input_size, uint8_t * output, size_t output_capacity,
+  size_t * output_size, rcl_serialized_message_t * scratch, void * state)
+{
+  (void)scratch;
+  ++*static_cast<int *>(state);
+  if (input_size > output_capacity) {
+    RCL_SET_ERROR_MSG("output too small");
+    return RCL_RET_ERROR;
+  }
+  if (input_size > 0u) {
+    memcpy(output, input, input_size);
+  }
+  *output_size = input_size;
+  return RCL_RET_OK;
+}
+
+}  // namespace
+
+TEST_F(TestCompression, custom_codec) {
+  int calls = 0;
+  codec.name = "copy";
+  codec.compress_bound = copy_bound;
+  codec.decompress_bound = copy_decompress_bound;
+  codec.compress = copy;
+  codec.decompress = copy;
+  codec.state = &calls;
+  expect_round_trip({1, 2, 3, 4, 5});
+  EXPECT_EQ(RCL_COMPRESSION_HEADER_SIZE + 5u, compressed.buffer_length);
+  EXPECT_EQ(5u, compressed.buffer[0]);
+  EXPECT_EQ(2, calls);
+}
@@ -0,0 +1,169 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "rcl/rcl.h"
+
+#include "rcl/environment.h"
+#include "rcl/error_handling.h"
+#include "rcl/security.h"
+#include "rcutils/env.h"
+#include "rcutils/filesystem.h"
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "../mocking_utils/patch.hpp"
+
+TEST(TestEnvironment, test_nominal) {
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_TRUE(rcutils_set_env("ROS_DOMAIN_ID", ""));
+    EXPECT_TRUE(rcutils_set_env("ROS_LOCALHOST_ONLY", ""));
+    rcl_reload_environment();
+  });
+  ASSERT_TRUE(rcutils_set_env("ROS_DOMAIN_ID", "42"));
+  ASSERT_TRUE(rcutils_set_env("ROS_LOCALHOST_ONLY", "1"));
+  rcl_reload_environment();
+
+  const rcl_environment_t * environment = nullptr;
+  ASSERT_EQ(RCL_RET_OK, rcl_get_environment(&environment)) << rcl_get_error_string().str;
+  ASSERT_NE(nullptr, environment);
+  EXPECT_EQ(42u, environment->domain_id);
+  EXPECT_EQ(RMW_LOCALHOST_ONLY_ENABLED, environment->localhost_only);
+  rcl_release_environment(environment);
+
+  // The snapshot is not affected by later changes to the environment
+  ASSERT_TRUE(rcutils_set_env("ROS_DOMAIN_ID", ""));
+  ASSERT_TRUE(rcutils_set_env("ROS_LOCALHOST_ONLY", "0"));
+  ASSERT_EQ(RCL_RET_OK, rcl_get_environment(&environment)) << rcl_get_error_string().str;
+  EXPECT_EQ(42u, environment->domain_id);
+  EXPECT_EQ(RMW_LOCALHOST_ONLY_ENABLED, environment->localhost_only);
+
+  // Until it is reloaded, which does not affect the snapshots still held
+  rcl_reload_environment();
+  const rcl_environment_t * reloaded_environment = nullptr;
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_get_environment(&reloaded_environment)) << rcl_get_error_string().str;
+  EXPECT_NE(environment, reloaded_environment);
+  EXPECT_EQ(RCL_DEFAULT_DOMAIN_ID, reloaded_environment->domain_id);
+  EXPECT_EQ(RMW_LOCALHOST_ONLY_DISABLED, reloaded_environment->localhost_only);
+  EXPECT_EQ(42u, environment->domain_id);
+  EXPECT_EQ(RMW_LOCALHOST_ONLY_ENABLED, environment->localhost_only);
+  rcl_release_environment(environment);
+  rcl_release_environment(reloaded_environment);
+
+  // Releasing nothing is fine
+  rcl_release_environment(nullptr);
+
+  ASSERT_TRUE(rcutils_set_env("ROS_DOMAIN_ID", "0   not really"));
+  rcl_reload_environment();
+  EXPECT_EQ(RCL_RET_ERROR, rcl_get_environment(&environment));
+  rcl_reset_error();
+
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_get_environment(nullptr));
+  rcl_reset_error();
+}
+
+TEST(TestEnvironment, test_security_options) {
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_TRUE(rcutils_set_env(ROS_SECURITY_ENABLE_VAR_NAME, ""));
+    EXPECT_TRUE(rcutils_set_env(ROS_SECURITY_STRATEGY_VAR_NAME, ""));
+    EXPECT_TRUE(rcutils_set_env(ROS_SECURITY_KEYSTORE_VAR_NAME, ""));
+    rcl_reload_environment();
+  });
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rmw_security_options_t options = rmw_get_zero_initialized_security_options();
+
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_get_security_options_from_environment_snapshot(nullptr, &allocator, &options));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_get_security_options_from_environment_snapshot("/", nullptr, &options));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_get_security_options_from_environment_snapshot("/", &allocator, nullptr));
+  rcl_reset_error();
+
+  ASSERT_TRUE(rcutils_set_env(ROS_SECURITY_ENABLE_VAR_NAME, "true"));
+  ASSERT_TRUE(rcutils_set_env(ROS_SECURITY_STRATEGY_VAR_NAME, "Enforce"));
+  ASSERT_TRUE(rcutils_set_env(ROS_SECURITY_KEYSTORE_VAR_NAME, "/not/a/real/secure/root"));
+  rcl_reload_environment();
+
+  // Enclaves are only looked up once
+  static size_t num_lookups;
+  num_lookups = 0u;
+  auto mock = mocking_utils::patch(
+    "lib:rcl", rcutils_is_directory,
+    [](auto) {
+      ++num_lookups;
+      return false;
+    });
+  for (size_t i = 0u; i < 2u; ++i) {
+    EXPECT_EQ(
+      RCL_RET_ERROR,
+      rcl_get_security_options_from_environment_snapshot("/", &allocator, &options));
+    EXPECT_TRUE(rcl_error_is_set());
+    rcl_reset_error();
+    EXPECT_EQ(RMW_SECURITY_ENFORCEMENT_ENFORCE, options.enforce_security);
+    EXPECT_EQ(nullptr, options.security_root_path);
+  }
+  EXPECT_EQ(1u, num_lookups);
+
+  ASSERT_TRUE(rcutils_set_env(ROS_SECURITY_STRATEGY_VAR_NAME, "Permissive"));
+  rcl_reload_environment();
+  EXPECT_EQ(
+    RCL_RET_OK,
+    rcl_get_security_options_from_environment_snapshot("/", &allocator, &options));
+  rcl_reset_error();
+  EXPECT_EQ(RMW_SECURITY_ENFORCEMENT_PERMISSIVE, options.enforce_security);
+  EXPECT_EQ(nullptr, options.security_root_path);
+  EXPECT_EQ(2u, num_lookups);
+}
+
+TEST(TestEnvironment, test_concurrent_reload) {
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_TRUE(rcutils_set_env("ROS_DOMAIN_ID", ""));
+    rcl_reload_environment();
+  });
+  ASSERT_TRUE(rcutils_set_env("ROS_DOMAIN_ID", "42"));
+  rcl_reload_environment();
+
+  // Snapshots stay valid while held, even if they are reloaded by other threads
+  std::vector<std::thread> threads;
+  for (size_t i = 0u; i < 4u; ++i) {
+    threads.emplace_back(
+      []() {
+        for (size_t j = 0u; j < 1000u; ++j) {
+          const rcl_environment_t * environment = nullptr;
+          ASSERT_EQ(RCL_RET_OK, rcl_get_environment(&environment));
+          EXPECT_EQ(42u, environment->domain_id);
+          rcl_reload_environment();
+          EXPECT_EQ(42u, environment->domain_id);
+          rcl_release_environment(environment);
+        }
+      });
+  }
+  for (std::thread & thread : threads) {
+    thread.join();
+  }
+}
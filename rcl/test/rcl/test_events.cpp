@@ -821,6 +821,138 @@ TEST_F(TestEventFixture, test_sub_message_lost_event)
   EXPECT_EQ(message_lost_status.total_count_change, 0u);
 }
 
+/*
+ * Basic test of publisher and subscriber deadline events taken through an event group
+ */
+TEST_F(TestEventFixture, test_event_group)
+{
+  rcl_event_group_t group = rcl_get_zero_initialized_event_group();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_event_group_init(nullptr, this->node_ptr));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_NODE_INVALID, rcl_event_group_init(&group, nullptr));
+  rcl_reset_error();
+
+  setup_publisher_subscriber_and_events_and_assert_discovery(
+    RCL_PUBLISHER_OFFERED_DEADLINE_MISSED,
+    RCL_SUBSCRIPTION_REQUESTED_DEADLINE_MISSED);
+  rcl_ret_t ret = rcl_event_group_add_publisher_event(
+    &group, &publisher, RCL_PUBLISHER_OFFERED_DEADLINE_MISSED);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_event_group_init(&group, this->node_ptr);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_event_group_fini(&group)) << rcl_get_error_string().str;
+    tear_down_publisher_subscriber_events();
+    tear_down_publisher_subscriber();
+  });
+  EXPECT_EQ(RCL_RET_ALREADY_INIT, rcl_event_group_init(&group, this->node_ptr));
+  rcl_reset_error();
+
+  // only valid endpoints of the node of the group can be added
+  rcl_publisher_t invalid_publisher = rcl_get_zero_initialized_publisher();
+  ret = rcl_event_group_add_publisher_event(
+    &group, &invalid_publisher, RCL_PUBLISHER_OFFERED_DEADLINE_MISSED);
+  EXPECT_EQ(RCL_RET_PUBLISHER_INVALID, ret);
+  rcl_reset_error();
+  rcl_subscription_t invalid_subscription = rcl_get_zero_initialized_subscription();
+  ret = rcl_event_group_add_subscription_event(
+    &group, &invalid_subscription, RCL_SUBSCRIPTION_REQUESTED_DEADLINE_MISSED);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_INVALID, ret);
+  rcl_reset_error();
+  {
+    rcl_node_t other_node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    ret = rcl_node_init(&other_node, "test_event_group_other_node", "", context_ptr, &node_options);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&other_node)) << rcl_get_error_string().str;
+    });
+    rcl_event_group_t other_group = rcl_get_zero_initialized_event_group();
+    ret = rcl_event_group_init(&other_group, &other_node);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_event_group_fini(&other_group)) << rcl_get_error_string().str;
+    });
+    ret = rcl_event_group_add_publisher_event(
+      &other_group, &publisher, RCL_PUBLISHER_OFFERED_DEADLINE_MISSED);
+    EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+    rcl_reset_error();
+    ret = rcl_event_group_add_subscription_event(
+      &other_group, &subscription, RCL_SUBSCRIPTION_REQUESTED_DEADLINE_MISSED);
+    EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+    rcl_reset_error();
+  }
+
+  rcl_event_group_status_t statuses[2];
+  size_t taken = 1u;
+  ret = rcl_event_group_take(&group, statuses, 2u, &taken);
+  EXPECT_EQ(RCL_RET_EVENT_TAKE_FAILED, ret);
+  EXPECT_EQ(0u, taken);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_event_group_take(&group, nullptr, 2u, &taken));
+  rcl_reset_error();
+
+  ret = rcl_event_group_add_publisher_event(
+    &group, &publisher, RCL_PUBLISHER_OFFERED_DEADLINE_MISSED);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_event_group_add_subscription_event(
+    &group, &subscription, RCL_SUBSCRIPTION_REQUESTED_DEADLINE_MISSED);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  // publish message to topic
+  {
+    test_msgs__msg__Strings msg;
+    test_msgs__msg__Strings__init(&msg);
+    ASSERT_TRUE(rosidl_runtime_c__String__assign(&msg.string_value, "testing"));
+    ret = rcl_publish(&publisher, &msg, nullptr);
+    test_msgs__msg__Strings__fini(&msg);
+    EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  }
+
+  // poll the group one status at a time until both deadlines were missed
+  bool publisher_status_taken = false;
+  bool subscription_status_taken = false;
+  auto start_time = std::chrono::system_clock::now();
+  while (!(publisher_status_taken && subscription_status_taken) &&
+    std::chrono::system_clock::now() - start_time < MAX_WAIT_PER_TESTCASE)
+  {
+    ret = rcl_event_group_take(&group, statuses, 1u, &taken);
+    if (RCL_RET_EVENT_TAKE_FAILED == ret) {
+      EXPECT_EQ(0u, taken);
+      std::this_thread::sleep_for(100ms);
+      continue;
+    }
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    ASSERT_EQ(1u, taken);
+    if (RMW_EVENT_OFFERED_DEADLINE_MISSED == statuses[0].event_type) {
+      EXPECT_EQ(&publisher, statuses[0].publisher);
+      EXPECT_EQ(nullptr, statuses[0].subscription);
+      EXPECT_EQ(1, statuses[0].status.offered_deadline_missed.total_count_change);
+      publisher_status_taken = true;
+    } else {
+      EXPECT_EQ(RMW_EVENT_REQUESTED_DEADLINE_MISSED, statuses[0].event_type);
+      EXPECT_EQ(nullptr, statuses[0].publisher);
+      EXPECT_EQ(&subscription, statuses[0].subscription);
+      EXPECT_EQ(1, statuses[0].status.requested_deadline_missed.total_count_change);
+      subscription_status_taken = true;
+    }
+  }
+  EXPECT_TRUE(publisher_status_taken);
+  EXPECT_TRUE(subscription_status_taken);
+
+  // removing an entity removes all of its events
+  EXPECT_EQ(RCL_RET_OK, rcl_event_group_remove(&group, &publisher));
+  EXPECT_EQ(RCL_RET_OK, rcl_event_group_remove(&group, &publisher));
+  EXPECT_EQ(RCL_RET_OK, rcl_event_group_remove(&group, &subscription));
+  ret = rcl_event_group_take(&group, statuses, 2u, &taken);
+  EXPECT_EQ(RCL_RET_EVENT_TAKE_FAILED, ret);
+  EXPECT_EQ(0u, taken);
+}
+
 static
 std::array<TestIncompatibleQosEventParams, 5>
 get_test_pubsub_incompatible_qos_inputs()
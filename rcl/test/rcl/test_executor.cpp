@@ -0,0 +1,535 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcl/error_handling.h"
+#include "rcl/executor.h"
+#include "rcl/rcl.h"
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/srv/basic_types.h"
+
+namespace
+{
+
+struct call_log
+{
+  std::vector<std::string> calls;
+  std::vector<int32_t> values;
+};
+
+void
+on_message(const void * message, void * context)
+{
+  auto log = static_cast<call_log *>(context);
+  log->calls.push_back("subscription");
+  log->values.push_back(static_cast<const test_msgs__msg__BasicTypes *>(message)->int32_value);
+}
+
+void
+on_guard_condition(void * context)
+{
+  static_cast<call_log *>(context)->calls.push_back("guard_condition");
+}
+
+void
+on_request(const void * request, void * response, void * context)
+{
+  static_cast<call_log *>(context)->calls.push_back("service");
+  static_cast<test_msgs__srv__BasicTypes_Response *>(response)->int32_value =
+    static_cast<const test_msgs__srv__BasicTypes_Request *>(request)->int32_value + 1;
+}
+
+void
+on_response(const void * response, const rmw_request_id_t * request_header, void * context)
+{
+  (void)request_header;
+  auto log = static_cast<call_log *>(context);
+  log->calls.push_back("client");
+  log->values.push_back(
+    static_cast<const test_msgs__srv__BasicTypes_Response *>(response)->int32_value);
+}
+
+call_log * g_timer_log = nullptr;
+
+void
+on_timer(rcl_timer_t * timer, int64_t last_call_time)
+{
+  (void)timer;
+  (void)last_call_time;
+  g_timer_log->calls.push_back("timer");
+}
+
+bool
+is_second_ready(const bool * is_ready, size_t number_of_handles, void * context)
+{
+  (void)context;
+  return number_of_handles > 1u && is_ready[1];
+}
+
+}  // namespace
+
+class TestExecutorFixture : public ::testing::Test
+{
+public:
+  rcl_context_t context;
+  rcl_node_t node;
+  const rosidl_message_type_support_t * ts;
+  call_log log;
+
+  void SetUp()
+  {
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+    });
+    context = rcl_get_zero_initialized_context();
+    ret = rcl_init(0, nullptr, &init_options, &context);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    ret = rcl_node_init(&node, "test_executor_node", "", &context, &node_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+    g_timer_log = &log;
+  }
+
+  void TearDown()
+  {
+    g_timer_log = nullptr;
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+  }
+
+  void publish(rcl_publisher_t * publisher, int32_t value)
+  {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    msg.int32_value = value;
+    EXPECT_EQ(RCL_RET_OK, rcl_publish(publisher, &msg, nullptr)) << rcl_get_error_string().str;
+    test_msgs__msg__BasicTypes__fini(&msg);
+  }
+};
+
+TEST_F(TestExecutorFixture, test_init_fini) {
+  rcl_executor_options_t options = rcl_executor_get_default_options();
+  rcl_executor_t executor = rcl_get_zero_initialized_executor();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_executor_init(nullptr, &context, 1u, &options));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_executor_init(&executor, &context, 0u, &options));
+  rcl_reset_error();
+  options.trigger = RCL_EXECUTOR_TRIGGER_PREDICATE;
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_executor_init(&executor, &context, 1u, &options));
+  rcl_reset_error();
+  options = rcl_executor_get_default_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_init(&executor, &context, 1u, &options));
+  EXPECT_EQ(RCL_RET_ALREADY_INIT, rcl_executor_init(&executor, &context, 1u, &options));
+  rcl_reset_error();
+  // Nothing to wait on.
+  EXPECT_EQ(RCL_RET_ERROR, rcl_executor_spin_some(&executor, 0));
+  rcl_reset_error();
+
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_guard_condition_init(
+      &guard_condition, &context, rcl_guard_condition_get_default_options()));
+  EXPECT_EQ(
+    RCL_RET_OK,
+    rcl_executor_add_guard_condition(&executor, &guard_condition, on_guard_condition, &log));
+  EXPECT_EQ(
+    RCL_RET_ERROR,
+    rcl_executor_add_guard_condition(&executor, &guard_condition, on_guard_condition, &log));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_TIMEOUT, rcl_executor_spin_some(&executor, 0));
+  EXPECT_FALSE(rcl_error_is_set());
+
+  EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&executor));
+  EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&executor));
+  EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition));
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_executor_add_guard_condition(&executor, &guard_condition, on_guard_condition, &log));
+  rcl_reset_error();
+}
+
+TEST_F(TestExecutorFixture, test_dispatch_order) {
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_publisher_init(&publisher, &node, ts, "chatter", &publisher_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &node));
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_subscription_init(&subscription, &node, ts, "chatter", &subscription_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_guard_condition_init(
+      &guard_condition, &context, rcl_guard_condition_get_default_options()));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition));
+  });
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_clock_t clock;
+  ASSERT_EQ(RCL_RET_OK, rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock));
+  });
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_init(&timer, &clock, &context, 0, on_timer, allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timer));
+  });
+
+  rcl_executor_t executor = rcl_get_zero_initialized_executor();
+  rcl_executor_options_t options = rcl_executor_get_default_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_init(&executor, &context, 3u, &options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&executor));
+  });
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  // Dispatched in the order added, not in the order of the wait set.
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_add_timer(&executor, &timer));
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_executor_add_guard_condition(&executor, &guard_condition, on_guard_condition, &log));
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_executor_add_subscription(&executor, &subscription, &msg, on_message, &log));
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_prepare(&executor)) << rcl_get_error_string().str;
+
+  publish(&publisher, 42);
+  ASSERT_EQ(RCL_RET_OK, rcl_trigger_guard_condition(&guard_condition));
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_spin_some(&executor, RCL_S_TO_NS(1))) <<
+    rcl_get_error_string().str;
+  EXPECT_EQ(
+    std::vector<std::string>({"timer", "guard_condition", "subscription"}), log.calls);
+  EXPECT_EQ(std::vector<int32_t>({42}), log.values);
+}
+
+TEST_F(TestExecutorFixture, test_triggers) {
+  rcl_publisher_t publishers[2];
+  rcl_subscription_t subscriptions[2];
+  test_msgs__msg__BasicTypes messages[2];
+  const char * topics[2] = {"first", "second"};
+  for (size_t i = 0u; i < 2u; ++i) {
+    publishers[i] = rcl_get_zero_initialized_publisher();
+    rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_publisher_init(&publishers[i], &node, ts, topics[i], &publisher_options));
+    subscriptions[i] = rcl_get_zero_initialized_subscription();
+    rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+    ASSERT_EQ(
+      RCL_RET_OK,
+      rcl_subscription_init(&subscriptions[i], &node, ts, topics[i], &subscription_options));
+    test_msgs__msg__BasicTypes__init(&messages[i]);
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0u; i < 2u; ++i) {
+      EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publishers[i], &node));
+      EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscriptions[i], &node));
+      test_msgs__msg__BasicTypes__fini(&messages[i]);
+    }
+  });
+
+  rcl_executor_options_t options = rcl_executor_get_default_options();
+  options.trigger = RCL_EXECUTOR_TRIGGER_ALL;
+  rcl_executor_t all_executor = rcl_get_zero_initialized_executor();
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_init(&all_executor, &context, 2u, &options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&all_executor));
+  });
+  options.trigger = RCL_EXECUTOR_TRIGGER_PREDICATE;
+  options.trigger_predicate = is_second_ready;
+  rcl_executor_t predicate_executor = rcl_get_zero_initialized_executor();
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_init(&predicate_executor, &context, 2u, &options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&predicate_executor));
+  });
+  for (size_t i = 0u; i < 2u; ++i) {
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_executor_add_subscription(
+        &all_executor, &subscriptions[i], &messages[i], on_message, &log));
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_executor_add_subscription(
+        &predicate_executor, &subscriptions[i], &messages[i], on_message, &log));
+  }
+
+  publish(&publishers[0], 1);
+  EXPECT_EQ(RCL_RET_OK, rcl_executor_spin_some(&all_executor, 0));
+  EXPECT_EQ(RCL_RET_OK, rcl_executor_spin_some(&predicate_executor, 0));
+  EXPECT_TRUE(log.calls.empty());
+
+  publish(&publishers[1], 2);
+  EXPECT_EQ(RCL_RET_OK, rcl_executor_spin_some(&all_executor, 0));
+  EXPECT_EQ(std::vector<int32_t>({1, 2}), log.values);
+
+  publish(&publishers[0], 3);
+  publish(&publishers[1], 4);
+  EXPECT_EQ(RCL_RET_OK, rcl_executor_spin_some(&predicate_executor, 0));
+  EXPECT_EQ(std::vector<int32_t>({1, 2, 3, 4}), log.values);
+}
+
+TEST_F(TestExecutorFixture, test_take_all_then_execute) {
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_publisher_init(&publisher, &node, ts, "chatter", &publisher_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &node));
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+  subscription_options.qos.depth = 1u;
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_subscription_init(&subscription, &node, ts, "chatter", &subscription_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_guard_condition_init(
+      &guard_condition, &context, rcl_guard_condition_get_default_options()));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition));
+  });
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+
+  // The guard condition callback replaces the pending message, before the subscription is
+  // taken with the default semantics and after with TAKE_ALL_THEN_EXECUTE.
+  struct publishing_context
+  {
+    TestExecutorFixture * fixture;
+    rcl_publisher_t * publisher;
+  } publishing = {this, &publisher};
+  auto on_guard_condition_publish = [](void * context) {
+      auto publishing = static_cast<publishing_context *>(context);
+      publishing->fixture->publish(publishing->publisher, 2);
+    };
+  const rcl_executor_semantics_t semantics[2] = {
+    RCL_EXECUTOR_SEMANTICS_TAKE_AND_EXECUTE, RCL_EXECUTOR_SEMANTICS_TAKE_ALL_THEN_EXECUTE};
+  const int32_t expected_values[2] = {2, 1};
+  for (size_t i = 0u; i < 2u; ++i) {
+    rcl_executor_options_t options = rcl_executor_get_default_options();
+    options.semantics = semantics[i];
+    rcl_executor_t executor = rcl_get_zero_initialized_executor();
+    ASSERT_EQ(RCL_RET_OK, rcl_executor_init(&executor, &context, 2u, &options));
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&executor));
+    });
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_executor_add_guard_condition(
+        &executor, &guard_condition, on_guard_condition_publish, &publishing));
+    ASSERT_EQ(
+      RCL_RET_OK,
+      rcl_executor_add_subscription(&executor, &subscription, &msg, on_message, &log));
+
+    log.values.clear();
+    publish(&publisher, 1);
+    ASSERT_EQ(RCL_RET_OK, rcl_trigger_guard_condition(&guard_condition));
+    ASSERT_EQ(RCL_RET_OK, rcl_executor_spin_some(&executor, RCL_S_TO_NS(1))) <<
+      rcl_get_error_string().str;
+    EXPECT_EQ(std::vector<int32_t>({expected_values[i]}), log.values) << "semantics " << i;
+    // Drop what the guard condition published.
+    rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+    (void)rcl_take(&subscription, &msg, &message_info, nullptr);
+  }
+}
+
+TEST_F(TestExecutorFixture, test_service_and_client) {
+  const rosidl_service_type_support_t * srv_ts =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_service_init(&service, &node, srv_ts, "add", &service_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_service_fini(&service, &node));
+  });
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_client_init(&client, &node, srv_ts, "add", &client_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_client_fini(&client, &node));
+  });
+  test_msgs__srv__BasicTypes_Request request;
+  test_msgs__srv__BasicTypes_Request__init(&request);
+  test_msgs__srv__BasicTypes_Request service_request;
+  test_msgs__srv__BasicTypes_Request__init(&service_request);
+  test_msgs__srv__BasicTypes_Response service_response;
+  test_msgs__srv__BasicTypes_Response__init(&service_response);
+  test_msgs__srv__BasicTypes_Response client_response;
+  test_msgs__srv__BasicTypes_Response__init(&client_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&request);
+    test_msgs__srv__BasicTypes_Request__fini(&service_request);
+    test_msgs__srv__BasicTypes_Response__fini(&service_response);
+    test_msgs__srv__BasicTypes_Response__fini(&client_response);
+  });
+
+  rcl_executor_t executor = rcl_get_zero_initialized_executor();
+  rcl_executor_options_t options = rcl_executor_get_default_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_init(&executor, &context, 2u, &options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&executor));
+  });
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_executor_add_service(
+      &executor, &service, &service_request, &service_response, on_request, &log));
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_executor_add_client(&executor, &client, &client_response, on_response, &log));
+
+  request.int32_value = 41;
+  int64_t sequence_number = 0;
+  ASSERT_EQ(RCL_RET_OK, rcl_send_request(&client, &request, &sequence_number));
+  for (int i = 0; i < 10 && log.values.empty(); ++i) {
+    rcl_ret_t ret = rcl_executor_spin_some(&executor, RCL_MS_TO_NS(100));
+    ASSERT_TRUE(RCL_RET_OK == ret || RCL_RET_TIMEOUT == ret) << rcl_get_error_string().str;
+  }
+  EXPECT_EQ(std::vector<std::string>({"service", "client"}), log.calls);
+  EXPECT_EQ(std::vector<int32_t>({42}), log.values);
+}
+
+TEST_F(TestExecutorFixture, test_dispatch_policies) {
+  rcl_publisher_t publishers[3];
+  rcl_subscription_t subscriptions[3];
+  test_msgs__msg__BasicTypes messages[3];
+  const char * topics[3] = {"bulk", "control", "deadline"};
+  const int32_t priorities[3] = {0, 2, 0};
+  const int64_t relative_deadlines[3] = {0, RCL_S_TO_NS(1), RCL_MS_TO_NS(1)};
+  for (size_t i = 0u; i < 3u; ++i) {
+    publishers[i] = rcl_get_zero_initialized_publisher();
+    rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_publisher_init(&publishers[i], &node, ts, topics[i], &publisher_options));
+    subscriptions[i] = rcl_get_zero_initialized_subscription();
+    rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+    subscription_options.dispatch.priority = priorities[i];
+    subscription_options.dispatch.relative_deadline = relative_deadlines[i];
+    ASSERT_EQ(
+      RCL_RET_OK,
+      rcl_subscription_init(&subscriptions[i], &node, ts, topics[i], &subscription_options));
+    test_msgs__msg__BasicTypes__init(&messages[i]);
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0u; i < 3u; ++i) {
+      EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publishers[i], &node));
+      EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscriptions[i], &node));
+      test_msgs__msg__BasicTypes__fini(&messages[i]);
+    }
+  });
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_clock_t clock;
+  ASSERT_EQ(RCL_RET_OK, rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock));
+  });
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_init(&timer, &clock, &context, 0, on_timer, allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timer));
+  });
+  rcl_dispatch_attributes_t timer_attributes = rcl_dispatch_get_default_attributes();
+  timer_attributes.priority = 1;
+  timer_attributes.relative_deadline = RCL_S_TO_NS(10);
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_set_dispatch_attributes(&timer, &timer_attributes));
+
+  const rcl_dispatch_policy_t policies[2] = {
+    RCL_DISPATCH_POLICY_FIXED_PRIORITY, RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST};
+  const std::vector<std::string> expected_calls[2] = {
+    {"subscription", "timer", "subscription", "subscription"},
+    {"subscription", "subscription", "timer", "subscription"}};
+  const std::vector<int32_t> expected_values[2] = {{2, 1, 3}, {3, 2, 1}};
+  for (size_t i = 0u; i < 2u; ++i) {
+    rcl_executor_options_t options = rcl_executor_get_default_options();
+    options.dispatch_policy = policies[i];
+    rcl_executor_t executor = rcl_get_zero_initialized_executor();
+    ASSERT_EQ(RCL_RET_OK, rcl_executor_init(&executor, &context, 4u, &options));
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&executor));
+    });
+    for (size_t j = 0u; j < 3u; ++j) {
+      ASSERT_EQ(
+        RCL_RET_OK, rcl_executor_add_subscription(
+          &executor, &subscriptions[j], &messages[j], on_message, &log));
+      if (1u == j) {
+        ASSERT_EQ(RCL_RET_OK, rcl_executor_add_timer(&executor, &timer));
+      }
+    }
+
+    log.calls.clear();
+    log.values.clear();
+    for (size_t j = 0u; j < 3u; ++j) {
+      publish(&publishers[j], static_cast<int32_t>(j + 1u));
+    }
+    ASSERT_EQ(RCL_RET_OK, rcl_executor_spin_some(&executor, RCL_S_TO_NS(1))) <<
+      rcl_get_error_string().str;
+    EXPECT_EQ(expected_calls[i], log.calls) << "policy " << i;
+    EXPECT_EQ(expected_values[i], log.values) << "policy " << i;
+  }
+
+  rcl_executor_options_t options = rcl_executor_get_default_options();
+  options.dispatch_policy = static_cast<rcl_dispatch_policy_t>(42);
+  rcl_executor_t executor = rcl_get_zero_initialized_executor();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_executor_init(&executor, &context, 1u, &options));
+  rcl_reset_error();
+}
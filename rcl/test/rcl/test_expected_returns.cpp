@@ -0,0 +1,169 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcl/client.h"
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+#include "rcl/service.h"
+#include "rcl/timer.h"
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/srv/basic_types.h"
+
+// Executors poll for these outcomes constantly, so none of them may touch the error state.
+class TestExpectedReturnsFixture : public ::testing::Test
+{
+public:
+  rcl_context_t context;
+  rcl_node_t node;
+
+  void SetUp()
+  {
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+    });
+    context = rcl_get_zero_initialized_context();
+    ret = rcl_init(0, nullptr, &init_options, &context);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    ret = rcl_node_init(&node, "test_expected_returns_node", "", &context, &node_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    rcl_reset_error();
+  }
+
+  void TearDown()
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+  }
+};
+
+TEST_F(TestExpectedReturnsFixture, test_take_nothing) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  rcl_ret_t ret = rcl_subscription_init(
+    &subscription, &node, ts, "chatter", &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  rcl_reset_error();
+
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_TAKE_FAILED, rcl_take(&subscription, &msg, nullptr, nullptr));
+  EXPECT_FALSE(rcl_error_is_set()) << rcl_get_error_string().str;
+}
+
+TEST_F(TestExpectedReturnsFixture, test_take_request_and_response_nothing) {
+  const rosidl_service_type_support_t * ts =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  rcl_ret_t ret = rcl_service_init(&service, &node, ts, "add", &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_service_fini(&service, &node));
+  });
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, &node, ts, "add", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_client_fini(&client, &node));
+  });
+  test_msgs__srv__BasicTypes_Request request;
+  test_msgs__srv__BasicTypes_Request__init(&request);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&request);
+  });
+  test_msgs__srv__BasicTypes_Response response;
+  test_msgs__srv__BasicTypes_Response__init(&response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&response);
+  });
+  rcl_reset_error();
+
+  rmw_request_id_t header;
+  EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, rcl_take_request(&service, &header, &request));
+  EXPECT_FALSE(rcl_error_is_set()) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_CLIENT_TAKE_FAILED, rcl_take_response(&client, &header, &response));
+  EXPECT_FALSE(rcl_error_is_set()) << rcl_get_error_string().str;
+}
+
+TEST_F(TestExpectedReturnsFixture, test_wait_timeout) {
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_ret_t ret = rcl_guard_condition_init(
+    &guard_condition, &context, rcl_guard_condition_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition));
+  });
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, 0, &context, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, nullptr));
+  rcl_reset_error();
+
+  EXPECT_EQ(RCL_RET_TIMEOUT, rcl_wait(&wait_set, 0));
+  EXPECT_FALSE(rcl_error_is_set()) << rcl_get_error_string().str;
+}
+
+TEST_F(TestExpectedReturnsFixture, test_call_canceled_timer) {
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_clock_t clock;
+  ASSERT_EQ(RCL_RET_OK, rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock));
+  });
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  rcl_ret_t ret = rcl_timer_init(&timer, &clock, &context, RCL_MS_TO_NS(1), nullptr, allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timer));
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_cancel(&timer)) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  EXPECT_EQ(RCL_RET_TIMER_CANCELED, rcl_timer_call(&timer));
+  EXPECT_FALSE(rcl_error_is_set()) << rcl_get_error_string().str;
+}
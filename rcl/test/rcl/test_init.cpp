@@ -17,6 +17,7 @@
 #include "osrf_testing_tools_cpp/memory_tools/memory_tools.hpp"
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
 #include "rcl/arguments.h"
+#include "rcl/environment.h"
 #include "rcl/error_handling.h"
 #include "rcl/rcl.h"
 #include "rcl/security.h"
@@ -29,6 +30,7 @@
 
 #include "./allocator_testing_utils.h"
 #include "../mocking_utils/patch.hpp"
+#include "../src/rcl/context_impl.h"
 #include "../src/rcl/init_options_impl.h"
 
 #ifdef RMW_IMPLEMENTATION
@@ -213,7 +215,10 @@ TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_init_invalid_argu
     OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
     {
       EXPECT_TRUE(rcutils_set_env(ROS_SECURITY_KEYSTORE_VAR_NAME, ""));
+      rcl_reload_environment();
     });
+    // The environment is only read once per process unless reloaded.
+    rcl_reload_environment();
     rcl_context_t context = rcl_get_zero_initialized_context();
     ret = rcl_init(0, nullptr, &init_options, &context);
     EXPECT_EQ(RCL_RET_ERROR, ret);
@@ -319,6 +324,155 @@ TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_init_and_shutdown
   context = rcl_get_zero_initialized_context();
 }
 
+/* Tests initializing contexts from a context template.
+ */
+TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_init_from_template) {
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  ret = rcl_init_options_set_domain_id(&init_options, 42u);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_context_template_t context_template = rcl_get_zero_initialized_context_template();
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  // A zero initialized template cannot be used.
+  ret = rcl_init_from_template(&context_template, &context);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_init_from_template(nullptr, &context));
+  rcl_reset_error();
+  // Finalizing a zero initialized template does nothing.
+  EXPECT_EQ(RCL_RET_OK, rcl_context_template_fini(&context_template));
+
+  // Invalid arguments are rejected as they are by rcl_init().
+  ret = rcl_context_template_init(42, nullptr, &init_options, &context_template);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_context_template_init(0, nullptr, nullptr, &context_template);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_context_template_init(0, nullptr, &init_options, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  {
+    const char * bad_args[] = {"--ros-args", "--enclave", "not a valid enclave"};
+    ret = rcl_context_template_init(3, bad_args, &init_options, &context_template);
+    EXPECT_EQ(RCL_RET_ERROR, ret);
+    rcl_reset_error();
+    EXPECT_EQ(nullptr, context_template.impl);
+  }
+
+  {
+    const char * args[] = {"foo", "--ros-args", "-r", "__ns:=/bar"};
+    ret = rcl_context_template_init(4, args, &init_options, &context_template);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  // Already init
+  ret = rcl_context_template_init(0, nullptr, &init_options, &context_template);
+  EXPECT_EQ(RCL_RET_ALREADY_INIT, ret);
+  rcl_reset_error();
+
+  rcl_context_instance_id_t previous_instance_id = 0u;
+  for (int i = 0; i < 3; ++i) {
+    context = rcl_get_zero_initialized_context();
+    ret = rcl_init_from_template(&context_template, &context);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+      EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+    });
+    ASSERT_TRUE(rcl_context_is_valid(&context));
+    EXPECT_NE(previous_instance_id, rcl_context_get_instance_id(&context));
+    previous_instance_id = rcl_context_get_instance_id(&context);
+
+    // Initializing an initialized context fails.
+    ret = rcl_init_from_template(&context_template, &context);
+    EXPECT_EQ(RCL_RET_ALREADY_INIT, ret);
+    rcl_reset_error();
+
+    size_t domain_id = 0u;
+    ASSERT_EQ(RCL_RET_OK, rcl_context_get_domain_id(&context, &domain_id));
+    EXPECT_EQ(42u, domain_id);
+    EXPECT_EQ(4, context.impl->argc);
+    ASSERT_NE(nullptr, context.impl->argv);
+    EXPECT_STREQ("__ns:=/bar", context.impl->argv[3]);
+    EXPECT_EQ(1, rcl_arguments_get_count_unparsed(&context.global_arguments));
+    const rcl_init_options_t * context_options = rcl_context_get_init_options(&context);
+    ASSERT_NE(nullptr, context_options);
+    EXPECT_STREQ("/", context_options->impl->rmw_init_options.enclave);
+  }
+
+  // Contexts do not depend on the template once initialized.
+  context = rcl_get_zero_initialized_context();
+  ret = rcl_init_from_template(&context_template, &context);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_OK, rcl_context_template_fini(&context_template));
+  EXPECT_EQ(nullptr, context_template.impl);
+  EXPECT_TRUE(rcl_context_is_valid(&context));
+  EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+}
+
+/* Tests contexts share one snapshot of the environment until it is reloaded.
+ */
+TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_init_environment_snapshot) {
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  ASSERT_TRUE(rcutils_set_env("ROS_DOMAIN_ID", "42"));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_TRUE(rcutils_set_env("ROS_DOMAIN_ID", ""));
+    rcl_reload_environment();
+  });
+  rcl_reload_environment();
+
+  rcl_context_t contexts[2] = {
+    rcl_get_zero_initialized_context(), rcl_get_zero_initialized_context()};
+  for (rcl_context_t & context : contexts) {
+    ret = rcl_init(0, nullptr, &init_options, &context);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    size_t domain_id = 0u;
+    ASSERT_EQ(RCL_RET_OK, rcl_context_get_domain_id(&context, &domain_id));
+    // The change is not seen once the snapshot is captured.
+    EXPECT_EQ(42u, domain_id);
+    ASSERT_TRUE(rcutils_set_env("ROS_DOMAIN_ID", "43"));
+  }
+  for (rcl_context_t & context : contexts) {
+    EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+  }
+
+  // Nor once they are all shut down, as the snapshot is kept for the process.
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  size_t domain_id = 0u;
+  EXPECT_EQ(RCL_RET_OK, rcl_context_get_domain_id(&context, &domain_id));
+  EXPECT_EQ(42u, domain_id);
+  EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+
+  // Until it is reloaded.
+  rcl_reload_environment();
+  context = rcl_get_zero_initialized_context();
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_OK, rcl_context_get_domain_id(&context, &domain_id));
+  EXPECT_EQ(43u, domain_id);
+  EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+}
+
 /* Tests rcl_init() deals with internal errors correctly.
  */
 TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_init_internal_error) {
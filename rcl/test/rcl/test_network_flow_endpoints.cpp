@@ -14,6 +14,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+
 #include "mimick/mimick.h"
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
 #include "rcl/error_handling.h"
@@ -21,6 +23,7 @@
 #include "rcl/publisher.h"
 #include "rcl/rcl.h"
 #include "rcl/subscription.h"
+#include "rmw/get_network_flow_endpoints.h"
 #include "test_msgs/msg/basic_types.h"
 
 #include "./allocator_testing_utils.h"
@@ -308,6 +311,168 @@ TEST_F(
   rcl_network_flow_endpoint_array_fini(&network_flow_endpoint_array_2);
 }
 
+TEST_F(
+  CLASSNAME(
+    TestPublisherNetworkFlowEndpoints,
+    RMW_IMPLEMENTATION), test_network_flow_endpoint_buffer_errors) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_allocator_t failing_allocator = get_failing_allocator();
+  rcl_network_flow_endpoint_buffer_t buffer =
+    rcl_get_zero_initialized_network_flow_endpoint_buffer();
+
+  // Invalid buffer
+  ret = rcl_network_flow_endpoint_buffer_init(nullptr, 0u, allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_network_flow_endpoint_buffer_fini(nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // Invalid allocator
+  rcl_allocator_t invalid_allocator = rcutils_get_zero_initialized_allocator();
+  ret = rcl_network_flow_endpoint_buffer_init(&buffer, 0u, invalid_allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // Failing allocator
+  set_failing_allocator_is_failing(failing_allocator, true);
+  ret = rcl_network_flow_endpoint_buffer_init(&buffer, 4u, failing_allocator);
+  EXPECT_EQ(RCL_RET_BAD_ALLOC, ret);
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_OK, rcl_network_flow_endpoint_buffer_fini(&buffer));
+
+  // Uninitialized buffer
+  ret = rcl_publisher_fill_network_flow_endpoint_buffer(&this->publisher_1, &buffer);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_network_flow_endpoint_buffer_init(&buffer, 4u, allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_network_flow_endpoint_buffer_fini(&buffer));
+  });
+  EXPECT_EQ(4u, buffer.capacity);
+  EXPECT_EQ(0u, buffer.size);
+
+  // Already initialized
+  ret = rcl_network_flow_endpoint_buffer_init(&buffer, 4u, allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // Invalid entities
+  ret = rcl_publisher_fill_network_flow_endpoint_buffer(nullptr, &buffer);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_subscription_fill_network_flow_endpoint_buffer(nullptr, &buffer);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_fill_network_flow_endpoint_buffer(nullptr, 1u, nullptr, 0u, &buffer, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_fill_network_flow_endpoint_buffer(nullptr, 0u, nullptr, 1u, &buffer, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_publisher_fill_network_flow_endpoint_buffer(&this->publisher_1, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // Nothing to query
+  size_t offsets[1] = {42u};
+  ret = rcl_fill_network_flow_endpoint_buffer(nullptr, 0u, nullptr, 0u, &buffer, offsets);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, buffer.size);
+  EXPECT_EQ(0u, offsets[0]);
+
+  // An allocation whose size overflows fails
+  {
+    static void * overflowing_allocation;
+    overflowing_allocation = &buffer;
+    auto mock = mocking_utils::patch(
+      "lib:rcl", rmw_publisher_get_network_flow_endpoints,
+      [](auto, rcutils_allocator_t * allocator, auto) {
+        overflowing_allocation = allocator->zero_allocate(SIZE_MAX, 2u, allocator->state);
+        return RMW_RET_BAD_ALLOC;
+      });
+    ret = rcl_publisher_fill_network_flow_endpoint_buffer(&this->publisher_1, &buffer);
+    EXPECT_EQ(RCL_RET_BAD_ALLOC, ret);
+    rcl_reset_error();
+    EXPECT_EQ(nullptr, overflowing_allocation);
+    EXPECT_EQ(0u, buffer.size);
+  }
+}
+
+TEST_F(
+  CLASSNAME(
+    TestPublisherNetworkFlowEndpoints,
+    RMW_IMPLEMENTATION), test_publisher_fill_network_flow_endpoint_buffer) {
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_network_flow_endpoint_array_t network_flow_endpoint_array =
+    rcl_get_zero_initialized_network_flow_endpoint_array();
+  rcl_ret_t ret = rcl_publisher_get_network_flow_endpoints(
+    &this->publisher_1, &allocator, &network_flow_endpoint_array);
+  if (ret == RCL_RET_UNSUPPORTED) {
+    // Nothing to compare with
+    rcl_reset_error();
+    return;
+  }
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_network_flow_endpoint_array_fini(&network_flow_endpoint_array);
+  });
+
+  rcl_network_flow_endpoint_buffer_t buffer =
+    rcl_get_zero_initialized_network_flow_endpoint_buffer();
+  ret = rcl_network_flow_endpoint_buffer_init(&buffer, 0u, allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_network_flow_endpoint_buffer_fini(&buffer));
+  });
+
+  // The buffer grows as needed and holds the same network flow endpoints.
+  ret = rcl_publisher_fill_network_flow_endpoint_buffer(&this->publisher_1, &buffer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(network_flow_endpoint_array.size, buffer.size);
+  for (size_t i = 0; i < buffer.size; i++) {
+    EXPECT_EQ(
+      network_flow_endpoint_array.network_flow_endpoint[i].transport_port,
+      buffer.network_flow_endpoint[i].transport_port);
+    EXPECT_STREQ(
+      network_flow_endpoint_array.network_flow_endpoint[i].internet_address,
+      buffer.network_flow_endpoint[i].internet_address);
+  }
+
+  // Querying again reuses the storage.
+  rcl_network_flow_endpoint_t * storage = buffer.network_flow_endpoint;
+  size_t capacity = buffer.capacity;
+  ret = rcl_publisher_fill_network_flow_endpoint_buffer(&this->publisher_1, &buffer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(network_flow_endpoint_array.size, buffer.size);
+  EXPECT_EQ(storage, buffer.network_flow_endpoint);
+  EXPECT_EQ(capacity, buffer.capacity);
+
+  // Bulk query of all the publishers of the node.
+  const rcl_publisher_t * publishers[] = {&this->publisher_1, &this->publisher_3};
+  size_t offsets[3] = {0u, 0u, 0u};
+  ret = rcl_fill_network_flow_endpoint_buffer(publishers, 2u, nullptr, 0u, &buffer, offsets);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, offsets[0]);
+  EXPECT_EQ(network_flow_endpoint_array.size, offsets[1]);
+  EXPECT_EQ(buffer.size, offsets[2]);
+  EXPECT_LE(offsets[1], offsets[2]);
+
+  // A failed query leaves the buffer empty.
+  const rcl_publisher_t * invalid_publishers[] = {&this->publisher_1, nullptr};
+  ret = rcl_fill_network_flow_endpoint_buffer(
+    invalid_publishers, 2u, nullptr, 0u, &buffer, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  EXPECT_EQ(0u, buffer.size);
+}
+
 TEST_F(
   CLASSNAME(
     TestSubscriptionNetworkFlowEndpoints,
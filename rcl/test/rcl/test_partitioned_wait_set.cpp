@@ -0,0 +1,212 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcl/error_handling.h"
+#include "rcl/partitioned_wait_set.h"
+#include "rcl/rcl.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+class TestPartitionedWaitSetFixture : public ::testing::Test
+{
+public:
+  rcl_context_t context;
+  rcl_node_t node;
+  rcl_partitioned_wait_set_t partitioned_wait_set;
+
+  void SetUp()
+  {
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+    });
+    context = rcl_get_zero_initialized_context();
+    ret = rcl_init(0, nullptr, &init_options, &context);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    ret = rcl_node_init(&node, "test_partitioned_wait_set_node", "", &context, &node_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    partitioned_wait_set = rcl_get_zero_initialized_partitioned_wait_set();
+    ret = rcl_partitioned_wait_set_init(
+      &partitioned_wait_set, 2u, &context, rcl_get_default_allocator());
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  void TearDown()
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_partitioned_wait_set_fini(&partitioned_wait_set)) <<
+      rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+  }
+};
+
+TEST_F(TestPartitionedWaitSetFixture, test_init_fini) {
+  rcl_partitioned_wait_set_t other = rcl_get_zero_initialized_partitioned_wait_set();
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_partitioned_wait_set_init(&other, 0u, &context, allocator));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_partitioned_wait_set_init(&other, 1u, nullptr, allocator));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_ALREADY_INIT,
+    rcl_partitioned_wait_set_init(&partitioned_wait_set, 1u, &context, allocator));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_OK, rcl_partitioned_wait_set_fini(&other));
+
+  rcl_wait_set_t * wait_set = nullptr;
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_partitioned_wait_set_wait(&partitioned_wait_set, 2u, 0, &wait_set));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_partitioned_wait_set_wake(&partitioned_wait_set, 2u));
+  rcl_reset_error();
+  EXPECT_FALSE(rcl_partitioned_wait_set_is_woken(&partitioned_wait_set, 2u));
+  // An empty partition still waits on its wake guard condition.
+  EXPECT_EQ(
+    RCL_RET_TIMEOUT, rcl_partitioned_wait_set_wait(&partitioned_wait_set, 0u, 0, &wait_set));
+  EXPECT_FALSE(rcl_error_is_set());
+}
+
+TEST_F(TestPartitionedWaitSetFixture, test_partitions_are_isolated) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_publisher_init(&publisher, &node, ts, "sensor", &publisher_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &node));
+  });
+  rcl_subscription_t subscriptions[2];
+  for (size_t i = 0u; i < 2u; ++i) {
+    subscriptions[i] = rcl_get_zero_initialized_subscription();
+    rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_subscription_init(
+        &subscriptions[i], &node, ts, 0u == i ? "idle" : "sensor", &subscription_options));
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0u; i < 2u; ++i) {
+      EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscriptions[i], &node));
+    }
+  });
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_guard_condition_init(
+      &guard_condition, &context, rcl_guard_condition_get_default_options()));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition));
+  });
+
+  size_t index = 42u;
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_partitioned_wait_set_add_subscription(
+      &partitioned_wait_set, 0u, &subscriptions[0], &index));
+  EXPECT_EQ(0u, index);
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_partitioned_wait_set_add_subscription(
+      &partitioned_wait_set, 0u, &subscriptions[1], &index));
+  EXPECT_EQ(1u, index);
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_partitioned_wait_set_add_guard_condition(
+      &partitioned_wait_set, 1u, &guard_condition, &index));
+  EXPECT_EQ(0u, index);
+
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_publish(&publisher, &msg, nullptr));
+
+  rcl_wait_set_t * wait_set = nullptr;
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_partitioned_wait_set_wait(&partitioned_wait_set, 0u, RCL_S_TO_NS(1), &wait_set)) <<
+    rcl_get_error_string().str;
+  ASSERT_NE(nullptr, wait_set);
+  EXPECT_EQ(nullptr, wait_set->subscriptions[0]);
+  EXPECT_EQ(&subscriptions[1], wait_set->subscriptions[1]);
+  EXPECT_FALSE(rcl_partitioned_wait_set_is_woken(&partitioned_wait_set, 0u));
+  // The message does not wake the other partition.
+  EXPECT_EQ(
+    RCL_RET_TIMEOUT, rcl_partitioned_wait_set_wait(&partitioned_wait_set, 1u, 0, &wait_set));
+
+  ASSERT_EQ(RCL_RET_OK, rcl_trigger_guard_condition(&guard_condition));
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_partitioned_wait_set_wait(&partitioned_wait_set, 1u, 0, &wait_set));
+  EXPECT_EQ(&guard_condition, wait_set->guard_conditions[0]);
+  EXPECT_FALSE(rcl_partitioned_wait_set_is_woken(&partitioned_wait_set, 1u));
+}
+
+TEST_F(TestPartitionedWaitSetFixture, test_cross_partition_wake) {
+  rcl_ret_t wait_ret = RCL_RET_ERROR;
+  bool is_woken = false;
+  std::thread waiter([this, &wait_ret, &is_woken]() {
+      rcl_wait_set_t * wait_set = nullptr;
+      wait_ret = rcl_partitioned_wait_set_wait(
+        &partitioned_wait_set, 1u, RCL_S_TO_NS(10), &wait_set);
+      is_woken = rcl_partitioned_wait_set_is_woken(&partitioned_wait_set, 1u);
+    });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  auto before = std::chrono::steady_clock::now();
+  EXPECT_EQ(RCL_RET_OK, rcl_partitioned_wait_set_wake(&partitioned_wait_set, 1u));
+  waiter.join();
+  auto elapsed = std::chrono::steady_clock::now() - before;
+  EXPECT_EQ(RCL_RET_OK, wait_ret);
+  EXPECT_TRUE(is_woken);
+  EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST_F(TestPartitionedWaitSetFixture, test_pin_thread) {
+  // Without an affinity the thread is left alone.
+  EXPECT_EQ(RCL_RET_OK, rcl_partitioned_wait_set_pin_thread(&partitioned_wait_set, 0u));
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_partitioned_wait_set_set_cpu_affinity(
+      &partitioned_wait_set, 2u, 1u));
+  rcl_reset_error();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_partitioned_wait_set_set_cpu_affinity(&partitioned_wait_set, 1u, 1u));
+  rcl_ret_t ret = RCL_RET_ERROR;
+  // Pin a separate thread so the test thread keeps its affinity.
+  std::thread pinned([this, &ret]() {
+      ret = rcl_partitioned_wait_set_pin_thread(&partitioned_wait_set, 1u);
+    });
+  pinned.join();
+#if defined(__linux__) || defined(_WIN32)
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+#else
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+#endif
+  rcl_reset_error();
+}
@@ -14,7 +14,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
 #include "rcl/publisher.h"
+#include "rcl/publisher_group.h"
 
 #include "rcl/rcl.h"
 #include "test_msgs/msg/basic_types.h"
@@ -29,6 +32,7 @@
 
 #include "./failing_allocator_functions.hpp"
 #include "./publisher_impl.h"
+#include "./wait_for_entity_helpers.hpp"
 #include "../mocking_utils/patch.hpp"
 
 #ifdef RMW_IMPLEMENTATION
@@ -587,6 +591,21 @@ TEST_F(CLASSNAME(TestPublisherFixtureInit, RMW_IMPLEMENTATION), test_mock_publis
   rcl_reset_error();
 }
 
+// A failing rmw call which sets no error must not report a stale error as its cause
+TEST_F(CLASSNAME(TestPublisherFixtureInit, RMW_IMPLEMENTATION), test_mock_publish_stale_error) {
+  auto mock = mocking_utils::patch_and_return("lib:rcl", rmw_publish, RMW_RET_ERROR);
+
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  RCL_SET_ERROR_MSG("stale error");
+  rcl_ret_t ret = rcl_publish(&publisher, &msg, nullptr);
+  test_msgs__msg__BasicTypes__fini(&msg);
+  EXPECT_EQ(RCL_RET_ERROR, ret);
+  ASSERT_TRUE(rcl_error_is_set());
+  EXPECT_EQ(nullptr, strstr(rcl_get_error_string().str, "stale error"));
+  rcl_reset_error();
+}
+
 // Mocking rmw_publish_serialized_message to make rcl_publish_serialized_message fail
 TEST_F(
   CLASSNAME(TestPublisherFixtureInit, RMW_IMPLEMENTATION), test_mock_publish_serialized_message)
@@ -809,6 +828,41 @@ TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_mocks_fail_publ
   }
 }
 
+// Publishers must still be created when the rmw cannot count matched subscriptions.
+TEST_F(
+  CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_mock_matched_count_unsupported)
+{
+  auto mock = mocking_utils::patch_and_return(
+    "lib:rcl", rmw_publisher_count_matched_subscriptions, RMW_RET_UNSUPPORTED);
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  constexpr char topic_name[] = "chatter";
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+
+  for (bool skip_when_unmatched : {false, true}) {
+    rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+    rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+    publisher_options.skip_when_unmatched = skip_when_unmatched;
+    rcl_ret_t ret = rcl_publisher_init(
+      &publisher, this->node_ptr, ts, topic_name, &publisher_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_FALSE(rcl_error_is_set());
+    // The count is unknown, so the publisher keeps publishing.
+    EXPECT_TRUE(rcl_publisher_has_matched_subscriptions(&publisher));
+    EXPECT_FALSE(rcl_error_is_set());
+    EXPECT_EQ(RCL_RET_OK, rcl_publish(&publisher, &msg, nullptr)) << rcl_get_error_string().str;
+    EXPECT_EQ(
+      RCL_RET_UNSUPPORTED, rcl_publisher_update_matched_subscription_count(&publisher));
+    rcl_reset_error();
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, this->node_ptr));
+  }
+}
+
 // Test mocked fail fini publisher
 TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_mock_publisher_fini_fail) {
   rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
@@ -825,3 +879,169 @@ TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_mock_publisher_
   ret = rcl_publisher_fini(&publisher, this->node_ptr);
   EXPECT_EQ(RCL_RET_ERROR, ret) << rcl_get_error_string().str;
 }
+
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publisher_group_init_fini) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const rosidl_message_type_support_t * ts_strings =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings);
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_t publisher_alias = rcl_get_zero_initialized_publisher();
+  rcl_publisher_t publisher_strings = rcl_get_zero_initialized_publisher();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_publisher_init(&publisher, this->node_ptr, ts, "raw", &publisher_options));
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_publisher_init(&publisher_alias, this->node_ptr, ts, "alias", &publisher_options));
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_publisher_init(
+      &publisher_strings, this->node_ptr, ts_strings, "strings", &publisher_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, this->node_ptr));
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher_alias, this->node_ptr));
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher_strings, this->node_ptr));
+  });
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_publisher_group_t group = rcl_get_zero_initialized_publisher_group();
+  const rcl_publisher_t * publishers[] = {&publisher, &publisher_alias, &publisher_strings};
+
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_publisher_group_init(nullptr, publishers, 2u, allocator));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_publisher_group_init(&group, nullptr, 2u, allocator));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_publisher_group_init(&group, publishers, 0u, allocator));
+  rcl_reset_error();
+  // The type compatibility is checked up front.
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_publisher_group_init(&group, publishers, 3u, allocator));
+  rcl_reset_error();
+  rcl_publisher_t invalid_publisher = rcl_get_zero_initialized_publisher();
+  const rcl_publisher_t * invalid_publishers[] = {&publisher, &invalid_publisher};
+  EXPECT_EQ(
+    RCL_RET_PUBLISHER_INVALID, rcl_publisher_group_init(&group, invalid_publishers, 2u, allocator));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_publish_to_many(&group, &publisher, nullptr));
+  rcl_reset_error();
+
+  ASSERT_EQ(RCL_RET_OK, rcl_publisher_group_init(&group, publishers, 2u, allocator)) <<
+    rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_ALREADY_INIT, rcl_publisher_group_init(&group, publishers, 2u, allocator));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_publish_to_many(&group, nullptr, nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_OK, rcl_publisher_group_fini(&group));
+  EXPECT_EQ(RCL_RET_OK, rcl_publisher_group_fini(&group));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_publisher_group_fini(nullptr));
+  rcl_reset_error();
+}
+
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publish_to_many) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  const char * topic_names[] = {"fan_out", "fan_out_alias"};
+  rcl_publisher_t publishers[2];
+  rcl_subscription_t subscriptions[2];
+  for (size_t i = 0u; i < 2u; ++i) {
+    publishers[i] = rcl_get_zero_initialized_publisher();
+    rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_publisher_init(
+        &publishers[i], this->node_ptr, ts, topic_names[i], &publisher_options));
+    subscriptions[i] = rcl_get_zero_initialized_subscription();
+    rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+    ASSERT_EQ(
+      RCL_RET_OK, rcl_subscription_init(
+        &subscriptions[i], this->node_ptr, ts, topic_names[i], &subscription_options));
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0u; i < 2u; ++i) {
+      EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscriptions[i], this->node_ptr));
+      EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publishers[i], this->node_ptr));
+    }
+  });
+  for (size_t i = 0u; i < 2u; ++i) {
+    ASSERT_TRUE(wait_for_established_subscription(&publishers[i], 10, 100));
+  }
+  rcl_publisher_group_t group = rcl_get_zero_initialized_publisher_group();
+  const rcl_publisher_t * group_publishers[] = {&publishers[0], &publishers[1]};
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_publisher_group_init(&group, group_publishers, 2u, rcl_get_default_allocator())) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_group_fini(&group));
+  });
+
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  msg.int64_value = 42;
+  ASSERT_EQ(RCL_RET_OK, rcl_publish_to_many(&group, &msg, nullptr)) <<
+    rcl_get_error_string().str;
+  for (size_t i = 0u; i < 2u; ++i) {
+    ASSERT_TRUE(wait_for_subscription_to_be_ready(&subscriptions[i], context_ptr, 10, 100));
+    test_msgs__msg__BasicTypes received;
+    test_msgs__msg__BasicTypes__init(&received);
+    EXPECT_EQ(RCL_RET_OK, rcl_take(&subscriptions[i], &received, nullptr, nullptr));
+    EXPECT_EQ(42, received.int64_value);
+    test_msgs__msg__BasicTypes__fini(&received);
+  }
+
+  {
+    auto mock = mocking_utils::patch_and_return("lib:rcl", rmw_serialize, RMW_RET_ERROR);
+    EXPECT_EQ(RCL_RET_ERROR, rcl_publish_to_many(&group, &msg, nullptr));
+    EXPECT_TRUE(rcl_error_is_set());
+    rcl_reset_error();
+  }
+
+  {
+    // The first publisher fails, the second one still publishes.
+    static size_t publish_calls = 0u;
+    auto mock = mocking_utils::patch(
+      "lib:rcl", rmw_publish_serialized_message, [](auto, auto, auto) {
+        return 0u == publish_calls++ ? RMW_RET_ERROR : RMW_RET_OK;
+      });
+    EXPECT_EQ(RCL_RET_ERROR, rcl_publish_to_many(&group, &msg, nullptr));
+    EXPECT_TRUE(rcl_error_is_set());
+    rcl_reset_error();
+    EXPECT_EQ(2u, publish_calls);
+  }
+}
+
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publish_to_many_unmatched) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.skip_when_unmatched = true;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_publisher_init(&publisher, this->node_ptr, ts, "unmatched", &publisher_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, this->node_ptr));
+  });
+  rcl_publisher_group_t group = rcl_get_zero_initialized_publisher_group();
+  const rcl_publisher_t * publishers[] = {&publisher};
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_publisher_group_init(&group, publishers, 1u, rcl_get_default_allocator()));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_group_fini(&group));
+  });
+
+  // Nobody listens, so the message is not even serialized.
+  auto mock = mocking_utils::patch_and_return("lib:rcl", rmw_serialize, RMW_RET_ERROR);
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  EXPECT_EQ(RCL_RET_OK, rcl_publish_to_many(&group, &msg, nullptr));
+  test_msgs__msg__BasicTypes__fini(&msg);
+}
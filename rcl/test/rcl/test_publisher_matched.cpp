@@ -0,0 +1,234 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+class TestPublisherMatchedFixture : public ::testing::Test
+{
+public:
+  rcl_context_t context;
+  rcl_node_t node;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+
+  void SetUp()
+  {
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+    });
+    context = rcl_get_zero_initialized_context();
+    ret = rcl_init(0, nullptr, &init_options, &context);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    ret = rcl_node_init(&node, "test_publisher_matched_node", "", &context, &node_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  void TearDown()
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+  }
+};
+
+TEST_F(TestPublisherMatchedFixture, test_invalid_options) {
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  EXPECT_FALSE(publisher_options.skip_when_unmatched);
+  publisher_options.matched_count_max_age = -1;
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_publisher_init(&publisher, &node, ts, "matched", &publisher_options));
+  rcl_reset_error();
+  publisher_options = rcl_publisher_get_default_options();
+  publisher_options.skip_when_unmatched = true;
+  publisher_options.qos.durability = RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT,
+    rcl_publisher_init(&publisher, &node, ts, "matched", &publisher_options));
+  rcl_reset_error();
+
+  EXPECT_FALSE(rcl_publisher_has_matched_subscriptions(nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_PUBLISHER_INVALID, rcl_publisher_update_matched_subscription_count(&publisher));
+  rcl_reset_error();
+}
+
+TEST_F(TestPublisherMatchedFixture, test_skip_until_matched_count_is_updated) {
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.skip_when_unmatched = true;
+  // Old enough to never expire during the test.
+  publisher_options.matched_count_max_age = RCL_S_TO_NS(60);
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_publisher_init(&publisher, &node, ts, "matched", &publisher_options)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &node));
+  });
+  EXPECT_FALSE(rcl_publisher_has_matched_subscriptions(&publisher));
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  EXPECT_EQ(RCL_RET_OK, rcl_publish(&publisher, &msg, nullptr));
+
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_subscription_init(&subscription, &node, ts, "matched", &subscription_options));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+
+  // The cache has not seen the subscription yet, so the message is dropped.
+  EXPECT_FALSE(rcl_publisher_has_matched_subscriptions(&publisher));
+  msg.int64_value = 1;
+  EXPECT_EQ(RCL_RET_OK, rcl_publish(&publisher, &msg, nullptr));
+  test_msgs__msg__BasicTypes received;
+  test_msgs__msg__BasicTypes__init(&received);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&received);
+  });
+  EXPECT_EQ(
+    RCL_RET_SUBSCRIPTION_TAKE_FAILED, rcl_take(&subscription, &received, nullptr, nullptr));
+
+  // As done on a graph guard condition trigger.
+  ASSERT_EQ(RCL_RET_OK, rcl_publisher_update_matched_subscription_count(&publisher));
+  EXPECT_TRUE(rcl_publisher_has_matched_subscriptions(&publisher));
+  msg.int64_value = 2;
+  EXPECT_EQ(RCL_RET_OK, rcl_publish(&publisher, &msg, nullptr));
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_wait_set_init(&wait_set, 1, 0, 0, 0, 0, 0, &context, rcl_get_default_allocator()));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_subscription(&wait_set, &subscription, nullptr));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait(&wait_set, RCL_S_TO_NS(1)));
+  ASSERT_EQ(RCL_RET_OK, rcl_take(&subscription, &received, nullptr, nullptr));
+  EXPECT_EQ(2, received.int64_value);
+}
+
+TEST_F(TestPublisherMatchedFixture, test_subscription_joins_while_publishing) {
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.skip_when_unmatched = true;
+  // The default max age, reading the count on every publish.
+  EXPECT_EQ(0, publisher_options.matched_count_max_age);
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_publisher_init(&publisher, &node, ts, "joining", &publisher_options)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &node));
+  });
+
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  std::atomic<bool> joined{false};
+  rcl_ret_t join_ret = RCL_RET_ERROR;
+  std::thread joiner([this, &subscription, &joined, &join_ret]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+      join_ret = rcl_subscription_init(
+        &subscription, &node, ts, "joining", &subscription_options);
+      joined.store(true);
+    });
+
+  // Keep publishing while the subscription joins, then a few more messages, fewer than the
+  // depth of the subscription so that none of them is lost to its history.
+  constexpr int64_t num_published_after_join = 5;
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  int64_t first_after_join = 0;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (0 == first_after_join && joined.load()) {
+      first_after_join = msg.int64_value + 1;
+    }
+    if (0 != first_after_join &&
+      msg.int64_value - first_after_join + 1 == num_published_after_join)
+    {
+      break;
+    }
+    ++msg.int64_value;
+    EXPECT_EQ(RCL_RET_OK, rcl_publish(&publisher, &msg, nullptr)) << rcl_get_error_string().str;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  joiner.join();
+  ASSERT_EQ(RCL_RET_OK, join_ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+  ASSERT_NE(0, first_after_join);
+  EXPECT_TRUE(rcl_publisher_has_matched_subscriptions(&publisher));
+
+  // No message published after the join was dropped.
+  test_msgs__msg__BasicTypes received;
+  test_msgs__msg__BasicTypes__init(&received);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&received);
+  });
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_wait_set_init(&wait_set, 1, 0, 0, 0, 0, 0, &context, rcl_get_default_allocator()));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_subscription(&wait_set, &subscription, nullptr));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait(&wait_set, RCL_S_TO_NS(1)));
+  int64_t expected = first_after_join;
+  while (RCL_RET_OK == rcl_take(&subscription, &received, nullptr, nullptr)) {
+    if (received.int64_value >= first_after_join) {
+      EXPECT_EQ(expected, received.int64_value);
+      expected = received.int64_value + 1;
+    }
+  }
+  rcl_reset_error();
+  EXPECT_EQ(first_after_join + num_published_after_join, expected);
+}
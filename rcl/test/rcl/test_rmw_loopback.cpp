@@ -0,0 +1,385 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "rcl/error_handling.h"
+#include "rcl/event.h"
+#include "rcl/graph.h"
+#include "rcl/rcl.h"
+
+#include "rcutils/env.h"
+#include "rmw/rmw.h"
+#include "rosidl_runtime_c/string_functions.h"
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/msg/strings.h"
+#include "test_msgs/srv/basic_types.h"
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+// These tests run with RMW_IMPLEMENTATION=rmw_loopback, the in-memory rmw of test/rmw_loopback.
+class TestRmwLoopbackFixture : public ::testing::Test
+{
+public:
+  rcl_context_t context;
+  rcl_node_t node;
+
+  void SetUp()
+  {
+    init_context(&this->context);
+    this->node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    rcl_ret_t ret = rcl_node_init(
+      &this->node, "test_rmw_loopback_node", "", &this->context, &node_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  void TearDown()
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&this->node)) << rcl_get_error_string().str;
+    fini_context(&this->context);
+  }
+
+  static void init_context(rcl_context_t * context)
+  {
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    rcl_ret_t ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+    });
+    *context = rcl_get_zero_initialized_context();
+    ret = rcl_init(0, nullptr, &init_options, context);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  static void fini_context(rcl_context_t * context)
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_shutdown(context)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_context_fini(context)) << rcl_get_error_string().str;
+  }
+};
+
+TEST_F(TestRmwLoopbackFixture, test_identifier) {
+  EXPECT_STREQ("rmw_loopback", rmw_get_implementation_identifier());
+}
+
+TEST_F(TestRmwLoopbackFixture, test_publish_take_basic_types) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  rcl_ret_t ret = rcl_publisher_init(&publisher, &this->node, ts, "chatter", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &this->node));
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(
+    &subscription, &this->node, ts, "chatter", &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &this->node));
+  });
+
+  size_t count = 0u;
+  ASSERT_EQ(RCL_RET_OK, rcl_publisher_get_subscription_count(&publisher, &count));
+  EXPECT_EQ(1u, count);
+  ASSERT_EQ(RCL_RET_OK, rcl_subscription_get_publisher_count(&subscription, &count));
+  EXPECT_EQ(1u, count);
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(
+    &wait_set, 1, 0, 0, 0, 0, 0, &this->context, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_subscription(&wait_set, &subscription, nullptr));
+  EXPECT_EQ(RCL_RET_TIMEOUT, rcl_wait(&wait_set, 0));
+
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  msg.int64_value = -42;
+  msg.float64_value = 3.5;
+  msg.bool_value = true;
+  ret = rcl_publish(&publisher, &msg, nullptr);
+  test_msgs__msg__BasicTypes__fini(&msg);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_clear(&wait_set));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_subscription(&wait_set, &subscription, nullptr));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait(&wait_set, RCL_S_TO_NS(1)));
+  EXPECT_EQ(&subscription, wait_set.subscriptions[0]);
+
+  test_msgs__msg__BasicTypes taken_msg;
+  test_msgs__msg__BasicTypes__init(&taken_msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&taken_msg);
+  });
+  rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+  ret = rcl_take(&subscription, &taken_msg, &message_info, nullptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(-42, taken_msg.int64_value);
+  EXPECT_EQ(3.5, taken_msg.float64_value);
+  EXPECT_TRUE(taken_msg.bool_value);
+  EXPECT_NE(0, message_info.source_timestamp);
+  ret = rcl_take(&subscription, &taken_msg, nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_TAKE_FAILED, ret);
+}
+
+TEST_F(TestRmwLoopbackFixture, test_publish_take_strings_and_message_lost) {
+  const rosidl_message_type_support_t * ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  rcl_ret_t ret = rcl_publisher_init(&publisher, &this->node, ts, "strings", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &this->node));
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.qos.depth = 2;
+  ret = rcl_subscription_init(
+    &subscription, &this->node, ts, "strings", &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &this->node));
+  });
+  rcl_event_t event = rcl_get_zero_initialized_event();
+  ret = rcl_subscription_event_init(&event, &subscription, RCL_SUBSCRIPTION_MESSAGE_LOST);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_event_fini(&event));
+  });
+
+  // The depth is 2, so publishing 3 messages loses the first one.
+  const char * values[] = {"first", "second", "a longer third message"};
+  for (const char * value : values) {
+    test_msgs__msg__Strings msg;
+    test_msgs__msg__Strings__init(&msg);
+    ASSERT_TRUE(rosidl_runtime_c__String__assign(&msg.string_value, value));
+    ret = rcl_publish(&publisher, &msg, nullptr);
+    test_msgs__msg__Strings__fini(&msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  rmw_message_lost_status_t message_lost;
+  ASSERT_EQ(RCL_RET_OK, rcl_take_event(&event, &message_lost)) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, message_lost.total_count);
+  EXPECT_EQ(1u, message_lost.total_count_change);
+
+  test_msgs__msg__Strings taken_msg;
+  test_msgs__msg__Strings__init(&taken_msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__Strings__fini(&taken_msg);
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_take(&subscription, &taken_msg, nullptr, nullptr));
+  EXPECT_EQ(std::string("second"), taken_msg.string_value.data);
+  ASSERT_EQ(RCL_RET_OK, rcl_take(&subscription, &taken_msg, nullptr, nullptr));
+  EXPECT_EQ(std::string("a longer third message"), taken_msg.string_value.data);
+}
+
+TEST_F(TestRmwLoopbackFixture, test_service_round_trip) {
+  const rosidl_service_type_support_t * ts =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  rcl_ret_t ret = rcl_client_init(&client, &this->node, ts, "add", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_client_fini(&client, &this->node));
+  });
+  bool is_available = true;
+  ASSERT_EQ(RCL_RET_OK, rcl_service_server_is_available(&this->node, &client, &is_available));
+  EXPECT_FALSE(is_available);
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, &this->node, ts, "add", &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_service_fini(&service, &this->node));
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_service_server_is_available(&this->node, &client, &is_available));
+  EXPECT_TRUE(is_available);
+
+  test_msgs__srv__BasicTypes_Request request;
+  test_msgs__srv__BasicTypes_Request__init(&request);
+  request.int64_value = 20;
+  int64_t sequence_number = 0;
+  ret = rcl_send_request(&client, &request, &sequence_number);
+  test_msgs__srv__BasicTypes_Request__fini(&request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  test_msgs__srv__BasicTypes_Request service_request;
+  test_msgs__srv__BasicTypes_Request__init(&service_request);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&service_request);
+  });
+  rmw_service_info_t header;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(20, service_request.int64_value);
+  EXPECT_EQ(sequence_number, header.request_id.sequence_number);
+
+  test_msgs__srv__BasicTypes_Response response;
+  test_msgs__srv__BasicTypes_Response__init(&response);
+  response.int64_value = service_request.int64_value + 1;
+  ret = rcl_send_response(&service, &header.request_id, &response);
+  test_msgs__srv__BasicTypes_Response__fini(&response);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  test_msgs__srv__BasicTypes_Response client_response;
+  test_msgs__srv__BasicTypes_Response__init(&client_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&client_response);
+  });
+  rmw_service_info_t response_header;
+  ret = rcl_take_response_with_info(&client, &response_header, &client_response);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(21, client_response.int64_value);
+  EXPECT_EQ(sequence_number, response_header.request_id.sequence_number);
+}
+
+TEST_F(TestRmwLoopbackFixture, test_guard_condition_wait) {
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_ret_t ret = rcl_guard_condition_init(
+    &guard_condition, &this->context, rcl_guard_condition_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition));
+  });
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(
+    &wait_set, 0, 1, 0, 0, 0, 0, &this->context, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+  });
+
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, nullptr));
+  EXPECT_EQ(RCL_RET_TIMEOUT, rcl_wait(&wait_set, RCL_MS_TO_NS(10)));
+
+  ASSERT_EQ(RCL_RET_OK, rcl_trigger_guard_condition(&guard_condition));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_clear(&wait_set));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, nullptr));
+  EXPECT_EQ(RCL_RET_OK, rcl_wait(&wait_set, -1));
+  EXPECT_EQ(&guard_condition, wait_set.guard_conditions[0]);
+
+  // Waiting consumes the trigger.
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_clear(&wait_set));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, nullptr));
+  EXPECT_EQ(RCL_RET_TIMEOUT, rcl_wait(&wait_set, 0));
+}
+
+TEST_F(TestRmwLoopbackFixture, test_graph) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  rcl_ret_t ret = rcl_publisher_init(&publisher, &this->node, ts, "graph", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &this->node));
+  });
+
+  size_t count = 0u;
+  ASSERT_EQ(RCL_RET_OK, rcl_count_publishers(&this->node, "/graph", &count));
+  EXPECT_EQ(1u, count);
+  ASSERT_EQ(RCL_RET_OK, rcl_count_subscribers(&this->node, "/graph", &count));
+  EXPECT_EQ(0u, count);
+
+  rcutils_string_array_t node_names = rcutils_get_zero_initialized_string_array();
+  rcutils_string_array_t node_namespaces = rcutils_get_zero_initialized_string_array();
+  ret = rcl_get_node_names(
+    &this->node, rcl_get_default_allocator(), &node_names, &node_namespaces);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_names));
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_namespaces));
+  });
+  ASSERT_EQ(1u, node_names.size);
+  EXPECT_STREQ("test_rmw_loopback_node", node_names.data[0]);
+  EXPECT_STREQ("/", node_namespaces.data[0]);
+}
+
+TEST(TestRmwLoopbackNoop, test_noop) {
+  ASSERT_TRUE(rcutils_set_env("RMW_LOOPBACK_NOOP", "1"));
+  rcl_context_t context;
+  TestRmwLoopbackFixture::init_context(&context);
+  ASSERT_TRUE(rcutils_set_env("RMW_LOOPBACK_NOOP", nullptr));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    TestRmwLoopbackFixture::fini_context(&context);
+  });
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  rcl_ret_t ret = rcl_node_init(&node, "noop_node", "", &context, &node_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node));
+  });
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&subscription, &node, ts, "noop", &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+
+  // Nothing was published, yet the wait returns at once and the take reports a message.
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 1, 0, 0, 0, 0, 0, &context, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_subscription(&wait_set, &subscription, nullptr));
+  EXPECT_EQ(RCL_RET_OK, rcl_wait(&wait_set, -1));
+  EXPECT_EQ(&subscription, wait_set.subscriptions[0]);
+
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  msg.int32_value = 7;
+  EXPECT_EQ(RCL_RET_OK, rcl_take(&subscription, &msg, nullptr, nullptr));
+  EXPECT_EQ(7, msg.int32_value);
+  test_msgs__msg__BasicTypes__fini(&msg);
+}
@@ -14,6 +14,10 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstring>
+#include <thread>
+
 #include "rcl/service.h"
 #include "rcl/rcl.h"
 
@@ -21,6 +25,7 @@
 
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
 #include "rcl/error_handling.h"
+#include "rmw/rmw.h"
 #include "rmw/validate_namespace.h"
 
 #include "wait_for_entity_helpers.hpp"
@@ -630,3 +635,852 @@ TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_fail_send_respons
     rcl_reset_error();
   }
 }
+
+/* Basic nominal test of a service taking requests and sending responses in sequences.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_sequence) {
+  rcl_ret_t ret;
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  constexpr char topic[] = "primitives";
+  constexpr size_t num_requests = 3u;
+  constexpr size_t count = 5u;
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, this->node_ptr, ts, topic, &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  ASSERT_TRUE(wait_for_server_to_be_available(this->node_ptr, &client, 10, 1000));
+
+  for (size_t i = 0u; i < num_requests; ++i) {
+    test_msgs__srv__BasicTypes_Request client_request;
+    test_msgs__srv__BasicTypes_Request__init(&client_request);
+    client_request.bool_value = false;
+    client_request.uint8_value = static_cast<uint8_t>(i);
+    client_request.uint32_value = 2;
+    int64_t sequence_number;
+    ret = rcl_send_request(&client, &client_request, &sequence_number);
+    test_msgs__srv__BasicTypes_Request__fini(&client_request);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  ASSERT_TRUE(wait_for_service_to_be_ready(&service, context_ptr, 10, 100));
+
+  {
+    test_msgs__srv__BasicTypes_Request service_requests[count];
+    test_msgs__srv__BasicTypes_Response service_responses[count];
+    void * ros_requests[count];
+    void * ros_responses[count];
+    for (size_t i = 0u; i < count; ++i) {
+      test_msgs__srv__BasicTypes_Request__init(&service_requests[i]);
+      test_msgs__srv__BasicTypes_Response__init(&service_responses[i]);
+      ros_requests[i] = &service_requests[i];
+      ros_responses[i] = &service_responses[i];
+    }
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      for (size_t i = 0u; i < count; ++i) {
+        test_msgs__srv__BasicTypes_Request__fini(&service_requests[i]);
+        test_msgs__srv__BasicTypes_Response__fini(&service_responses[i]);
+      }
+    });
+    rmw_service_info_t headers[count];
+    rmw_request_id_t request_ids[count];
+
+    // Requests may not have all arrived yet, keep taking until they have.
+    size_t total_taken = 0u;
+    for (size_t attempt = 0u; attempt < 10u && total_taken < num_requests; ++attempt) {
+      size_t taken = 0u;
+      ret = rcl_take_request_sequence(
+        &service, count - total_taken, &headers[total_taken], &ros_requests[total_taken], &taken);
+      if (RCL_RET_SERVICE_TAKE_FAILED == ret) {
+        EXPECT_EQ(0u, taken);
+        ASSERT_TRUE(wait_for_service_to_be_ready(&service, context_ptr, 10, 100));
+        continue;
+      }
+      ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+      total_taken += taken;
+    }
+    ASSERT_EQ(num_requests, total_taken);
+
+    for (size_t i = 0u; i < total_taken; ++i) {
+      EXPECT_EQ(i, service_requests[i].uint8_value);
+      EXPECT_EQ(2UL, service_requests[i].uint32_value);
+      service_responses[i].uint64_value =
+        service_requests[i].uint8_value + service_requests[i].uint32_value;
+      request_ids[i] = headers[i].request_id;
+    }
+
+    size_t taken = 0u;
+    ret = rcl_take_request_sequence(&service, count, headers, ros_requests, &taken);
+    EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(0u, taken);
+
+    size_t sent = 0u;
+    ret = rcl_send_response_sequence(&service, total_taken, request_ids, ros_responses, &sent);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(num_requests, sent);
+  }
+
+  for (size_t i = 0u; i < num_requests; ++i) {
+    ASSERT_TRUE(wait_for_client_to_be_ready(&client, context_ptr, 10, 100));
+    test_msgs__srv__BasicTypes_Response client_response;
+    test_msgs__srv__BasicTypes_Response__init(&client_response);
+    rmw_service_info_t header;
+    ret = rcl_take_response_with_info(&client, &header, &client_response);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(
+      static_cast<uint64_t>(header.request_id.sequence_number + 1),
+      client_response.uint64_value);
+    test_msgs__srv__BasicTypes_Response__fini(&client_response);
+  }
+}
+
+/* Test failed service take_request_sequence and send_response_sequence using mocks and nullptrs
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_fail_service_sequence) {
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  constexpr char topic[] = "primitives";
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  rcl_ret_t ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  test_msgs__srv__BasicTypes_Request service_requests[2];
+  test_msgs__srv__BasicTypes_Response service_responses[2];
+  for (size_t i = 0u; i < 2u; ++i) {
+    test_msgs__srv__BasicTypes_Request__init(&service_requests[i]);
+    test_msgs__srv__BasicTypes_Response__init(&service_responses[i]);
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0u; i < 2u; ++i) {
+      test_msgs__srv__BasicTypes_Request__fini(&service_requests[i]);
+      test_msgs__srv__BasicTypes_Response__fini(&service_responses[i]);
+    }
+  });
+  void * ros_requests[2] = {&service_requests[0], &service_requests[1]};
+  void * ros_responses[2] = {&service_responses[0], &service_responses[1]};
+  rmw_service_info_t headers[2];
+  rmw_request_id_t request_ids[2];
+  size_t taken = 0u;
+  size_t sent = 0u;
+
+  // The count is set even when the arguments are invalid.
+  taken = 2u;
+  ret = rcl_take_request_sequence(nullptr, 2u, headers, ros_requests, &taken);
+  EXPECT_EQ(RCL_RET_SERVICE_INVALID, ret);
+  EXPECT_EQ(0u, taken);
+  EXPECT_TRUE(rcl_error_is_set());
+  rcl_reset_error();
+
+  ret = rcl_take_request_sequence(&service, 2u, nullptr, ros_requests, &taken);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  EXPECT_TRUE(rcl_error_is_set());
+  rcl_reset_error();
+
+  ret = rcl_take_request_sequence(&service, 2u, headers, nullptr, &taken);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  EXPECT_TRUE(rcl_error_is_set());
+  rcl_reset_error();
+
+  ret = rcl_take_request_sequence(&service, 2u, headers, ros_requests, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  EXPECT_TRUE(rcl_error_is_set());
+  rcl_reset_error();
+
+  {
+    void * missing_requests[2] = {&service_requests[0], nullptr};
+    ret = rcl_take_request_sequence(&service, 2u, headers, missing_requests, &taken);
+    EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+    EXPECT_TRUE(rcl_error_is_set());
+    rcl_reset_error();
+  }
+  {
+    auto mock = mocking_utils::patch_and_return(
+      "lib:rcl", rmw_take_request, RMW_RET_ERROR);
+    ret = rcl_take_request_sequence(&service, 2u, headers, ros_requests, &taken);
+    EXPECT_EQ(RCL_RET_ERROR, ret);
+    EXPECT_EQ(0u, taken);
+    EXPECT_TRUE(rcl_error_is_set());
+    rcl_reset_error();
+  }
+  {
+    auto mock = mocking_utils::patch_and_return(
+      "lib:rcl", rmw_take_request, RMW_RET_BAD_ALLOC);
+    ret = rcl_take_request_sequence(&service, 2u, headers, ros_requests, &taken);
+    EXPECT_EQ(RCL_RET_BAD_ALLOC, ret);
+    EXPECT_TRUE(rcl_error_is_set());
+    rcl_reset_error();
+  }
+  {
+    // Only one request is pending
+    static size_t num_calls;
+    num_calls = 0u;
+    auto mock = mocking_utils::patch(
+      "lib:rcl", rmw_take_request,
+      [](auto, auto, auto, bool * taken) {
+        *taken = (0u == num_calls++);
+        return RMW_RET_OK;
+      });
+    ret = rcl_take_request_sequence(&service, 2u, headers, ros_requests, &taken);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(1u, taken);
+    EXPECT_EQ(2u, num_calls);
+
+    ret = rcl_take_request_sequence(&service, 2u, headers, ros_requests, &taken);
+    EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, ret);
+    EXPECT_EQ(0u, taken);
+  }
+
+  sent = 2u;
+  ret = rcl_send_response_sequence(nullptr, 2u, request_ids, ros_responses, &sent);
+  EXPECT_EQ(RCL_RET_SERVICE_INVALID, ret);
+  EXPECT_EQ(0u, sent);
+  rcl_reset_error();
+
+  ret = rcl_send_response_sequence(&service, 2u, nullptr, ros_responses, &sent);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_send_response_sequence(&service, 2u, request_ids, nullptr, &sent);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_send_response_sequence(&service, 2u, request_ids, ros_responses, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  {
+    auto mock = mocking_utils::patch_and_return(
+      "lib:rcl", rmw_send_response, RMW_RET_ERROR);
+    ret = rcl_send_response_sequence(&service, 2u, request_ids, ros_responses, &sent);
+    EXPECT_EQ(RCL_RET_ERROR, ret);
+    EXPECT_EQ(0u, sent);
+    EXPECT_TRUE(rcl_error_is_set());
+    rcl_reset_error();
+  }
+  {
+    // The second response fails to be sent
+    static size_t num_calls;
+    num_calls = 0u;
+    auto mock = mocking_utils::patch(
+      "lib:rcl", rmw_send_response,
+      [](auto, auto, auto) {
+        return 0u == num_calls++ ? RMW_RET_OK : RMW_RET_ERROR;
+      });
+    ret = rcl_send_response_sequence(&service, 2u, request_ids, ros_responses, &sent);
+    EXPECT_EQ(RCL_RET_ERROR, ret);
+    EXPECT_EQ(1u, sent);
+    EXPECT_TRUE(rcl_error_is_set());
+    rcl_reset_error();
+  }
+}
+
+/* Test of a service deduplicating identical requests and caching their responses.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_response_cache) {
+  rcl_ret_t ret;
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  constexpr char topic[] = "primitives";
+  rcl_service_response_cache_stats_t stats;
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  EXPECT_EQ(0u, service_options.response_cache.capacity);
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_ERROR, rcl_service_get_response_cache_stats(&service, &stats));
+  rcl_reset_error();
+  ret = rcl_service_fini(&service, this->node_ptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  test_msgs__srv__BasicTypes_Response cached_response;
+  test_msgs__srv__BasicTypes_Response__init(&cached_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&cached_response);
+  });
+  service_options.response_cache.capacity = 64 * 1024;
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  service_options.response_cache.ttl = RCUTILS_S_TO_NS(60);
+  service_options.response_cache.request_type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, srv, BasicTypes_Request);
+  service_options.response_cache.response_type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, srv, BasicTypes_Response);
+  service_options.response_cache.response_buffer = &cached_response;
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_service_get_response_cache_stats(&service, nullptr));
+  rcl_reset_error();
+
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, this->node_ptr, ts, topic, &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  ASSERT_TRUE(wait_for_server_to_be_available(this->node_ptr, &client, 10, 1000));
+
+  auto send_request = [&client]() {
+      test_msgs__srv__BasicTypes_Request client_request;
+      test_msgs__srv__BasicTypes_Request__init(&client_request);
+      client_request.uint8_value = 1;
+      client_request.uint32_value = 2;
+      int64_t sequence_number;
+      rcl_ret_t ret = rcl_send_request(&client, &client_request, &sequence_number);
+      test_msgs__srv__BasicTypes_Request__fini(&client_request);
+      return ret;
+    };
+
+  test_msgs__srv__BasicTypes_Request service_request;
+  test_msgs__srv__BasicTypes_Request__init(&service_request);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&service_request);
+  });
+  rmw_service_info_t header;
+
+  // The first request has to be handled.
+  ASSERT_EQ(RCL_RET_OK, send_request()) << rcl_get_error_string().str;
+  ASSERT_TRUE(wait_for_service_to_be_ready(&service, context_ptr, 10, 100));
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rmw_request_id_t leader_id = header.request_id;
+
+  // Identical requests are held back while it is.
+  ASSERT_EQ(RCL_RET_OK, send_request()) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, send_request()) << rcl_get_error_string().str;
+  for (size_t attempt = 0u; attempt < 10u; ++attempt) {
+    ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+    if (2u == stats.coalesced) {
+      break;
+    }
+    ASSERT_TRUE(wait_for_service_to_be_ready(&service, context_ptr, 10, 100));
+    ret = rcl_take_request_with_info(&service, &header, &service_request);
+    EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, ret) << rcl_get_error_string().str;
+  }
+  EXPECT_EQ(2u, stats.coalesced);
+
+  // Answering the first request answers them all.
+  test_msgs__srv__BasicTypes_Response service_response;
+  test_msgs__srv__BasicTypes_Response__init(&service_response);
+  service_response.uint64_value = 3;
+  ret = rcl_send_response(&service, &leader_id, &service_response);
+  test_msgs__srv__BasicTypes_Response__fini(&service_response);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // Later identical requests are answered from the cache.
+  ASSERT_EQ(RCL_RET_OK, send_request()) << rcl_get_error_string().str;
+  for (size_t attempt = 0u; attempt < 10u; ++attempt) {
+    ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+    if (1u == stats.hits) {
+      break;
+    }
+    ASSERT_TRUE(wait_for_service_to_be_ready(&service, context_ptr, 10, 100));
+    ret = rcl_take_request_with_info(&service, &header, &service_request);
+    EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, ret) << rcl_get_error_string().str;
+  }
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(1u, stats.misses);
+  EXPECT_EQ(0u, stats.evictions);
+  EXPECT_EQ(1u, stats.num_entries);
+  EXPECT_LT(0u, stats.size);
+  EXPECT_EQ(3u, cached_response.uint64_value);
+
+  for (size_t i = 0u; i < 4u; ++i) {
+    ASSERT_TRUE(wait_for_client_to_be_ready(&client, context_ptr, 10, 100));
+    test_msgs__srv__BasicTypes_Response client_response;
+    test_msgs__srv__BasicTypes_Response__init(&client_response);
+    ret = rcl_take_response_with_info(&client, &header, &client_response);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(3u, client_response.uint64_value);
+    test_msgs__srv__BasicTypes_Response__fini(&client_response);
+  }
+}
+
+/* Test of a service response cache bounding and timing out the requests being handled.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_response_cache_pending) {
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  constexpr char topic[] = "primitives";
+  rcl_service_response_cache_stats_t stats;
+
+  test_msgs__srv__BasicTypes_Response cached_response;
+  test_msgs__srv__BasicTypes_Response__init(&cached_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&cached_response);
+  });
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  EXPECT_EQ(RCUTILS_S_TO_NS(10), service_options.response_cache.pending_timeout);
+  service_options.response_cache.capacity = 64 * 1024;
+  service_options.response_cache.ttl = RCUTILS_S_TO_NS(60);
+  service_options.response_cache.pending_timeout = -1;
+  service_options.response_cache.request_type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, srv, BasicTypes_Request);
+  service_options.response_cache.response_type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, srv, BasicTypes_Response);
+  service_options.response_cache.response_buffer = &cached_response;
+  rcl_ret_t ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  service_options.response_cache.pending_timeout = RCUTILS_MS_TO_NS(10);
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  test_msgs__srv__BasicTypes_Request service_request;
+  test_msgs__srv__BasicTypes_Request__init(&service_request);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&service_request);
+  });
+  test_msgs__srv__BasicTypes_Response service_response;
+  test_msgs__srv__BasicTypes_Response__init(&service_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&service_response);
+  });
+  rmw_service_info_t header;
+
+  // Identical requests, as the taken request is left unmodified.
+  static size_t num_pending;
+  static int64_t sequence_number;
+  static size_t num_sent;
+  auto take_mock = mocking_utils::patch(
+    "lib:rcl", rmw_take_request,
+    [](auto, rmw_service_info_t * request_header, auto, bool * taken) {
+      *taken = 0u != num_pending;
+      if (*taken) {
+        --num_pending;
+        request_header->source_timestamp = 0;
+        request_header->request_id.sequence_number = ++sequence_number;
+        memset(request_header->request_id.writer_guid, 0, RMW_GID_STORAGE_SIZE);
+      }
+      return RMW_RET_OK;
+    });
+  auto send_mock = mocking_utils::patch(
+    "lib:rcl", rmw_send_response,
+    [](auto, auto, auto) {
+      ++num_sent;
+      return RMW_RET_OK;
+    });
+  sequence_number = 0;
+  num_sent = 0u;
+
+  // The request being handled holds back an identical one and counts against the capacity.
+  num_pending = 2u;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rmw_request_id_t timed_out_request = header.request_id;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, ret);
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+  EXPECT_EQ(1u, stats.coalesced);
+  EXPECT_EQ(0u, stats.num_entries);
+  EXPECT_LT(0u, stats.size);
+
+  // Once it times out, the next identical request is handled instead.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  num_pending = 1u;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(3, header.request_id.sequence_number);
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+  EXPECT_EQ(2u, stats.misses);
+
+  // The timed out request is still answered, but neither cached nor sent to the dropped waiter.
+  ret = rcl_send_response(&service, &timed_out_request, &service_response);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, num_sent);
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+  EXPECT_EQ(0u, stats.num_entries);
+  ret = rcl_send_response(&service, &header.request_id, &service_response);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(2u, num_sent);
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+  EXPECT_EQ(1u, stats.num_entries);
+  ret = rcl_service_fini(&service, this->node_ptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // Requests which do not fit in the capacity are handled on their own.
+  service_options.response_cache.capacity = 1u;
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  num_pending = 2u;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+  EXPECT_EQ(0u, stats.coalesced);
+  EXPECT_EQ(2u, stats.misses);
+  EXPECT_EQ(0u, stats.size);
+}
+
+/* Test of a service response cache forgetting requests which are not going to be answered.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_response_cache_release) {
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  constexpr char topic[] = "primitives";
+  rcl_service_response_cache_stats_t stats;
+
+  test_msgs__srv__BasicTypes_Response cached_response;
+  test_msgs__srv__BasicTypes_Response__init(&cached_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&cached_response);
+  });
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  service_options.response_cache.capacity = 64 * 1024;
+  service_options.response_cache.ttl = RCUTILS_S_TO_NS(60);
+  service_options.response_cache.request_type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, srv, BasicTypes_Request);
+  service_options.response_cache.response_type_support =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, srv, BasicTypes_Response);
+  service_options.response_cache.response_buffer = &cached_response;
+  rcl_ret_t ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  test_msgs__srv__BasicTypes_Request service_request;
+  test_msgs__srv__BasicTypes_Request__init(&service_request);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&service_request);
+  });
+  test_msgs__srv__BasicTypes_Response service_response;
+  test_msgs__srv__BasicTypes_Response__init(&service_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&service_response);
+  });
+  rmw_service_info_t header;
+
+  // Identical requests, as the taken request is left unmodified.
+  static size_t num_pending;
+  static int64_t sequence_number;
+  static size_t num_sent;
+  static bool fail_send;
+  auto take_mock = mocking_utils::patch(
+    "lib:rcl", rmw_take_request,
+    [](auto, rmw_service_info_t * request_header, auto, bool * taken) {
+      *taken = 0u != num_pending;
+      if (*taken) {
+        --num_pending;
+        request_header->source_timestamp = 0;
+        request_header->request_id.sequence_number = ++sequence_number;
+        memset(request_header->request_id.writer_guid, 0, RMW_GID_STORAGE_SIZE);
+      }
+      return RMW_RET_OK;
+    });
+  auto send_mock = mocking_utils::patch(
+    "lib:rcl", rmw_send_response,
+    [](auto, auto, auto) {
+      if (fail_send) {
+        return RMW_RET_ERROR;
+      }
+      ++num_sent;
+      return RMW_RET_OK;
+    });
+  sequence_number = 0;
+  num_sent = 0u;
+  fail_send = false;
+
+  // A request released without a response stops holding back identical requests.
+  num_pending = 2u;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, ret);
+  rmw_request_id_t released_request = {};
+  released_request.sequence_number = 1;
+  EXPECT_EQ(RCL_RET_OK, rcl_service_release_request(&service, &released_request));
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+  EXPECT_EQ(0u, stats.size);
+  num_pending = 1u;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(3, header.request_id.sequence_number);
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+  EXPECT_EQ(1u, stats.coalesced);
+  EXPECT_EQ(2u, stats.misses);
+
+  // As does a request whose response cannot be sent.
+  fail_send = true;
+  ret = rcl_send_response(&service, &header.request_id, &service_response);
+  EXPECT_EQ(RCL_RET_ERROR, ret);
+  rcl_reset_error();
+  fail_send = false;
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+  EXPECT_EQ(0u, stats.size);
+  num_pending = 1u;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(4, header.request_id.sequence_number);
+
+  // Which is then answered and cached as usual.
+  ret = rcl_send_response(&service, &header.request_id, &service_response);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, num_sent);
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_response_cache_stats(&service, &stats));
+  EXPECT_EQ(1u, stats.num_entries);
+  EXPECT_EQ(1u, stats.coalesced);
+  EXPECT_EQ(3u, stats.misses);
+}
+
+/* Test of a service shedding requests when overloaded or past their deadline.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_admission) {
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  constexpr char topic[] = "primitives";
+
+  test_msgs__srv__BasicTypes_Response busy_response;
+  test_msgs__srv__BasicTypes_Response__init(&busy_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&busy_response);
+  });
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  service_options.admission.max_in_flight = 1u;
+  service_options.admission.deadline = -1;
+  rcl_ret_t ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  service_options.admission.deadline = 0;
+  service_options.admission.in_flight_timeout = -1;
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  service_options.admission.in_flight_timeout = 0;
+  service_options.admission.deadline = RCUTILS_S_TO_NS(1);
+  service_options.admission.busy_response = &busy_response;
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_service_admission_stats_t stats;
+  EXPECT_EQ(RCL_RET_SERVICE_INVALID, rcl_service_get_admission_stats(nullptr, &stats));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_service_get_admission_stats(&service, nullptr));
+  rcl_reset_error();
+
+  test_msgs__srv__BasicTypes_Request service_request;
+  test_msgs__srv__BasicTypes_Request__init(&service_request);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&service_request);
+  });
+  rmw_service_info_t header;
+  test_msgs__srv__BasicTypes_Response service_response;
+  test_msgs__srv__BasicTypes_Response__init(&service_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Response__fini(&service_response);
+  });
+
+  // Three requests are pending, each sent at source_timestamp.
+  static size_t num_pending;
+  static int64_t sequence_number;
+  static rmw_time_point_value_t source_timestamp;
+  static size_t num_sent;
+  auto take_mock = mocking_utils::patch(
+    "lib:rcl", rmw_take_request,
+    [](auto, rmw_service_info_t * request_header, auto, bool * taken) {
+      *taken = 0u != num_pending;
+      if (*taken) {
+        --num_pending;
+        request_header->source_timestamp = source_timestamp;
+        request_header->request_id.sequence_number = ++sequence_number;
+        memset(request_header->request_id.writer_guid, 0, RMW_GID_STORAGE_SIZE);
+      }
+      return RMW_RET_OK;
+    });
+  auto send_mock = mocking_utils::patch(
+    "lib:rcl", rmw_send_response,
+    [](auto, auto, auto) {
+      ++num_sent;
+      return RMW_RET_OK;
+    });
+  num_pending = 3u;
+  sequence_number = 0;
+  num_sent = 0u;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_system_time_now(&source_timestamp));
+
+  // The first request is taken, the second one exceeds the maximum in flight,
+  // and the third one is left pending.
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rmw_request_id_t first_request = header.request_id;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, ret);
+  EXPECT_EQ(1u, num_sent);
+  EXPECT_EQ(1u, num_pending);
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_admission_stats(&service, &stats));
+  EXPECT_EQ(1u, stats.shed_overload);
+  EXPECT_EQ(1u, stats.in_flight);
+
+  // Answering the shed request does not end the one in flight.
+  ret = rcl_send_response(&service, &header.request_id, &service_response);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_admission_stats(&service, &stats));
+  EXPECT_EQ(1u, stats.in_flight);
+
+  ret = rcl_send_response(&service, &first_request, &service_response);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(3u, num_sent);
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(3, header.request_id.sequence_number);
+  size_t sent = 0u;
+  void * service_responses[] = {&service_response};
+  ret = rcl_send_response_sequence(&service, 1u, &header.request_id, service_responses, &sent);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(4u, num_sent);
+
+  // A request sent too long ago is shed as well.
+  num_pending = 1u;
+  source_timestamp -= RCUTILS_S_TO_NS(2);
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  EXPECT_EQ(RCL_RET_SERVICE_TAKE_FAILED, ret);
+  EXPECT_EQ(5u, num_sent);
+
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_admission_stats(&service, &stats));
+  EXPECT_EQ(1u, stats.shed_overload);
+  EXPECT_EQ(1u, stats.shed_deadline);
+  EXPECT_EQ(2u, stats.busy_responses);
+  EXPECT_EQ(0u, stats.in_flight);
+}
+
+/* Test of a service releasing requests in flight, or timing them out, when never answered.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_admission_release) {
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, BasicTypes);
+  constexpr char topic[] = "primitives";
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  service_options.admission.max_in_flight = 1u;
+  service_options.admission.in_flight_timeout = RCUTILS_MS_TO_NS(10);
+  rcl_ret_t ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  test_msgs__srv__BasicTypes_Request service_request;
+  test_msgs__srv__BasicTypes_Request__init(&service_request);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__srv__BasicTypes_Request__fini(&service_request);
+  });
+  rmw_service_info_t header;
+  rcl_service_admission_stats_t stats;
+
+  static size_t num_pending;
+  static int64_t sequence_number;
+  auto take_mock = mocking_utils::patch(
+    "lib:rcl", rmw_take_request,
+    [](auto, rmw_service_info_t * request_header, auto, bool * taken) {
+      *taken = 0u != num_pending;
+      if (*taken) {
+        --num_pending;
+        request_header->source_timestamp = 0;
+        request_header->request_id.sequence_number = ++sequence_number;
+        memset(request_header->request_id.writer_guid, 0, RMW_GID_STORAGE_SIZE);
+      }
+      return RMW_RET_OK;
+    });
+  num_pending = 1u;
+  sequence_number = 0;
+
+  EXPECT_EQ(RCL_RET_SERVICE_INVALID, rcl_service_release_request(nullptr, &header.request_id));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_service_release_request(&service, nullptr));
+  rcl_reset_error();
+
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rmw_request_id_t unknown_request = header.request_id;
+  ++unknown_request.sequence_number;
+  EXPECT_EQ(RCL_RET_OK, rcl_service_release_request(&service, &unknown_request));
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_admission_stats(&service, &stats));
+  EXPECT_EQ(1u, stats.in_flight);
+  EXPECT_EQ(RCL_RET_OK, rcl_service_release_request(&service, &header.request_id));
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_admission_stats(&service, &stats));
+  EXPECT_EQ(0u, stats.in_flight);
+  EXPECT_EQ(RCL_RET_OK, rcl_service_release_request(&service, &header.request_id));
+
+  // A request never answered nor released times out, rather than shedding the next one.
+  num_pending = 1u;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  num_pending = 1u;
+  ret = rcl_take_request_with_info(&service, &header, &service_request);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_service_get_admission_stats(&service, &stats));
+  EXPECT_EQ(0u, stats.shed_overload);
+  EXPECT_EQ(1u, stats.in_flight);
+}
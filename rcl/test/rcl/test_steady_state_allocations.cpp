@@ -0,0 +1,380 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "osrf_testing_tools_cpp/memory_tools/memory_tools.hpp"
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcl/error_handling.h"
+#include "rcl/executor.h"
+#include "rcl/rcl.h"
+#include "rcl/timer.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "./counting_allocator.h"
+
+using osrf_testing_tools_cpp::memory_tools::on_unexpected_malloc;
+using osrf_testing_tools_cpp::memory_tools::on_unexpected_realloc;
+using osrf_testing_tools_cpp::memory_tools::on_unexpected_calloc;
+using osrf_testing_tools_cpp::memory_tools::on_unexpected_free;
+
+// These tests run on rmw_loopback with RMW_LOOPBACK_NOOP=1, so the rmw layer does no work and
+// any memory operation seen in the steady state comes from rcl.
+// Entities are created with a counting allocator which traps once they are initialized, and the
+// steady state calls are also run under memory_tools to catch rcl's own use of malloc.
+class TestSteadyStateAllocationsFixture : public ::testing::Test
+{
+public:
+  static constexpr int kIterations = 10;
+
+  counting_allocator_state allocator_state;
+  rcl_allocator_t allocator;
+  rcl_context_t context;
+  rcl_node_t node;
+
+  void SetUp()
+  {
+    allocator = get_counting_allocator(&allocator_state);
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    rcl_ret_t ret = rcl_init_options_init(&init_options, allocator);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+    });
+    context = rcl_get_zero_initialized_context();
+    ret = rcl_init(0, nullptr, &init_options, &context);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    node_options.allocator = allocator;
+    ret = rcl_node_init(&node, "test_steady_state_node", "", &context, &node_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+    osrf_testing_tools_cpp::memory_tools::initialize();
+    on_unexpected_malloc([]() {ADD_FAILURE() << "UNEXPECTED MALLOC";});
+    on_unexpected_realloc([]() {ADD_FAILURE() << "UNEXPECTED REALLOC";});
+    on_unexpected_calloc([]() {ADD_FAILURE() << "UNEXPECTED CALLOC";});
+    on_unexpected_free([]() {ADD_FAILURE() << "UNEXPECTED FREE";});
+    osrf_testing_tools_cpp::memory_tools::enable_monitoring_in_all_threads();
+  }
+
+  void TearDown()
+  {
+    osrf_testing_tools_cpp::memory_tools::uninitialize();
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context)) << rcl_get_error_string().str;
+  }
+
+  /// Trap the allocator for the rest of the test, entities must all be initialized.
+  void start_steady_state()
+  {
+    set_counting_allocator_is_trapping(allocator, true);
+  }
+
+  void expect_no_trapped_calls()
+  {
+    EXPECT_EQ(0u, allocator_state.trapped) << "the steady state used the rcl allocator";
+  }
+};
+
+TEST_F(TestSteadyStateAllocationsFixture, test_publish) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.allocator = allocator;
+  rcl_ret_t ret = rcl_publisher_init(&publisher, &node, ts, "chatter", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &node));
+  });
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_publish(&publisher, &msg, nullptr)) << rcl_get_error_string().str;
+
+  start_steady_state();
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    for (int i = 0; i < kIterations && RCL_RET_OK == ret; ++i) {
+      ret = rcl_publish(&publisher, &msg, nullptr);
+    }
+  });
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  expect_no_trapped_calls();
+}
+
+TEST_F(TestSteadyStateAllocationsFixture, test_take) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.allocator = allocator;
+  rcl_ret_t ret = rcl_subscription_init(
+    &subscription, &node, ts, "chatter", &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+  ret = rcl_take(&subscription, &msg, &message_info, nullptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  start_steady_state();
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    for (int i = 0; i < kIterations && RCL_RET_OK == ret; ++i) {
+      ret = rcl_take(&subscription, &msg, &message_info, nullptr);
+    }
+  });
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  expect_no_trapped_calls();
+}
+
+TEST_F(TestSteadyStateAllocationsFixture, test_wait) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.allocator = allocator;
+  rcl_ret_t ret = rcl_subscription_init(
+    &subscription, &node, ts, "chatter", &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_guard_condition_options_t guard_condition_options =
+    rcl_guard_condition_get_default_options();
+  guard_condition_options.allocator = allocator;
+  ret = rcl_guard_condition_init(&guard_condition, &context, guard_condition_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition));
+  });
+  rcl_clock_t clock;
+  ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock));
+  });
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(&timer, &clock, &context, RCL_S_TO_NS(1), nullptr, allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timer));
+  });
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 1, 1, 1, 0, 0, 0, &context, allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+  });
+
+  auto wait_once = [&]() {
+      rcl_ret_t wait_ret = rcl_wait_set_clear(&wait_set);
+      if (RCL_RET_OK == wait_ret) {
+        wait_ret = rcl_wait_set_add_subscription(&wait_set, &subscription, nullptr);
+      }
+      if (RCL_RET_OK == wait_ret) {
+        wait_ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, nullptr);
+      }
+      if (RCL_RET_OK == wait_ret) {
+        wait_ret = rcl_wait_set_add_timer(&wait_set, &timer, nullptr);
+      }
+      if (RCL_RET_OK == wait_ret) {
+        wait_ret = rcl_wait(&wait_set, RCL_MS_TO_NS(10));
+      }
+      return wait_ret;
+    };
+  ASSERT_EQ(RCL_RET_OK, wait_once()) << rcl_get_error_string().str;
+
+  start_steady_state();
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    for (int i = 0; i < kIterations && RCL_RET_OK == ret; ++i) {
+      ret = wait_once();
+    }
+  });
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  expect_no_trapped_calls();
+}
+
+TEST_F(TestSteadyStateAllocationsFixture, test_timer_call) {
+  rcl_clock_t clock;
+  rcl_ret_t ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock));
+  });
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(&timer, &clock, &context, 0, nullptr, allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timer));
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_call(&timer)) << rcl_get_error_string().str;
+
+  start_steady_state();
+  bool is_ready = false;
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    for (int i = 0; i < kIterations && RCL_RET_OK == ret; ++i) {
+      ret = rcl_timer_is_ready(&timer, &is_ready);
+      if (RCL_RET_OK == ret) {
+        ret = rcl_timer_call(&timer);
+      }
+    }
+  });
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_TRUE(is_ready);
+  expect_no_trapped_calls();
+}
+
+TEST_F(TestSteadyStateAllocationsFixture, test_trigger_guard_condition) {
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_guard_condition_options_t guard_condition_options =
+    rcl_guard_condition_get_default_options();
+  guard_condition_options.allocator = allocator;
+  rcl_ret_t ret = rcl_guard_condition_init(&guard_condition, &context, guard_condition_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition));
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_trigger_guard_condition(&guard_condition));
+
+  start_steady_state();
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    for (int i = 0; i < kIterations && RCL_RET_OK == ret; ++i) {
+      ret = rcl_trigger_guard_condition(&guard_condition);
+    }
+  });
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  expect_no_trapped_calls();
+}
+
+TEST_F(TestSteadyStateAllocationsFixture, test_executor_spin_some) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.allocator = allocator;
+  rcl_ret_t ret = rcl_subscription_init(
+    &subscription, &node, ts, "chatter", &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_guard_condition_options_t guard_condition_options =
+    rcl_guard_condition_get_default_options();
+  guard_condition_options.allocator = allocator;
+  ret = rcl_guard_condition_init(&guard_condition, &context, guard_condition_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition));
+  });
+  rcl_clock_t clock;
+  ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock));
+  });
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(&timer, &clock, &context, 0, nullptr, allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timer));
+  });
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  rcl_executor_t executor = rcl_get_zero_initialized_executor();
+  rcl_executor_options_t executor_options = rcl_executor_get_default_options();
+  executor_options.allocator = allocator;
+  ret = rcl_executor_init(&executor, &context, 3u, &executor_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    set_counting_allocator_is_trapping(allocator, false);
+    EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&executor));
+  });
+  auto on_message = [](const void *, void *) {};
+  auto on_guard_condition = [](void *) {};
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_executor_add_subscription(&executor, &subscription, &msg, on_message, nullptr));
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_executor_add_guard_condition(&executor, &guard_condition, on_guard_condition, nullptr));
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_add_timer(&executor, &timer));
+  ASSERT_EQ(RCL_RET_OK, rcl_executor_spin_some(&executor, RCL_MS_TO_NS(10))) <<
+    rcl_get_error_string().str;
+
+  start_steady_state();
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    for (int i = 0; i < kIterations && RCL_RET_OK == ret; ++i) {
+      ret = rcl_executor_spin_some(&executor, RCL_MS_TO_NS(10));
+    }
+  });
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  expect_no_trapped_calls();
+}
@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cstring>
 #include <string>
 #include <thread>
 
@@ -336,6 +337,95 @@ TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription
   }
 }
 
+/* Test of the dispatch order of ready subscriptions collected from a wait set.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_dispatch_order) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  constexpr char topic[] = "/chatter_dispatch";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // The first subscription is added first but has the later deadline.
+  const int64_t relative_deadlines[2] = {RCL_S_TO_NS(20), RCL_S_TO_NS(10)};
+  rcl_subscription_t subscriptions[2];
+  for (size_t i = 0u; i < 2u; ++i) {
+    rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+    subscription_options.dispatch.relative_deadline = relative_deadlines[i];
+    subscriptions[i] = rcl_get_zero_initialized_subscription();
+    ret = rcl_subscription_init(
+      &subscriptions[i], this->node_ptr, ts, topic, &subscription_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0u; i < 2u; ++i) {
+      ret = rcl_subscription_fini(&subscriptions[i], this->node_ptr);
+      EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    }
+  });
+
+  size_t subscription_count = 0u;
+  for (size_t i = 0u; i < 10u && subscription_count < 2u; ++i) {
+    ret = rcl_publisher_get_subscription_count(&publisher, &subscription_count);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    if (subscription_count < 2u) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+  ASSERT_EQ(2u, subscription_count);
+  {
+    test_msgs__msg__BasicTypes msg;
+    test_msgs__msg__BasicTypes__init(&msg);
+    msg.int64_value = 42;
+    ret = rcl_publish(&publisher, &msg, nullptr);
+    test_msgs__msg__BasicTypes__fini(&msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  for (size_t i = 0u; i < 2u; ++i) {
+    ASSERT_TRUE(wait_for_subscription_to_be_ready(&subscriptions[i], context_ptr, 10, 100));
+  }
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 2, 0, 0, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set)) << rcl_get_error_string().str;
+  });
+  for (size_t i = 0u; i < 2u; ++i) {
+    ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_subscription(&wait_set, &subscriptions[i], NULL));
+  }
+  ASSERT_EQ(RCL_RET_OK, rcl_wait(&wait_set, RCL_MS_TO_NS(100))) << rcl_get_error_string().str;
+
+  // Nothing is taken, so both messages are released when the order is collected and
+  // earliest deadline first falls back to the relative deadlines.
+  rcl_time_point_value_t before;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_system_time_now(&before));
+  rcl_dispatch_entry_t entries[2];
+  size_t count = 0u;
+  ret = rcl_wait_set_get_dispatch_order(
+    &wait_set, RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST, entries, 2u, &count);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_time_point_value_t after;
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_system_time_now(&after));
+  ASSERT_EQ(2u, count);
+  EXPECT_EQ(RCL_DISPATCH_ENTITY_SUBSCRIPTION, entries[0].type);
+  EXPECT_EQ(1u, entries[0].index);
+  EXPECT_EQ(0u, entries[1].index);
+  EXPECT_EQ(entries[0].release_time, entries[1].release_time);
+  EXPECT_LE(before, entries[0].release_time);
+  EXPECT_GE(after, entries[0].release_time);
+}
+
 /* Basic nominal test of a publisher with a string.
  */
 TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_nominal_string) {
@@ -631,6 +721,126 @@ TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription
   }
 }
 
+/* Test a compressing publisher with a decompressing subscription.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_compressed) {
+  rcl_ret_t ret;
+  rcutils_allocator_t allocator = rcl_get_default_allocator();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings);
+  constexpr char topic[] = "/chatterCompressed";
+
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.compression = rcl_get_lz4_compression_codec();
+  publisher_options.compression.name = "not-valid";
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  publisher_options.compression = rcl_get_lz4_compression_codec();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  EXPECT_STREQ("/chatterCompressed/lz4_compressed", rcl_publisher_get_topic_name(&publisher));
+  EXPECT_FALSE(rcl_publisher_can_loan_messages(&publisher));
+
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.compression = rcl_get_lz4_compression_codec();
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  EXPECT_STREQ(
+    "/chatterCompressed/lz4_compressed", rcl_subscription_get_topic_name(&subscription));
+  EXPECT_FALSE(rcl_subscription_can_loan_messages(&subscription));
+  void * loaned_message = nullptr;
+  EXPECT_EQ(
+    RCL_RET_UNSUPPORTED,
+    rcl_take_loaned_message(&subscription, &loaned_message, nullptr, nullptr));
+  rcl_reset_error();
+
+  // A subscription which does not decompress is not matched with the compressing publisher.
+  rcl_subscription_options_t plain_subscription_options = rcl_subscription_get_default_options();
+  rcl_subscription_t plain_subscription = rcl_get_zero_initialized_subscription();
+  ret = rcl_subscription_init(
+    &plain_subscription, this->node_ptr, ts, topic, &plain_subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_ret_t ret = rcl_subscription_fini(&plain_subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  ASSERT_TRUE(wait_for_established_subscription(&publisher, 10, 100));
+  size_t publisher_count = 0u;
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_subscription_get_publisher_count(&plain_subscription, &publisher_count));
+  EXPECT_EQ(0u, publisher_count);
+
+  // A repetitive string, as found in maps or images, which compresses well.
+  const std::string test_string(4096u, 'x');
+  test_msgs__msg__Strings msg;
+  test_msgs__msg__Strings__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__Strings__fini(&msg);
+  });
+  ASSERT_TRUE(rosidl_runtime_c__String__assign(&msg.string_value, test_string.c_str()));
+  ret = rcl_publish(&publisher, &msg, nullptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_TRUE(wait_for_subscription_to_be_ready(&subscription, context_ptr, 10, 100));
+  {
+    test_msgs__msg__Strings msg_rcv;
+    test_msgs__msg__Strings__init(&msg_rcv);
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+    {
+      test_msgs__msg__Strings__fini(&msg_rcv);
+    });
+    ret = rcl_take(&subscription, &msg_rcv, nullptr, nullptr);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(test_string, std::string(msg_rcv.string_value.data, msg_rcv.string_value.size));
+  }
+
+  // Serialized messages are compressed and decompressed as well.
+  rcl_serialized_message_t serialized_msg = rmw_get_zero_initialized_serialized_message();
+  ASSERT_EQ(RMW_RET_OK, rmw_serialized_message_init(&serialized_msg, 0u, &allocator));
+  rcl_serialized_message_t serialized_msg_rcv = rmw_get_zero_initialized_serialized_message();
+  ASSERT_EQ(RMW_RET_OK, rmw_serialized_message_init(&serialized_msg_rcv, 0u, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RMW_RET_OK, rmw_serialized_message_fini(&serialized_msg));
+    EXPECT_EQ(RMW_RET_OK, rmw_serialized_message_fini(&serialized_msg_rcv));
+  });
+  ASSERT_EQ(RMW_RET_OK, rmw_serialize(&msg, ts, &serialized_msg));
+  ret = rcl_publish_serialized_message(&publisher, &serialized_msg, nullptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_TRUE(wait_for_subscription_to_be_ready(&subscription, context_ptr, 10, 100));
+  ret = rcl_take_serialized_message(&subscription, &serialized_msg_rcv, nullptr, nullptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(serialized_msg.buffer_length, serialized_msg_rcv.buffer_length);
+  EXPECT_EQ(
+    0, memcmp(serialized_msg.buffer, serialized_msg_rcv.buffer, serialized_msg.buffer_length));
+
+  // Nothing reached the plain subscription.
+  test_msgs__msg__Strings msg_plain;
+  test_msgs__msg__Strings__init(&msg_plain);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__Strings__fini(&msg_plain);
+  });
+  EXPECT_EQ(
+    RCL_RET_SUBSCRIPTION_TAKE_FAILED,
+    rcl_take(&plain_subscription, &msg_plain, nullptr, nullptr));
+}
+
 /* Basic test for subscription loan functions
  */
 TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_loaned) {
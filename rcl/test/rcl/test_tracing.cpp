@@ -0,0 +1,382 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+#include "rcl/timer.h"
+#include "rcl/tracing.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+#ifdef RCL_TRACING_ENABLED
+
+namespace
+{
+
+std::string
+read_file(const char * path)
+{
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+size_t
+count_occurrences(const std::string & haystack, const std::string & needle)
+{
+  size_t count = 0u;
+  for (size_t i = haystack.find(needle); std::string::npos != i; i = haystack.find(needle, i + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+void
+record_publish(const void * publisher, const void * message)
+{
+  RCL_TRACING_RECORD_rcl_publish(publisher, message);
+}
+
+void
+timer_callback(rcl_timer_t * timer, int64_t last_call_time)
+{
+  (void)timer;
+  (void)last_call_time;
+}
+
+}  // namespace
+
+class TestTracingFixture : public ::testing::Test
+{
+public:
+  const char * binary_path = "test_tracing.rcltrace";
+  const char * json_path = "test_tracing.json";
+
+  void SetUp()
+  {
+    ASSERT_EQ(RCL_RET_OK, rcl_tracing_start(16u, rcl_get_default_allocator())) <<
+      rcl_get_error_string().str;
+  }
+
+  void TearDown()
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_tracing_fini());
+    std::remove(binary_path);
+    std::remove(json_path);
+  }
+};
+
+TEST_F(TestTracingFixture, test_start_stop) {
+  EXPECT_TRUE(rcl_tracing_is_recording());
+  EXPECT_EQ(RCL_RET_ALREADY_INIT, rcl_tracing_start(16u, rcl_get_default_allocator()));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_OK, rcl_tracing_stop());
+  EXPECT_FALSE(rcl_tracing_is_recording());
+  EXPECT_EQ(RCL_RET_NOT_INIT, rcl_tracing_stop());
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_tracing_start(0u, rcl_get_default_allocator()));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_ERROR, rcl_tracing_start(32u, rcl_get_default_allocator()));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_OK, rcl_tracing_start(16u, rcl_get_default_allocator()));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_tracing_flush(nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_tracing_dump_chrome_json(nullptr));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_tracing_convert_to_chrome_json(nullptr, json_path));
+  rcl_reset_error();
+}
+
+TEST_F(TestTracingFixture, test_dump_chrome_json) {
+  int message = 0;
+  record_publish(this, &message);
+  std::thread other_thread([&message]() {record_publish(nullptr, &message);});
+  other_thread.join();
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_stop());
+  // Nothing is recorded once stopped.
+  record_publish(this, &message);
+
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_dump_chrome_json(json_path)) << rcl_get_error_string().str;
+  const std::string json = read_file(json_path);
+  EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+  EXPECT_EQ(2u, count_occurrences(json, "\"name\":\"rcl_publish\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"tid\":0,"));
+  EXPECT_EQ(1u, count_occurrences(json, "\"tid\":1,"));
+  EXPECT_EQ(1u, count_occurrences(json, "\"publisher_handle\":\"0x0\""));
+
+  // Dumping drains the buffers.
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_dump_chrome_json(json_path)) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, count_occurrences(read_file(json_path), "\"name\""));
+}
+
+TEST_F(TestTracingFixture, test_exited_threads_release_buffers) {
+  int message = 0;
+  // Twice as many threads as buffers, one after the other, each reuse the first buffer.
+  for (size_t i = 0u; i < 2u * RCL_TRACING_MAX_THREADS; ++i) {
+    std::thread thread([&message]() {record_publish(nullptr, &message);});
+    thread.join();
+    ASSERT_EQ(RCL_RET_OK, rcl_tracing_dump_chrome_json(json_path)) << rcl_get_error_string().str;
+    EXPECT_EQ(1u, count_occurrences(read_file(json_path), "\"tid\":0,"));
+  }
+  EXPECT_EQ(0u, rcl_tracing_get_dropped_event_count());
+}
+
+TEST_F(TestTracingFixture, test_full_buffer_drops_events) {
+  int message = 0;
+  for (int i = 0; i < 20; ++i) {
+    record_publish(this, &message);
+  }
+  EXPECT_EQ(4u, rcl_tracing_get_dropped_event_count());
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_dump_chrome_json(json_path)) << rcl_get_error_string().str;
+  EXPECT_EQ(16u, count_occurrences(read_file(json_path), "\"name\":\"rcl_publish\""));
+
+  // The drained buffer records again.
+  record_publish(this, &message);
+  EXPECT_EQ(4u, rcl_tracing_get_dropped_event_count());
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_dump_chrome_json(json_path)) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, count_occurrences(read_file(json_path), "\"name\":\"rcl_publish\""));
+}
+
+TEST_F(TestTracingFixture, test_flush_and_convert) {
+  std::remove(binary_path);
+  int message = 0;
+  record_publish(this, &message);
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_flush(binary_path)) << rcl_get_error_string().str;
+  // Flushing again appends to the same file.
+  record_publish(this, &message);
+  record_publish(this, &message);
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_flush(binary_path)) << rcl_get_error_string().str;
+
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_convert_to_chrome_json(binary_path, json_path)) <<
+    rcl_get_error_string().str;
+  EXPECT_EQ(3u, count_occurrences(read_file(json_path), "\"name\":\"rcl_publish\""));
+
+  // A JSON file is not a binary trace.
+  EXPECT_EQ(RCL_RET_ERROR, rcl_tracing_convert_to_chrome_json(json_path, json_path));
+  rcl_reset_error();
+}
+
+TEST_F(TestTracingFixture, test_texts) {
+  const std::string long_topic_name(100u, 'a');
+  RCL_TRACING_RECORD_rcl_publisher_init(this, this, this, long_topic_name.c_str(), 7u);
+  RCL_TRACING_RECORD_rcl_lifecycle_transition(this, "inactive", "active");
+  RCL_TRACING_RECORD_rcl_node_init(this, this, "quote\"node", nullptr);
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_dump_chrome_json(json_path)) << rcl_get_error_string().str;
+  const std::string json = read_file(json_path);
+  EXPECT_EQ(
+    1u, count_occurrences(
+      json, "\"topic_name\":\"" + long_topic_name.substr(0, RCL_TRACING_EVENT_TEXT_SIZE - 2u) +
+      "\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"queue_depth\":7"));
+  EXPECT_EQ(1u, count_occurrences(json, "\"start_label\":\"inactive\",\"goal_label\":\"active\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"node_name\":\"quote\\\"node\",\"namespace\":\"\""));
+}
+
+TEST_F(TestTracingFixture, test_rcl_tracepoints) {
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_init_options_init(&init_options, rcl_get_default_allocator()));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options));
+  });
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ASSERT_EQ(RCL_RET_OK, rcl_init(0, nullptr, &init_options, &context)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context));
+    EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context));
+  });
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_node_init(&node, "test_tracing_node", "", &context, &node_options)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node));
+  });
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_publisher_init(&publisher, &node, ts, "chatter", &publisher_options)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &node));
+  });
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_publish(&publisher, &msg, nullptr)) << rcl_get_error_string().str;
+
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_dump_chrome_json(json_path)) << rcl_get_error_string().str;
+  const std::string json = read_file(json_path);
+  EXPECT_EQ(1u, count_occurrences(json, "\"name\":\"rcl_init\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"node_name\":\"test_tracing_node\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"topic_name\":\"/chatter\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"name\":\"rcl_publish\""));
+}
+
+TEST_F(TestTracingFixture, test_take_wait_and_timer_tracepoints) {
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_init_options_init(&init_options, rcl_get_default_allocator()));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options));
+  });
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ASSERT_EQ(RCL_RET_OK, rcl_init(0, nullptr, &init_options, &context)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_shutdown(&context));
+    EXPECT_EQ(RCL_RET_OK, rcl_context_fini(&context));
+  });
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  ASSERT_EQ(RCL_RET_OK, rcl_node_init(&node, "test_tracing_node", "", &context, &node_options)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_node_fini(&node));
+  });
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_publisher_init(&publisher, &node, ts, "chatter", &publisher_options)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, &node));
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_subscription_init(&subscription, &node, ts, "chatter", &subscription_options)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, &node));
+  });
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_clock_t clock;
+  ASSERT_EQ(RCL_RET_OK, rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock));
+  });
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_timer_init(&timer, &clock, &context, 0, timer_callback, allocator)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timer));
+  });
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_wait_set_init(&wait_set, 1, 0, 1, 0, 0, 0, &context, allocator)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+  });
+
+  test_msgs__msg__BasicTypes msg;
+  test_msgs__msg__BasicTypes__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&msg);
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_publish(&publisher, &msg, nullptr)) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_subscription(&wait_set, &subscription, nullptr));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_timer(&wait_set, &timer, nullptr));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait(&wait_set, RCL_S_TO_NS(1))) << rcl_get_error_string().str;
+  rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+  ASSERT_EQ(RCL_RET_OK, rcl_take(&subscription, &msg, &message_info, nullptr)) <<
+    rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_call(&timer)) << rcl_get_error_string().str;
+
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_dump_chrome_json(json_path)) << rcl_get_error_string().str;
+  const std::string json = read_file(json_path);
+  EXPECT_EQ(1u, count_occurrences(json, "\"name\":\"rcl_take\""));
+  EXPECT_EQ(
+    1u, count_occurrences(
+      json, "\"source_timestamp\":" + std::to_string(message_info.source_timestamp) + ","));
+  EXPECT_EQ(1u, count_occurrences(json, "\"name\":\"rcl_wait\",\"cat\":\"rcl\",\"ph\":\"B\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"name\":\"rcl_wait\",\"cat\":\"rcl\",\"ph\":\"E\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"name\":\"rcl_timer_call\""));
+  EXPECT_EQ(
+    1u, count_occurrences(json, "\"name\":\"rcl_timer_callback\",\"cat\":\"rcl\",\"ph\":\"B\""));
+  EXPECT_EQ(
+    1u, count_occurrences(json, "\"name\":\"rcl_timer_callback\",\"cat\":\"rcl\",\"ph\":\"E\""));
+}
+
+TEST_F(TestTracingFixture, test_action_goal_events) {
+  const uint8_t goal_uuid[16] = {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2};
+  RCL_TRACING_RECORD_rcl_action_accept_new_goal(this, this, goal_uuid);
+  RCL_TRACING_RECORD_rcl_action_update_goal_state(this, 0, 2);
+  RCL_TRACING_RECORD_rcl_action_expire_goals(this, 3u);
+  ASSERT_EQ(RCL_RET_OK, rcl_tracing_dump_chrome_json(json_path)) << rcl_get_error_string().str;
+  const std::string json = read_file(json_path);
+  EXPECT_EQ(
+    1u, count_occurrences(
+      json, "\"goal_id_high\":\"0x100000000000000\",\"goal_id_low\":\"0x2\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"name\":\"rcl_action_update_goal_state\""));
+  EXPECT_EQ(1u, count_occurrences(json, "\"num_expired\":3"));
+}
+
+#else  // RCL_TRACING_ENABLED
+
+TEST(TestTracing, test_stubs) {
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, rcl_tracing_start(16u, rcl_get_default_allocator()));
+  rcl_reset_error();
+  EXPECT_FALSE(rcl_tracing_is_recording());
+  EXPECT_EQ(RCL_RET_NOT_INIT, rcl_tracing_stop());
+  rcl_reset_error();
+  int message = 0;
+  RCL_TRACING_RECORD_rcl_publish(nullptr, &message);
+  EXPECT_EQ(0u, rcl_tracing_get_dropped_event_count());
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, rcl_tracing_flush("test_tracing.rcltrace"));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, rcl_tracing_dump_chrome_json("test_tracing.json"));
+  rcl_reset_error();
+  EXPECT_EQ(
+    RCL_RET_UNSUPPORTED,
+    rcl_tracing_convert_to_chrome_json("test_tracing.rcltrace", "test_tracing.json"));
+  rcl_reset_error();
+  EXPECT_EQ(RCL_RET_OK, rcl_tracing_fini());
+}
+
+#endif  // RCL_TRACING_ENABLED
@@ -708,6 +708,200 @@ TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), wait_set_get_allocator
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
 
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), dispatch_order) {
+  rcl_dispatch_entry_t entries[3];
+  const int32_t priorities[3] = {1, 5, 1};
+  const int64_t relative_deadlines[3] = {RCL_MS_TO_NS(30), 0, RCL_MS_TO_NS(10)};
+  for (size_t i = 0u; i < 3u; ++i) {
+    entries[i].type = RCL_DISPATCH_ENTITY_OTHER;
+    entries[i].index = i;
+    entries[i].attributes.priority = priorities[i];
+    entries[i].attributes.relative_deadline = relative_deadlines[i];
+    entries[i].release_time = 0;
+  }
+  EXPECT_EQ(RCL_RET_OK, rcl_dispatch_order(entries, 3u, RCL_DISPATCH_POLICY_ADDED_ORDER));
+  EXPECT_EQ(0u, entries[0].index);
+  EXPECT_EQ(1u, entries[1].index);
+  EXPECT_EQ(2u, entries[2].index);
+  // Ties keep their order.
+  EXPECT_EQ(RCL_RET_OK, rcl_dispatch_order(entries, 3u, RCL_DISPATCH_POLICY_FIXED_PRIORITY));
+  EXPECT_EQ(1u, entries[0].index);
+  EXPECT_EQ(0u, entries[1].index);
+  EXPECT_EQ(2u, entries[2].index);
+  EXPECT_EQ(
+    RCL_RET_OK, rcl_dispatch_order(entries, 3u, RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST));
+  EXPECT_EQ(2u, entries[0].index);
+  EXPECT_EQ(0u, entries[1].index);
+  EXPECT_EQ(1u, entries[2].index);
+  EXPECT_EQ(INT64_MAX, rcl_dispatch_entry_get_deadline(&entries[2]));
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_dispatch_order(nullptr, 3u, RCL_DISPATCH_POLICY_ADDED_ORDER));
+  rcl_reset_error();
+}
+
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), wait_set_get_dispatch_order) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_dispatch_entry_t entries[3];
+  size_t count = 0u;
+  EXPECT_EQ(
+    RCL_RET_WAIT_SET_INVALID, rcl_wait_set_get_dispatch_order(
+      &wait_set, RCL_DISPATCH_POLICY_FIXED_PRIORITY, entries, 3u, &count));
+  rcl_reset_error();
+  rcl_ret_t ret =
+    rcl_wait_set_init(&wait_set, 0, 0, 3, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set)) << rcl_get_error_string().str;
+  });
+  rcl_clock_t clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock)) << rcl_get_error_string().str;
+  });
+
+  // Always ready timers, the second with the highest priority and the third with the
+  // earliest deadline.
+  rcl_timer_t timers[3];
+  const int32_t priorities[3] = {0, 10, 0};
+  const int64_t relative_deadlines[3] = {RCL_S_TO_NS(20), RCL_S_TO_NS(30), RCL_S_TO_NS(10)};
+  for (size_t i = 0u; i < 3u; ++i) {
+    timers[i] = rcl_get_zero_initialized_timer();
+    ret = rcl_timer_init(&timers[i], &clock, context_ptr, 0, nullptr, allocator);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    rcl_dispatch_attributes_t attributes = rcl_dispatch_get_default_attributes();
+    attributes.priority = priorities[i];
+    attributes.relative_deadline = relative_deadlines[i];
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_set_dispatch_attributes(&timers[i], &attributes));
+    ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_timer(&wait_set, &timers[i], NULL));
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    for (size_t i = 0u; i < 3u; ++i) {
+      EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timers[i])) << rcl_get_error_string().str;
+    }
+  });
+  rcl_dispatch_attributes_t attributes;
+  EXPECT_EQ(RCL_RET_OK, rcl_timer_get_dispatch_attributes(&timers[1], &attributes));
+  EXPECT_EQ(10, attributes.priority);
+  attributes.relative_deadline = -1;
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_timer_set_dispatch_attributes(&timers[1], &attributes));
+  rcl_reset_error();
+  ASSERT_EQ(RCL_RET_OK, rcl_wait(&wait_set, RCL_MS_TO_NS(100))) << rcl_get_error_string().str;
+
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_wait_set_get_dispatch_order(
+      &wait_set, RCL_DISPATCH_POLICY_FIXED_PRIORITY, entries, 2u, &count));
+  rcl_reset_error();
+  ret = rcl_wait_set_get_dispatch_order(
+    &wait_set, RCL_DISPATCH_POLICY_FIXED_PRIORITY, entries, 3u, &count);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(3u, count);
+  EXPECT_EQ(RCL_DISPATCH_ENTITY_TIMER, entries[0].type);
+  EXPECT_EQ(1u, entries[0].index);
+  EXPECT_EQ(0u, entries[1].index);
+  EXPECT_EQ(2u, entries[2].index);
+  ret = rcl_wait_set_get_dispatch_order(
+    &wait_set, RCL_DISPATCH_POLICY_EARLIEST_DEADLINE_FIRST, entries, 3u, &count);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(3u, count);
+  EXPECT_EQ(2u, entries[0].index);
+  EXPECT_EQ(0u, entries[1].index);
+  EXPECT_EQ(1u, entries[2].index);
+}
+
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), wait_mode) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_wait_mode_options_t options = rcl_wait_mode_get_default_options();
+  EXPECT_EQ(RCL_WAIT_MODE_BLOCK, options.mode);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_wait_set_set_wait_mode(&wait_set, &options));
+  rcl_reset_error();
+  rcl_ret_t ret =
+    rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, 0, context_ptr, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set)) << rcl_get_error_string().str;
+  });
+  rcl_guard_condition_t guard_cond = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond, context_ptr, rcl_guard_condition_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_cond)) << rcl_get_error_string().str;
+  });
+
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_wait_set_set_wait_mode(&wait_set, nullptr));
+  rcl_reset_error();
+  options.mode = static_cast<rcl_wait_mode_t>(42);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_wait_set_set_wait_mode(&wait_set, &options));
+  rcl_reset_error();
+  options.mode = RCL_WAIT_MODE_SPIN;
+  options.spin_budget = -1;
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_wait_set_set_wait_mode(&wait_set, &options));
+  rcl_reset_error();
+  rcl_wait_mode_stats_t stats;
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_wait_set_get_wait_mode_stats(&wait_set, nullptr));
+  rcl_reset_error();
+
+  // A spinning wait picks up a trigger from another thread without blocking.
+  options.spin_budget = RCL_S_TO_NS(5);
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_set_wait_mode(&wait_set, &options));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_guard_condition(&wait_set, &guard_cond, NULL));
+  std::thread trigger([&guard_cond]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      EXPECT_EQ(RCL_RET_OK, rcl_trigger_guard_condition(&guard_cond));
+    });
+  ret = rcl_wait(&wait_set, RCL_S_TO_NS(10));
+  trigger.join();
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&guard_cond, wait_set.guard_conditions[0]);
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_get_wait_mode_stats(&wait_set, &stats));
+  EXPECT_EQ(1u, stats.spin_wakeups);
+  EXPECT_EQ(0u, stats.spin_misses);
+
+  // Without data the spin gives up after the budget and blocks for the rest of the timeout.
+  options.spin_budget = RCL_MS_TO_NS(5);
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_set_wait_mode(&wait_set, &options));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_clear(&wait_set));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_guard_condition(&wait_set, &guard_cond, NULL));
+  std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(20));
+  std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - before;
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+  EXPECT_GE(elapsed.count(), RCL_MS_TO_NS(20));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_get_wait_mode_stats(&wait_set, &stats));
+  EXPECT_EQ(0u, stats.spin_wakeups);
+  EXPECT_EQ(1u, stats.spin_misses);
+
+  // A non-blocking wait never spins.
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_clear(&wait_set));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_guard_condition(&wait_set, &guard_cond, NULL));
+  EXPECT_EQ(RCL_RET_TIMEOUT, rcl_wait(&wait_set, 0));
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_get_wait_mode_stats(&wait_set, &stats));
+  EXPECT_EQ(1u, stats.blocking_waits);
+
+  // The adaptive mode blocks when arrivals are slower than the budget.
+  options.mode = RCL_WAIT_MODE_ADAPTIVE;
+  options.spin_budget = RCL_US_TO_NS(100);
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_set_wait_mode(&wait_set, &options));
+  for (int i = 0; i < 3; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_EQ(RCL_RET_OK, rcl_trigger_guard_condition(&guard_cond));
+    ASSERT_EQ(RCL_RET_OK, rcl_wait_set_clear(&wait_set));
+    ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_guard_condition(&wait_set, &guard_cond, NULL));
+    EXPECT_EQ(RCL_RET_OK, rcl_wait(&wait_set, RCL_S_TO_NS(1)));
+  }
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_get_wait_mode_stats(&wait_set, &stats));
+  EXPECT_EQ(3u, stats.blocking_waits);
+  EXPECT_EQ(0u, stats.spin_wakeups);
+  EXPECT_GE(stats.mean_inter_arrival, RCL_MS_TO_NS(5));
+}
+
 // Test wait set init failure cases using mocks
 TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), wait_set_failed_init) {
   rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
@@ -0,0 +1,291 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "rcutils/allocator.h"
+#include "rcutils/time.h"
+
+#include "rmw/error_handling.h"
+
+#include "rosidl_runtime_c/message_initialization.h"
+#include "rosidl_runtime_c/string_functions.h"
+#include "rosidl_runtime_c/u16string_functions.h"
+#include "rosidl_typesupport_introspection_c/field_types.h"
+#include "rosidl_typesupport_introspection_c/identifier.h"
+
+#include "./loopback.hpp"
+
+namespace rmw_loopback
+{
+
+const char * const identifier = "rmw_loopback";
+
+namespace
+{
+
+using MessageMember = rosidl_typesupport_introspection_c__MessageMember;
+
+size_t
+get_primitive_size(uint8_t type_id)
+{
+  switch (type_id) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT:
+      return sizeof(float);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE:
+      return sizeof(double);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_LONG_DOUBLE:
+      return sizeof(long double);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WCHAR:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
+      return sizeof(uint16_t);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN:
+      return sizeof(bool);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_CHAR:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_OCTET:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
+      return sizeof(uint8_t);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
+      return sizeof(uint32_t);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
+      return sizeof(uint64_t);
+    default:
+      return 0u;
+  }
+}
+
+bool
+copy_element(const MessageMember & member, void * destination, const void * source)
+{
+  switch (member.type_id_) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE:
+      return copy_message(
+        static_cast<const MessageMembers *>(member.members_->data), destination, source);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
+      {
+        auto source_string = static_cast<const rosidl_runtime_c__String *>(source);
+        return rosidl_runtime_c__String__assignn(
+          static_cast<rosidl_runtime_c__String *>(destination),
+          source_string->data, source_string->size);
+      }
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING:
+      {
+        auto source_string = static_cast<const rosidl_runtime_c__U16String *>(source);
+        return rosidl_runtime_c__U16String__assignn(
+          static_cast<rosidl_runtime_c__U16String *>(destination),
+          source_string->data, source_string->size);
+      }
+    default:
+      {
+        size_t size = get_primitive_size(member.type_id_);
+        if (0u == size) {
+          RMW_SET_ERROR_MSG("unknown field type");
+          return false;
+        }
+        std::memcpy(destination, source, size);
+        return true;
+      }
+  }
+}
+
+bool
+copy_member(const MessageMember & member, void * destination, const void * source)
+{
+  if (!member.is_array_) {
+    return copy_element(member, destination, source);
+  }
+  size_t size = member.size_function(source);
+  if (member.size_function(destination) != size) {
+    if (nullptr == member.resize_function || !member.resize_function(destination, size)) {
+      RMW_SET_ERROR_MSG("failed to resize sequence");
+      return false;
+    }
+  }
+  for (size_t i = 0u; i < size; ++i) {
+    if (!copy_element(member, member.get_function(destination, i),
+      member.get_const_function(source, i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool
+copy_message(const MessageMembers * members, void * destination, const void * source)
+{
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const MessageMember & member = members->members_[i];
+    if (!copy_member(
+        member,
+        static_cast<uint8_t *>(destination) + member.offset_,
+        static_cast<const uint8_t *>(source) + member.offset_))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void *
+clone_message(const MessageMembers * members, const void * source)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  void * message = allocator.allocate(members->size_of_, allocator.state);
+  if (nullptr == message) {
+    RMW_SET_ERROR_MSG("failed to allocate message");
+    return nullptr;
+  }
+  members->init_function(message, ROSIDL_RUNTIME_C_MSG_INIT_ALL);
+  if (!copy_message(members, message, source)) {
+    destroy_message(members, message);
+    return nullptr;
+  }
+  return message;
+}
+
+void
+destroy_message(const MessageMembers * members, void * message)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  members->fini_function(message);
+  allocator.deallocate(message, allocator.state);
+}
+
+const MessageMembers *
+get_message_members(const rosidl_message_type_support_t * type_support)
+{
+  const rosidl_message_type_support_t * introspection = get_message_typesupport_handle(
+    type_support, rosidl_typesupport_introspection_c__identifier);
+  if (nullptr == introspection) {
+    RMW_SET_ERROR_MSG("type support has no C introspection type support");
+    return nullptr;
+  }
+  return static_cast<const MessageMembers *>(introspection->data);
+}
+
+const ServiceMembers *
+get_service_members(const rosidl_service_type_support_t * type_support)
+{
+  const rosidl_service_type_support_t * introspection = get_service_typesupport_handle(
+    type_support, rosidl_typesupport_introspection_c__identifier);
+  if (nullptr == introspection) {
+    RMW_SET_ERROR_MSG("type support has no C introspection type support");
+    return nullptr;
+  }
+  return static_cast<const ServiceMembers *>(introspection->data);
+}
+
+std::string
+get_type_name(const char * message_namespace, const char * message_name)
+{
+  // The namespace is separated with "__", e.g. "std_msgs__msg".
+  std::string type_name = message_namespace;
+  for (size_t position = type_name.find("__"); std::string::npos != position;
+    position = type_name.find("__", position + 1u))
+  {
+    type_name.replace(position, 2u, "/");
+  }
+  return type_name + "/" + message_name;
+}
+
+Graph &
+get_graph()
+{
+  static Graph graph;
+  return graph;
+}
+
+rmw_gid_t
+make_gid(Graph & graph)
+{
+  rmw_gid_t gid;
+  std::memset(&gid, 0, sizeof(gid));
+  gid.implementation_identifier = identifier;
+  uint64_t value = graph.next_gid++;
+  static_assert(sizeof(value) <= RMW_GID_STORAGE_SIZE, "gid storage is too small");
+  std::memcpy(gid.data, &value, sizeof(value));
+  return gid;
+}
+
+void
+notify_graph_change(Graph & graph, size_t domain_id)
+{
+  for (Node * node : graph.nodes) {
+    if (node->domain_id() == domain_id) {
+      node->graph_guard_condition.triggered = true;
+    }
+  }
+  graph.condition.notify_all();
+}
+
+void
+stamp(rmw_time_point_value_t * source_timestamp, rmw_time_point_value_t * received_timestamp)
+{
+  rcutils_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&now)) {
+    rcutils_reset_error();
+  }
+  *source_timestamp = now;
+  *received_timestamp = now;
+}
+
+size_t
+get_depth(const rmw_qos_profile_t & qos)
+{
+  if (RMW_QOS_POLICY_HISTORY_KEEP_ALL == qos.history) {
+    return SIZE_MAX;
+  }
+  return 0u == qos.depth ? 1u : qos.depth;
+}
+
+rmw_qos_profile_t
+resolve_qos(const rmw_qos_profile_t & qos)
+{
+  rmw_qos_profile_t resolved = qos;
+  if (RMW_QOS_POLICY_HISTORY_SYSTEM_DEFAULT == resolved.history ||
+    RMW_QOS_POLICY_HISTORY_UNKNOWN == resolved.history)
+  {
+    resolved.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+  }
+  if (RMW_QOS_POLICY_HISTORY_KEEP_LAST == resolved.history && 0u == resolved.depth) {
+    resolved.depth = 1u;
+  }
+  if (RMW_QOS_POLICY_RELIABILITY_SYSTEM_DEFAULT == resolved.reliability ||
+    RMW_QOS_POLICY_RELIABILITY_UNKNOWN == resolved.reliability)
+  {
+    resolved.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+  }
+  if (RMW_QOS_POLICY_DURABILITY_SYSTEM_DEFAULT == resolved.durability ||
+    RMW_QOS_POLICY_DURABILITY_UNKNOWN == resolved.durability)
+  {
+    resolved.durability = RMW_QOS_POLICY_DURABILITY_VOLATILE;
+  }
+  if (RMW_QOS_POLICY_LIVELINESS_SYSTEM_DEFAULT == resolved.liveliness ||
+    RMW_QOS_POLICY_LIVELINESS_UNKNOWN == resolved.liveliness)
+  {
+    resolved.liveliness = RMW_QOS_POLICY_LIVELINESS_AUTOMATIC;
+  }
+  return resolved;
+}
+
+}  // namespace rmw_loopback
@@ -0,0 +1,206 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_LOOPBACK__LOOPBACK_HPP_
+#define RMW_LOOPBACK__LOOPBACK_HPP_
+
+// In-memory rmw implementation used to measure and test rcl on its own.
+//
+// All entities of the process live in a single graph protected by a single
+// mutex, and every change that can make an entity ready notifies a single
+// condition variable that rmw_wait() blocks on.
+// Messages are deep copied with the C introspection type support, so any
+// message type with generated C introspection type support can be used.
+//
+// When the RMW_LOOPBACK_NOOP environment variable is set to "1" at rmw_init()
+// time, the entities of that context do no work at all: publishing and
+// sending drop the data, taking reports a message without writing it, and
+// rmw_wait() returns immediately with all entities ready. This isolates the
+// cost of rcl itself.
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rmw/rmw.h"
+#include "rmw/types.h"
+
+#include "rosidl_typesupport_introspection_c/message_introspection.h"
+#include "rosidl_typesupport_introspection_c/service_introspection.h"
+
+struct rmw_context_impl_s
+{
+  size_t domain_id;
+  bool noop;
+};
+
+namespace rmw_loopback
+{
+
+extern const char * const identifier;
+
+using MessageMembers = rosidl_typesupport_introspection_c__MessageMembers;
+using ServiceMembers = rosidl_typesupport_introspection_c__ServiceMembers;
+
+/// Allocate and initialize a message, then deep copy `source` into it.
+void * clone_message(const MessageMembers * members, const void * source);
+
+/// Finalize and deallocate a message allocated by clone_message().
+void destroy_message(const MessageMembers * members, void * message);
+
+/// Deep copy `source` into the initialized message `destination`.
+bool copy_message(const MessageMembers * members, void * destination, const void * source);
+
+/// Return the C introspection members of a message type support, or set an error.
+const MessageMembers * get_message_members(const rosidl_message_type_support_t * type_support);
+
+/// Return the C introspection members of a service type support, or set an error.
+const ServiceMembers * get_service_members(const rosidl_service_type_support_t * type_support);
+
+/// Return the ROS type name, e.g. "std_msgs/msg/String", of message members.
+std::string get_type_name(const char * message_namespace, const char * message_name);
+
+struct GuardCondition
+{
+  rmw_guard_condition_t handle;
+  bool triggered = false;
+};
+
+struct Node
+{
+  rmw_node_t handle;
+  rmw_context_t * context;
+  std::string name;
+  std::string namespace_;
+  std::string enclave;
+  GuardCondition graph_guard_condition;
+
+  size_t domain_id() const {return context->impl->domain_id;}
+  bool noop() const {return context->impl->noop;}
+};
+
+struct Sample
+{
+  void * message;
+  rmw_message_info_t info;
+};
+
+struct Subscription;
+
+struct Publisher
+{
+  rmw_publisher_t handle;
+  Node * node;
+  std::string topic_name;
+  std::string type_name;
+  const MessageMembers * members;
+  rmw_qos_profile_t qos;
+  rmw_gid_t gid;
+  std::vector<Subscription *> matched;
+};
+
+struct Subscription
+{
+  rmw_subscription_t handle;
+  Node * node;
+  std::string topic_name;
+  std::string type_name;
+  const MessageMembers * members;
+  rmw_qos_profile_t qos;
+  rmw_gid_t gid;
+  std::deque<Sample> queue;
+  size_t matched_publishers = 0u;
+  rmw_message_lost_status_t message_lost = {0u, 0u};
+};
+
+struct Request
+{
+  void * message;
+  rmw_service_info_t info;
+};
+
+struct Service
+{
+  rmw_service_t handle;
+  Node * node;
+  std::string service_name;
+  std::string type_name;
+  const ServiceMembers * members;
+  rmw_qos_profile_t qos;
+  rmw_gid_t gid;
+  std::deque<Request> requests;
+};
+
+struct Client
+{
+  rmw_client_t handle;
+  Node * node;
+  std::string service_name;
+  std::string type_name;
+  const ServiceMembers * members;
+  rmw_qos_profile_t qos;
+  rmw_gid_t gid;
+  int64_t next_sequence_number = 1;
+  std::deque<Request> responses;
+};
+
+struct WaitSet
+{
+  rmw_wait_set_t handle;
+  rmw_context_t * context;
+};
+
+/// All the entities of the process.
+struct Graph
+{
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<Node *> nodes;
+  std::vector<Publisher *> publishers;
+  std::vector<Subscription *> subscriptions;
+  std::vector<Service *> services;
+  std::vector<Client *> clients;
+  uint64_t next_gid = 1u;
+};
+
+Graph & get_graph();
+
+/// Return a new gid unique in the process; the graph mutex must be held.
+rmw_gid_t make_gid(Graph & graph);
+
+/// Trigger the graph guard conditions of a domain and wake up waiters; the mutex must be held.
+void notify_graph_change(Graph & graph, size_t domain_id);
+
+/// Fill the source and reception timestamps of a sample.
+void stamp(rmw_time_point_value_t * source_timestamp, rmw_time_point_value_t * received_timestamp);
+
+/// Return the queue depth to use for a QoS profile.
+size_t get_depth(const rmw_qos_profile_t & qos);
+
+/// Resolve the system default policies of a QoS profile.
+rmw_qos_profile_t resolve_qos(const rmw_qos_profile_t & qos);
+
+}  // namespace rmw_loopback
+
+#define LOOPBACK_CHECK_IDENTIFIER(handle, return_value) \
+  do { \
+    if ((handle)->implementation_identifier != rmw_loopback::identifier) { \
+      RMW_SET_ERROR_MSG(#handle " implementation is not rmw_loopback"); \
+      return return_value; \
+    } \
+  } while (0)
+
+#endif  // RMW_LOOPBACK__LOOPBACK_HPP_
@@ -0,0 +1,263 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <new>
+
+#include "rcutils/get_env.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/init.h"
+#include "rmw/init_options.h"
+#include "rmw/qos_profiles.h"
+#include "rmw/rmw.h"
+
+#include "./loopback.hpp"
+
+extern "C"
+{
+
+const char *
+rmw_get_implementation_identifier(void)
+{
+  return rmw_loopback::identifier;
+}
+
+const char *
+rmw_get_serialization_format(void)
+{
+  return rmw_loopback::identifier;
+}
+
+rmw_ret_t
+rmw_init_options_init(rmw_init_options_t * init_options, rcutils_allocator_t allocator)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(init_options, RMW_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(&allocator, return RMW_RET_INVALID_ARGUMENT);
+  if (nullptr != init_options->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected zero-initialized init_options");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  init_options->instance_id = 0;
+  init_options->implementation_identifier = rmw_loopback::identifier;
+  init_options->allocator = allocator;
+  init_options->impl = nullptr;
+  init_options->domain_id = RMW_DEFAULT_DOMAIN_ID;
+  init_options->security_options = rmw_get_default_security_options();
+  init_options->localhost_only = RMW_LOCALHOST_ONLY_DEFAULT;
+  init_options->enclave = nullptr;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_init_options_copy(const rmw_init_options_t * src, rmw_init_options_t * dst)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(src, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(dst, RMW_RET_INVALID_ARGUMENT);
+  if (nullptr == src->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected initialized src");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  LOOPBACK_CHECK_IDENTIFIER(src, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (nullptr != dst->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected zero-initialized dst");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  const rcutils_allocator_t * allocator = &src->allocator;
+  rmw_init_options_t tmp = *src;
+  tmp.enclave = nullptr;
+  if (nullptr != src->enclave) {
+    tmp.enclave = rcutils_strdup(src->enclave, *allocator);
+    if (nullptr == tmp.enclave) {
+      RMW_SET_ERROR_MSG("failed to copy enclave");
+      return RMW_RET_BAD_ALLOC;
+    }
+  }
+  tmp.security_options = rmw_get_zero_initialized_security_options();
+  rmw_ret_t ret = rmw_security_options_copy(
+    &src->security_options, allocator, &tmp.security_options);
+  if (RMW_RET_OK != ret) {
+    allocator->deallocate(tmp.enclave, allocator->state);
+    return ret;
+  }
+  *dst = tmp;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_init_options_fini(rmw_init_options_t * init_options)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(init_options, RMW_RET_INVALID_ARGUMENT);
+  if (nullptr == init_options->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected initialized init_options");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  LOOPBACK_CHECK_IDENTIFIER(init_options, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  rcutils_allocator_t * allocator = &init_options->allocator;
+  allocator->deallocate(init_options->enclave, allocator->state);
+  rmw_ret_t ret = rmw_security_options_fini(&init_options->security_options, allocator);
+  *init_options = rmw_get_zero_initialized_init_options();
+  return ret;
+}
+
+rmw_ret_t
+rmw_init(const rmw_init_options_t * options, rmw_context_t * context)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(options, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, RMW_RET_INVALID_ARGUMENT);
+  if (nullptr == options->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected initialized init options");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  LOOPBACK_CHECK_IDENTIFIER(options, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (nullptr != context->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected a zero-initialized context");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  const char * noop = nullptr;
+  if (nullptr != rcutils_get_env("RMW_LOOPBACK_NOOP", &noop)) {
+    noop = nullptr;
+  }
+
+  auto impl = new (std::nothrow) rmw_context_impl_t;
+  if (nullptr == impl) {
+    RMW_SET_ERROR_MSG("failed to allocate context impl");
+    return RMW_RET_BAD_ALLOC;
+  }
+  context->instance_id = options->instance_id;
+  context->implementation_identifier = rmw_loopback::identifier;
+  context->actual_domain_id =
+    RMW_DEFAULT_DOMAIN_ID == options->domain_id ? 0u : options->domain_id;
+  impl->domain_id = context->actual_domain_id;
+  impl->noop = nullptr != noop && 0 == std::strcmp(noop, "1");
+  context->impl = impl;
+  context->options = rmw_get_zero_initialized_init_options();
+  rmw_ret_t ret = rmw_init_options_copy(options, &context->options);
+  if (RMW_RET_OK != ret) {
+    delete impl;
+    *context = rmw_get_zero_initialized_context();
+    return ret;
+  }
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_shutdown(rmw_context_t * context)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_FOR_NULL_WITH_MSG(
+    context->implementation_identifier, "expected initialized context",
+    return RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(context, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_context_fini(rmw_context_t * context)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_FOR_NULL_WITH_MSG(
+    context->implementation_identifier, "expected initialized context",
+    return RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(context, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  rmw_ret_t ret = rmw_init_options_fini(&context->options);
+  delete context->impl;
+  *context = rmw_get_zero_initialized_context();
+  return ret;
+}
+
+rmw_ret_t
+rmw_set_log_severity(rmw_log_severity_t severity)
+{
+  (void)severity;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_qos_profile_check_compatible(
+  const rmw_qos_profile_t publisher_profile,
+  const rmw_qos_profile_t subscription_profile,
+  rmw_qos_compatibility_type_t * compatibility,
+  char * reason,
+  size_t reason_size)
+{
+  (void)publisher_profile;
+  (void)subscription_profile;
+  RMW_CHECK_ARGUMENT_FOR_NULL(compatibility, RMW_RET_INVALID_ARGUMENT);
+  if (nullptr == reason && 0u != reason_size) {
+    RMW_SET_ERROR_MSG("reason parameter is null, but reason_size parameter is not zero");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  // Every profile is delivered in memory.
+  *compatibility = RMW_QOS_COMPATIBILITY_OK;
+  if (0u != reason_size) {
+    reason[0] = '\0';
+  }
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_get_serialized_message_size(
+  const rosidl_message_type_support_t * type_support,
+  const rosidl_runtime_c__Sequence__bound * message_bounds,
+  size_t * size)
+{
+  (void)type_support;
+  (void)message_bounds;
+  (void)size;
+  RMW_SET_ERROR_MSG("rmw_loopback does not serialize messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_serialize(
+  const void * ros_message,
+  const rosidl_message_type_support_t * type_support,
+  rmw_serialized_message_t * serialized_message)
+{
+  (void)ros_message;
+  (void)type_support;
+  (void)serialized_message;
+  RMW_SET_ERROR_MSG("rmw_loopback does not serialize messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_deserialize(
+  const rmw_serialized_message_t * serialized_message,
+  const rosidl_message_type_support_t * type_support,
+  void * ros_message)
+{
+  (void)serialized_message;
+  (void)type_support;
+  (void)ros_message;
+  RMW_SET_ERROR_MSG("rmw_loopback does not serialize messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_compare_gids_equal(const rmw_gid_t * gid1, const rmw_gid_t * gid2, bool * result)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(gid1, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(gid2, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(result, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(gid1, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  LOOPBACK_CHECK_IDENTIFIER(gid2, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  *result = 0 == std::memcmp(gid1->data, gid2->data, RMW_GID_STORAGE_SIZE);
+  return RMW_RET_OK;
+}
+
+}  // extern "C"
@@ -0,0 +1,620 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "rcutils/strdup.h"
+#include "rcutils/types/string_array.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/get_node_info_and_types.h"
+#include "rmw/get_service_names_and_types.h"
+#include "rmw/get_topic_endpoint_info.h"
+#include "rmw/get_topic_names_and_types.h"
+#include "rmw/names_and_types.h"
+#include "rmw/rmw.h"
+#include "rmw/sanity_checks.h"
+#include "rmw/topic_endpoint_info.h"
+#include "rmw/topic_endpoint_info_array.h"
+
+#include "./loopback.hpp"
+
+namespace
+{
+
+using rmw_loopback::Graph;
+using rmw_loopback::Node;
+
+using NamesAndTypes = std::map<std::string, std::set<std::string>>;
+
+rmw_ret_t
+check_node(const rmw_node_t * node)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(node, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return RMW_RET_OK;
+}
+
+/// Whether an entity belongs to the domain of `node` and, if given, to the named node.
+bool
+matches(
+  const Node * entity_node,
+  const Node * node,
+  const char * node_name = nullptr,
+  const char * node_namespace = nullptr)
+{
+  if (entity_node->domain_id() != node->domain_id()) {
+    return false;
+  }
+  return nullptr == node_name ||
+         (entity_node->name == node_name && entity_node->namespace_ == node_namespace);
+}
+
+rmw_ret_t
+fill_names_and_types(
+  const NamesAndTypes & entries,
+  rcutils_allocator_t * allocator,
+  rmw_names_and_types_t * names_and_types)
+{
+  if (entries.empty()) {
+    return RMW_RET_OK;
+  }
+  rmw_ret_t ret = rmw_names_and_types_init(names_and_types, entries.size(), allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  size_t i = 0u;
+  for (const auto & entry : entries) {
+    names_and_types->names.data[i] = rcutils_strdup(entry.first.c_str(), *allocator);
+    rcutils_ret_t rcutils_ret = nullptr == names_and_types->names.data[i] ?
+      RCUTILS_RET_BAD_ALLOC :
+      rcutils_string_array_init(&names_and_types->types[i], entry.second.size(), allocator);
+    size_t j = 0u;
+    for (const std::string & type : entry.second) {
+      if (RCUTILS_RET_OK != rcutils_ret) {
+        break;
+      }
+      names_and_types->types[i].data[j] = rcutils_strdup(type.c_str(), *allocator);
+      if (nullptr == names_and_types->types[i].data[j++]) {
+        rcutils_ret = RCUTILS_RET_BAD_ALLOC;
+      }
+    }
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      RMW_SET_ERROR_MSG("failed to allocate names and types");
+      if (RMW_RET_OK != rmw_names_and_types_fini(names_and_types)) {
+        rmw_reset_error();
+      }
+      return RMW_RET_BAD_ALLOC;
+    }
+    ++i;
+  }
+  return RMW_RET_OK;
+}
+
+const std::string &
+get_name(const rmw_loopback::Publisher * publisher) {return publisher->topic_name;}
+const std::string &
+get_name(const rmw_loopback::Subscription * subscription) {return subscription->topic_name;}
+const std::string &
+get_name(const rmw_loopback::Service * service) {return service->service_name;}
+const std::string &
+get_name(const rmw_loopback::Client * client) {return client->service_name;}
+
+/// Add the name and type of the entities of a node, or of all nodes of its domain.
+template<typename EntityT>
+void
+collect(
+  const std::vector<EntityT *> & entities,
+  const Node * node,
+  const char * node_name,
+  const char * node_namespace,
+  NamesAndTypes & entries)
+{
+  for (const EntityT * entity : entities) {
+    if (matches(entity->node, node, node_name, node_namespace)) {
+      entries[get_name(entity)].insert(entity->type_name);
+    }
+  }
+}
+
+/// Collect the topic names and types of publishers and/or subscriptions.
+rmw_ret_t
+get_topic_names_and_types(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  bool publishers,
+  bool subscriptions,
+  rmw_names_and_types_t * names_and_types)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RMW_RET_INVALID_ARGUMENT);
+  ret = rmw_names_and_types_check_zero(names_and_types);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  auto self = static_cast<const Node *>(node->data);
+  NamesAndTypes entries;
+  {
+    Graph & graph = rmw_loopback::get_graph();
+    std::lock_guard<std::mutex> lock(graph.mutex);
+    if (nullptr != node_name) {
+      bool found = std::any_of(
+        graph.nodes.begin(), graph.nodes.end(), [&](const Node * other) {
+          return matches(other, self, node_name, node_namespace);
+        });
+      if (!found) {
+        RMW_SET_ERROR_MSG("node not found");
+        return RMW_RET_NODE_NAME_NON_EXISTENT;
+      }
+    }
+    if (publishers) {
+      collect(graph.publishers, self, node_name, node_namespace, entries);
+    }
+    if (subscriptions) {
+      collect(graph.subscriptions, self, node_name, node_namespace, entries);
+    }
+  }
+  return fill_names_and_types(entries, allocator, names_and_types);
+}
+
+/// Collect the service names and types of services and/or clients.
+rmw_ret_t
+get_service_names_and_types(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  bool services,
+  bool clients,
+  rmw_names_and_types_t * names_and_types)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RMW_RET_INVALID_ARGUMENT);
+  ret = rmw_names_and_types_check_zero(names_and_types);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  auto self = static_cast<const Node *>(node->data);
+  NamesAndTypes entries;
+  {
+    Graph & graph = rmw_loopback::get_graph();
+    std::lock_guard<std::mutex> lock(graph.mutex);
+    if (nullptr != node_name) {
+      bool found = std::any_of(
+        graph.nodes.begin(), graph.nodes.end(), [&](const Node * other) {
+          return matches(other, self, node_name, node_namespace);
+        });
+      if (!found) {
+        RMW_SET_ERROR_MSG("node not found");
+        return RMW_RET_NODE_NAME_NON_EXISTENT;
+      }
+    }
+    if (services) {
+      collect(graph.services, self, node_name, node_namespace, entries);
+    }
+    if (clients) {
+      collect(graph.clients, self, node_name, node_namespace, entries);
+    }
+  }
+  return fill_names_and_types(entries, allocator, names_and_types);
+}
+
+template<typename EntityT>
+rmw_ret_t
+get_endpoint_info_by_topic(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * topic_name,
+  const std::vector<EntityT *> & entities,
+  rmw_endpoint_type_t endpoint_type,
+  rmw_topic_endpoint_info_array_t * info_array)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(topic_name, RMW_RET_INVALID_ARGUMENT);
+  ret = rmw_topic_endpoint_info_array_check_zero(info_array);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  auto self = static_cast<const Node *>(node->data);
+  std::vector<const EntityT *> found;
+  for (const EntityT * entity : entities) {
+    if (matches(entity->node, self) && entity->topic_name == topic_name) {
+      found.push_back(entity);
+    }
+  }
+  if (found.empty()) {
+    return RMW_RET_OK;
+  }
+  ret = rmw_topic_endpoint_info_array_init_with_size(info_array, found.size(), allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  for (size_t i = 0u; i < found.size() && RMW_RET_OK == ret; ++i) {
+    rmw_topic_endpoint_info_t * info = &info_array->info_array[i];
+    *info = rmw_get_zero_initialized_topic_endpoint_info();
+    ret = rmw_topic_endpoint_info_set_node_name(info, found[i]->node->name.c_str(), allocator);
+    if (RMW_RET_OK == ret) {
+      ret = rmw_topic_endpoint_info_set_node_namespace(
+        info, found[i]->node->namespace_.c_str(), allocator);
+    }
+    if (RMW_RET_OK == ret) {
+      ret = rmw_topic_endpoint_info_set_topic_type(
+        info, found[i]->type_name.c_str(), allocator);
+    }
+    if (RMW_RET_OK == ret) {
+      ret = rmw_topic_endpoint_info_set_endpoint_type(info, endpoint_type);
+    }
+    if (RMW_RET_OK == ret) {
+      ret = rmw_topic_endpoint_info_set_gid(info, found[i]->gid.data, RMW_GID_STORAGE_SIZE);
+    }
+    if (RMW_RET_OK == ret) {
+      ret = rmw_topic_endpoint_info_set_qos_profile(info, &found[i]->qos);
+    }
+  }
+  if (RMW_RET_OK != ret) {
+    if (RMW_RET_OK != rmw_topic_endpoint_info_array_fini(info_array, allocator)) {
+      rmw_reset_error();
+    }
+  }
+  return ret;
+}
+
+rmw_ret_t
+get_node_names(
+  const rmw_node_t * node,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces,
+  rcutils_string_array_t * enclaves)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  if (RMW_RET_OK != rmw_check_zero_rmw_string_array(node_names) ||
+    RMW_RET_OK != rmw_check_zero_rmw_string_array(node_namespaces) ||
+    (nullptr != enclaves && RMW_RET_OK != rmw_check_zero_rmw_string_array(enclaves)))
+  {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  auto self = static_cast<const Node *>(node->data);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  std::vector<const Node *> found;
+  for (const Node * other : graph.nodes) {
+    if (matches(other, self)) {
+      found.push_back(other);
+    }
+  }
+  rcutils_ret_t rcutils_ret = rcutils_string_array_init(node_names, found.size(), &allocator);
+  if (RCUTILS_RET_OK == rcutils_ret) {
+    rcutils_ret = rcutils_string_array_init(node_namespaces, found.size(), &allocator);
+  }
+  if (RCUTILS_RET_OK == rcutils_ret && nullptr != enclaves) {
+    rcutils_ret = rcutils_string_array_init(enclaves, found.size(), &allocator);
+  }
+  for (size_t i = 0u; i < found.size() && RCUTILS_RET_OK == rcutils_ret; ++i) {
+    node_names->data[i] = rcutils_strdup(found[i]->name.c_str(), allocator);
+    node_namespaces->data[i] = rcutils_strdup(found[i]->namespace_.c_str(), allocator);
+    if (nullptr == node_names->data[i] || nullptr == node_namespaces->data[i]) {
+      rcutils_ret = RCUTILS_RET_BAD_ALLOC;
+    }
+    if (nullptr != enclaves) {
+      enclaves->data[i] = rcutils_strdup(found[i]->enclave.c_str(), allocator);
+      if (nullptr == enclaves->data[i]) {
+        rcutils_ret = RCUTILS_RET_BAD_ALLOC;
+      }
+    }
+  }
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RMW_SET_ERROR_MSG("failed to allocate node names");
+    (void)rcutils_string_array_fini(node_names);
+    (void)rcutils_string_array_fini(node_namespaces);
+    if (nullptr != enclaves) {
+      (void)rcutils_string_array_fini(enclaves);
+    }
+    return RMW_RET_BAD_ALLOC;
+  }
+  return RMW_RET_OK;
+}
+
+}  // namespace
+
+extern "C"
+{
+
+rmw_node_t *
+rmw_create_node(rmw_context_t * context, const char * name, const char * namespace_)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, nullptr);
+  LOOPBACK_CHECK_IDENTIFIER(context, nullptr);
+  RMW_CHECK_FOR_NULL_WITH_MSG(context->impl, "expected initialized context", return nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(name, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(namespace_, nullptr);
+
+  auto node = new (std::nothrow) Node;
+  if (nullptr == node) {
+    RMW_SET_ERROR_MSG("failed to allocate node");
+    return nullptr;
+  }
+  node->context = context;
+  node->name = name;
+  node->namespace_ = namespace_;
+  if (nullptr != context->options.enclave) {
+    node->enclave = context->options.enclave;
+  }
+  node->handle.implementation_identifier = rmw_loopback::identifier;
+  node->handle.data = node;
+  node->handle.name = node->name.c_str();
+  node->handle.namespace_ = node->namespace_.c_str();
+  node->handle.context = context;
+  node->graph_guard_condition.handle.implementation_identifier = rmw_loopback::identifier;
+  node->graph_guard_condition.handle.data = &node->graph_guard_condition;
+  node->graph_guard_condition.handle.context = context;
+
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  graph.nodes.push_back(node);
+  rmw_loopback::notify_graph_change(graph, node->domain_id());
+  return &node->handle;
+}
+
+rmw_ret_t
+rmw_destroy_node(rmw_node_t * node)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  auto self = static_cast<Node *>(node->data);
+  Graph & graph = rmw_loopback::get_graph();
+  {
+    std::lock_guard<std::mutex> lock(graph.mutex);
+    graph.nodes.erase(std::remove(graph.nodes.begin(), graph.nodes.end(), self), graph.nodes.end());
+    rmw_loopback::notify_graph_change(graph, self->domain_id());
+  }
+  delete self;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_node_assert_liveliness(const rmw_node_t * node)
+{
+  return check_node(node);
+}
+
+const rmw_guard_condition_t *
+rmw_node_get_graph_guard_condition(const rmw_node_t * node)
+{
+  if (RMW_RET_OK != check_node(node)) {
+    return nullptr;
+  }
+  return &static_cast<const Node *>(node->data)->graph_guard_condition.handle;
+}
+
+rmw_ret_t
+rmw_get_node_names(
+  const rmw_node_t * node,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces)
+{
+  return get_node_names(node, node_names, node_namespaces, nullptr);
+}
+
+rmw_ret_t
+rmw_get_node_names_with_enclaves(
+  const rmw_node_t * node,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces,
+  rcutils_string_array_t * enclaves)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(enclaves, RMW_RET_INVALID_ARGUMENT);
+  return get_node_names(node, node_names, node_namespaces, enclaves);
+}
+
+rmw_ret_t
+rmw_count_publishers(const rmw_node_t * node, const char * topic_name, size_t * count)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(topic_name, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(count, RMW_RET_INVALID_ARGUMENT);
+  auto self = static_cast<const Node *>(node->data);
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  *count = static_cast<size_t>(
+    std::count_if(
+      graph.publishers.begin(), graph.publishers.end(), [&](const auto * publisher) {
+        return matches(publisher->node, self) && publisher->topic_name == topic_name;
+      }));
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_count_subscribers(const rmw_node_t * node, const char * topic_name, size_t * count)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(topic_name, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(count, RMW_RET_INVALID_ARGUMENT);
+  auto self = static_cast<const Node *>(node->data);
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  *count = static_cast<size_t>(
+    std::count_if(
+      graph.subscriptions.begin(), graph.subscriptions.end(), [&](const auto * subscription) {
+        return matches(subscription->node, self) && subscription->topic_name == topic_name;
+      }));
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_service_server_is_available(
+  const rmw_node_t * node,
+  const rmw_client_t * client,
+  bool * is_available)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(client, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(is_available, RMW_RET_INVALID_ARGUMENT);
+  auto self = static_cast<const rmw_loopback::Client *>(client->data);
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  *is_available = std::any_of(
+    graph.services.begin(), graph.services.end(), [&](const auto * service) {
+      return matches(service->node, self->node) && service->service_name == self->service_name;
+    });
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_get_topic_names_and_types(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  bool no_demangle,
+  rmw_names_and_types_t * topic_names_and_types)
+{
+  (void)no_demangle;
+  return get_topic_names_and_types(
+    node, allocator, nullptr, nullptr, true, true, topic_names_and_types);
+}
+
+rmw_ret_t
+rmw_get_publisher_names_and_types_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  bool no_demangle,
+  rmw_names_and_types_t * topic_names_and_types)
+{
+  (void)no_demangle;
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_name, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_namespace, RMW_RET_INVALID_ARGUMENT);
+  return get_topic_names_and_types(
+    node, allocator, node_name, node_namespace, true, false, topic_names_and_types);
+}
+
+rmw_ret_t
+rmw_get_subscriber_names_and_types_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  bool no_demangle,
+  rmw_names_and_types_t * topic_names_and_types)
+{
+  (void)no_demangle;
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_name, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_namespace, RMW_RET_INVALID_ARGUMENT);
+  return get_topic_names_and_types(
+    node, allocator, node_name, node_namespace, false, true, topic_names_and_types);
+}
+
+rmw_ret_t
+rmw_get_service_names_and_types(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  rmw_names_and_types_t * service_names_and_types)
+{
+  return get_service_names_and_types(
+    node, allocator, nullptr, nullptr, true, true, service_names_and_types);
+}
+
+rmw_ret_t
+rmw_get_service_names_and_types_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  rmw_names_and_types_t * service_names_and_types)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_name, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_namespace, RMW_RET_INVALID_ARGUMENT);
+  return get_service_names_and_types(
+    node, allocator, node_name, node_namespace, true, false, service_names_and_types);
+}
+
+rmw_ret_t
+rmw_get_client_names_and_types_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  rmw_names_and_types_t * service_names_and_types)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_name, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_namespace, RMW_RET_INVALID_ARGUMENT);
+  return get_service_names_and_types(
+    node, allocator, node_name, node_namespace, false, true, service_names_and_types);
+}
+
+rmw_ret_t
+rmw_get_publishers_info_by_topic(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * topic_name,
+  bool no_mangle,
+  rmw_topic_endpoint_info_array_t * publishers_info)
+{
+  (void)no_mangle;
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  return get_endpoint_info_by_topic(
+    node, allocator, topic_name, graph.publishers, RMW_ENDPOINT_PUBLISHER, publishers_info);
+}
+
+rmw_ret_t
+rmw_get_subscriptions_info_by_topic(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * topic_name,
+  bool no_mangle,
+  rmw_topic_endpoint_info_array_t * subscriptions_info)
+{
+  (void)no_mangle;
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  return get_endpoint_info_by_topic(
+    node, allocator, topic_name, graph.subscriptions, RMW_ENDPOINT_SUBSCRIPTION,
+    subscriptions_info);
+}
+
+}  // extern "C"
@@ -0,0 +1,372 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "./loopback.hpp"
+
+namespace
+{
+
+using rmw_loopback::Client;
+using rmw_loopback::Graph;
+using rmw_loopback::Node;
+using rmw_loopback::Request;
+using rmw_loopback::Service;
+
+static_assert(
+  sizeof(rmw_request_id_t::writer_guid) <= RMW_GID_STORAGE_SIZE,
+  "a client gid must fit in a writer guid");
+
+void
+clear_queue(const rmw_loopback::MessageMembers * members, std::deque<Request> & queue)
+{
+  for (Request & request : queue) {
+    rmw_loopback::destroy_message(members, request.message);
+  }
+  queue.clear();
+}
+
+/// Pop the oldest entry of a queue into `ros_message`; the graph mutex must be held.
+rmw_ret_t
+take_request(
+  const rmw_loopback::MessageMembers * members,
+  std::deque<Request> & queue,
+  rmw_service_info_t * request_header,
+  void * ros_message,
+  bool * taken)
+{
+  *taken = false;
+  if (queue.empty()) {
+    return RMW_RET_OK;
+  }
+  Request & request = queue.front();
+  if (!rmw_loopback::copy_message(members, ros_message, request.message)) {
+    return RMW_RET_ERROR;  // error already set
+  }
+  *request_header = request.info;
+  rmw_loopback::destroy_message(members, request.message);
+  queue.pop_front();
+  *taken = true;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+check_node(const rmw_node_t * node)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(node, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+check_client(const rmw_client_t * client)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(client, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+check_service(const rmw_service_t * service)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(service, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(service, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return RMW_RET_OK;
+}
+
+}  // namespace
+
+extern "C"
+{
+
+rmw_client_t *
+rmw_create_client(
+  const rmw_node_t * node,
+  const rosidl_service_type_support_t * type_support,
+  const char * service_name,
+  const rmw_qos_profile_t * qos_policies)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, nullptr);
+  LOOPBACK_CHECK_IDENTIFIER(node, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(service_name, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos_policies, nullptr);
+  if (0 == strlen(service_name)) {
+    RMW_SET_ERROR_MSG("service_name argument is an empty string");
+    return nullptr;
+  }
+  const rmw_loopback::ServiceMembers * members = rmw_loopback::get_service_members(type_support);
+  if (nullptr == members) {
+    return nullptr;  // error already set
+  }
+
+  auto client = new (std::nothrow) Client;
+  if (nullptr == client) {
+    RMW_SET_ERROR_MSG("failed to allocate client");
+    return nullptr;
+  }
+  client->node = static_cast<Node *>(node->data);
+  client->service_name = service_name;
+  client->type_name = rmw_loopback::get_type_name(
+    members->service_namespace_, members->service_name_);
+  client->members = members;
+  client->qos = rmw_loopback::resolve_qos(*qos_policies);
+  client->handle.implementation_identifier = rmw_loopback::identifier;
+  client->handle.data = client;
+  client->handle.service_name = client->service_name.c_str();
+
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  client->gid = rmw_loopback::make_gid(graph);
+  graph.clients.push_back(client);
+  rmw_loopback::notify_graph_change(graph, client->node->domain_id());
+  return &client->handle;
+}
+
+rmw_ret_t
+rmw_destroy_client(rmw_node_t * node, rmw_client_t * client)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  ret = check_client(client);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  auto self = static_cast<Client *>(client->data);
+  {
+    Graph & graph = rmw_loopback::get_graph();
+    std::lock_guard<std::mutex> lock(graph.mutex);
+    graph.clients.erase(
+      std::remove(graph.clients.begin(), graph.clients.end(), self),
+      graph.clients.end());
+    clear_queue(self->members->response_members_, self->responses);
+    rmw_loopback::notify_graph_change(graph, self->node->domain_id());
+  }
+  delete self;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_send_request(
+  const rmw_client_t * client,
+  const void * ros_request,
+  int64_t * sequence_id)
+{
+  rmw_ret_t ret = check_client(client);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_request, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(sequence_id, RMW_RET_INVALID_ARGUMENT);
+  auto self = static_cast<Client *>(client->data);
+
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  *sequence_id = self->next_sequence_number++;
+  if (self->node->noop()) {
+    return RMW_RET_OK;
+  }
+  Request request;
+  request.info.request_id.sequence_number = *sequence_id;
+  std::memcpy(
+    request.info.request_id.writer_guid, self->gid.data,
+    sizeof(request.info.request_id.writer_guid));
+  rmw_loopback::stamp(&request.info.source_timestamp, &request.info.received_timestamp);
+  for (Service * service : graph.services) {
+    if (service->node->domain_id() != self->node->domain_id() ||
+      service->service_name != self->service_name)
+    {
+      continue;
+    }
+    request.message = rmw_loopback::clone_message(
+      self->members->request_members_, ros_request);
+    if (nullptr == request.message) {
+      return RMW_RET_ERROR;  // error already set
+    }
+    service->requests.push_back(request);
+  }
+  graph.condition.notify_all();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_take_response(
+  const rmw_client_t * client,
+  rmw_service_info_t * request_header,
+  void * ros_response,
+  bool * taken)
+{
+  rmw_ret_t ret = check_client(client);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(request_header, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_response, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  auto self = static_cast<Client *>(client->data);
+  if (self->node->noop()) {
+    *taken = true;
+    return RMW_RET_OK;
+  }
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  return take_request(
+    self->members->response_members_, self->responses, request_header, ros_response, taken);
+}
+
+rmw_service_t *
+rmw_create_service(
+  const rmw_node_t * node,
+  const rosidl_service_type_support_t * type_support,
+  const char * service_name,
+  const rmw_qos_profile_t * qos_policies)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, nullptr);
+  LOOPBACK_CHECK_IDENTIFIER(node, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(service_name, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos_policies, nullptr);
+  if (0 == strlen(service_name)) {
+    RMW_SET_ERROR_MSG("service_name argument is an empty string");
+    return nullptr;
+  }
+  const rmw_loopback::ServiceMembers * members = rmw_loopback::get_service_members(type_support);
+  if (nullptr == members) {
+    return nullptr;  // error already set
+  }
+
+  auto service = new (std::nothrow) Service;
+  if (nullptr == service) {
+    RMW_SET_ERROR_MSG("failed to allocate service");
+    return nullptr;
+  }
+  service->node = static_cast<Node *>(node->data);
+  service->service_name = service_name;
+  service->type_name = rmw_loopback::get_type_name(
+    members->service_namespace_, members->service_name_);
+  service->members = members;
+  service->qos = rmw_loopback::resolve_qos(*qos_policies);
+  service->handle.implementation_identifier = rmw_loopback::identifier;
+  service->handle.data = service;
+  service->handle.service_name = service->service_name.c_str();
+
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  service->gid = rmw_loopback::make_gid(graph);
+  graph.services.push_back(service);
+  rmw_loopback::notify_graph_change(graph, service->node->domain_id());
+  return &service->handle;
+}
+
+rmw_ret_t
+rmw_destroy_service(rmw_node_t * node, rmw_service_t * service)
+{
+  rmw_ret_t ret = check_node(node);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  ret = check_service(service);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  auto self = static_cast<Service *>(service->data);
+  {
+    Graph & graph = rmw_loopback::get_graph();
+    std::lock_guard<std::mutex> lock(graph.mutex);
+    graph.services.erase(
+      std::remove(graph.services.begin(), graph.services.end(), self),
+      graph.services.end());
+    clear_queue(self->members->request_members_, self->requests);
+    rmw_loopback::notify_graph_change(graph, self->node->domain_id());
+  }
+  delete self;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_take_request(
+  const rmw_service_t * service,
+  rmw_service_info_t * request_header,
+  void * ros_request,
+  bool * taken)
+{
+  rmw_ret_t ret = check_service(service);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(request_header, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_request, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  auto self = static_cast<Service *>(service->data);
+  if (self->node->noop()) {
+    *taken = true;
+    return RMW_RET_OK;
+  }
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  return take_request(
+    self->members->request_members_, self->requests, request_header, ros_request, taken);
+}
+
+rmw_ret_t
+rmw_send_response(
+  const rmw_service_t * service,
+  rmw_request_id_t * request_header,
+  void * ros_response)
+{
+  rmw_ret_t ret = check_service(service);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(request_header, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_response, RMW_RET_INVALID_ARGUMENT);
+  auto self = static_cast<Service *>(service->data);
+  if (self->node->noop()) {
+    return RMW_RET_OK;
+  }
+
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  auto it = std::find_if(
+    graph.clients.begin(), graph.clients.end(), [&](const Client * client) {
+      return 0 == std::memcmp(
+        client->gid.data, request_header->writer_guid, sizeof(request_header->writer_guid));
+    });
+  if (graph.clients.end() == it) {
+    // The client went away, like a middleware the response is dropped.
+    return RMW_RET_OK;
+  }
+  Request response;
+  response.info.request_id = *request_header;
+  rmw_loopback::stamp(&response.info.source_timestamp, &response.info.received_timestamp);
+  response.message = rmw_loopback::clone_message(self->members->response_members_, ros_response);
+  if (nullptr == response.message) {
+    return RMW_RET_ERROR;  // error already set
+  }
+  (*it)->responses.push_back(response);
+  graph.condition.notify_all();
+  return RMW_RET_OK;
+}
+
+}  // extern "C"
@@ -0,0 +1,723 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include "rmw/error_handling.h"
+#include "rmw/event.h"
+#include "rmw/get_network_flow_endpoints.h"
+#include "rmw/rmw.h"
+
+#include "./loopback.hpp"
+
+namespace
+{
+
+using rmw_loopback::Graph;
+using rmw_loopback::Node;
+using rmw_loopback::Publisher;
+using rmw_loopback::Sample;
+using rmw_loopback::Subscription;
+
+bool
+is_match(const Publisher * publisher, const Subscription * subscription)
+{
+  if (publisher->node->domain_id() != subscription->node->domain_id() ||
+    publisher->topic_name != subscription->topic_name ||
+    publisher->type_name != subscription->type_name)
+  {
+    return false;
+  }
+  return !subscription->handle.options.ignore_local_publications ||
+         publisher->node->context != subscription->node->context;
+}
+
+void
+clear_queue(Subscription * subscription)
+{
+  for (Sample & sample : subscription->queue) {
+    rmw_loopback::destroy_message(subscription->members, sample.message);
+  }
+  subscription->queue.clear();
+}
+
+/// Pop the oldest sample of a subscription into `ros_message`; the graph mutex must be held.
+rmw_ret_t
+take_sample(
+  Subscription * subscription,
+  void * ros_message,
+  bool * taken,
+  rmw_message_info_t * message_info)
+{
+  *taken = false;
+  if (subscription->queue.empty()) {
+    return RMW_RET_OK;
+  }
+  Sample & sample = subscription->queue.front();
+  if (!rmw_loopback::copy_message(subscription->members, ros_message, sample.message)) {
+    return RMW_RET_ERROR;  // error already set
+  }
+  if (nullptr != message_info) {
+    *message_info = sample.info;
+  }
+  rmw_loopback::destroy_message(subscription->members, sample.message);
+  subscription->queue.pop_front();
+  *taken = true;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+check_subscription(const rmw_subscription_t * subscription)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(subscription, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+check_publisher(const rmw_publisher_t * publisher)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(publisher, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return RMW_RET_OK;
+}
+
+}  // namespace
+
+extern "C"
+{
+
+rmw_publisher_t *
+rmw_create_publisher(
+  const rmw_node_t * node,
+  const rosidl_message_type_support_t * type_support,
+  const char * topic_name,
+  const rmw_qos_profile_t * qos_policies,
+  const rmw_publisher_options_t * publisher_options)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, nullptr);
+  LOOPBACK_CHECK_IDENTIFIER(node, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(topic_name, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos_policies, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher_options, nullptr);
+  if (0 == strlen(topic_name)) {
+    RMW_SET_ERROR_MSG("topic_name argument is an empty string");
+    return nullptr;
+  }
+  const rmw_loopback::MessageMembers * members = rmw_loopback::get_message_members(type_support);
+  if (nullptr == members) {
+    return nullptr;  // error already set
+  }
+
+  auto publisher = new (std::nothrow) Publisher;
+  if (nullptr == publisher) {
+    RMW_SET_ERROR_MSG("failed to allocate publisher");
+    return nullptr;
+  }
+  publisher->node = static_cast<Node *>(node->data);
+  publisher->topic_name = topic_name;
+  publisher->type_name = rmw_loopback::get_type_name(
+    members->message_namespace_, members->message_name_);
+  publisher->members = members;
+  publisher->qos = rmw_loopback::resolve_qos(*qos_policies);
+  publisher->handle.implementation_identifier = rmw_loopback::identifier;
+  publisher->handle.data = publisher;
+  publisher->handle.topic_name = publisher->topic_name.c_str();
+  publisher->handle.options = *publisher_options;
+  publisher->handle.can_loan_messages = false;
+
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  publisher->gid = rmw_loopback::make_gid(graph);
+  for (Subscription * subscription : graph.subscriptions) {
+    if (is_match(publisher, subscription)) {
+      publisher->matched.push_back(subscription);
+      ++subscription->matched_publishers;
+    }
+  }
+  graph.publishers.push_back(publisher);
+  rmw_loopback::notify_graph_change(graph, publisher->node->domain_id());
+  return &publisher->handle;
+}
+
+rmw_ret_t
+rmw_destroy_publisher(rmw_node_t * node, rmw_publisher_t * publisher)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(node, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  rmw_ret_t ret = check_publisher(publisher);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  auto self = static_cast<Publisher *>(publisher->data);
+  {
+    Graph & graph = rmw_loopback::get_graph();
+    std::lock_guard<std::mutex> lock(graph.mutex);
+    for (Subscription * subscription : self->matched) {
+      --subscription->matched_publishers;
+    }
+    graph.publishers.erase(
+      std::remove(graph.publishers.begin(), graph.publishers.end(), self),
+      graph.publishers.end());
+    rmw_loopback::notify_graph_change(graph, self->node->domain_id());
+  }
+  delete self;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publish(
+  const rmw_publisher_t * publisher,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  (void)allocation;
+  rmw_ret_t ret = check_publisher(publisher);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+  auto self = static_cast<Publisher *>(publisher->data);
+  if (self->node->noop()) {
+    return RMW_RET_OK;
+  }
+
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  if (self->matched.empty()) {
+    return RMW_RET_OK;
+  }
+  rmw_message_info_t info = rmw_get_zero_initialized_message_info();
+  rmw_loopback::stamp(&info.source_timestamp, &info.received_timestamp);
+  info.publisher_gid = self->gid;
+  info.from_intra_process = false;
+  for (Subscription * subscription : self->matched) {
+    void * message = rmw_loopback::clone_message(self->members, ros_message);
+    if (nullptr == message) {
+      return RMW_RET_ERROR;  // error already set
+    }
+    if (subscription->queue.size() >= rmw_loopback::get_depth(subscription->qos)) {
+      rmw_loopback::destroy_message(subscription->members, subscription->queue.front().message);
+      subscription->queue.pop_front();
+      ++subscription->message_lost.total_count;
+      ++subscription->message_lost.total_count_change;
+    }
+    subscription->queue.push_back(Sample{message, info});
+  }
+  graph.condition.notify_all();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publish_serialized_message(
+  const rmw_publisher_t * publisher,
+  const rmw_serialized_message_t * serialized_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  (void)publisher;
+  (void)serialized_message;
+  (void)allocation;
+  RMW_SET_ERROR_MSG("rmw_loopback does not serialize messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_borrow_loaned_message(
+  const rmw_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  void ** ros_message)
+{
+  (void)publisher;
+  (void)type_support;
+  (void)ros_message;
+  RMW_SET_ERROR_MSG("rmw_loopback does not support loaned messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_return_loaned_message_from_publisher(
+  const rmw_publisher_t * publisher,
+  void * loaned_message)
+{
+  (void)publisher;
+  (void)loaned_message;
+  RMW_SET_ERROR_MSG("rmw_loopback does not support loaned messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_publish_loaned_message(
+  const rmw_publisher_t * publisher,
+  void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  (void)publisher;
+  (void)ros_message;
+  (void)allocation;
+  RMW_SET_ERROR_MSG("rmw_loopback does not support loaned messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_init_publisher_allocation(
+  const rosidl_message_type_support_t * type_support,
+  const rosidl_runtime_c__Sequence__bound * message_bounds,
+  rmw_publisher_allocation_t * allocation)
+{
+  (void)type_support;
+  (void)message_bounds;
+  (void)allocation;
+  RMW_SET_ERROR_MSG("rmw_loopback does not support preallocation");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_fini_publisher_allocation(rmw_publisher_allocation_t * allocation)
+{
+  (void)allocation;
+  RMW_SET_ERROR_MSG("rmw_loopback does not support preallocation");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_publisher_count_matched_subscriptions(
+  const rmw_publisher_t * publisher,
+  size_t * subscription_count)
+{
+  rmw_ret_t ret = check_publisher(publisher);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription_count, RMW_RET_INVALID_ARGUMENT);
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  *subscription_count = static_cast<const Publisher *>(publisher->data)->matched.size();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publisher_get_actual_qos(const rmw_publisher_t * publisher, rmw_qos_profile_t * qos)
+{
+  rmw_ret_t ret = check_publisher(publisher);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos, RMW_RET_INVALID_ARGUMENT);
+  *qos = static_cast<const Publisher *>(publisher->data)->qos;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publisher_assert_liveliness(const rmw_publisher_t * publisher)
+{
+  return check_publisher(publisher);
+}
+
+rmw_ret_t
+rmw_get_gid_for_publisher(const rmw_publisher_t * publisher, rmw_gid_t * gid)
+{
+  rmw_ret_t ret = check_publisher(publisher);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(gid, RMW_RET_INVALID_ARGUMENT);
+  *gid = static_cast<const Publisher *>(publisher->data)->gid;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publisher_get_network_flow_endpoints(
+  const rmw_publisher_t * publisher,
+  rcutils_allocator_t * allocator,
+  rmw_network_flow_endpoint_array_t * network_flow_endpoint_array)
+{
+  (void)publisher;
+  (void)allocator;
+  (void)network_flow_endpoint_array;
+  RMW_SET_ERROR_MSG("rmw_loopback has no network flow endpoints");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_subscription_t *
+rmw_create_subscription(
+  const rmw_node_t * node,
+  const rosidl_message_type_support_t * type_support,
+  const char * topic_name,
+  const rmw_qos_profile_t * qos_policies,
+  const rmw_subscription_options_t * subscription_options)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, nullptr);
+  LOOPBACK_CHECK_IDENTIFIER(node, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(topic_name, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos_policies, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription_options, nullptr);
+  if (0 == strlen(topic_name)) {
+    RMW_SET_ERROR_MSG("topic_name argument is an empty string");
+    return nullptr;
+  }
+  const rmw_loopback::MessageMembers * members = rmw_loopback::get_message_members(type_support);
+  if (nullptr == members) {
+    return nullptr;  // error already set
+  }
+
+  auto subscription = new (std::nothrow) Subscription;
+  if (nullptr == subscription) {
+    RMW_SET_ERROR_MSG("failed to allocate subscription");
+    return nullptr;
+  }
+  subscription->node = static_cast<Node *>(node->data);
+  subscription->topic_name = topic_name;
+  subscription->type_name = rmw_loopback::get_type_name(
+    members->message_namespace_, members->message_name_);
+  subscription->members = members;
+  subscription->qos = rmw_loopback::resolve_qos(*qos_policies);
+  subscription->handle.implementation_identifier = rmw_loopback::identifier;
+  subscription->handle.data = subscription;
+  subscription->handle.topic_name = subscription->topic_name.c_str();
+  subscription->handle.options = *subscription_options;
+  subscription->handle.can_loan_messages = false;
+
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  subscription->gid = rmw_loopback::make_gid(graph);
+  for (Publisher * publisher : graph.publishers) {
+    if (is_match(publisher, subscription)) {
+      publisher->matched.push_back(subscription);
+      ++subscription->matched_publishers;
+    }
+  }
+  graph.subscriptions.push_back(subscription);
+  rmw_loopback::notify_graph_change(graph, subscription->node->domain_id());
+  return &subscription->handle;
+}
+
+rmw_ret_t
+rmw_destroy_subscription(rmw_node_t * node, rmw_subscription_t * subscription)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(node, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  rmw_ret_t ret = check_subscription(subscription);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  auto self = static_cast<Subscription *>(subscription->data);
+  {
+    Graph & graph = rmw_loopback::get_graph();
+    std::lock_guard<std::mutex> lock(graph.mutex);
+    for (Publisher * publisher : graph.publishers) {
+      publisher->matched.erase(
+        std::remove(publisher->matched.begin(), publisher->matched.end(), self),
+        publisher->matched.end());
+    }
+    graph.subscriptions.erase(
+      std::remove(graph.subscriptions.begin(), graph.subscriptions.end(), self),
+      graph.subscriptions.end());
+    clear_queue(self);
+    rmw_loopback::notify_graph_change(graph, self->node->domain_id());
+  }
+  delete self;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_subscription_count_matched_publishers(
+  const rmw_subscription_t * subscription,
+  size_t * publisher_count)
+{
+  rmw_ret_t ret = check_subscription(subscription);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher_count, RMW_RET_INVALID_ARGUMENT);
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  *publisher_count = static_cast<const Subscription *>(subscription->data)->matched_publishers;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_subscription_get_actual_qos(
+  const rmw_subscription_t * subscription,
+  rmw_qos_profile_t * qos)
+{
+  rmw_ret_t ret = check_subscription(subscription);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos, RMW_RET_INVALID_ARGUMENT);
+  *qos = static_cast<const Subscription *>(subscription->data)->qos;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_take_with_info(
+  const rmw_subscription_t * subscription,
+  void * ros_message,
+  bool * taken,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  (void)allocation;
+  rmw_ret_t ret = check_subscription(subscription);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  auto self = static_cast<Subscription *>(subscription->data);
+  if (self->node->noop()) {
+    *taken = true;
+    return RMW_RET_OK;
+  }
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  return take_sample(self, ros_message, taken, message_info);
+}
+
+rmw_ret_t
+rmw_take(
+  const rmw_subscription_t * subscription,
+  void * ros_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  return rmw_take_with_info(subscription, ros_message, taken, nullptr, allocation);
+}
+
+rmw_ret_t
+rmw_take_sequence(
+  const rmw_subscription_t * subscription,
+  size_t count,
+  rmw_message_sequence_t * message_sequence,
+  rmw_message_info_sequence_t * message_info_sequence,
+  size_t * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  (void)allocation;
+  rmw_ret_t ret = check_subscription(subscription);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_sequence, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_info_sequence, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  if (0u == count || count > message_sequence->capacity ||
+    count > message_info_sequence->capacity)
+  {
+    RMW_SET_ERROR_MSG("count must be positive and fit in the sequences");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  auto self = static_cast<Subscription *>(subscription->data);
+  *taken = 0u;
+  if (self->node->noop()) {
+    *taken = count;
+  } else {
+    Graph & graph = rmw_loopback::get_graph();
+    std::lock_guard<std::mutex> lock(graph.mutex);
+    for (; *taken < count; ++*taken) {
+      bool taken_one = false;
+      ret = take_sample(
+        self, message_sequence->data[*taken], &taken_one,
+        &message_info_sequence->data[*taken]);
+      if (RMW_RET_OK != ret || !taken_one) {
+        break;
+      }
+    }
+  }
+  message_sequence->size = *taken;
+  message_info_sequence->size = *taken;
+  return ret;
+}
+
+rmw_ret_t
+rmw_take_serialized_message_with_info(
+  const rmw_subscription_t * subscription,
+  rmw_serialized_message_t * serialized_message,
+  bool * taken,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  (void)subscription;
+  (void)serialized_message;
+  (void)taken;
+  (void)message_info;
+  (void)allocation;
+  RMW_SET_ERROR_MSG("rmw_loopback does not serialize messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_take_serialized_message(
+  const rmw_subscription_t * subscription,
+  rmw_serialized_message_t * serialized_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  return rmw_take_serialized_message_with_info(
+    subscription, serialized_message, taken, nullptr, allocation);
+}
+
+rmw_ret_t
+rmw_take_loaned_message_with_info(
+  const rmw_subscription_t * subscription,
+  void ** loaned_message,
+  bool * taken,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  (void)subscription;
+  (void)loaned_message;
+  (void)taken;
+  (void)message_info;
+  (void)allocation;
+  RMW_SET_ERROR_MSG("rmw_loopback does not support loaned messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_take_loaned_message(
+  const rmw_subscription_t * subscription,
+  void ** loaned_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  return rmw_take_loaned_message_with_info(
+    subscription, loaned_message, taken, nullptr, allocation);
+}
+
+rmw_ret_t
+rmw_return_loaned_message_from_subscription(
+  const rmw_subscription_t * subscription,
+  void * loaned_message)
+{
+  (void)subscription;
+  (void)loaned_message;
+  RMW_SET_ERROR_MSG("rmw_loopback does not support loaned messages");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_init_subscription_allocation(
+  const rosidl_message_type_support_t * type_support,
+  const rosidl_runtime_c__Sequence__bound * message_bounds,
+  rmw_subscription_allocation_t * allocation)
+{
+  (void)type_support;
+  (void)message_bounds;
+  (void)allocation;
+  RMW_SET_ERROR_MSG("rmw_loopback does not support preallocation");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_fini_subscription_allocation(rmw_subscription_allocation_t * allocation)
+{
+  (void)allocation;
+  RMW_SET_ERROR_MSG("rmw_loopback does not support preallocation");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_subscription_get_network_flow_endpoints(
+  const rmw_subscription_t * subscription,
+  rcutils_allocator_t * allocator,
+  rmw_network_flow_endpoint_array_t * network_flow_endpoint_array)
+{
+  (void)subscription;
+  (void)allocator;
+  (void)network_flow_endpoint_array;
+  RMW_SET_ERROR_MSG("rmw_loopback has no network flow endpoints");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_publisher_event_init(
+  rmw_event_t * rmw_event,
+  const rmw_publisher_t * publisher,
+  rmw_event_type_t event_type)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(rmw_event, RMW_RET_INVALID_ARGUMENT);
+  rmw_ret_t ret = check_publisher(publisher);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  switch (event_type) {
+    case RMW_EVENT_LIVELINESS_LOST:
+    case RMW_EVENT_OFFERED_DEADLINE_MISSED:
+    case RMW_EVENT_OFFERED_QOS_INCOMPATIBLE:
+      break;
+    default:
+      RMW_SET_ERROR_MSG("event type is not supported for publishers");
+      return RMW_RET_UNSUPPORTED;
+  }
+  // These events never occur in memory, the event only refers to its publisher.
+  rmw_event->implementation_identifier = rmw_loopback::identifier;
+  rmw_event->data = publisher->data;
+  rmw_event->event_type = event_type;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_subscription_event_init(
+  rmw_event_t * rmw_event,
+  const rmw_subscription_t * subscription,
+  rmw_event_type_t event_type)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(rmw_event, RMW_RET_INVALID_ARGUMENT);
+  rmw_ret_t ret = check_subscription(subscription);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  switch (event_type) {
+    case RMW_EVENT_LIVELINESS_CHANGED:
+    case RMW_EVENT_REQUESTED_DEADLINE_MISSED:
+    case RMW_EVENT_REQUESTED_QOS_INCOMPATIBLE:
+    case RMW_EVENT_MESSAGE_LOST:
+      break;
+    default:
+      RMW_SET_ERROR_MSG("event type is not supported for subscriptions");
+      return RMW_RET_UNSUPPORTED;
+  }
+  rmw_event->implementation_identifier = rmw_loopback::identifier;
+  rmw_event->data = subscription->data;
+  rmw_event->event_type = event_type;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_take_event(const rmw_event_t * event_handle, void * event_info, bool * taken)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(event_handle, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(event_handle, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(event_info, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  *taken = false;
+  if (RMW_EVENT_MESSAGE_LOST != event_handle->event_type) {
+    return RMW_RET_OK;
+  }
+  auto subscription = static_cast<Subscription *>(event_handle->data);
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  *static_cast<rmw_message_lost_status_t *>(event_info) = subscription->message_lost;
+  subscription->message_lost.total_count_change = 0u;
+  *taken = true;
+  return RMW_RET_OK;
+}
+
+}  // extern "C"
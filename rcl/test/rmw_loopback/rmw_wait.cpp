@@ -0,0 +1,210 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <mutex>
+#include <new>
+
+#include "rmw/error_handling.h"
+#include "rmw/event.h"
+#include "rmw/rmw.h"
+
+#include "./loopback.hpp"
+
+namespace
+{
+
+using rmw_loopback::Client;
+using rmw_loopback::GuardCondition;
+using rmw_loopback::Graph;
+using rmw_loopback::Service;
+using rmw_loopback::Subscription;
+using rmw_loopback::WaitSet;
+
+bool
+is_ready(const rmw_event_t * event)
+{
+  if (RMW_EVENT_MESSAGE_LOST != event->event_type) {
+    return false;
+  }
+  return 0u != static_cast<const Subscription *>(event->data)->message_lost.total_count_change;
+}
+
+/// Whether any entity is ready, and if `collect` null out the others; the mutex must be held.
+bool
+check_ready(
+  rmw_subscriptions_t * subscriptions,
+  rmw_guard_conditions_t * guard_conditions,
+  rmw_services_t * services,
+  rmw_clients_t * clients,
+  rmw_events_t * events,
+  bool collect)
+{
+  bool ready = false;
+  if (nullptr != subscriptions) {
+    for (size_t i = 0u; i < subscriptions->subscriber_count; ++i) {
+      auto subscription = static_cast<Subscription *>(subscriptions->subscribers[i]);
+      if (nullptr == subscription || subscription->queue.empty()) {
+        if (collect) {subscriptions->subscribers[i] = nullptr;}
+        continue;
+      }
+      ready = true;
+    }
+  }
+  if (nullptr != guard_conditions) {
+    for (size_t i = 0u; i < guard_conditions->guard_condition_count; ++i) {
+      auto guard_condition = static_cast<GuardCondition *>(guard_conditions->guard_conditions[i]);
+      if (nullptr == guard_condition || !guard_condition->triggered) {
+        if (collect) {guard_conditions->guard_conditions[i] = nullptr;}
+        continue;
+      }
+      if (collect) {guard_condition->triggered = false;}
+      ready = true;
+    }
+  }
+  if (nullptr != services) {
+    for (size_t i = 0u; i < services->service_count; ++i) {
+      auto service = static_cast<Service *>(services->services[i]);
+      if (nullptr == service || service->requests.empty()) {
+        if (collect) {services->services[i] = nullptr;}
+        continue;
+      }
+      ready = true;
+    }
+  }
+  if (nullptr != clients) {
+    for (size_t i = 0u; i < clients->client_count; ++i) {
+      auto client = static_cast<Client *>(clients->clients[i]);
+      if (nullptr == client || client->responses.empty()) {
+        if (collect) {clients->clients[i] = nullptr;}
+        continue;
+      }
+      ready = true;
+    }
+  }
+  if (nullptr != events) {
+    for (size_t i = 0u; i < events->event_count; ++i) {
+      auto event = static_cast<rmw_event_t *>(events->events[i]);
+      if (nullptr == event || !is_ready(event)) {
+        if (collect) {events->events[i] = nullptr;}
+        continue;
+      }
+      ready = true;
+    }
+  }
+  return ready;
+}
+
+}  // namespace
+
+extern "C"
+{
+
+rmw_guard_condition_t *
+rmw_create_guard_condition(rmw_context_t * context)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, nullptr);
+  LOOPBACK_CHECK_IDENTIFIER(context, nullptr);
+  auto guard_condition = new (std::nothrow) GuardCondition;
+  if (nullptr == guard_condition) {
+    RMW_SET_ERROR_MSG("failed to allocate guard condition");
+    return nullptr;
+  }
+  guard_condition->handle.implementation_identifier = rmw_loopback::identifier;
+  guard_condition->handle.data = guard_condition;
+  guard_condition->handle.context = context;
+  return &guard_condition->handle;
+}
+
+rmw_ret_t
+rmw_destroy_guard_condition(rmw_guard_condition_t * guard_condition)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(guard_condition, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(guard_condition, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  delete static_cast<GuardCondition *>(guard_condition->data);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_trigger_guard_condition(const rmw_guard_condition_t * guard_condition)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(guard_condition, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(guard_condition, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  Graph & graph = rmw_loopback::get_graph();
+  std::lock_guard<std::mutex> lock(graph.mutex);
+  static_cast<GuardCondition *>(guard_condition->data)->triggered = true;
+  graph.condition.notify_all();
+  return RMW_RET_OK;
+}
+
+rmw_wait_set_t *
+rmw_create_wait_set(rmw_context_t * context, size_t max_conditions)
+{
+  (void)max_conditions;
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, nullptr);
+  LOOPBACK_CHECK_IDENTIFIER(context, nullptr);
+  auto wait_set = new (std::nothrow) WaitSet;
+  if (nullptr == wait_set) {
+    RMW_SET_ERROR_MSG("failed to allocate wait set");
+    return nullptr;
+  }
+  wait_set->context = context;
+  wait_set->handle.implementation_identifier = rmw_loopback::identifier;
+  wait_set->handle.data = wait_set;
+  wait_set->handle.guard_conditions = nullptr;
+  return &wait_set->handle;
+}
+
+rmw_ret_t
+rmw_destroy_wait_set(rmw_wait_set_t * wait_set)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(wait_set, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(wait_set, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  delete static_cast<WaitSet *>(wait_set->data);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_wait(
+  rmw_subscriptions_t * subscriptions,
+  rmw_guard_conditions_t * guard_conditions,
+  rmw_services_t * services,
+  rmw_clients_t * clients,
+  rmw_events_t * events,
+  rmw_wait_set_t * wait_set,
+  const rmw_time_t * wait_timeout)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(wait_set, RMW_RET_INVALID_ARGUMENT);
+  LOOPBACK_CHECK_IDENTIFIER(wait_set, RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (static_cast<const WaitSet *>(wait_set->data)->context->impl->noop) {
+    return RMW_RET_OK;
+  }
+
+  auto is_any_ready = [&]() {
+      return check_ready(subscriptions, guard_conditions, services, clients, events, false);
+    };
+  Graph & graph = rmw_loopback::get_graph();
+  std::unique_lock<std::mutex> lock(graph.mutex);
+  if (nullptr == wait_timeout) {
+    graph.condition.wait(lock, is_any_ready);
+  } else if (0u != wait_timeout->sec || 0u != wait_timeout->nsec) {
+    auto timeout = std::chrono::seconds(wait_timeout->sec) +
+      std::chrono::nanoseconds(wait_timeout->nsec);
+    graph.condition.wait_for(lock, timeout, is_any_ready);
+  }
+  bool ready = check_ready(subscriptions, guard_conditions, services, clients, events, true);
+  return ready ? RMW_RET_OK : RMW_RET_TIMEOUT;
+}
+
+}  // extern "C"
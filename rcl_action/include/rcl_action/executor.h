@@ -0,0 +1,155 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_ACTION__EXECUTOR_H_
+#define RCL_ACTION__EXECUTOR_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+
+#include "rcl_action/action_client.h"
+#include "rcl_action/action_server.h"
+#include "rcl_action/visibility_control.h"
+#include "rcl/executor.h"
+
+struct rcl_action_server_executor_handle_t;
+struct rcl_action_client_executor_handle_t;
+
+/// Callback for an action server with ready entities.
+typedef void (* rcl_action_server_executor_callback_t)(
+  struct rcl_action_server_executor_handle_t * handle);
+
+/// Callback for an action client with ready entities.
+typedef void (* rcl_action_client_executor_callback_t)(
+  struct rcl_action_client_executor_handle_t * handle);
+
+/// Executor handle of an action server.
+/**
+ * The readiness flags are set before the callback is called, which then takes
+ * the ready requests with the rcl_action_take_*() functions.
+ */
+typedef struct rcl_action_server_executor_handle_t
+{
+  /// The action server.
+  rcl_action_server_t * action_server;
+  /// Callback called when any of its entities is ready.
+  rcl_action_server_executor_callback_t callback;
+  /// User context for the callback.
+  void * context;
+  /// Whether a goal request is ready to take.
+  bool is_goal_request_ready;
+  /// Whether a cancel request is ready to take.
+  bool is_cancel_request_ready;
+  /// Whether a result request is ready to take.
+  bool is_result_request_ready;
+  /// Whether goals expired, see rcl_action_expire_goals().
+  bool is_goal_expired;
+} rcl_action_server_executor_handle_t;
+
+/// Executor handle of an action client.
+/**
+ * The readiness flags are set before the callback is called, which then takes
+ * the ready messages with the rcl_action_take_*() functions.
+ */
+typedef struct rcl_action_client_executor_handle_t
+{
+  /// The action client.
+  rcl_action_client_t * action_client;
+  /// Callback called when any of its entities is ready.
+  rcl_action_client_executor_callback_t callback;
+  /// User context for the callback.
+  void * context;
+  /// Whether feedback is ready to take.
+  bool is_feedback_ready;
+  /// Whether a status array is ready to take.
+  bool is_status_ready;
+  /// Whether a goal response is ready to take.
+  bool is_goal_response_ready;
+  /// Whether a cancel response is ready to take.
+  bool is_cancel_response_ready;
+  /// Whether a result response is ready to take.
+  bool is_result_response_ready;
+} rcl_action_client_executor_handle_t;
+
+/// Add an action server to an executor.
+/**
+ * The handle is initialized here and must outlive the executor.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to add the action server to
+ * \param[out] handle storage for the handle of the action server
+ * \param[in] action_server the action server
+ * \param[in] callback the callback to call when any entity is ready
+ * \param[in] context user context for the callback
+ * \return #RCL_RET_OK if the action server was added successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if the handle table of the executor is full.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_executor_add_server(
+  rcl_executor_t * executor,
+  rcl_action_server_executor_handle_t * handle,
+  rcl_action_server_t * action_server,
+  rcl_action_server_executor_callback_t callback,
+  void * context);
+
+/// Add an action client to an executor.
+/**
+ * The handle is initialized here and must outlive the executor.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] executor the executor to add the action client to
+ * \param[out] handle storage for the handle of the action client
+ * \param[in] action_client the action client
+ * \param[in] callback the callback to call when any entity is ready
+ * \param[in] context user context for the callback
+ * \return #RCL_RET_OK if the action client was added successfully, or
+ * \return #RCL_RET_INVALID_ARGUMENT if any arguments are invalid, or
+ * \return #RCL_RET_ERROR if the handle table of the executor is full.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_executor_add_client(
+  rcl_executor_t * executor,
+  rcl_action_client_executor_handle_t * handle,
+  rcl_action_client_t * action_client,
+  rcl_action_client_executor_callback_t callback,
+  void * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL_ACTION__EXECUTOR_H_
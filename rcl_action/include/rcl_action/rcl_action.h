@@ -50,6 +50,7 @@ extern "C"
 #include "rcl_action/action_client.h"
 #include "rcl_action/action_server.h"
 #include "rcl_action/default_qos.h"
+#include "rcl_action/executor.h"
 #include "rcl_action/goal_handle.h"
 #include "rcl_action/goal_state_machine.h"
 #include "rcl_action/graph.h"
@@ -29,6 +29,7 @@ extern "C"
 #include "rcl/error_handling.h"
 #include "rcl/rcl.h"
 #include "rcl/time.h"
+#include "rcl/tracing.h"
 
 #include "rcutils/logging_macros.h"
 #include "rcutils/strdup.h"
@@ -399,6 +400,11 @@ rcl_action_accept_new_goal(
 
   action_server->impl->goal_handles = goal_handles;
   action_server->impl->num_goal_handles = new_num_goal_handles;
+  RCL_IN_PROCESS_TRACEPOINT(
+    rcl_action_accept_new_goal,
+    (const void *)action_server,
+    (const void *)goal_handles[num_goal_handles],
+    goal_info->goal_id.uuid);
   return goal_handles[num_goal_handles];
 }
 
@@ -667,6 +673,11 @@ rcl_action_expire_goals(
     ret_final = expire_timer_ret;
   }
 
+  if (num_goals_expired > 0u) {
+    RCL_IN_PROCESS_TRACEPOINT(
+      rcl_action_expire_goals, (const void *)action_server, num_goals_expired);
+  }
+
   // If argument is not null, then set it
   if (NULL != num_expired) {
     (*num_expired) = num_goals_expired;
@@ -0,0 +1,171 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl_action/executor.h"
+
+#include "rcl_action/wait.h"
+
+#include "rcl/error_handling.h"
+
+static rcl_ret_t
+_server_get_number_of_entities(
+  void * data,
+  size_t * number_of_subscriptions,
+  size_t * number_of_guard_conditions,
+  size_t * number_of_timers,
+  size_t * number_of_clients,
+  size_t * number_of_services)
+{
+  rcl_action_server_executor_handle_t * handle = (rcl_action_server_executor_handle_t *)data;
+  return rcl_action_server_wait_set_get_num_entities(
+    handle->action_server, number_of_subscriptions, number_of_guard_conditions,
+    number_of_timers, number_of_clients, number_of_services);
+}
+
+static rcl_ret_t
+_server_add_to_wait_set(void * data, rcl_wait_set_t * wait_set)
+{
+  rcl_action_server_executor_handle_t * handle = (rcl_action_server_executor_handle_t *)data;
+  return rcl_action_wait_set_add_action_server(wait_set, handle->action_server, NULL);
+}
+
+static rcl_ret_t
+_server_is_ready(void * data, const rcl_wait_set_t * wait_set, bool * is_ready)
+{
+  rcl_action_server_executor_handle_t * handle = (rcl_action_server_executor_handle_t *)data;
+  rcl_ret_t ret = rcl_action_server_wait_set_get_entities_ready(
+    wait_set, handle->action_server, &handle->is_goal_request_ready,
+    &handle->is_cancel_request_ready, &handle->is_result_request_ready,
+    &handle->is_goal_expired);
+  *is_ready =
+    handle->is_goal_request_ready || handle->is_cancel_request_ready ||
+    handle->is_result_request_ready || handle->is_goal_expired;
+  return ret;
+}
+
+static rcl_ret_t
+_server_execute(void * data)
+{
+  rcl_action_server_executor_handle_t * handle = (rcl_action_server_executor_handle_t *)data;
+  handle->callback(handle);
+  return RCL_RET_OK;
+}
+
+static rcl_ret_t
+_client_get_number_of_entities(
+  void * data,
+  size_t * number_of_subscriptions,
+  size_t * number_of_guard_conditions,
+  size_t * number_of_timers,
+  size_t * number_of_clients,
+  size_t * number_of_services)
+{
+  rcl_action_client_executor_handle_t * handle = (rcl_action_client_executor_handle_t *)data;
+  return rcl_action_client_wait_set_get_num_entities(
+    handle->action_client, number_of_subscriptions, number_of_guard_conditions,
+    number_of_timers, number_of_clients, number_of_services);
+}
+
+static rcl_ret_t
+_client_add_to_wait_set(void * data, rcl_wait_set_t * wait_set)
+{
+  rcl_action_client_executor_handle_t * handle = (rcl_action_client_executor_handle_t *)data;
+  return rcl_action_wait_set_add_action_client(wait_set, handle->action_client, NULL, NULL);
+}
+
+static rcl_ret_t
+_client_is_ready(void * data, const rcl_wait_set_t * wait_set, bool * is_ready)
+{
+  rcl_action_client_executor_handle_t * handle = (rcl_action_client_executor_handle_t *)data;
+  rcl_ret_t ret = rcl_action_client_wait_set_get_entities_ready(
+    wait_set, handle->action_client, &handle->is_feedback_ready, &handle->is_status_ready,
+    &handle->is_goal_response_ready, &handle->is_cancel_response_ready,
+    &handle->is_result_response_ready);
+  *is_ready =
+    handle->is_feedback_ready || handle->is_status_ready || handle->is_goal_response_ready ||
+    handle->is_cancel_response_ready || handle->is_result_response_ready;
+  return ret;
+}
+
+static rcl_ret_t
+_client_execute(void * data)
+{
+  rcl_action_client_executor_handle_t * handle = (rcl_action_client_executor_handle_t *)data;
+  handle->callback(handle);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_executor_add_server(
+  rcl_executor_t * executor,
+  rcl_action_server_executor_handle_t * handle,
+  rcl_action_server_t * action_server,
+  rcl_action_server_executor_callback_t callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(action_server, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  handle->action_server = action_server;
+  handle->callback = callback;
+  handle->context = context;
+  handle->is_goal_request_ready = false;
+  handle->is_cancel_request_ready = false;
+  handle->is_result_request_ready = false;
+  handle->is_goal_expired = false;
+  rcl_executor_waitable_t waitable;
+  waitable.data = handle;
+  waitable.get_number_of_entities = _server_get_number_of_entities;
+  waitable.add_to_wait_set = _server_add_to_wait_set;
+  waitable.is_ready = _server_is_ready;
+  waitable.execute = _server_execute;
+  return rcl_executor_add_waitable(executor, &waitable);
+}
+
+rcl_ret_t
+rcl_action_executor_add_client(
+  rcl_executor_t * executor,
+  rcl_action_client_executor_handle_t * handle,
+  rcl_action_client_t * action_client,
+  rcl_action_client_executor_callback_t callback,
+  void * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(action_client, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  handle->action_client = action_client;
+  handle->callback = callback;
+  handle->context = context;
+  handle->is_feedback_ready = false;
+  handle->is_status_ready = false;
+  handle->is_goal_response_ready = false;
+  handle->is_cancel_response_ready = false;
+  handle->is_result_response_ready = false;
+  rcl_executor_waitable_t waitable;
+  waitable.data = handle;
+  waitable.get_number_of_entities = _client_get_number_of_entities;
+  waitable.add_to_wait_set = _client_add_to_wait_set;
+  waitable.is_ready = _client_is_ready;
+  waitable.execute = _client_execute;
+  return rcl_executor_add_waitable(executor, &waitable);
+}
+
+#ifdef __cplusplus
+}
+#endif
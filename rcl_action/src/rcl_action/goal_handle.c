@@ -21,6 +21,7 @@ extern "C"
 
 #include "rcl/rcl.h"
 #include "rcl/error_handling.h"
+#include "rcl/tracing.h"
 
 typedef struct rcl_action_goal_handle_impl_t
 {
@@ -99,6 +100,8 @@ rcl_action_update_goal_state(
     return RCL_RET_ACTION_GOAL_EVENT_INVALID;
   }
   goal_handle->impl->state = new_state;
+  RCL_IN_PROCESS_TRACEPOINT(
+    rcl_action_update_goal_state, (const void *)goal_handle, goal_event, new_state);
   return RCL_RET_OK;
 }
 
@@ -0,0 +1,142 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL_ACTION__COUNTING_ALLOCATOR_H_
+#define RCL_ACTION__COUNTING_ALLOCATOR_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+
+/// Counters of an allocator that forwards to the default allocator.
+/**
+ * While `is_trapping` is set, the allocator instead fails every allocation and records all of
+ * its calls in `trapped`, so a test can assert that a steady state path never touches it.
+ */
+typedef struct counting_allocator_state
+{
+  /// Calls to allocate and zero_allocate.
+  size_t allocations;
+  /// Calls to reallocate.
+  size_t reallocations;
+  /// Calls to deallocate with a non-NULL pointer.
+  size_t deallocations;
+  bool is_trapping;
+  /// Calls made while trapping.
+  size_t trapped;
+} counting_allocator_state;
+
+static inline bool
+counting_allocator_trap(void * state)
+{
+  counting_allocator_state * counting_state = (counting_allocator_state *)state;
+  if (counting_state->is_trapping) {
+    counting_state->trapped++;
+  }
+  return counting_state->is_trapping;
+}
+
+static void *
+counting_malloc(size_t size, void * state)
+{
+  if (counting_allocator_trap(state)) {
+    return NULL;
+  }
+  ((counting_allocator_state *)state)->allocations++;
+  return rcutils_get_default_allocator().allocate(size, rcutils_get_default_allocator().state);
+}
+
+static void *
+counting_realloc(void * pointer, size_t size, void * state)
+{
+  if (counting_allocator_trap(state)) {
+    return NULL;
+  }
+  ((counting_allocator_state *)state)->reallocations++;
+  return rcutils_get_default_allocator().reallocate(
+    pointer, size, rcutils_get_default_allocator().state);
+}
+
+static void
+counting_free(void * pointer, void * state)
+{
+  // Freeing is recorded but still done, a trapped deallocation must not leak as well.
+  if (NULL != pointer && !counting_allocator_trap(state)) {
+    ((counting_allocator_state *)state)->deallocations++;
+  }
+  rcutils_get_default_allocator().deallocate(pointer, rcutils_get_default_allocator().state);
+}
+
+static void *
+counting_calloc(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (counting_allocator_trap(state)) {
+    return NULL;
+  }
+  ((counting_allocator_state *)state)->allocations++;
+  return rcutils_get_default_allocator().zero_allocate(
+    number_of_elements, size_of_element, rcutils_get_default_allocator().state);
+}
+
+/// Return an allocator that records its calls in `state`, which must outlive it.
+static inline rcutils_allocator_t
+get_counting_allocator(counting_allocator_state * state)
+{
+  state->allocations = 0u;
+  state->reallocations = 0u;
+  state->deallocations = 0u;
+  state->is_trapping = false;
+  state->trapped = 0u;
+  rcutils_allocator_t counting_allocator = rcutils_get_default_allocator();
+  counting_allocator.allocate = counting_malloc;
+  counting_allocator.deallocate = counting_free;
+  counting_allocator.reallocate = counting_realloc;
+  counting_allocator.zero_allocate = counting_calloc;
+  counting_allocator.state = state;
+  return counting_allocator;
+}
+
+/// Return the number of calls that may have acquired memory, i.e. allocations and reallocations.
+static inline size_t
+get_counting_allocator_count(const counting_allocator_state * state)
+{
+  return state->allocations + state->reallocations;
+}
+
+static inline void
+reset_counting_allocator(counting_allocator_state * state)
+{
+  state->allocations = 0u;
+  state->reallocations = 0u;
+  state->deallocations = 0u;
+  state->trapped = 0u;
+}
+
+static inline void
+set_counting_allocator_is_trapping(rcutils_allocator_t & counting_allocator, bool is_trapping)
+{
+  ((counting_allocator_state *)counting_allocator.state)->is_trapping = is_trapping;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL_ACTION__COUNTING_ALLOCATOR_H_
@@ -17,6 +17,7 @@
 
 #include "rcl_action/action_client.h"
 #include "rcl_action/action_server.h"
+#include "rcl_action/executor.h"
 #include "rcl_action/wait.h"
 
 #include "rcl/error_handling.h"
@@ -26,6 +27,8 @@
 
 #include "test_msgs/action/fibonacci.h"
 
+#include "counting_allocator.h"
+
 #ifdef RMW_IMPLEMENTATION
 # define CLASSNAME_(NAME, SUFFIX) NAME ## __ ## SUFFIX
 # define CLASSNAME(NAME, SUFFIX) CLASSNAME_(NAME, SUFFIX)
@@ -1182,3 +1185,185 @@ TEST_F(CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION), test_valid_feedba
     test_msgs__action__Fibonacci_FeedbackMessage__fini(&outgoing_feedback);
   });
 }
+
+TEST_F(CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION), test_executor_goal_comm)
+{
+  struct goal_exchange
+  {
+    test_msgs__action__Fibonacci_SendGoal_Request request;
+    test_msgs__action__Fibonacci_SendGoal_Response response;
+    int32_t order;
+    bool accepted;
+  } exchange;
+  test_msgs__action__Fibonacci_SendGoal_Request__init(&exchange.request);
+  test_msgs__action__Fibonacci_SendGoal_Response__init(&exchange.response);
+  exchange.order = 0;
+  exchange.accepted = false;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__action__Fibonacci_SendGoal_Request__fini(&exchange.request);
+    test_msgs__action__Fibonacci_SendGoal_Response__fini(&exchange.response);
+  });
+
+  rcl_executor_t executor = rcl_get_zero_initialized_executor();
+  rcl_executor_options_t options = rcl_executor_get_default_options();
+  rcl_ret_t ret = rcl_executor_init(&executor, &this->context, 2u, &options);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_executor_fini(&executor)) << rcl_get_error_string().str;
+  });
+  auto on_server_ready = [](rcl_action_server_executor_handle_t * handle) {
+      auto exchange = static_cast<goal_exchange *>(handle->context);
+      if (!handle->is_goal_request_ready) {
+        return;
+      }
+      rmw_request_id_t request_header;
+      ASSERT_EQ(
+        RCL_RET_OK, rcl_action_take_goal_request(
+          handle->action_server, &request_header, &exchange->request));
+      exchange->order = exchange->request.goal.order;
+      exchange->response.accepted = true;
+      EXPECT_EQ(
+        RCL_RET_OK, rcl_action_send_goal_response(
+          handle->action_server, &request_header, &exchange->response));
+    };
+  auto on_client_ready = [](rcl_action_client_executor_handle_t * handle) {
+      auto exchange = static_cast<goal_exchange *>(handle->context);
+      if (!handle->is_goal_response_ready) {
+        return;
+      }
+      rmw_request_id_t response_header;
+      test_msgs__action__Fibonacci_SendGoal_Response response;
+      test_msgs__action__Fibonacci_SendGoal_Response__init(&response);
+      EXPECT_EQ(
+        RCL_RET_OK, rcl_action_take_goal_response(
+          handle->action_client, &response_header, &response));
+      exchange->accepted = response.accepted;
+      test_msgs__action__Fibonacci_SendGoal_Response__fini(&response);
+    };
+  rcl_action_server_executor_handle_t server_handle;
+  ret = rcl_action_executor_add_server(
+    &executor, &server_handle, &this->action_server, on_server_ready, &exchange);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_action_client_executor_handle_t client_handle;
+  ret = rcl_action_executor_add_client(
+    &executor, &client_handle, &this->action_client, on_client_ready, &exchange);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  test_msgs__action__Fibonacci_SendGoal_Request goal_request;
+  test_msgs__action__Fibonacci_SendGoal_Request__init(&goal_request);
+  init_test_uuid0(goal_request.goal_id.uuid);
+  goal_request.goal.order = 10;
+  int64_t sequence_number;
+  ret = rcl_action_send_goal_request(&this->action_client, &goal_request, &sequence_number);
+  test_msgs__action__Fibonacci_SendGoal_Request__fini(&goal_request);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  for (int i = 0; i < 10 && !exchange.accepted; ++i) {
+    ret = rcl_executor_spin_some(&executor, RCL_S_TO_NS(1));
+    ASSERT_TRUE(RCL_RET_OK == ret || RCL_RET_TIMEOUT == ret) << rcl_get_error_string().str;
+  }
+  EXPECT_EQ(10, exchange.order);
+  EXPECT_TRUE(exchange.accepted);
+}
+
+// Action server and client using a counting allocator, to check that steady state
+// communication does not allocate.
+class CLASSNAME (TestActionCommunicationAllocation, RMW_IMPLEMENTATION)
+  : public CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION)
+{
+protected:
+  void SetUp() override
+  {
+    CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION)::SetUp();
+    if (HasFatalFailure()) {
+      return;
+    }
+    // Replace the action server and client by ones using the counting allocator.
+    rcl_ret_t ret = rcl_action_server_fini(&this->action_server, &this->node);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    ret = rcl_action_client_fini(&this->action_client, &this->node);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    this->counting_allocator = get_counting_allocator(&this->allocator_state);
+    const rosidl_action_type_support_t * ts = ROSIDL_GET_ACTION_TYPE_SUPPORT(
+      test_msgs, Fibonacci);
+    const char * action_name = "test_action_commmunication_name";
+    rcl_action_server_options_t server_options = rcl_action_server_get_default_options();
+    server_options.allocator = this->counting_allocator;
+    this->action_server = rcl_action_get_zero_initialized_server();
+    ret = rcl_action_server_init(
+      &this->action_server, &this->node, &this->clock, ts, action_name, &server_options);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    rcl_action_client_options_t client_options = rcl_action_client_get_default_options();
+    client_options.allocator = this->counting_allocator;
+    this->action_client = rcl_action_get_zero_initialized_client();
+    ret = rcl_action_client_init(
+      &this->action_client, &this->node, ts, action_name, &client_options);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  }
+
+  counting_allocator_state allocator_state;
+  rcl_allocator_t counting_allocator;
+};
+
+TEST_F(
+  CLASSNAME(TestActionCommunicationAllocation, RMW_IMPLEMENTATION), test_status_comm_no_allocation)
+{
+  action_msgs__msg__GoalStatusArray incoming_status_array;
+  action_msgs__msg__GoalStatusArray__init(&incoming_status_array);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    action_msgs__msg__GoalStatusArray__fini(&incoming_status_array);
+  });
+
+  // Getting the status array allocates by design, as it is sized by the number of goals,
+  // so it is done once up front and only publishing and taking it are checked.
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+  rcl_action_goal_handle_t * goal_handle =
+    rcl_action_accept_new_goal(&this->action_server, &goal_info);
+  ASSERT_NE(goal_handle, nullptr) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_action_goal_handle_fini(goal_handle));
+  });
+  rcl_action_goal_status_array_t status_array =
+    rcl_action_get_zero_initialized_goal_status_array();
+  rcl_ret_t ret = rcl_action_get_goal_status_array(&this->action_server, &status_array);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RCL_RET_OK, rcl_action_goal_status_array_fini(&status_array));
+  });
+
+  // The first iteration warms up, the others must not use the action allocator.
+  size_t warm_allocator_calls = 0u;
+  for (int i = 0; i < 5; ++i) {
+    if (1 == i) {
+      warm_allocator_calls = get_counting_allocator_count(&this->allocator_state);
+    }
+    ret = rcl_action_publish_status(&this->action_server, &status_array.msg);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    ret = rcl_wait_set_clear(&this->wait_set);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    ret = rcl_action_wait_set_add_action_client(
+      &this->wait_set, &this->action_client, NULL, NULL);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    ret = rcl_wait(&this->wait_set, RCL_S_TO_NS(10));
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    ret = rcl_action_client_wait_set_get_entities_ready(
+      &this->wait_set,
+      &this->action_client,
+      &this->is_feedback_ready,
+      &this->is_status_ready,
+      &this->is_goal_response_ready,
+      &this->is_cancel_response_ready,
+      &this->is_result_response_ready);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    ASSERT_TRUE(this->is_status_ready);
+    ret = rcl_action_take_status(&this->action_client, &incoming_status_array);
+    ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+    ASSERT_EQ(status_array.msg.status_list.size, incoming_status_array.status_list.size);
+  }
+  EXPECT_EQ(warm_allocator_calls, get_counting_allocator_count(&this->allocator_state));
+}
@@ -25,11 +25,11 @@ extern "C"
 
 #include "rcl/rcl.h"
 #include "rcl/error_handling.h"
+#include "rcl/tracing.h"
 
 #include "rcutils/logging_macros.h"
 #include "rcutils/macros.h"
 #include "rcutils/strdup.h"
-#include "tracetools/tracetools.h"
 
 #include "rcl_lifecycle/default_state_machine.h"
 #include "rcl_lifecycle/transition_map.h"
@@ -247,7 +247,7 @@ rcl_lifecycle_state_machine_init(
     }
   }
 
-  TRACEPOINT(
+  RCL_TRACEPOINT(
     rcl_lifecycle_state_machine_init,
     (const void *)node_handle,
     (const void *)state_machine);
@@ -370,7 +370,7 @@ _trigger_transition(
     }
   }
 
-  TRACEPOINT(
+  RCL_TRACEPOINT(
     rcl_lifecycle_transition,
     (const void *)state_machine,
     transition->start->label,
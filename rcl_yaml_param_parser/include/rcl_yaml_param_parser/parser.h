@@ -27,6 +27,7 @@
 #ifndef RCL_YAML_PARAM_PARSER__PARSER_H_
 #define RCL_YAML_PARAM_PARSER__PARSER_H_
 
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "rcl_yaml_param_parser/types.h"
@@ -53,6 +54,19 @@ rcl_params_t * rcl_yaml_node_struct_init_with_capacity(
   size_t capacity,
   const rcutils_allocator_t allocator);
 
+/// \brief Initialize parameter structure backed by an arena
+/// Every member of the structure is allocated from chunks of bump storage rather than
+/// individually, and `rcl_yaml_node_struct_fini()` releases them at once.
+/// The allocator of the structure is then the arena allocator, which must be used for
+/// `rcl_yaml_node_struct_reallocate()`.
+/// \param[in] chunk_size size in bytes of the arena chunks, or 0 for a default size
+/// \param[in] allocator memory allocator to be used for the arena chunks
+/// \return a pointer to param structure on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_node_struct_init_with_arena(
+  size_t chunk_size,
+  const rcutils_allocator_t allocator);
+
 /// \brief Reallocate parameter structure with a new capacity
 /// \post the address of \p node_names in \p params_st might be changed
 ///   even if the result value is `RCL_RET_BAD_ALLOC`.
@@ -77,6 +91,20 @@ RCL_YAML_PARAM_PARSER_PUBLIC
 rcl_params_t * rcl_yaml_node_struct_copy(
   const rcl_params_t * params_st);
 
+/// \brief Share parameter structure
+/// Rather than being duplicated like by `rcl_yaml_node_struct_copy()`, the members of
+/// \p params_st are shared with the returned structure through a reference count.
+/// Either structure gets its own copy of the members, as needed, when modified through
+/// `rcl_parse_yaml_file()`, `rcl_parse_yaml_value()`, `rcl_yaml_node_struct_reallocate()`
+/// or `rcl_yaml_node_struct_get()`, so members must not be modified directly while shared.
+/// Only the reference count of \p params_st is written, atomically, so it may be shared
+/// concurrently from several threads.
+/// \param[in] params_st points to the parameter struct to be shared
+/// \return a pointer to the sharing param structure on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_node_struct_share(
+  rcl_params_t * params_st);
+
 /// \brief Free parameter structure
 /// \param[in] params_st points to the populated parameter struct
 RCL_YAML_PARAM_PARSER_PUBLIC
@@ -94,6 +122,23 @@ bool rcl_parse_yaml_file(
   const char * file_path,
   rcl_params_t * params_st);
 
+/// \brief Parse the YAML file and populate \p params_st with the parameters of the given nodes
+/// Parameters of nodes whose name, wildcards included, matches none of the given node fully
+/// qualified names are skipped without being processed.
+/// \pre Given \p params_st must be a valid parameter struct
+///   as returned by `rcl_yaml_node_struct_init()`
+/// \param[in] file_path is the path to the YAML file
+/// \param[in] node_fqns is an array of node fully qualified names, e.g. `/ns/node`
+/// \param[in] num_node_fqns is the number of node fully qualified names in \p node_fqns
+/// \param[inout] params_st points to the struct to be populated
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_parse_yaml_file_for_nodes(
+  const char * file_path,
+  const char * const * node_fqns,
+  size_t num_node_fqns,
+  rcl_params_t * params_st);
+
 /// \brief Parse a parameter value as a YAML string, updating params_st accordingly
 /// \param[in] node_name is the name of the node to which the parameter belongs
 /// \param[in] param_name is the name of the parameter whose value will be parsed
@@ -109,6 +154,9 @@ bool rcl_parse_yaml_value(
 
 /// \brief Get the variant value for a given parameter, zero initializing it in the
 /// process if not present already
+/// The returned value may be modified in place, so a structure shared with
+/// `rcl_yaml_node_struct_share()` or loaded from a cache first gets its own copy of the
+/// members; use `rcl_yaml_node_struct_find()` to only read a parameter.
 /// \param[in] node_name is the name of the node to which the parameter belongs
 /// \param[in] param_name is the name of the parameter whose value is to be retrieved
 /// \param[inout] params_st points to the populated (or to be populated) parameter struct
@@ -119,12 +167,118 @@ rcl_variant_t * rcl_yaml_node_struct_get(
   const char * param_name,
   rcl_params_t * params_st);
 
+/// \brief Find the variant value of a given parameter, without adding it if not present
+/// The structure is left untouched, members shared with `rcl_yaml_node_struct_share()`
+/// or loaded from a cache included.
+/// \param[in] node_name is the name of the node to which the parameter belongs
+/// \param[in] param_name is the name of the parameter whose value is to be found
+/// \param[in] params_st points to the populated parameter struct
+/// \return parameter variant value if present, or NULL otherwise or on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+const rcl_variant_t * rcl_yaml_node_struct_find(
+  const char * node_name,
+  const char * param_name,
+  const rcl_params_t * params_st);
+
 /// \brief Print the parameter structure to stdout
 /// \param[in] params_st points to the populated parameter struct
 RCL_YAML_PARAM_PARSER_PUBLIC
 void rcl_yaml_node_struct_print(
   const rcl_params_t * const params_st);
 
+/// \brief Compute the hash of a YAML parameter file's contents
+/// The hash is meant to validate a binary parameter cache against its source file.
+/// \param[in] file_path is the path to the YAML file
+/// \param[out] hash is the 64 bits hash of the file contents
+/// \return `RCUTILS_RET_OK` if the hash was computed successfully, or
+/// \return `RCUTILS_RET_INVALID_ARGUMENT` if any argument is NULL, or
+/// \return `RCUTILS_RET_ERROR` if the file could not be read.
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcutils_ret_t rcl_yaml_file_hash(
+  const char * file_path,
+  uint64_t * hash);
+
+/// \brief Serialize a parameter structure into a binary image
+/// The image is versioned and position independent: it holds a string table,
+/// typed value arrays and a node and parameter index, all addressed by offsets.
+/// \param[in] params_st points to the parameter struct to be serialized
+/// \param[in] source_hash is the hash of the source the structure was parsed from
+/// \param[out] image is the serialized image, allocated with the allocator of \p params_st
+/// \param[out] image_size is the size in bytes of the serialized image
+/// \return `RCUTILS_RET_OK` if the structure was serialized successfully, or
+/// \return `RCUTILS_RET_INVALID_ARGUMENT` if any argument is NULL, or
+/// \return `RCUTILS_RET_BAD_ALLOC` if allocating memory failed.
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcutils_ret_t rcl_yaml_node_struct_serialize(
+  const rcl_params_t * params_st,
+  uint64_t source_hash,
+  uint8_t ** image,
+  size_t * image_size);
+
+/// \brief Hydrate a parameter structure from a binary image
+/// Every name, array and value of the returned structure is backed by a single allocation.
+/// The structure may still be modified, e.g. by `rcl_parse_yaml_value()`, in which case
+/// its members are first moved to individual allocations.
+/// \param[in] image is the serialized image, as produced by `rcl_yaml_node_struct_serialize()`,
+///   at an 8 bytes aligned address
+/// \param[in] image_size is the size in bytes of \p image
+/// \param[in] source_hash is the expected hash of the source the image was produced from
+/// \param[in] allocator memory allocator to be used
+/// \return a pointer to param structure on success or NULL if the image is invalid,
+///   stale or memory could not be allocated
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_node_struct_deserialize(
+  const uint8_t * image,
+  size_t image_size,
+  uint64_t source_hash,
+  const rcutils_allocator_t allocator);
+
+/// \brief Write a parameter structure to a binary cache file
+/// The image is written to a temporary file in the same directory, which is then renamed
+/// over the cache file, so processes which loaded the previous cache are not affected.
+/// \param[in] params_st points to the parameter struct to be cached
+/// \param[in] source_hash is the hash of the source the structure was parsed from
+/// \param[in] cache_path is the path to the cache file
+/// \return `RCUTILS_RET_OK` if the cache file was written successfully, or
+/// \return `RCUTILS_RET_INVALID_ARGUMENT` if any argument is NULL, or
+/// \return `RCUTILS_RET_BAD_ALLOC` if allocating memory failed, or
+/// \return `RCUTILS_RET_ERROR` if the cache file could not be written.
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcutils_ret_t rcl_yaml_node_struct_write_cache(
+  const rcl_params_t * params_st,
+  uint64_t source_hash,
+  const char * cache_path);
+
+/// \brief Load a parameter structure from a binary cache file
+/// The file is memory mapped where supported and hydrated with a single allocation,
+/// see `rcl_yaml_node_struct_deserialize()`.
+/// \param[in] cache_path is the path to the cache file
+/// \param[in] source_hash is the expected hash of the source the cache was produced from
+/// \param[in] allocator memory allocator to be used
+/// \return a pointer to param structure on success or NULL if the cache is missing,
+///   invalid, stale or memory could not be allocated
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_node_struct_load_cache(
+  const char * cache_path,
+  uint64_t source_hash,
+  const rcutils_allocator_t allocator);
+
+/// \brief Parse the YAML file through a binary cache and populate \p params_st
+/// The cache is used if it matches the hash of the YAML file, otherwise the YAML file
+/// is parsed and the cache is (re)written.
+/// Failing to write the cache is not an error.
+/// \pre Given \p params_st must be a valid parameter struct
+///   as returned by `rcl_yaml_node_struct_init()`
+/// \param[in] file_path is the path to the YAML file
+/// \param[in] cache_path is the path to the cache file
+/// \param[inout] params_st points to the struct to be populated
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_parse_yaml_file_with_cache(
+  const char * file_path,
+  const char * cache_path,
+  rcl_params_t * params_st);
+
 #ifdef __cplusplus
 }
 #endif
@@ -95,6 +95,9 @@ typedef struct rcl_node_params_s
   size_t capacity_params;  ///< Capacity of parameters in the node
 } rcl_node_params_t;
 
+/// Private implementation of a parameter structure
+struct rcl_params_impl_s;
+
 /// stores all the parameters of all nodes of a process
 /*
 * \typedef rcl_params_t
@@ -106,6 +109,9 @@ typedef struct rcl_params_s
   size_t num_nodes;       ///< Number of nodes
   size_t capacity_nodes;  ///< Capacity of nodes
   rcutils_allocator_t allocator;  ///< Allocator used
+  /// Private implementation pointer, NULL if every member is individually allocated and
+  /// owned by this structure only
+  struct rcl_params_impl_s * impl;
 } rcl_params_t;
 
 #endif  // RCL_YAML_PARAM_PARSER__TYPES_H_
@@ -0,0 +1,74 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMPL__PARAMS_ARENA_H_
+#define IMPL__PARAMS_ARENA_H_
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types.h"
+
+#include "rcl_yaml_param_parser/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PARAMS_ARENA_DEFAULT_CHUNK_SIZE 16384U
+
+typedef struct params_arena_chunk_s params_arena_chunk_t;
+
+/// Chunked bump storage, every allocation of which is released at once
+typedef struct params_arena_s
+{
+  /// Allocator the chunks are allocated with
+  rcutils_allocator_t allocator;
+  /// Chunks, the one being bumped through first
+  params_arena_chunk_t * chunks;
+  /// Size of a regular chunk, larger allocations get a chunk of their own
+  size_t chunk_size;
+} params_arena_t;
+
+///
+/// Create an arena with chunks of chunk_size bytes, or of a default size if 0
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+params_arena_t * params_arena_init(
+  size_t chunk_size,
+  const rcutils_allocator_t allocator);
+
+///
+/// Get an allocator allocating from an arena. Deallocation only reclaims memory
+/// of the last allocation made, which reallocation also grows in place if possible
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_allocator_t params_arena_get_allocator(
+  params_arena_t * arena);
+
+///
+/// Release every allocation of an arena, then the arena itself
+///
+RCL_YAML_PARAM_PARSER_PUBLIC
+void params_arena_fini(
+  params_arena_t * arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // IMPL__PARAMS_ARENA_H_
@@ -0,0 +1,53 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// NOTE: Only to be included from C sources, the reference count is a C11 atomic
+
+#ifndef IMPL__PARAMS_IMPL_H_
+#define IMPL__PARAMS_IMPL_H_
+
+#include "rcutils/allocator.h"
+#include "rcutils/stdatomic_helper.h"
+
+#include "rcl_yaml_param_parser/types.h"
+
+#include "./params_arena.h"
+
+/// Private state of a parameter structure, shared by all of its copies
+typedef struct rcl_params_impl_s
+{
+  /// Single allocation backing every name, array and value of the structure,
+  /// or NULL if they are individually allocated.
+  /// If not NULL, the implementation struct itself lives at the start of this allocation.
+  void * storage;
+  /// Arena every name, array and value of the structure is allocated from, or NULL.
+  /// If not NULL, the implementation struct itself is allocated from the arena.
+  params_arena_t * arena;
+  /// Number of parameter structures sharing the members
+  atomic_uint_least64_t ref_count;
+} rcl_params_impl_t;
+
+///
+/// Get the allocator of the structure itself, which outlives the arena of its members if any
+///
+static inline rcutils_allocator_t
+get_params_st_allocator(const rcl_params_t * params_st)
+{
+  if (NULL != params_st->impl && NULL != params_st->impl->arena) {
+    return params_st->impl->arena->allocator;
+  }
+  return params_st->allocator;
+}
+
+#endif  // IMPL__PARAMS_IMPL_H_
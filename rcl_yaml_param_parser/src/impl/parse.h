@@ -64,6 +64,27 @@ rcutils_ret_t parse_file_events(
   namespace_tracker_t * ns_tracker,
   rcl_params_t * params_st);
 
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t parse_file_events_for_nodes(
+  yaml_parser_t * parser,
+  namespace_tracker_t * ns_tracker,
+  const char * const * node_fqns,
+  const size_t num_node_fqns,
+  rcl_params_t * params_st);
+
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+bool node_name_matches(
+  const char * node_name,
+  const char * node_fqn);
+
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t skip_value_events(
+  yaml_parser_t * parser,
+  const uint32_t line_num);
+
 RCL_YAML_PARAM_PARSER_PUBLIC
 RCUTILS_WARN_UNUSED
 rcutils_ret_t parse_value_events(
@@ -87,6 +108,11 @@ rcutils_ret_t find_parameter(
   rcl_params_t * param_st,
   size_t * parameter_idx);
 
+RCL_YAML_PARAM_PARSER_PUBLIC
+RCUTILS_WARN_UNUSED
+rcutils_ret_t make_params_modifiable(
+  rcl_params_t * params_st);
+
 #ifdef __cplusplus
 }
 #endif
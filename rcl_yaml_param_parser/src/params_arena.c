@@ -0,0 +1,195 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+
+#include "./impl/params_arena.h"
+
+/// Every allocation is aligned for any type, and preceded by its size
+#define ARENA_ALIGNMENT ((size_t)_Alignof(max_align_t))
+#define ARENA_ALIGN_SIZE(size) (((size) + ARENA_ALIGNMENT - 1U) & ~(ARENA_ALIGNMENT - 1U))
+#define ARENA_HEADER_SIZE ARENA_ALIGN_SIZE(sizeof(size_t))
+#define ARENA_MAX_ALLOCATION_SIZE (SIZE_MAX / 2U)
+
+struct params_arena_chunk_s
+{
+  params_arena_chunk_t * next;
+  size_t size;
+  size_t used;
+};
+
+static uint8_t *
+_chunk_data(params_arena_chunk_t * chunk)
+{
+  return (uint8_t *)chunk + ARENA_ALIGN_SIZE(sizeof(params_arena_chunk_t));
+}
+
+static size_t
+_allocation_size(const void * pointer)
+{
+  return *(const size_t *)((const uint8_t *)pointer - ARENA_HEADER_SIZE);
+}
+
+///
+/// Check whether an allocation is the last one made in the current chunk
+///
+static bool
+_is_last_allocation(params_arena_t * arena, const void * pointer)
+{
+  params_arena_chunk_t * chunk = arena->chunks;
+  return NULL != chunk &&
+         (const uint8_t *)pointer + ARENA_ALIGN_SIZE(_allocation_size(pointer)) ==
+         _chunk_data(chunk) + chunk->used;
+}
+
+static void *
+_arena_allocate(size_t size, void * state)
+{
+  params_arena_t * arena = (params_arena_t *)state;
+  if (size > ARENA_MAX_ALLOCATION_SIZE) {
+    return NULL;
+  }
+  const size_t needed = ARENA_HEADER_SIZE + ARENA_ALIGN_SIZE(size);
+  params_arena_chunk_t * chunk = arena->chunks;
+  if (NULL == chunk || chunk->size - chunk->used < needed) {
+    const size_t chunk_size = needed > arena->chunk_size ? needed : arena->chunk_size;
+    chunk = arena->allocator.allocate(
+      ARENA_ALIGN_SIZE(sizeof(params_arena_chunk_t)) + chunk_size, arena->allocator.state);
+    if (NULL == chunk) {
+      return NULL;
+    }
+    chunk->size = chunk_size;
+    chunk->used = 0U;
+    if (NULL != arena->chunks && chunk_size > arena->chunk_size) {
+      // Keep bumping through the current chunk, this one is already full
+      chunk->next = arena->chunks->next;
+      arena->chunks->next = chunk;
+    } else {
+      chunk->next = arena->chunks;
+      arena->chunks = chunk;
+    }
+  }
+  uint8_t * header = _chunk_data(chunk) + chunk->used;
+  chunk->used += needed;
+  *(size_t *)header = size;
+  return header + ARENA_HEADER_SIZE;
+}
+
+static void
+_arena_deallocate(void * pointer, void * state)
+{
+  params_arena_t * arena = (params_arena_t *)state;
+  if (NULL == pointer) {
+    return;
+  }
+  if (_is_last_allocation(arena, pointer)) {
+    arena->chunks->used -= ARENA_HEADER_SIZE + ARENA_ALIGN_SIZE(_allocation_size(pointer));
+  }
+}
+
+static void *
+_arena_reallocate(void * pointer, size_t size, void * state)
+{
+  params_arena_t * arena = (params_arena_t *)state;
+  if (NULL == pointer) {
+    return _arena_allocate(size, state);
+  }
+  if (size > ARENA_MAX_ALLOCATION_SIZE) {
+    return NULL;
+  }
+  const size_t old_size = _allocation_size(pointer);
+  if (_is_last_allocation(arena, pointer)) {
+    params_arena_chunk_t * chunk = arena->chunks;
+    const size_t offset = (size_t)((uint8_t *)pointer - _chunk_data(chunk));
+    if (chunk->size - offset >= ARENA_ALIGN_SIZE(size)) {
+      // Grow or shrink in place
+      chunk->used = offset + ARENA_ALIGN_SIZE(size);
+      *(size_t *)((uint8_t *)pointer - ARENA_HEADER_SIZE) = size;
+      return pointer;
+    }
+  }
+  if (size <= old_size) {
+    return pointer;
+  }
+  void * new_pointer = _arena_allocate(size, state);
+  if (NULL == new_pointer) {
+    return NULL;
+  }
+  memcpy(new_pointer, pointer, old_size);
+  return new_pointer;
+}
+
+static void *
+_arena_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (0U != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  const size_t size = number_of_elements * size_of_element;
+  void * pointer = _arena_allocate(size, state);
+  if (NULL != pointer) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+params_arena_t * params_arena_init(
+  size_t chunk_size,
+  const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return NULL);
+  params_arena_t * arena = allocator.allocate(sizeof(params_arena_t), allocator.state);
+  if (NULL == arena) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters arena");
+    return NULL;
+  }
+  arena->allocator = allocator;
+  arena->chunks = NULL;
+  arena->chunk_size = 0U == chunk_size ? PARAMS_ARENA_DEFAULT_CHUNK_SIZE : chunk_size;
+  return arena;
+}
+
+rcutils_allocator_t params_arena_get_allocator(
+  params_arena_t * arena)
+{
+  rcutils_allocator_t allocator = rcutils_get_zero_initialized_allocator();
+  allocator.allocate = _arena_allocate;
+  allocator.deallocate = _arena_deallocate;
+  allocator.reallocate = _arena_reallocate;
+  allocator.zero_allocate = _arena_zero_allocate;
+  allocator.state = arena;
+  return allocator;
+}
+
+void params_arena_fini(
+  params_arena_t * arena)
+{
+  if (NULL == arena) {
+    return;
+  }
+  rcutils_allocator_t allocator = arena->allocator;
+  params_arena_chunk_t * chunk = arena->chunks;
+  while (NULL != chunk) {
+    params_arena_chunk_t * next = chunk->next;
+    allocator.deallocate(chunk, allocator.state);
+    chunk = next;
+  }
+  allocator.deallocate(arena, allocator.state);
+}
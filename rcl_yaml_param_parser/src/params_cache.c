@@ -0,0 +1,920 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// mkstemp(), fchmod() and fdopen() are POSIX, not standard C
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+# define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <io.h>
+#include <windows.h>
+#endif
+
+#include "rcl_yaml_param_parser/parser.h"
+#include "rcl_yaml_param_parser/types.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/format_string.h"
+#include "rcutils/types.h"
+
+#include "./impl/node_params.h"
+#include "./impl/params_impl.h"
+#include "./impl/parse.h"
+#include "./impl/types.h"
+#include "./impl/yaml_variant.h"
+
+/// Binary image layout, all offsets are relative to the start of the image:
+///
+///   params_image_header_t
+///   params_image_node_t[num_nodes]    node index, names and parameter ranges
+///   params_image_param_t[num_params]  parameter index, names and typed values
+///   values section                    array values, 8 bytes aligned
+///   strings section                   NUL terminated strings
+
+#define PARAMS_IMAGE_MAGIC "RCLP"
+#define PARAMS_IMAGE_VERSION 1U
+#define PARAMS_IMAGE_BYTE_ORDER 0x01020304U
+#define PARAMS_IMAGE_ALIGNMENT 8U
+
+#define FNV1A_64_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV1A_64_PRIME 0x100000001b3ULL
+
+#define ALIGN_SIZE(size) \
+  (((size) + (PARAMS_IMAGE_ALIGNMENT - 1U)) & ~((size_t)PARAMS_IMAGE_ALIGNMENT - 1U))
+
+typedef enum params_image_type_e
+{
+  PARAMS_IMAGE_TYPE_NONE = 0U,
+  PARAMS_IMAGE_TYPE_BOOL = 1U,
+  PARAMS_IMAGE_TYPE_INT64 = 2U,
+  PARAMS_IMAGE_TYPE_DOUBLE = 3U,
+  PARAMS_IMAGE_TYPE_STRING = 4U,
+  PARAMS_IMAGE_TYPE_BYTE_ARRAY = 5U,
+  PARAMS_IMAGE_TYPE_BOOL_ARRAY = 6U,
+  PARAMS_IMAGE_TYPE_INT64_ARRAY = 7U,
+  PARAMS_IMAGE_TYPE_DOUBLE_ARRAY = 8U,
+  PARAMS_IMAGE_TYPE_STRING_ARRAY = 9U
+} params_image_type_t;
+
+typedef struct params_image_header_s
+{
+  char magic[4];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t header_size;
+  /// Hash of the source the image was produced from
+  uint64_t source_hash;
+  /// Hash of everything past the header
+  uint64_t checksum;
+  uint64_t image_size;
+  uint64_t num_nodes;
+  uint64_t num_params;
+  uint64_t nodes_offset;
+  uint64_t params_offset;
+  uint64_t values_offset;
+  uint64_t values_size;
+  uint64_t strings_offset;
+  uint64_t strings_size;
+} params_image_header_t;
+
+typedef struct params_image_node_s
+{
+  uint64_t name;
+  uint64_t first_param;
+  uint64_t num_params;
+} params_image_node_t;
+
+typedef struct params_image_param_s
+{
+  uint64_t name;
+  uint32_t type;
+  uint32_t reserved;
+  /// Number of elements for arrays, unused otherwise
+  uint64_t count;
+  /// Scalar value bits, string offset, or offset in the values section for arrays
+  uint64_t value;
+} params_image_param_t;
+
+static uint64_t
+_fnv1a_64(uint64_t hash, const uint8_t * data, size_t size)
+{
+  for (size_t i = 0U; i < size; ++i) {
+    hash ^= data[i];
+    hash *= FNV1A_64_PRIME;
+  }
+  return hash;
+}
+
+rcutils_ret_t rcl_yaml_file_hash(
+  const char * file_path,
+  uint64_t * hash)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(file_path, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(hash, RCUTILS_RET_INVALID_ARGUMENT);
+
+  FILE * file = fopen(file_path, "rb");
+  if (NULL == file) {
+    RCUTILS_SET_ERROR_MSG("Error opening YAML file");
+    return RCUTILS_RET_ERROR;
+  }
+  uint8_t buffer[4096];
+  uint64_t value = FNV1A_64_OFFSET_BASIS;
+  size_t read_size = 0U;
+  while (0U != (read_size = fread(buffer, 1U, sizeof(buffer), file))) {
+    value = _fnv1a_64(value, buffer, read_size);
+  }
+  const bool failed = (0 != ferror(file));
+  fclose(file);
+  if (failed) {
+    RCUTILS_SET_ERROR_MSG("Error reading YAML file");
+    return RCUTILS_RET_ERROR;
+  }
+  *hash = value;
+  return RCUTILS_RET_OK;
+}
+
+static size_t
+_string_size(const char * str)
+{
+  return NULL == str ? 0U : strlen(str) + 1U;
+}
+
+/// Compute the sizes of the values and strings sections needed by a variant
+static void
+_variant_image_sizes(
+  const rcl_variant_t * param_var,
+  size_t * values_size,
+  size_t * strings_size)
+{
+  if (NULL != param_var->string_value) {
+    *strings_size += _string_size(param_var->string_value);
+  } else if (NULL != param_var->byte_array_value) {
+    *values_size += ALIGN_SIZE(param_var->byte_array_value->size);
+  } else if (NULL != param_var->bool_array_value) {
+    *values_size += ALIGN_SIZE(param_var->bool_array_value->size);
+  } else if (NULL != param_var->integer_array_value) {
+    *values_size += param_var->integer_array_value->size * sizeof(int64_t);
+  } else if (NULL != param_var->double_array_value) {
+    *values_size += param_var->double_array_value->size * sizeof(double);
+  } else if (NULL != param_var->string_array_value) {
+    *values_size += param_var->string_array_value->size * sizeof(uint64_t);
+    for (size_t i = 0U; i < param_var->string_array_value->size; ++i) {
+      *strings_size += _string_size(param_var->string_array_value->data[i]);
+    }
+  }
+}
+
+typedef struct params_image_writer_s
+{
+  uint8_t * image;
+  size_t values_offset;
+  size_t values_cursor;
+  size_t strings_offset;
+  size_t strings_cursor;
+} params_image_writer_t;
+
+static uint64_t
+_write_string(params_image_writer_t * writer, const char * str)
+{
+  const size_t size = _string_size(str);
+  const uint64_t offset = writer->strings_cursor;
+  if (0U != size) {
+    memcpy(writer->image + writer->strings_offset + writer->strings_cursor, str, size);
+  }
+  writer->strings_cursor += size;
+  return offset;
+}
+
+static uint64_t
+_write_values(params_image_writer_t * writer, const void * values, size_t size)
+{
+  const uint64_t offset = writer->values_cursor;
+  if (0U != size) {
+    memcpy(writer->image + writer->values_offset + writer->values_cursor, values, size);
+  }
+  writer->values_cursor += ALIGN_SIZE(size);
+  return offset;
+}
+
+static void
+_write_variant(
+  params_image_writer_t * writer,
+  const rcl_variant_t * param_var,
+  params_image_param_t * entry)
+{
+  if (NULL != param_var->bool_value) {
+    entry->type = PARAMS_IMAGE_TYPE_BOOL;
+    entry->value = *(param_var->bool_value) ? 1U : 0U;
+  } else if (NULL != param_var->integer_value) {
+    entry->type = PARAMS_IMAGE_TYPE_INT64;
+    memcpy(&entry->value, param_var->integer_value, sizeof(int64_t));
+  } else if (NULL != param_var->double_value) {
+    entry->type = PARAMS_IMAGE_TYPE_DOUBLE;
+    memcpy(&entry->value, param_var->double_value, sizeof(double));
+  } else if (NULL != param_var->string_value) {
+    entry->type = PARAMS_IMAGE_TYPE_STRING;
+    entry->value = _write_string(writer, param_var->string_value);
+  } else if (NULL != param_var->byte_array_value) {
+    entry->type = PARAMS_IMAGE_TYPE_BYTE_ARRAY;
+    entry->count = param_var->byte_array_value->size;
+    entry->value = _write_values(
+      writer, param_var->byte_array_value->values, param_var->byte_array_value->size);
+  } else if (NULL != param_var->bool_array_value) {
+    entry->type = PARAMS_IMAGE_TYPE_BOOL_ARRAY;
+    entry->count = param_var->bool_array_value->size;
+    entry->value = writer->values_cursor;
+    uint8_t * values = writer->image + writer->values_offset + writer->values_cursor;
+    for (size_t i = 0U; i < param_var->bool_array_value->size; ++i) {
+      values[i] = param_var->bool_array_value->values[i] ? 1U : 0U;
+    }
+    writer->values_cursor += ALIGN_SIZE(param_var->bool_array_value->size);
+  } else if (NULL != param_var->integer_array_value) {
+    entry->type = PARAMS_IMAGE_TYPE_INT64_ARRAY;
+    entry->count = param_var->integer_array_value->size;
+    entry->value = _write_values(
+      writer, param_var->integer_array_value->values,
+      param_var->integer_array_value->size * sizeof(int64_t));
+  } else if (NULL != param_var->double_array_value) {
+    entry->type = PARAMS_IMAGE_TYPE_DOUBLE_ARRAY;
+    entry->count = param_var->double_array_value->size;
+    entry->value = _write_values(
+      writer, param_var->double_array_value->values,
+      param_var->double_array_value->size * sizeof(double));
+  } else if (NULL != param_var->string_array_value) {
+    entry->type = PARAMS_IMAGE_TYPE_STRING_ARRAY;
+    entry->count = param_var->string_array_value->size;
+    entry->value = writer->values_cursor;
+    uint64_t * offsets =
+      (uint64_t *)(writer->image + writer->values_offset + writer->values_cursor);
+    for (size_t i = 0U; i < param_var->string_array_value->size; ++i) {
+      offsets[i] = _write_string(writer, param_var->string_array_value->data[i]);
+    }
+    writer->values_cursor += param_var->string_array_value->size * sizeof(uint64_t);
+  } else {
+    entry->type = PARAMS_IMAGE_TYPE_NONE;
+  }
+}
+
+rcutils_ret_t rcl_yaml_node_struct_serialize(
+  const rcl_params_t * params_st,
+  uint64_t source_hash,
+  uint8_t ** image,
+  size_t * image_size)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(image, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(image_size, RCUTILS_RET_INVALID_ARGUMENT);
+  rcutils_allocator_t allocator = params_st->allocator;
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    &allocator, "invalid allocator", return RCUTILS_RET_INVALID_ARGUMENT);
+
+  size_t num_params = 0U;
+  size_t values_size = 0U;
+  size_t strings_size = 0U;
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; ++node_idx) {
+    const rcl_node_params_t * node_params_st = &(params_st->params[node_idx]);
+    strings_size += _string_size(params_st->node_names[node_idx]);
+    num_params += node_params_st->num_params;
+    for (size_t parameter_idx = 0U; parameter_idx < node_params_st->num_params; ++parameter_idx) {
+      strings_size += _string_size(node_params_st->parameter_names[parameter_idx]);
+      _variant_image_sizes(
+        &(node_params_st->parameter_values[parameter_idx]), &values_size, &strings_size);
+    }
+  }
+
+  params_image_writer_t writer;
+  const size_t nodes_offset = sizeof(params_image_header_t);
+  const size_t params_offset = nodes_offset + params_st->num_nodes * sizeof(params_image_node_t);
+  writer.values_offset = params_offset + num_params * sizeof(params_image_param_t);
+  writer.values_cursor = 0U;
+  writer.strings_offset = writer.values_offset + values_size;
+  writer.strings_cursor = 0U;
+  const size_t total_size = writer.strings_offset + strings_size;
+
+  writer.image = allocator.zero_allocate(1U, total_size, allocator.state);
+  if (NULL == writer.image) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters image");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
+  params_image_node_t * nodes = (params_image_node_t *)(writer.image + nodes_offset);
+  params_image_param_t * params = (params_image_param_t *)(writer.image + params_offset);
+  size_t param_entry_idx = 0U;
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; ++node_idx) {
+    const rcl_node_params_t * node_params_st = &(params_st->params[node_idx]);
+    nodes[node_idx].name = _write_string(&writer, params_st->node_names[node_idx]);
+    nodes[node_idx].first_param = param_entry_idx;
+    nodes[node_idx].num_params = node_params_st->num_params;
+    for (size_t parameter_idx = 0U; parameter_idx < node_params_st->num_params; ++parameter_idx) {
+      params_image_param_t * entry = &(params[param_entry_idx++]);
+      entry->name = _write_string(&writer, node_params_st->parameter_names[parameter_idx]);
+      _write_variant(&writer, &(node_params_st->parameter_values[parameter_idx]), entry);
+    }
+  }
+
+  params_image_header_t * header = (params_image_header_t *)writer.image;
+  memcpy(header->magic, PARAMS_IMAGE_MAGIC, sizeof(header->magic));
+  header->version = PARAMS_IMAGE_VERSION;
+  header->byte_order = PARAMS_IMAGE_BYTE_ORDER;
+  header->header_size = (uint32_t)sizeof(params_image_header_t);
+  header->source_hash = source_hash;
+  header->image_size = total_size;
+  header->num_nodes = params_st->num_nodes;
+  header->num_params = num_params;
+  header->nodes_offset = nodes_offset;
+  header->params_offset = params_offset;
+  header->values_offset = writer.values_offset;
+  header->values_size = values_size;
+  header->strings_offset = writer.strings_offset;
+  header->strings_size = strings_size;
+  header->checksum = _fnv1a_64(
+    FNV1A_64_OFFSET_BASIS, writer.image + nodes_offset, total_size - nodes_offset);
+
+  *image = writer.image;
+  *image_size = total_size;
+  return RCUTILS_RET_OK;
+}
+
+/// Check a string offset lies in the strings section, which is known to be NUL terminated
+static bool
+_valid_string(const params_image_header_t * header, uint64_t offset)
+{
+  return offset < header->strings_size;
+}
+
+/// Check an array lies in the values section, aligned as the writer leaves it
+static bool
+_valid_array(const params_image_header_t * header, const params_image_param_t * entry, size_t elem)
+{
+  if (0U != entry->value % PARAMS_IMAGE_ALIGNMENT ||
+    entry->value > header->values_size || entry->count > header->values_size / elem)
+  {
+    return false;
+  }
+  return entry->count * elem <= header->values_size - entry->value;
+}
+
+/// Validate an image and compute the size of its hydrated storage
+static bool
+_validate_image(
+  const uint8_t * image,
+  size_t image_size,
+  uint64_t source_hash,
+  size_t * storage_size)
+{
+  if (image_size < sizeof(params_image_header_t)) {
+    RCUTILS_SET_ERROR_MSG("Parameters image is truncated");
+    return false;
+  }
+  // Sections and arrays are read in place as 8 bytes words
+  if (0U != (uintptr_t)image % PARAMS_IMAGE_ALIGNMENT) {
+    RCUTILS_SET_ERROR_MSG("Parameters image is misaligned");
+    return false;
+  }
+  const params_image_header_t * header = (const params_image_header_t *)image;
+  if (0 != memcmp(header->magic, PARAMS_IMAGE_MAGIC, sizeof(header->magic)) ||
+    PARAMS_IMAGE_BYTE_ORDER != header->byte_order ||
+    sizeof(params_image_header_t) != header->header_size)
+  {
+    RCUTILS_SET_ERROR_MSG("Not a parameters image");
+    return false;
+  }
+  if (PARAMS_IMAGE_VERSION != header->version) {
+    RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Unsupported parameters image version %u", header->version);
+    return false;
+  }
+  if (source_hash != header->source_hash) {
+    RCUTILS_SET_ERROR_MSG("Parameters image is stale");
+    return false;
+  }
+  // Sections are laid out back to back, check them in order to rule out overflows
+  if (header->image_size != image_size ||
+    header->nodes_offset != sizeof(params_image_header_t) ||
+    header->num_nodes > (image_size - header->nodes_offset) / sizeof(params_image_node_t) ||
+    header->params_offset != header->nodes_offset +
+    header->num_nodes * sizeof(params_image_node_t) ||
+    header->num_params > (image_size - header->params_offset) / sizeof(params_image_param_t) ||
+    header->values_offset != header->params_offset +
+    header->num_params * sizeof(params_image_param_t) ||
+    header->values_size > image_size - header->values_offset ||
+    header->strings_offset != header->values_offset + header->values_size ||
+    header->strings_size != image_size - header->strings_offset)
+  {
+    RCUTILS_SET_ERROR_MSG("Parameters image is corrupted");
+    return false;
+  }
+  const uint64_t checksum = _fnv1a_64(
+    FNV1A_64_OFFSET_BASIS, image + header->nodes_offset, image_size - header->nodes_offset);
+  if (checksum != header->checksum) {
+    RCUTILS_SET_ERROR_MSG("Parameters image checksum mismatch");
+    return false;
+  }
+  if (0U != header->strings_size && '\0' != image[image_size - 1U]) {
+    RCUTILS_SET_ERROR_MSG("Parameters image is corrupted");
+    return false;
+  }
+
+  const params_image_node_t * nodes =
+    (const params_image_node_t *)(image + header->nodes_offset);
+  const params_image_param_t * params =
+    (const params_image_param_t *)(image + header->params_offset);
+  const size_t capacity_nodes = 0U == header->num_nodes ? 1U : header->num_nodes;
+  size_t size = ALIGN_SIZE(sizeof(rcl_params_impl_t)) +
+    ALIGN_SIZE(capacity_nodes * sizeof(char *)) +
+    ALIGN_SIZE(capacity_nodes * sizeof(rcl_node_params_t)) +
+    ALIGN_SIZE(header->strings_size);
+  for (size_t node_idx = 0U; node_idx < header->num_nodes; ++node_idx) {
+    const params_image_node_t * node = &(nodes[node_idx]);
+    if (!_valid_string(header, node->name) ||
+      node->first_param > header->num_params ||
+      node->num_params > header->num_params - node->first_param)
+    {
+      RCUTILS_SET_ERROR_MSG("Parameters image is corrupted");
+      return false;
+    }
+    const size_t capacity_params = 0U == node->num_params ? 1U : node->num_params;
+    size += ALIGN_SIZE(capacity_params * sizeof(char *)) +
+      ALIGN_SIZE(capacity_params * sizeof(rcl_variant_t));
+  }
+  for (size_t param_idx = 0U; param_idx < header->num_params; ++param_idx) {
+    const params_image_param_t * entry = &(params[param_idx]);
+    bool valid = _valid_string(header, entry->name);
+    switch (entry->type) {
+      case PARAMS_IMAGE_TYPE_NONE:
+        break;
+      case PARAMS_IMAGE_TYPE_BOOL:
+        size += ALIGN_SIZE(sizeof(bool));
+        break;
+      case PARAMS_IMAGE_TYPE_INT64:
+        size += ALIGN_SIZE(sizeof(int64_t));
+        break;
+      case PARAMS_IMAGE_TYPE_DOUBLE:
+        size += ALIGN_SIZE(sizeof(double));
+        break;
+      case PARAMS_IMAGE_TYPE_STRING:
+        valid = valid && _valid_string(header, entry->value);
+        break;
+      case PARAMS_IMAGE_TYPE_BYTE_ARRAY:
+        valid = valid && _valid_array(header, entry, sizeof(uint8_t));
+        size += ALIGN_SIZE(sizeof(rcl_byte_array_t)) + ALIGN_SIZE(entry->count);
+        break;
+      case PARAMS_IMAGE_TYPE_BOOL_ARRAY:
+        valid = valid && _valid_array(header, entry, sizeof(uint8_t));
+        size += ALIGN_SIZE(sizeof(rcl_bool_array_t)) + ALIGN_SIZE(entry->count * sizeof(bool));
+        break;
+      case PARAMS_IMAGE_TYPE_INT64_ARRAY:
+        valid = valid && _valid_array(header, entry, sizeof(int64_t));
+        size += ALIGN_SIZE(sizeof(rcl_int64_array_t)) + ALIGN_SIZE(entry->count * sizeof(int64_t));
+        break;
+      case PARAMS_IMAGE_TYPE_DOUBLE_ARRAY:
+        valid = valid && _valid_array(header, entry, sizeof(double));
+        size += ALIGN_SIZE(sizeof(rcl_double_array_t)) + ALIGN_SIZE(entry->count * sizeof(double));
+        break;
+      case PARAMS_IMAGE_TYPE_STRING_ARRAY:
+        valid = valid && _valid_array(header, entry, sizeof(uint64_t));
+        if (valid) {
+          const uint64_t * offsets =
+            (const uint64_t *)(image + header->values_offset + entry->value);
+          for (size_t i = 0U; valid && i < entry->count; ++i) {
+            valid = _valid_string(header, offsets[i]);
+          }
+        }
+        size += ALIGN_SIZE(sizeof(rcutils_string_array_t)) +
+          ALIGN_SIZE(entry->count * sizeof(char *));
+        break;
+      default:
+        valid = false;
+        break;
+    }
+    if (!valid) {
+      RCUTILS_SET_ERROR_MSG("Parameters image is corrupted");
+      return false;
+    }
+  }
+  *storage_size = size;
+  return true;
+}
+
+/// Carve an aligned chunk out of the hydrated storage
+static void *
+_bump(uint8_t ** cursor, size_t size)
+{
+  void * chunk = *cursor;
+  *cursor += ALIGN_SIZE(size);
+  return chunk;
+}
+
+static void
+_hydrate_variant(
+  const uint8_t * image,
+  const params_image_header_t * header,
+  const params_image_param_t * entry,
+  char * strings,
+  uint8_t ** cursor,
+  rcl_variant_t * param_var,
+  const rcutils_allocator_t allocator)
+{
+  const uint8_t * values = image + header->values_offset + entry->value;
+  switch (entry->type) {
+    case PARAMS_IMAGE_TYPE_BOOL:
+      param_var->bool_value = _bump(cursor, sizeof(bool));
+      *(param_var->bool_value) = 0U != entry->value;
+      break;
+    case PARAMS_IMAGE_TYPE_INT64:
+      param_var->integer_value = _bump(cursor, sizeof(int64_t));
+      memcpy(param_var->integer_value, &entry->value, sizeof(int64_t));
+      break;
+    case PARAMS_IMAGE_TYPE_DOUBLE:
+      param_var->double_value = _bump(cursor, sizeof(double));
+      memcpy(param_var->double_value, &entry->value, sizeof(double));
+      break;
+    case PARAMS_IMAGE_TYPE_STRING:
+      param_var->string_value = strings + entry->value;
+      break;
+    case PARAMS_IMAGE_TYPE_BYTE_ARRAY:
+      param_var->byte_array_value = _bump(cursor, sizeof(rcl_byte_array_t));
+      param_var->byte_array_value->size = entry->count;
+      param_var->byte_array_value->values = NULL;
+      if (0U != entry->count) {
+        param_var->byte_array_value->values = _bump(cursor, entry->count);
+        memcpy(param_var->byte_array_value->values, values, entry->count);
+      }
+      break;
+    case PARAMS_IMAGE_TYPE_BOOL_ARRAY:
+      param_var->bool_array_value = _bump(cursor, sizeof(rcl_bool_array_t));
+      param_var->bool_array_value->size = entry->count;
+      param_var->bool_array_value->values = NULL;
+      if (0U != entry->count) {
+        param_var->bool_array_value->values = _bump(cursor, entry->count * sizeof(bool));
+        for (size_t i = 0U; i < entry->count; ++i) {
+          param_var->bool_array_value->values[i] = 0U != values[i];
+        }
+      }
+      break;
+    case PARAMS_IMAGE_TYPE_INT64_ARRAY:
+      param_var->integer_array_value = _bump(cursor, sizeof(rcl_int64_array_t));
+      param_var->integer_array_value->size = entry->count;
+      param_var->integer_array_value->values = NULL;
+      if (0U != entry->count) {
+        param_var->integer_array_value->values = _bump(cursor, entry->count * sizeof(int64_t));
+        memcpy(param_var->integer_array_value->values, values, entry->count * sizeof(int64_t));
+      }
+      break;
+    case PARAMS_IMAGE_TYPE_DOUBLE_ARRAY:
+      param_var->double_array_value = _bump(cursor, sizeof(rcl_double_array_t));
+      param_var->double_array_value->size = entry->count;
+      param_var->double_array_value->values = NULL;
+      if (0U != entry->count) {
+        param_var->double_array_value->values = _bump(cursor, entry->count * sizeof(double));
+        memcpy(param_var->double_array_value->values, values, entry->count * sizeof(double));
+      }
+      break;
+    case PARAMS_IMAGE_TYPE_STRING_ARRAY:
+      {
+        const uint64_t * offsets = (const uint64_t *)values;
+        param_var->string_array_value = _bump(cursor, sizeof(rcutils_string_array_t));
+        param_var->string_array_value->size = entry->count;
+        param_var->string_array_value->allocator = allocator;
+        param_var->string_array_value->data = NULL;
+        if (0U != entry->count) {
+          param_var->string_array_value->data = _bump(cursor, entry->count * sizeof(char *));
+          for (size_t i = 0U; i < entry->count; ++i) {
+            param_var->string_array_value->data[i] = strings + offsets[i];
+          }
+        }
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+rcl_params_t * rcl_yaml_node_struct_deserialize(
+  const uint8_t * image,
+  size_t image_size,
+  uint64_t source_hash,
+  const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(image, NULL);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return NULL);
+
+  size_t storage_size = 0U;
+  if (!_validate_image(image, image_size, source_hash, &storage_size)) {
+    return NULL;
+  }
+  const params_image_header_t * header = (const params_image_header_t *)image;
+  const params_image_node_t * nodes =
+    (const params_image_node_t *)(image + header->nodes_offset);
+  const params_image_param_t * params =
+    (const params_image_param_t *)(image + header->params_offset);
+
+  rcl_params_t * params_st = allocator.zero_allocate(1U, sizeof(rcl_params_t), allocator.state);
+  if (NULL == params_st) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters");
+    return NULL;
+  }
+  uint8_t * storage = allocator.zero_allocate(1U, storage_size, allocator.state);
+  if (NULL == storage) {
+    allocator.deallocate(params_st, allocator.state);
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters storage");
+    return NULL;
+  }
+
+  uint8_t * cursor = storage;
+  rcl_params_impl_t * impl = _bump(&cursor, sizeof(rcl_params_impl_t));
+  impl->storage = storage;
+  impl->arena = NULL;
+  atomic_init(&impl->ref_count, 1U);
+  const size_t capacity_nodes = 0U == header->num_nodes ? 1U : header->num_nodes;
+  params_st->allocator = allocator;
+  params_st->impl = impl;
+  params_st->node_names = _bump(&cursor, capacity_nodes * sizeof(char *));
+  params_st->params = _bump(&cursor, capacity_nodes * sizeof(rcl_node_params_t));
+  params_st->num_nodes = header->num_nodes;
+  params_st->capacity_nodes = capacity_nodes;
+
+  char * strings = _bump(&cursor, header->strings_size);
+  if (0U != header->strings_size) {
+    memcpy(strings, image + header->strings_offset, header->strings_size);
+  }
+
+  for (size_t node_idx = 0U; node_idx < header->num_nodes; ++node_idx) {
+    const params_image_node_t * node = &(nodes[node_idx]);
+    rcl_node_params_t * node_params_st = &(params_st->params[node_idx]);
+    const size_t capacity_params = 0U == node->num_params ? 1U : node->num_params;
+    params_st->node_names[node_idx] = strings + node->name;
+    node_params_st->parameter_names = _bump(&cursor, capacity_params * sizeof(char *));
+    node_params_st->parameter_values = _bump(&cursor, capacity_params * sizeof(rcl_variant_t));
+    node_params_st->num_params = node->num_params;
+    node_params_st->capacity_params = capacity_params;
+    for (size_t parameter_idx = 0U; parameter_idx < node->num_params; ++parameter_idx) {
+      const params_image_param_t * entry = &(params[node->first_param + parameter_idx]);
+      node_params_st->parameter_names[parameter_idx] = strings + entry->name;
+      _hydrate_variant(
+        image, header, entry, strings, &cursor,
+        &(node_params_st->parameter_values[parameter_idx]), allocator);
+    }
+  }
+  return params_st;
+}
+
+/// Write an image next to the cache file, then rename it over the cache file.
+/// The cache may be mapped by other processes, which truncating it in place would crash.
+static rcutils_ret_t
+_write_cache_file(
+  const uint8_t * image,
+  size_t image_size,
+  const char * cache_path,
+  const rcutils_allocator_t allocator)
+{
+  char * temp_path = rcutils_format_string(allocator, "%s.XXXXXX", cache_path);
+  if (NULL == temp_path) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters cache path");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  FILE * cache_file = NULL;
+#ifndef _WIN32
+  int fd = mkstemp(temp_path);
+  if (fd >= 0) {
+    // mkstemp() only lets the owner read, but the cache is shared like the YAML file
+    (void)fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    cache_file = fdopen(fd, "wb");
+    if (NULL == cache_file) {
+      close(fd);
+      unlink(temp_path);
+    }
+  }
+#else
+  if (0 == _mktemp_s(temp_path, strlen(temp_path) + 1U)) {
+    cache_file = fopen(temp_path, "wb");
+  }
+#endif
+  if (NULL == cache_file) {
+    RCUTILS_SET_ERROR_MSG("Error opening parameters cache file");
+    allocator.deallocate(temp_path, allocator.state);
+    return RCUTILS_RET_ERROR;
+  }
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  if (image_size != fwrite(image, 1U, image_size, cache_file)) {
+    RCUTILS_SET_ERROR_MSG("Error writing parameters cache file");
+    ret = RCUTILS_RET_ERROR;
+  }
+  if (0 != fclose(cache_file) && RCUTILS_RET_OK == ret) {
+    RCUTILS_SET_ERROR_MSG("Error closing parameters cache file");
+    ret = RCUTILS_RET_ERROR;
+  }
+  if (RCUTILS_RET_OK == ret) {
+#ifndef _WIN32
+    const bool renamed = 0 == rename(temp_path, cache_path);
+#else
+    const bool renamed = 0 != MoveFileExA(temp_path, cache_path, MOVEFILE_REPLACE_EXISTING);
+#endif
+    if (!renamed) {
+      RCUTILS_SET_ERROR_MSG("Error replacing parameters cache file");
+      ret = RCUTILS_RET_ERROR;
+    }
+  }
+  if (RCUTILS_RET_OK != ret) {
+    remove(temp_path);
+  }
+  allocator.deallocate(temp_path, allocator.state);
+  return ret;
+}
+
+rcutils_ret_t rcl_yaml_node_struct_write_cache(
+  const rcl_params_t * params_st,
+  uint64_t source_hash,
+  const char * cache_path)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, RCUTILS_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(cache_path, RCUTILS_RET_INVALID_ARGUMENT);
+
+  uint8_t * image = NULL;
+  size_t image_size = 0U;
+  rcutils_ret_t ret = rcl_yaml_node_struct_serialize(
+    params_st, source_hash, &image, &image_size);
+  if (RCUTILS_RET_OK != ret) {
+    return ret;
+  }
+
+  ret = _write_cache_file(image, image_size, cache_path, params_st->allocator);
+  params_st->allocator.deallocate(image, params_st->allocator.state);
+  return ret;
+}
+
+rcl_params_t * rcl_yaml_node_struct_load_cache(
+  const char * cache_path,
+  uint64_t source_hash,
+  const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(cache_path, NULL);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return NULL);
+
+  rcl_params_t * params_st = NULL;
+#ifndef _WIN32
+  int fd = open(cache_path, O_RDONLY);
+  if (fd < 0) {
+    RCUTILS_SET_ERROR_MSG("Error opening parameters cache file");
+    return NULL;
+  }
+  struct stat file_stat;
+  if (0 != fstat(fd, &file_stat) || file_stat.st_size <= 0) {
+    close(fd);
+    RCUTILS_SET_ERROR_MSG("Error reading parameters cache file");
+    return NULL;
+  }
+  const size_t image_size = (size_t)file_stat.st_size;
+  void * image = mmap(NULL, image_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (MAP_FAILED == image) {
+    RCUTILS_SET_ERROR_MSG("Error mapping parameters cache file");
+    return NULL;
+  }
+  params_st = rcl_yaml_node_struct_deserialize(image, image_size, source_hash, allocator);
+  munmap(image, image_size);
+#else
+  FILE * cache_file = fopen(cache_path, "rb");
+  if (NULL == cache_file) {
+    RCUTILS_SET_ERROR_MSG("Error opening parameters cache file");
+    return NULL;
+  }
+  long file_size = -1;
+  if (0 == fseek(cache_file, 0, SEEK_END)) {
+    file_size = ftell(cache_file);
+  }
+  if (file_size <= 0 || 0 != fseek(cache_file, 0, SEEK_SET)) {
+    fclose(cache_file);
+    RCUTILS_SET_ERROR_MSG("Error reading parameters cache file");
+    return NULL;
+  }
+  const size_t image_size = (size_t)file_size;
+  uint8_t * image = allocator.allocate(image_size, allocator.state);
+  if (NULL == image) {
+    fclose(cache_file);
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters image");
+    return NULL;
+  }
+  if (image_size == fread(image, 1U, image_size, cache_file)) {
+    params_st = rcl_yaml_node_struct_deserialize(image, image_size, source_hash, allocator);
+  } else {
+    RCUTILS_SET_ERROR_MSG("Error reading parameters cache file");
+  }
+  fclose(cache_file);
+  allocator.deallocate(image, allocator.state);
+#endif
+  return params_st;
+}
+
+///
+/// Move or copy every parameter of src_params_st into params_st, then free src_params_st
+///
+static bool
+_merge_params(rcl_params_t * params_st, rcl_params_t * src_params_st)
+{
+  rcutils_allocator_t allocator = params_st->allocator;
+  if (0U == params_st->num_nodes) {
+    // Nothing to merge with, take over the source members as is
+    rcl_params_t previous_params_st = *params_st;
+    *params_st = *src_params_st;
+    *src_params_st = previous_params_st;
+    rcl_yaml_node_struct_fini(src_params_st);
+    return true;
+  }
+
+  if (RCUTILS_RET_OK != make_params_modifiable(params_st)) {
+    rcl_yaml_node_struct_fini(src_params_st);
+    return false;
+  }
+  bool success = true;
+  for (size_t node_idx = 0U; success && node_idx < src_params_st->num_nodes; ++node_idx) {
+    const rcl_node_params_t * src_node_params_st = &(src_params_st->params[node_idx]);
+    for (size_t parameter_idx = 0U;
+      success && parameter_idx < src_node_params_st->num_params; ++parameter_idx)
+    {
+      rcl_variant_t * param_var = rcl_yaml_node_struct_get(
+        src_params_st->node_names[node_idx],
+        src_node_params_st->parameter_names[parameter_idx],
+        params_st);
+      if (NULL == param_var) {
+        success = false;
+        break;
+      }
+      rcl_yaml_variant_fini(param_var, allocator);
+      success = rcl_yaml_variant_copy(
+        param_var, &(src_node_params_st->parameter_values[parameter_idx]), allocator);
+    }
+  }
+  rcl_yaml_node_struct_fini(src_params_st);
+  return success;
+}
+
+bool rcl_parse_yaml_file_with_cache(
+  const char * file_path,
+  const char * cache_path,
+  rcl_params_t * params_st)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    file_path, "YAML file path is NULL", return false);
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    cache_path, "cache file path is NULL", return false);
+
+  if (NULL == params_st) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Pass an initialized parameter structure");
+    return false;
+  }
+
+  uint64_t source_hash = 0U;
+  if (RCUTILS_RET_OK != rcl_yaml_file_hash(file_path, &source_hash)) {
+    return false;
+  }
+
+  // The structure loaded or parsed may be taken over by params_st, it must outlive its arena
+  rcutils_allocator_t allocator = get_params_st_allocator(params_st);
+  rcl_params_t * file_params_st = rcl_yaml_node_struct_load_cache(
+    cache_path, source_hash, allocator);
+  if (NULL == file_params_st) {
+    // Cache miss, it is not an error
+    rcutils_reset_error();
+    file_params_st = rcl_yaml_node_struct_init(allocator);
+    if (NULL == file_params_st) {
+      return false;
+    }
+    if (!rcl_parse_yaml_file(file_path, file_params_st)) {
+      rcl_yaml_node_struct_fini(file_params_st);
+      return false;
+    }
+    if (RCUTILS_RET_OK !=
+      rcl_yaml_node_struct_write_cache(file_params_st, source_hash, cache_path))
+    {
+      // Failing to write the cache only costs a reparse next time
+      rcutils_reset_error();
+    }
+  }
+  return _merge_params(params_st, file_params_st);
+}
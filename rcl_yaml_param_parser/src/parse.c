@@ -29,6 +29,7 @@
 #include "./impl/parse.h"
 #include "./impl/namespace.h"
 #include "./impl/node_params.h"
+#include "./impl/params_impl.h"
 #include "rcl_yaml_param_parser/parser.h"
 #include "rcl_yaml_param_parser/visibility_control.h"
 
@@ -733,6 +734,103 @@ rcutils_ret_t parse_key(
   return ret;
 }
 
+///
+/// Check whether a node name from a parameter YAML file, possibly holding wildcards,
+/// matches a node fully qualified name. Leading slashes are ignored on both sides.
+/// `*` matches exactly one name token and `**` matches zero or more name tokens.
+///
+bool node_name_matches(
+  const char * node_name,
+  const char * node_fqn)
+{
+  assert(NULL != node_name);
+  assert(NULL != node_fqn);
+
+  while ('/' == *node_name) {
+    node_name++;
+  }
+  while ('/' == *node_fqn) {
+    node_fqn++;
+  }
+  if ('\0' == *node_name) {
+    return '\0' == *node_fqn;
+  }
+
+  const char * name_token_end = strchr(node_name, '/');
+  const size_t name_token_len = NULL == name_token_end ?
+    strlen(node_name) : (size_t)(name_token_end - node_name);
+  const char * name_rest = node_name + name_token_len;
+
+  if (2U == name_token_len && 0 == strncmp(node_name, "**", 2U)) {
+    // Match zero tokens, or consume one token and try again
+    if (node_name_matches(name_rest, node_fqn)) {
+      return true;
+    }
+    if ('\0' == *node_fqn) {
+      return false;
+    }
+    const char * fqn_token_end = strchr(node_fqn, '/');
+    return node_name_matches(
+      node_name, NULL == fqn_token_end ? node_fqn + strlen(node_fqn) : fqn_token_end);
+  }
+
+  if ('\0' == *node_fqn) {
+    return false;
+  }
+  const char * fqn_token_end = strchr(node_fqn, '/');
+  const size_t fqn_token_len = NULL == fqn_token_end ?
+    strlen(node_fqn) : (size_t)(fqn_token_end - node_fqn);
+  if (!(1U == name_token_len && '*' == *node_name) &&
+    (name_token_len != fqn_token_len || 0 != strncmp(node_name, node_fqn, name_token_len)))
+  {
+    return false;
+  }
+  return node_name_matches(name_rest, node_fqn + fqn_token_len);
+}
+
+///
+/// Consume the events of the next value, a scalar or a whole sequence or mapping,
+/// without processing them
+///
+rcutils_ret_t skip_value_events(
+  yaml_parser_t * parser,
+  const uint32_t line_num)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(parser, RCUTILS_RET_INVALID_ARGUMENT);
+
+  rcutils_ret_t ret = RCUTILS_RET_OK;
+  uint32_t depth = 0U;
+  do {
+    yaml_event_t event;
+    int success = yaml_parser_parse(parser, &event);
+    if (0 == success) {
+      RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "Error parsing a event near line %d", line_num);
+      return RCUTILS_RET_ERROR;
+    }
+    switch (event.type) {
+      case YAML_MAPPING_START_EVENT:
+      case YAML_SEQUENCE_START_EVENT:
+        depth++;
+        break;
+      case YAML_MAPPING_END_EVENT:
+      case YAML_SEQUENCE_END_EVENT:
+        depth--;
+        break;
+      case YAML_SCALAR_EVENT:
+      case YAML_ALIAS_EVENT:
+        break;
+      default:
+        RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Unexpected YAML event near line %d", line_num);
+        ret = RCUTILS_RET_ERROR;
+        break;
+    }
+    yaml_event_delete(&event);
+  } while (RCUTILS_RET_OK == ret && depth > 0U);
+  return ret;
+}
+
 ///
 /// Get events from parsing a parameter YAML file and process them
 ///
@@ -740,6 +838,20 @@ rcutils_ret_t parse_file_events(
   yaml_parser_t * parser,
   namespace_tracker_t * ns_tracker,
   rcl_params_t * params_st)
+{
+  return parse_file_events_for_nodes(parser, ns_tracker, NULL, 0U, params_st);
+}
+
+///
+/// Get events from parsing a parameter YAML file and process them, skipping the
+/// parameters of nodes matching none of the given node names, if any
+///
+rcutils_ret_t parse_file_events_for_nodes(
+  yaml_parser_t * parser,
+  namespace_tracker_t * ns_tracker,
+  const char * const * node_fqns,
+  const size_t num_node_fqns,
+  rcl_params_t * params_st)
 {
   int32_t done_parsing = 0;
   bool is_key = true;
@@ -780,6 +892,27 @@ rcutils_ret_t parse_file_events(
       case YAML_SCALAR_EVENT:
         {
           /// Need to toggle between key and value at params level
+          if (is_key && NULL != node_fqns && MAP_NODE_NAME_LVL == map_level &&
+            NULL != event.data.scalar.value && 0U != ns_tracker->num_node_ns &&
+            0 == strncmp(PARAMS_KEY, (char *)event.data.scalar.value, strlen(PARAMS_KEY)))
+          {
+            bool is_wanted_node = false;
+            for (size_t i = 0U; i < num_node_fqns && !is_wanted_node; ++i) {
+              is_wanted_node = node_name_matches(ns_tracker->node_ns, node_fqns[i]);
+            }
+            if (!is_wanted_node) {
+              /// Drop the node name from the namespace as parse_key() would,
+              /// then skip its parameters altogether
+              ret = rem_name_from_ns(ns_tracker, NS_TYPE_NODE, allocator);
+              if (RCUTILS_RET_OK != ret) {
+                RCUTILS_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                  "Internal error removing node namespace at line %d", line_num);
+                break;
+              }
+              ret = skip_value_events(parser, line_num);
+              break;
+            }
+          }
           if (is_key) {
             ret = parse_key(
               event, &map_level, &is_new_map, &node_idx, &parameter_idx, ns_tracker, params_st);
@@ -1043,3 +1176,27 @@ rcutils_ret_t find_node(
   param_st->num_nodes++;
   return RCUTILS_RET_OK;
 }
+
+///
+/// Copy the members of a parameter structure that are shared with other structures or
+/// backed by a single storage allocation, so that they can be modified
+///
+rcutils_ret_t make_params_modifiable(rcl_params_t * params_st)
+{
+  rcl_params_impl_t * impl = params_st->impl;
+  if (NULL == impl ||
+    (NULL == impl->storage && 1U == rcutils_atomic_load_uint64_t(&impl->ref_count)))
+  {
+    return RCUTILS_RET_OK;
+  }
+  rcl_params_t * out_params_st = rcl_yaml_node_struct_copy(params_st);
+  if (NULL == out_params_st) {
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+  // Swap members, then drop the reference to the previous ones
+  rcl_params_t previous_params_st = *params_st;
+  *params_st = *out_params_st;
+  *out_params_st = previous_params_st;
+  rcl_yaml_node_struct_fini(out_params_st);
+  return RCUTILS_RET_OK;
+}
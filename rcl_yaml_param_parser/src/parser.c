@@ -31,6 +31,7 @@
 #include "rcutils/types.h"
 
 #include "./impl/types.h"
+#include "./impl/params_impl.h"
 #include "./impl/parse.h"
 #include "./impl/node_params.h"
 #include "./impl/yaml_variant.h"
@@ -63,11 +64,21 @@ rcl_params_t * rcl_yaml_node_struct_init_with_capacity(
 
   params_st->allocator = allocator;
 
+  // Allocated upfront, so that sharing never writes to the shared structure
+  params_st->impl = allocator.allocate(sizeof(rcl_params_impl_t), allocator.state);
+  if (NULL == params_st->impl) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters");
+    goto clean;
+  }
+  params_st->impl->storage = NULL;
+  params_st->impl->arena = NULL;
+  atomic_init(&params_st->impl->ref_count, 1U);
+
   params_st->node_names = allocator.zero_allocate(
     capacity, sizeof(char *), allocator.state);
   if (NULL == params_st->node_names) {
     RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameter node names");
-    goto clean;
+    goto clean_impl;
   }
 
   params_st->params = allocator.zero_allocate(
@@ -76,13 +87,57 @@ rcl_params_t * rcl_yaml_node_struct_init_with_capacity(
     allocator.deallocate(params_st->node_names, allocator.state);
     params_st->node_names = NULL;
     RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameter values");
-    goto clean;
+    goto clean_impl;
   }
 
   params_st->num_nodes = 0U;
   params_st->capacity_nodes = capacity;
   return params_st;
 
+clean_impl:
+  allocator.deallocate(params_st->impl, allocator.state);
+clean:
+  allocator.deallocate(params_st, allocator.state);
+  return NULL;
+}
+
+rcl_params_t * rcl_yaml_node_struct_init_with_arena(
+  size_t chunk_size,
+  const rcutils_allocator_t allocator)
+{
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return NULL);
+  rcl_params_t * params_st = allocator.zero_allocate(1, sizeof(rcl_params_t), allocator.state);
+  if (NULL == params_st) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters");
+    return NULL;
+  }
+
+  params_arena_t * arena = params_arena_init(chunk_size, allocator);
+  if (NULL == arena) {
+    goto clean;
+  }
+  rcutils_allocator_t arena_allocator = params_arena_get_allocator(arena);
+  rcl_params_impl_t * impl = arena_allocator.allocate(
+    sizeof(rcl_params_impl_t), arena_allocator.state);
+  params_st->node_names = arena_allocator.zero_allocate(
+    INIT_NUM_NODE_ENTRIES, sizeof(char *), arena_allocator.state);
+  params_st->params = arena_allocator.zero_allocate(
+    INIT_NUM_NODE_ENTRIES, sizeof(rcl_node_params_t), arena_allocator.state);
+  if (NULL == impl || NULL == params_st->node_names || NULL == params_st->params) {
+    params_arena_fini(arena);
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters");
+    goto clean;
+  }
+  impl->storage = NULL;
+  impl->arena = arena;
+  atomic_init(&impl->ref_count, 1U);
+
+  params_st->allocator = arena_allocator;
+  params_st->impl = impl;
+  params_st->num_nodes = 0U;
+  params_st->capacity_nodes = INIT_NUM_NODE_ENTRIES;
+  return params_st;
+
 clean:
   allocator.deallocate(params_st, allocator.state);
   return NULL;
@@ -105,6 +160,11 @@ rcutils_ret_t rcl_yaml_node_struct_reallocate(
     return RCUTILS_RET_INVALID_ARGUMENT;
   }
 
+  if (RCUTILS_RET_OK != make_params_modifiable(params_st)) {
+    RCUTILS_SET_ERROR_MSG("Failed to allocate memory for parameters");
+    return RCUTILS_RET_BAD_ALLOC;
+  }
+
   void * node_names = allocator.reallocate(
     params_st->node_names, new_capacity * sizeof(char *), allocator.state);
   if (NULL == node_names) {
@@ -145,7 +205,8 @@ rcl_params_t * rcl_yaml_node_struct_copy(
 {
   RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, NULL);
 
-  rcutils_allocator_t allocator = params_st->allocator;
+  // Members of the copy never come from the arena of the copied structure, if any
+  rcutils_allocator_t allocator = get_params_st_allocator(params_st);
   rcl_params_t * out_params_st = rcl_yaml_node_struct_init_with_capacity(
     params_st->capacity_nodes,
     allocator);
@@ -200,6 +261,31 @@ fail:
   return NULL;
 }
 
+///
+/// Share the members of the rcl_params_t parameter structure with a new one
+///
+rcl_params_t * rcl_yaml_node_struct_share(
+  rcl_params_t * params_st)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, NULL);
+
+  rcutils_allocator_t allocator = get_params_st_allocator(params_st);
+  rcl_params_t * out_params_st = allocator.allocate(sizeof(rcl_params_t), allocator.state);
+  if (NULL == out_params_st) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem\n");
+    return NULL;
+  }
+  if (NULL == params_st->impl) {
+    RCUTILS_SET_ERROR_MSG("parameter structure was not initialized");
+    allocator.deallocate(out_params_st, allocator.state);
+    return NULL;
+  }
+  // Only the reference count of the shared structure is written, atomically
+  *out_params_st = *params_st;
+  atomic_fetch_add(&params_st->impl->ref_count, 1U);
+  return out_params_st;
+}
+
 ///
 /// Free param structure
 /// NOTE: If there is an error, would recommend just to safely exit the process instead
@@ -213,6 +299,30 @@ void rcl_yaml_node_struct_fini(
   }
   rcutils_allocator_t allocator = params_st->allocator;
 
+  rcl_params_impl_t * impl = params_st->impl;
+  if (NULL != impl) {
+    rcutils_allocator_t params_st_allocator = get_params_st_allocator(params_st);
+    if (1U != atomic_fetch_sub(&impl->ref_count, 1U)) {
+      // Members are still shared with other structures
+      params_st_allocator.deallocate(params_st, params_st_allocator.state);
+      return;
+    }
+    if (NULL != impl->arena) {
+      // Every member, the implementation struct included, lives in the arena
+      params_arena_fini(impl->arena);
+      params_st_allocator.deallocate(params_st, params_st_allocator.state);
+      return;
+    }
+    if (NULL != impl->storage) {
+      // Every member lives in the single storage allocation
+      allocator.deallocate(impl->storage, allocator.state);
+      allocator.deallocate(params_st, allocator.state);
+      return;
+    }
+    allocator.deallocate(impl, allocator.state);
+    params_st->impl = NULL;
+  }
+
   if (NULL != params_st->node_names) {
     for (size_t node_idx = 0U; node_idx < params_st->num_nodes; node_idx++) {
       char * node_name = params_st->node_names[node_idx];
@@ -243,10 +353,14 @@ void rcl_yaml_node_struct_fini(
 /// TODO (anup.pemmaiah): Support Mutiple yaml files
 ///
 ///
-/// Parse the YAML file and populate params_st
+/// Parse the YAML file and populate params_st, with the parameters of the given nodes only
+/// if node_fqns is not NULL
 ///
-bool rcl_parse_yaml_file(
+static bool
+_parse_yaml_file(
   const char * file_path,
+  const char * const * node_fqns,
+  size_t num_node_fqns,
   rcl_params_t * params_st)
 {
   RCUTILS_CHECK_FOR_NULL_WITH_MSG(
@@ -257,6 +371,10 @@ bool rcl_parse_yaml_file(
     return false;
   }
 
+  if (RCUTILS_RET_OK != make_params_modifiable(params_st)) {
+    return false;
+  }
+
   yaml_parser_t parser;
   int success = yaml_parser_initialize(&parser);
   if (0 == success) {
@@ -275,7 +393,8 @@ bool rcl_parse_yaml_file(
 
   namespace_tracker_t ns_tracker;
   memset(&ns_tracker, 0, sizeof(namespace_tracker_t));
-  rcutils_ret_t ret = parse_file_events(&parser, &ns_tracker, params_st);
+  rcutils_ret_t ret = parse_file_events_for_nodes(
+    &parser, &ns_tracker, node_fqns, num_node_fqns, params_st);
 
   fclose(yaml_file);
 
@@ -292,6 +411,34 @@ bool rcl_parse_yaml_file(
   return RCUTILS_RET_OK == ret;
 }
 
+///
+/// Parse the YAML file and populate params_st
+///
+bool rcl_parse_yaml_file(
+  const char * file_path,
+  rcl_params_t * params_st)
+{
+  return _parse_yaml_file(file_path, NULL, 0U, params_st);
+}
+
+///
+/// Parse the YAML file and populate params_st with the parameters of the given nodes
+///
+bool rcl_parse_yaml_file_for_nodes(
+  const char * file_path,
+  const char * const * node_fqns,
+  size_t num_node_fqns,
+  rcl_params_t * params_st)
+{
+  RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+    node_fqns, "node names are NULL", return false);
+  for (size_t i = 0U; i < num_node_fqns; ++i) {
+    RCUTILS_CHECK_FOR_NULL_WITH_MSG(
+      node_fqns[i], "node name is NULL", return false);
+  }
+  return _parse_yaml_file(file_path, node_fqns, num_node_fqns, params_st);
+}
+
 ///
 /// Parse a YAML string and populate params_st
 ///
@@ -314,6 +461,10 @@ bool rcl_parse_yaml_value(
     return false;
   }
 
+  if (RCUTILS_RET_OK != make_params_modifiable(params_st)) {
+    return false;
+  }
+
   size_t node_idx = 0U;
   rcutils_ret_t ret = find_node(node_name, params_st, &node_idx);
   if (RCUTILS_RET_OK != ret) {
@@ -354,6 +505,11 @@ rcl_variant_t * rcl_yaml_node_struct_get(
 
   rcl_variant_t * param_value = NULL;
 
+  // The returned value may be modified in place, it must not be shared
+  if (RCUTILS_RET_OK != make_params_modifiable(params_st)) {
+    return NULL;
+  }
+
   size_t node_idx = 0U;
   rcutils_ret_t ret = find_node(node_name, params_st, &node_idx);
   if (RCUTILS_RET_OK == ret) {
@@ -366,6 +522,30 @@ rcl_variant_t * rcl_yaml_node_struct_get(
   return param_value;
 }
 
+const rcl_variant_t * rcl_yaml_node_struct_find(
+  const char * node_name,
+  const char * param_name,
+  const rcl_params_t * params_st)
+{
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(node_name, NULL);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(param_name, NULL);
+  RCUTILS_CHECK_ARGUMENT_FOR_NULL(params_st, NULL);
+
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; ++node_idx) {
+    if (0 != strcmp(params_st->node_names[node_idx], node_name)) {
+      continue;
+    }
+    const rcl_node_params_t * node_params_st = &(params_st->params[node_idx]);
+    for (size_t parameter_idx = 0U; parameter_idx < node_params_st->num_params; ++parameter_idx) {
+      if (0 == strcmp(node_params_st->parameter_names[parameter_idx], param_name)) {
+        return &(node_params_st->parameter_values[parameter_idx]);
+      }
+    }
+    break;
+  }
+  return NULL;
+}
+
 ///
 /// Dump the param structure
 ///
@@ -154,7 +154,7 @@ bool rcl_yaml_variant_copy(
     rcutils_ret_t ret = rcutils_string_array_init(
       out_param_var->string_array_value,
       param_var->string_array_value->size,
-      &(param_var->string_array_value->allocator));
+      &allocator);
     if (RCUTILS_RET_OK != ret) {
       if (RCUTILS_RET_BAD_ALLOC == ret) {
         RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem for string array\n");
@@ -43,3 +43,55 @@ BENCHMARK_F(PerformanceTest, parser_yaml_param)(benchmark::State & st)
     rcl_yaml_node_struct_fini(params_hdl);
   }
 }
+
+BENCHMARK_F(PerformanceTest, parser_yaml_param_arena)(benchmark::State & st)
+{
+  std::string path =
+    (rcpputils::fs::current_path() / "test" / "benchmark" / "benchmark_params.yaml").string();
+  reset_heap_counters();
+  for (auto _ : st) {
+    rcl_params_t * params_hdl =
+      rcl_yaml_node_struct_init_with_arena(0u, rcutils_get_default_allocator());
+    if (NULL == params_hdl) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    bool res = rcl_parse_yaml_file(path.c_str(), params_hdl);
+    if (!res) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    rcl_yaml_node_struct_fini(params_hdl);
+  }
+}
+
+BENCHMARK_F(PerformanceTest, parser_yaml_param_cached)(benchmark::State & st)
+{
+  std::string path =
+    (rcpputils::fs::current_path() / "test" / "benchmark" / "benchmark_params.yaml").string();
+  std::string cache_path =
+    (rcpputils::fs::temp_directory_path() / "benchmark_params.bin").string();
+  // Warm up the cache
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(rcutils_get_default_allocator());
+  if (NULL == params_hdl) {
+    st.SkipWithError(rcutils_get_error_string().str);
+    return;
+  }
+  bool res = rcl_parse_yaml_file_with_cache(path.c_str(), cache_path.c_str(), params_hdl);
+  rcl_yaml_node_struct_fini(params_hdl);
+  if (!res) {
+    st.SkipWithError(rcutils_get_error_string().str);
+    return;
+  }
+  reset_heap_counters();
+  for (auto _ : st) {
+    params_hdl = rcl_yaml_node_struct_init(rcutils_get_default_allocator());
+    if (NULL == params_hdl) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    res = rcl_parse_yaml_file_with_cache(path.c_str(), cache_path.c_str(), params_hdl);
+    if (!res) {
+      st.SkipWithError(rcutils_get_error_string().str);
+    }
+    rcl_yaml_node_struct_fini(params_hdl);
+  }
+  rcpputils::fs::remove(rcpputils::fs::path(cache_path));
+}
@@ -0,0 +1,231 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcl_yaml_param_parser/parser.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/filesystem.h"
+
+#include "../src/impl/params_arena.h"
+
+static char cur_dir[1024];
+
+struct counting_allocator_state
+{
+  size_t num_allocations;
+  size_t num_deallocations;
+};
+
+static void * counting_allocate(size_t size, void * state)
+{
+  ++static_cast<counting_allocator_state *>(state)->num_allocations;
+  return rcutils_get_default_allocator().allocate(size, rcutils_get_default_allocator().state);
+}
+
+static void counting_deallocate(void * pointer, void * state)
+{
+  if (NULL != pointer) {
+    ++static_cast<counting_allocator_state *>(state)->num_deallocations;
+  }
+  rcutils_get_default_allocator().deallocate(pointer, rcutils_get_default_allocator().state);
+}
+
+static void * counting_reallocate(void * pointer, size_t size, void * state)
+{
+  if (NULL == pointer) {
+    ++static_cast<counting_allocator_state *>(state)->num_allocations;
+  }
+  return rcutils_get_default_allocator().reallocate(
+    pointer, size, rcutils_get_default_allocator().state);
+}
+
+static void * counting_zero_allocate(
+  size_t number_of_elements, size_t size_of_element, void * state)
+{
+  ++static_cast<counting_allocator_state *>(state)->num_allocations;
+  return rcutils_get_default_allocator().zero_allocate(
+    number_of_elements, size_of_element, rcutils_get_default_allocator().state);
+}
+
+class TestParamsArena : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rcutils_reset_error();
+    ASSERT_TRUE(rcutils_get_cwd(cur_dir, 1024)) << rcutils_get_error_string().str;
+    allocator = rcutils_get_default_allocator();
+    allocator.allocate = counting_allocate;
+    allocator.deallocate = counting_deallocate;
+    allocator.reallocate = counting_reallocate;
+    allocator.zero_allocate = counting_zero_allocate;
+    allocator.state = &state;
+    yaml_path = std::string(cur_dir) + "/test/correct_config.yaml";
+  }
+
+  counting_allocator_state state{0u, 0u};
+  rcutils_allocator_t allocator;
+  std::string yaml_path;
+};
+
+TEST_F(TestParamsArena, arena_allocator) {
+  params_arena_t * arena = params_arena_init(256u, allocator);
+  ASSERT_TRUE(NULL != arena) << rcutils_get_error_string().str;
+  rcutils_allocator_t arena_allocator = params_arena_get_allocator(arena);
+  ASSERT_TRUE(rcutils_allocator_is_valid(&arena_allocator));
+
+  char * first = static_cast<char *>(arena_allocator.allocate(10u, arena_allocator.state));
+  ASSERT_TRUE(NULL != first);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(first) % alignof(std::max_align_t));
+  std::strcpy(first, "012345678");  // NOLINT
+
+  // Growing the last allocation happens in place
+  char * grown =
+    static_cast<char *>(arena_allocator.reallocate(first, 100u, arena_allocator.state));
+  EXPECT_EQ(first, grown);
+  EXPECT_STREQ("012345678", grown);
+
+  // Growing any other allocation moves it
+  void * second = arena_allocator.zero_allocate(4u, sizeof(int64_t), arena_allocator.state);
+  ASSERT_TRUE(NULL != second);
+  EXPECT_EQ(0, static_cast<int64_t *>(second)[3]);
+  char * moved =
+    static_cast<char *>(arena_allocator.reallocate(grown, 200u, arena_allocator.state));
+  ASSERT_TRUE(NULL != moved);
+  EXPECT_NE(grown, moved);
+  EXPECT_STREQ("012345678", moved);
+
+  // Deallocating the last allocation reclaims its memory
+  arena_allocator.deallocate(moved, arena_allocator.state);
+  void * third = arena_allocator.allocate(8u, arena_allocator.state);
+  EXPECT_EQ(static_cast<void *>(moved), third);
+
+  // Allocations larger than a chunk get a chunk of their own
+  void * large = arena_allocator.allocate(1024u, arena_allocator.state);
+  ASSERT_TRUE(NULL != large);
+  void * fourth = arena_allocator.allocate(8u, arena_allocator.state);
+  ASSERT_TRUE(NULL != fourth);
+  EXPECT_LT(static_cast<char *>(third), static_cast<char *>(fourth));
+
+  EXPECT_EQ(NULL, arena_allocator.zero_allocate(SIZE_MAX, 2u, arena_allocator.state));
+
+  params_arena_fini(arena);
+  EXPECT_EQ(state.num_allocations, state.num_deallocations);
+}
+
+TEST_F(TestParamsArena, parse_yaml_file) {
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(rcutils_get_default_allocator());
+  ASSERT_TRUE(NULL != params_hdl) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_hdl);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_file(yaml_path.c_str(), params_hdl)) <<
+    rcutils_get_error_string().str;
+
+  rcl_params_t * arena_params_hdl = rcl_yaml_node_struct_init_with_arena(0u, allocator);
+  ASSERT_TRUE(NULL != arena_params_hdl) << rcutils_get_error_string().str;
+  ASSERT_TRUE(rcl_parse_yaml_file(yaml_path.c_str(), arena_params_hdl)) <<
+    rcutils_get_error_string().str;
+  // Only a handful of chunks are allocated
+  EXPECT_GT(16u, state.num_allocations);
+
+  ASSERT_EQ(params_hdl->num_nodes, arena_params_hdl->num_nodes);
+  for (size_t node_idx = 0u; node_idx < params_hdl->num_nodes; ++node_idx) {
+    EXPECT_STREQ(params_hdl->node_names[node_idx], arena_params_hdl->node_names[node_idx]);
+    const rcl_node_params_t * node_params = &params_hdl->params[node_idx];
+    const rcl_node_params_t * arena_node_params = &arena_params_hdl->params[node_idx];
+    ASSERT_EQ(node_params->num_params, arena_node_params->num_params);
+    for (size_t param_idx = 0u; param_idx < node_params->num_params; ++param_idx) {
+      EXPECT_STREQ(
+        node_params->parameter_names[param_idx], arena_node_params->parameter_names[param_idx]);
+    }
+  }
+
+  // Modifying the structure keeps allocating from the arena
+  EXPECT_TRUE(rcl_parse_yaml_value("lidar_ns/lidar_2", "id", "12", arena_params_hdl)) <<
+    rcutils_get_error_string().str;
+  EXPECT_TRUE(rcl_parse_yaml_value("new_node", "new_param", "[a, b]", arena_params_hdl)) <<
+    rcutils_get_error_string().str;
+  rcl_variant_t * param_value =
+    rcl_yaml_node_struct_get("lidar_ns/lidar_2", "id", arena_params_hdl);
+  ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+  ASSERT_TRUE(NULL != param_value->integer_value);
+  EXPECT_EQ(12, *param_value->integer_value);
+
+  // Copies are individually allocated, shared structures outlive each other
+  rcl_params_t * copy = rcl_yaml_node_struct_copy(arena_params_hdl);
+  ASSERT_TRUE(NULL != copy) << rcutils_get_error_string().str;
+  rcl_params_t * shared = rcl_yaml_node_struct_share(arena_params_hdl);
+  ASSERT_TRUE(NULL != shared) << rcutils_get_error_string().str;
+  rcl_yaml_node_struct_fini(arena_params_hdl);
+  param_value = rcl_yaml_node_struct_get("new_node", "new_param", shared);
+  ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+  ASSERT_TRUE(NULL != param_value->string_array_value);
+  EXPECT_EQ(2u, param_value->string_array_value->size);
+  rcl_yaml_node_struct_fini(shared);
+  param_value = rcl_yaml_node_struct_get("new_node", "new_param", copy);
+  ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+  ASSERT_TRUE(NULL != param_value->string_array_value);
+  EXPECT_STREQ("b", param_value->string_array_value->data[1]);
+  rcl_yaml_node_struct_fini(copy);
+
+  EXPECT_EQ(state.num_allocations, state.num_deallocations);
+}
+
+TEST_F(TestParamsArena, parse_yaml_file_with_cache) {
+  const std::string cache_path = std::string(cur_dir) + "/test_params_arena.bin";
+  std::remove(cache_path.c_str());
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    std::remove(cache_path.c_str());
+  });
+
+  for (int i = 0; i < 2; ++i) {
+    rcl_params_t * arena_params_hdl = rcl_yaml_node_struct_init_with_arena(1024u, allocator);
+    ASSERT_TRUE(NULL != arena_params_hdl) << rcutils_get_error_string().str;
+    EXPECT_TRUE(
+      rcl_parse_yaml_file_with_cache(yaml_path.c_str(), cache_path.c_str(), arena_params_hdl)) <<
+      rcutils_get_error_string().str;
+    rcl_variant_t * param_value = rcl_yaml_node_struct_get("intel", "num_cores", arena_params_hdl);
+    ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+    ASSERT_TRUE(NULL != param_value->integer_value);
+    EXPECT_EQ(8, *param_value->integer_value);
+    rcl_yaml_node_struct_fini(arena_params_hdl);
+  }
+  EXPECT_EQ(state.num_allocations, state.num_deallocations);
+}
+
+TEST_F(TestParamsArena, init_with_arena_bad_args) {
+  rcutils_allocator_t bad_allocator = rcutils_get_zero_initialized_allocator();
+  EXPECT_EQ(NULL, rcl_yaml_node_struct_init_with_arena(0u, bad_allocator));
+  rcutils_reset_error();
+}
+
+int32_t main(int32_t argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,368 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+
+#include "rcl_yaml_param_parser/parser.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/error_handling.h"
+#include "rcutils/filesystem.h"
+
+static char cur_dir[1024];
+
+class TestParamsCache : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rcutils_reset_error();
+    ASSERT_TRUE(rcutils_get_cwd(cur_dir, 1024)) << rcutils_get_error_string().str;
+    allocator = rcutils_get_default_allocator();
+    char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+    ASSERT_TRUE(NULL != test_path) << rcutils_get_error_string().str;
+    char * path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+    allocator.deallocate(test_path, allocator.state);
+    ASSERT_TRUE(NULL != path) << rcutils_get_error_string().str;
+    yaml_path = path;
+    allocator.deallocate(path, allocator.state);
+    cache_path = std::string(cur_dir) + "/test_params_cache.bin";
+    std::remove(cache_path.c_str());
+
+    params_hdl = rcl_yaml_node_struct_init(allocator);
+    ASSERT_TRUE(NULL != params_hdl) << rcutils_get_error_string().str;
+    ASSERT_TRUE(rcl_parse_yaml_file(yaml_path.c_str(), params_hdl)) <<
+      rcutils_get_error_string().str;
+    ASSERT_EQ(
+      RCUTILS_RET_OK, rcl_yaml_file_hash(yaml_path.c_str(), &source_hash)) <<
+      rcutils_get_error_string().str;
+  }
+
+  void TearDown() override
+  {
+    rcl_yaml_node_struct_fini(params_hdl);
+    std::remove(cache_path.c_str());
+  }
+
+  rcutils_allocator_t allocator;
+  std::string yaml_path;
+  std::string cache_path;
+  rcl_params_t * params_hdl = nullptr;
+  uint64_t source_hash = 0u;
+};
+
+static void expect_params_eq(const rcl_params_t * expected, const rcl_params_t * actual)
+{
+  ASSERT_EQ(expected->num_nodes, actual->num_nodes);
+  for (size_t node_idx = 0u; node_idx < expected->num_nodes; ++node_idx) {
+    EXPECT_STREQ(expected->node_names[node_idx], actual->node_names[node_idx]);
+    const rcl_node_params_t * expected_node = &expected->params[node_idx];
+    const rcl_node_params_t * actual_node = &actual->params[node_idx];
+    ASSERT_EQ(expected_node->num_params, actual_node->num_params);
+    for (size_t param_idx = 0u; param_idx < expected_node->num_params; ++param_idx) {
+      EXPECT_STREQ(
+        expected_node->parameter_names[param_idx], actual_node->parameter_names[param_idx]);
+      const rcl_variant_t * expected_var = &expected_node->parameter_values[param_idx];
+      const rcl_variant_t * actual_var = &actual_node->parameter_values[param_idx];
+      if (NULL != expected_var->bool_value) {
+        ASSERT_TRUE(NULL != actual_var->bool_value);
+        EXPECT_EQ(*expected_var->bool_value, *actual_var->bool_value);
+      } else if (NULL != expected_var->integer_value) {
+        ASSERT_TRUE(NULL != actual_var->integer_value);
+        EXPECT_EQ(*expected_var->integer_value, *actual_var->integer_value);
+      } else if (NULL != expected_var->double_value) {
+        ASSERT_TRUE(NULL != actual_var->double_value);
+        EXPECT_DOUBLE_EQ(*expected_var->double_value, *actual_var->double_value);
+      } else if (NULL != expected_var->string_value) {
+        ASSERT_TRUE(NULL != actual_var->string_value);
+        EXPECT_STREQ(expected_var->string_value, actual_var->string_value);
+      } else if (NULL != expected_var->bool_array_value) {
+        ASSERT_TRUE(NULL != actual_var->bool_array_value);
+        ASSERT_EQ(expected_var->bool_array_value->size, actual_var->bool_array_value->size);
+        for (size_t i = 0u; i < expected_var->bool_array_value->size; ++i) {
+          EXPECT_EQ(
+            expected_var->bool_array_value->values[i], actual_var->bool_array_value->values[i]);
+        }
+      } else if (NULL != expected_var->integer_array_value) {
+        ASSERT_TRUE(NULL != actual_var->integer_array_value);
+        ASSERT_EQ(expected_var->integer_array_value->size, actual_var->integer_array_value->size);
+        for (size_t i = 0u; i < expected_var->integer_array_value->size; ++i) {
+          EXPECT_EQ(
+            expected_var->integer_array_value->values[i],
+            actual_var->integer_array_value->values[i]);
+        }
+      } else if (NULL != expected_var->double_array_value) {
+        ASSERT_TRUE(NULL != actual_var->double_array_value);
+        ASSERT_EQ(expected_var->double_array_value->size, actual_var->double_array_value->size);
+        for (size_t i = 0u; i < expected_var->double_array_value->size; ++i) {
+          EXPECT_DOUBLE_EQ(
+            expected_var->double_array_value->values[i],
+            actual_var->double_array_value->values[i]);
+        }
+      } else if (NULL != expected_var->string_array_value) {
+        ASSERT_TRUE(NULL != actual_var->string_array_value);
+        ASSERT_EQ(expected_var->string_array_value->size, actual_var->string_array_value->size);
+        for (size_t i = 0u; i < expected_var->string_array_value->size; ++i) {
+          EXPECT_STREQ(
+            expected_var->string_array_value->data[i], actual_var->string_array_value->data[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TestParamsCache, serialize_deserialize) {
+  uint8_t * image = nullptr;
+  size_t image_size = 0u;
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcl_yaml_node_struct_serialize(nullptr, source_hash, &image, &image_size));
+  rcutils_reset_error();
+  EXPECT_EQ(
+    RCUTILS_RET_INVALID_ARGUMENT,
+    rcl_yaml_node_struct_serialize(params_hdl, source_hash, nullptr, &image_size));
+  rcutils_reset_error();
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcl_yaml_node_struct_serialize(params_hdl, source_hash, &image, &image_size)) <<
+    rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(image, allocator.state);
+  });
+
+  rcl_params_t * loaded = rcl_yaml_node_struct_deserialize(
+    image, image_size, source_hash, allocator);
+  ASSERT_TRUE(NULL != loaded) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(loaded);
+  });
+  expect_params_eq(params_hdl, loaded);
+
+  // Copies of a loaded structure own their members
+  rcl_params_t * copy = rcl_yaml_node_struct_copy(loaded);
+  ASSERT_TRUE(NULL != copy) << rcutils_get_error_string().str;
+  expect_params_eq(params_hdl, copy);
+  rcl_yaml_node_struct_fini(copy);
+}
+
+TEST_F(TestParamsCache, deserialize_rejects_bad_images) {
+  uint8_t * image = nullptr;
+  size_t image_size = 0u;
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcl_yaml_node_struct_serialize(params_hdl, source_hash, &image, &image_size)) <<
+    rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(image, allocator.state);
+  });
+
+  // Stale image
+  EXPECT_EQ(
+    nullptr, rcl_yaml_node_struct_deserialize(image, image_size, source_hash + 1u, allocator));
+  rcutils_reset_error();
+
+  // Truncated image
+  EXPECT_EQ(
+    nullptr, rcl_yaml_node_struct_deserialize(image, image_size - 1u, source_hash, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_deserialize(image, 4u, source_hash, allocator));
+  rcutils_reset_error();
+
+  // Corrupted image
+  image[image_size / 2u] ^= 0xffu;
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_deserialize(image, image_size, source_hash, allocator));
+  rcutils_reset_error();
+  image[image_size / 2u] ^= 0xffu;
+
+  // Not an image
+  image[0] = 'X';
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_deserialize(image, image_size, source_hash, allocator));
+  rcutils_reset_error();
+  image[0] = 'R';
+
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_deserialize(nullptr, image_size, source_hash, allocator));
+  rcutils_reset_error();
+
+  // Misaligned image
+  std::vector<uint64_t> copy(image_size / sizeof(uint64_t) + 2u);
+  uint8_t * misaligned = reinterpret_cast<uint8_t *>(copy.data()) + 1u;
+  memcpy(misaligned, image, image_size);
+  EXPECT_EQ(
+    nullptr, rcl_yaml_node_struct_deserialize(misaligned, image_size, source_hash, allocator));
+  rcutils_reset_error();
+
+  rcl_params_t * loaded = rcl_yaml_node_struct_deserialize(
+    image, image_size, source_hash, allocator);
+  EXPECT_TRUE(NULL != loaded) << rcutils_get_error_string().str;
+  rcl_yaml_node_struct_fini(loaded);
+}
+
+TEST_F(TestParamsCache, modify_loaded_params) {
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcl_yaml_node_struct_write_cache(params_hdl, source_hash, cache_path.c_str())) <<
+    rcutils_get_error_string().str;
+  rcl_params_t * loaded = rcl_yaml_node_struct_load_cache(
+    cache_path.c_str(), source_hash, allocator);
+  ASSERT_TRUE(NULL != loaded) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(loaded);
+  });
+
+  // Finding a parameter of the loaded structure does not copy it out of its storage
+  rcl_node_params_t * loaded_params = loaded->params;
+  const rcl_variant_t * found_value = rcl_yaml_node_struct_find("intel", "num_cores", loaded);
+  ASSERT_TRUE(NULL != found_value);
+  ASSERT_TRUE(NULL != found_value->integer_value);
+  EXPECT_EQ(8, *found_value->integer_value);
+  EXPECT_EQ(loaded_params, loaded->params);
+
+  EXPECT_TRUE(rcl_parse_yaml_value("intel", "num_cores", "16", loaded)) <<
+    rcutils_get_error_string().str;
+  EXPECT_TRUE(rcl_parse_yaml_value("intel", "new_param", "[1, 2]", loaded)) <<
+    rcutils_get_error_string().str;
+  rcl_variant_t * param_value = rcl_yaml_node_struct_get("intel", "num_cores", loaded);
+  ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+  ASSERT_TRUE(NULL != param_value->integer_value);
+  EXPECT_EQ(16, *param_value->integer_value);
+  param_value = rcl_yaml_node_struct_get("lidar_ns/lidar_2", "name", loaded);
+  ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+  ASSERT_TRUE(NULL != param_value->string_value);
+  EXPECT_STREQ("back_lidar", param_value->string_value);
+}
+
+TEST_F(TestParamsCache, share_loaded_params) {
+  ASSERT_EQ(
+    RCUTILS_RET_OK,
+    rcl_yaml_node_struct_write_cache(params_hdl, source_hash, cache_path.c_str())) <<
+    rcutils_get_error_string().str;
+  rcl_params_t * loaded = rcl_yaml_node_struct_load_cache(
+    cache_path.c_str(), source_hash, allocator);
+  ASSERT_TRUE(NULL != loaded) << rcutils_get_error_string().str;
+  rcl_params_t * shared = rcl_yaml_node_struct_share(loaded);
+  ASSERT_TRUE(NULL != shared) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(shared);
+  });
+  EXPECT_EQ(loaded->params, shared->params);
+
+  // The storage outlives the structure it was loaded into
+  rcl_yaml_node_struct_fini(loaded);
+  rcl_variant_t * param_value = rcl_yaml_node_struct_get("intel", "num_cores", shared);
+  ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+  ASSERT_TRUE(NULL != param_value->integer_value);
+  EXPECT_EQ(8, *param_value->integer_value);
+}
+
+TEST_F(TestParamsCache, parse_with_cache) {
+  EXPECT_FALSE(rcl_parse_yaml_file_with_cache(nullptr, cache_path.c_str(), params_hdl));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcl_parse_yaml_file_with_cache(yaml_path.c_str(), nullptr, params_hdl));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcl_parse_yaml_file_with_cache(yaml_path.c_str(), cache_path.c_str(), nullptr));
+  rcutils_reset_error();
+
+  // First parse misses the cache and writes it
+  rcl_params_t * first = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != first) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(first);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_file_with_cache(yaml_path.c_str(), cache_path.c_str(), first)) <<
+    rcutils_get_error_string().str;
+  expect_params_eq(params_hdl, first);
+
+  rcl_params_t * cached = rcl_yaml_node_struct_load_cache(
+    cache_path.c_str(), source_hash, allocator);
+  ASSERT_TRUE(NULL != cached) << rcutils_get_error_string().str;
+  rcl_yaml_node_struct_fini(cached);
+
+  // Second parse hits the cache
+  rcl_params_t * second = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != second) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(second);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_file_with_cache(yaml_path.c_str(), cache_path.c_str(), second)) <<
+    rcutils_get_error_string().str;
+  expect_params_eq(params_hdl, second);
+
+  // Cached parameters merge over existing ones
+  rcl_params_t * merged = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != merged) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(merged);
+  });
+  ASSERT_TRUE(rcl_parse_yaml_value("intel", "num_cores", "\"many\"", merged));
+  ASSERT_TRUE(rcl_parse_yaml_file_with_cache(yaml_path.c_str(), cache_path.c_str(), merged)) <<
+    rcutils_get_error_string().str;
+  EXPECT_EQ(params_hdl->num_nodes, merged->num_nodes);
+  rcl_variant_t * param_value = rcl_yaml_node_struct_get("intel", "num_cores", merged);
+  ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+  EXPECT_EQ(nullptr, param_value->string_value);
+  ASSERT_TRUE(NULL != param_value->integer_value);
+  EXPECT_EQ(8, *param_value->integer_value);
+
+  // Rewriting the cache replaces the file, leaving mappings of the previous one intact
+#ifndef _WIN32
+  int fd = open(cache_path.c_str(), O_RDONLY);
+  ASSERT_LE(0, fd);
+  const off_t cache_size = lseek(fd, 0, SEEK_END);
+  ASSERT_LT(0, cache_size);
+  void * mapping = mmap(nullptr, static_cast<size_t>(cache_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  ASSERT_NE(MAP_FAILED, mapping);
+  std::vector<uint8_t> mapped(
+    static_cast<uint8_t *>(mapping), static_cast<uint8_t *>(mapping) + cache_size);
+  rcl_params_t * empty = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != empty) << rcutils_get_error_string().str;
+  EXPECT_EQ(
+    RCUTILS_RET_OK, rcl_yaml_node_struct_write_cache(empty, source_hash, cache_path.c_str())) <<
+    rcutils_get_error_string().str;
+  rcl_yaml_node_struct_fini(empty);
+  EXPECT_EQ(0, memcmp(mapped.data(), mapping, mapped.size()));
+  munmap(mapping, static_cast<size_t>(cache_size));
+#endif
+  EXPECT_EQ(
+    RCUTILS_RET_ERROR,
+    rcl_yaml_node_struct_write_cache(params_hdl, source_hash, "not_a_dir/cache.bin"));
+  rcutils_reset_error();
+
+  // A stale cache is ignored
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_load_cache(cache_path.c_str(), 0u, allocator));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_load_cache("not_a_file.bin", source_hash, allocator));
+  rcutils_reset_error();
+}
@@ -453,6 +453,24 @@ TEST(TestParse, parse_key_bad_args)
   rcutils_reset_error();
 }
 
+TEST(TestParse, node_name_matches) {
+  EXPECT_TRUE(node_name_matches("/ns/node", "/ns/node"));
+  EXPECT_TRUE(node_name_matches("ns/node", "/ns/node"));
+  EXPECT_FALSE(node_name_matches("/ns/node", "/ns/other_node"));
+  EXPECT_FALSE(node_name_matches("/ns", "/ns/node"));
+  EXPECT_FALSE(node_name_matches("/ns/node", "/ns"));
+  EXPECT_TRUE(node_name_matches("/*", "/node"));
+  EXPECT_FALSE(node_name_matches("/*", "/ns/node"));
+  EXPECT_TRUE(node_name_matches("/ns/*", "/ns/node"));
+  EXPECT_TRUE(node_name_matches("/**", "/node"));
+  EXPECT_TRUE(node_name_matches("/**", "/ns/node"));
+  EXPECT_TRUE(node_name_matches("/**/node", "/node"));
+  EXPECT_TRUE(node_name_matches("/**/node", "/ns1/ns2/node"));
+  EXPECT_FALSE(node_name_matches("/**/node", "/ns1/ns2/other_node"));
+  EXPECT_TRUE(node_name_matches("/ns/**/bar/node", "/ns/foo/bar/node"));
+  EXPECT_FALSE(node_name_matches("/ns/*/bar/node", "/ns/bar/node"));
+}
+
 TEST(TestParse, parse_file_events_mock_yaml_parser_parse) {
   char cur_dir[1024];
   rcutils_reset_error();
@@ -661,6 +661,91 @@ TEST(test_file_parser, wildcards_partial) {
   }
 }
 
+TEST(test_file_parser, for_nodes) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  ASSERT_TRUE(NULL != test_path) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(test_path, allocator.state);
+  });
+  char * path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  ASSERT_TRUE(NULL != path) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(path, allocator.state);
+  });
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != params_hdl) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_hdl);
+  });
+
+  EXPECT_FALSE(rcl_parse_yaml_file_for_nodes(path, NULL, 1U, params_hdl));
+  rcutils_reset_error();
+
+  const char * node_fqns[] = {"/lidar_ns/lidar_2", "/camera"};
+  bool res = rcl_parse_yaml_file_for_nodes(path, node_fqns, 2U, params_hdl);
+  ASSERT_TRUE(res) << rcutils_get_error_string().str;
+  ASSERT_EQ(2U, params_hdl->num_nodes);
+  EXPECT_STREQ("lidar_ns/lidar_2", params_hdl->node_names[0]);
+  EXPECT_STREQ("camera", params_hdl->node_names[1]);
+
+  rcl_variant_t * param_value = rcl_yaml_node_struct_get("lidar_ns/lidar_2", "is_back", params_hdl);
+  ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+  ASSERT_TRUE(NULL != param_value->bool_value);
+  EXPECT_FALSE(*param_value->bool_value);
+  param_value = rcl_yaml_node_struct_get("camera", "cam_spec.supported_brands", params_hdl);
+  ASSERT_TRUE(NULL != param_value) << rcutils_get_error_string().str;
+  ASSERT_TRUE(NULL != param_value->string_array_value);
+  EXPECT_EQ(3U, param_value->string_array_value->size);
+
+  // Parsing the whole file afterwards merges the remaining nodes in
+  res = rcl_parse_yaml_file(path, params_hdl);
+  ASSERT_TRUE(res) << rcutils_get_error_string().str;
+  EXPECT_LT(2U, params_hdl->num_nodes);
+}
+
+TEST(test_file_parser, for_nodes_wildcards) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  ASSERT_TRUE(NULL != test_path) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(test_path, allocator.state);
+  });
+  char * path = rcutils_join_path(test_path, "wildcards.yaml", allocator);
+  ASSERT_TRUE(NULL != path) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    allocator.deallocate(path, allocator.state);
+  });
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  ASSERT_TRUE(NULL != params_hdl) << rcutils_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rcl_yaml_node_struct_fini(params_hdl);
+  });
+
+  const char * node_fqns[] = {"/foo7/baz/some_node7", "/foo6/some_node6"};
+  bool res = rcl_parse_yaml_file_for_nodes(path, node_fqns, 2U, params_hdl);
+  ASSERT_TRUE(res) << rcutils_get_error_string().str;
+  const std::vector<std::string> expected_node_names = {
+    "/**", "/foo6/**/some_node6", "/foo7/*/some_node7"
+  };
+  ASSERT_EQ(expected_node_names.size(), params_hdl->num_nodes);
+  for (size_t i = 0U; i < params_hdl->num_nodes; ++i) {
+    EXPECT_EQ(expected_node_names[i], params_hdl->node_names[i]);
+  }
+}
+
 int32_t main(int32_t argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
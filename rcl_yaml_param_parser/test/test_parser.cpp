@@ -132,7 +132,7 @@ TEST(RclYamlParamParser, node_copy) {
   // Reset calloc countdown
   set_time_bomb_allocator_calloc_count(params_st->allocator, -1);
 
-  constexpr int expected_num_malloc_calls = 3;
+  constexpr int expected_num_malloc_calls = 4;
   for (int i = 0; i < expected_num_malloc_calls; ++i) {
     set_time_bomb_allocator_malloc_count(params_st->allocator, i);
     EXPECT_EQ(nullptr, rcl_yaml_node_struct_copy(params_st));
@@ -144,7 +144,7 @@ TEST(RclYamlParamParser, node_copy) {
   EXPECT_NE(nullptr, copy);
   rcl_yaml_node_struct_fini(copy);
 
-  constexpr int num_malloc_calls_until_copy_param = 2;
+  constexpr int num_malloc_calls_until_copy_param = 3;
 
   // Check integer value
   int64_t temp_int = 42;
@@ -247,6 +247,78 @@ TEST(RclYamlParamParser, node_copy) {
 
   rcl_yaml_node_struct_fini(params_st);
 }
+
+TEST(RclYamlParamParser, node_share) {
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rcl_params_t * params_st = rcl_yaml_node_struct_init(allocator);
+  ASSERT_NE(params_st, nullptr);
+
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_share(nullptr));
+
+  const char node_name[] = "node name";
+  const char param_name[] = "param name";
+  EXPECT_TRUE(rcl_parse_yaml_value(node_name, param_name, "true", params_st));
+
+  rcl_params_t * shared = rcl_yaml_node_struct_share(params_st);
+  ASSERT_NE(nullptr, shared);
+  EXPECT_EQ(params_st->node_names, shared->node_names);
+  EXPECT_EQ(params_st->params, shared->params);
+  rcl_params_t * shared_again = rcl_yaml_node_struct_share(shared);
+  ASSERT_NE(nullptr, shared_again);
+  rcl_yaml_node_struct_fini(shared_again);
+
+  // Modifying one structure leaves the other untouched
+  EXPECT_TRUE(rcl_parse_yaml_value(node_name, param_name, "false", shared));
+  EXPECT_NE(params_st->params, shared->params);
+  rcl_variant_t * param_value = rcl_yaml_node_struct_get(node_name, param_name, params_st);
+  ASSERT_NE(nullptr, param_value);
+  ASSERT_NE(nullptr, param_value->bool_value);
+  EXPECT_TRUE(*param_value->bool_value);
+  param_value = rcl_yaml_node_struct_get(node_name, param_name, shared);
+  ASSERT_NE(nullptr, param_value);
+  ASSERT_NE(nullptr, param_value->bool_value);
+  EXPECT_FALSE(*param_value->bool_value);
+  rcl_yaml_node_struct_fini(shared);
+
+  // Finding a parameter of a shared structure leaves the members shared,
+  // getting one gets the structure its own members
+  shared = rcl_yaml_node_struct_share(params_st);
+  ASSERT_NE(nullptr, shared);
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_find(nullptr, param_name, params_st));
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_find(node_name, nullptr, params_st));
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_find(node_name, param_name, nullptr));
+  rcutils_reset_error();
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_find(node_name, "other param name", params_st));
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_find("other node name", param_name, params_st));
+  const rcl_variant_t * found_value = rcl_yaml_node_struct_find(node_name, param_name, params_st);
+  ASSERT_NE(nullptr, found_value);
+  ASSERT_NE(nullptr, found_value->bool_value);
+  EXPECT_TRUE(*found_value->bool_value);
+  EXPECT_EQ(params_st->params, shared->params);
+  param_value = rcl_yaml_node_struct_get(node_name, param_name, params_st);
+  ASSERT_NE(nullptr, param_value);
+  EXPECT_NE(params_st->params, shared->params);
+  rcl_yaml_node_struct_fini(params_st);
+  param_value = rcl_yaml_node_struct_get(node_name, param_name, shared);
+  ASSERT_NE(nullptr, param_value);
+  ASSERT_NE(nullptr, param_value->bool_value);
+  EXPECT_TRUE(*param_value->bool_value);
+  params_st = shared;
+
+  rcl_yaml_node_struct_fini(params_st);
+
+  params_st = rcl_yaml_node_struct_init(get_time_bomb_allocator());
+  ASSERT_NE(params_st, nullptr);
+  // Allocation of the sharing structure fails, the reference count is allocated at init
+  set_time_bomb_allocator_malloc_count(params_st->allocator, 0);
+  EXPECT_EQ(nullptr, rcl_yaml_node_struct_share(params_st));
+  set_time_bomb_allocator_malloc_count(params_st->allocator, -1);
+  shared = rcl_yaml_node_struct_share(params_st);
+  ASSERT_NE(nullptr, shared);
+  rcl_yaml_node_struct_fini(shared);
+  rcl_yaml_node_struct_fini(params_st);
+}
+
 // // This just tests a couple of basic failures that test_parse_yaml.cpp misses.
 // // See that file for more thorough testing of bad yaml files
 TEST(RclYamlParamParser, test_file) {